@@ -2,6 +2,7 @@
 /// @brief	Declares the UDP client port class
 #pragma once
 #include <core/communication.h>
+
 namespace communication
 {
 	namespace ports
@@ -17,17 +18,35 @@ namespace communication
 
 #pragma pack()
 
+		/// A received CAN message along with its receive time
+		struct can_timestamped_msg
+		{
+			can_msg msg;
+			/// Kernel receive time in nanoseconds since epoch (hardware time when provided by the device), 0 if unavailable
+			uint64_t timestamp_ns;
+		};
+
+		/// A kernel-side receive filter, a message is received when (received_id & mask) == (id & mask).
+		/// Uses the SocketCAN conventions: the extended frame flag (CAN_EFF_FLAG) may be part of the id and mask,
+		/// and setting CAN_INV_FILTER on the id inverts the filter.
+		struct can_id_filter
+		{
+			uint32_t id;
+			uint32_t mask;
+		};
+
 		enum can_interface
 		{
 			socket_can,
 			slcan
 		};
 
+		/// The frame sizes of SocketCAN (CAN_MTU and CANFD_MTU of linux/can.h)
 		enum can_mode
 		{
 #ifndef _WIN32
-			MODE_CAN_MTU = CAN_MTU,
-			MODE_CANFD_MTU = CANFD_MTU
+			MODE_CAN_MTU = 16,
+			MODE_CANFD_MTU = 72
 
 #else
 			MODE_CAN_MTU = 16,
@@ -36,6 +55,53 @@ namespace communication
 #endif
 		};
 
+		class can_port_interface : public core::ref_count_interface
+		{
+		public:
+
+			~can_port_interface() = default;
+
+			virtual bool can_open() = 0;
+			virtual bool can_close() = 0;
+			virtual size_t can_read(void* buffer, size_t size) = 0;
+			virtual size_t can_send(const void* buffer, size_t size) const = 0;
+			virtual core::communication::communication_status communication_status() const = 0;
+
+			/// @fn	virtual size_t can_port_interface::can_read_batch(can_timestamped_msg* messages, size_t count, core::communication::communication_error* error)
+			/// @brief	Reads up to 'count' messages, blocking until at least one message is received or the read times out.
+			/// 		The default implementation reads a single message without a timestamp.
+			/// @date	19/10/2026
+			/// @param [out]	messages	The received messages.
+			/// @param 		   	count   	The maximum number of messages to read.
+			/// @param [out]	error   	Why no message was read: TIMED_OUT when the read should be retried, any other error when the port failed.
+			/// @return	The number of messages read, 0 on timeout or failure.
+			virtual size_t can_read_batch(can_timestamped_msg* messages, size_t count, core::communication::communication_error* error)
+			{
+				*error = core::communication::communication_error::NO_ERRORS;
+				if (messages == nullptr || count == 0)
+					return 0;
+
+				messages[0].timestamp_ns = 0;
+				if (can_read(&messages[0].msg, sizeof(can_msg)) > 0)
+					return 1;
+
+				// can_read only gives up once the port is closed
+				*error = core::communication::communication_error::UNKNOWN_ERROR;
+				return 0;
+			}
+
+			/// @fn	virtual bool can_port_interface::can_set_filters(const can_id_filter* filters, size_t count)
+			/// @brief	Sets the receive filters, replacing the current ones. No filters means receiving every message.
+			/// @date	19/10/2026
+			/// @param	filters	The filters.
+			/// @param	count  	Number of filters.
+			/// @return	True if it succeeds, false if filtering is not supported or fails.
+			virtual bool can_set_filters(const can_id_filter* filters, size_t count)
+			{
+				return false;
+			}
+		};
+
 		class DLL_EXPORT can_port_adapter : public core::communication::client_channel_interface
 		{
 		public:
@@ -54,19 +120,31 @@ namespace communication
 				communication::ports::can_port_interface* can_port_interface,
 				core::communication::client_channel_interface** client);
 
-		};
+			/// @fn	virtual size_t can_port_adapter::recieve_batch(can_timestamped_msg* messages, size_t count, core::communication::communication_error* commError) = 0;
+			/// @brief	Pops up to 'count' received messages, blocking until at least one message is available
+			/// @date	19/10/2026
+			/// @param [out]	messages 	The received messages with their kernel receive timestamps.
+			/// @param 		   	count	 	The maximum number of messages to pop.
+			/// @param [out]	commError	The communication error, the error of the port when it failed.
+			/// @return	The number of popped messages, 0 when the adapter is disconnected or the port failed.
+			virtual size_t recieve_batch(can_timestamped_msg* messages, size_t count, core::communication::communication_error* commError) = 0;
 
-		class can_port_interface : public core::ref_count_interface
-		{
-		public:
+			/// @fn	virtual bool can_port_adapter::set_filters(const can_id_filter* filters, size_t count) = 0;
+			/// @brief	Sets kernel-side receive filters so unwanted messages never reach user space.
+			/// 		Can be called before or after connecting.
+			/// @date	19/10/2026
+			/// @param	filters	The filters, nullptr to receive every message.
+			/// @param	count  	Number of filters.
+			/// @return	True if it succeeds, false if it fails.
+			virtual bool set_filters(const can_id_filter* filters, size_t count) = 0;
 
-			~can_port_interface() = default;
+			/// @fn	virtual uint64_t can_port_adapter::dropped_messages() const = 0;
+			/// @brief	Gets the number of received messages which were dropped since the receive queue was full
+			/// @date	19/10/2026
+			/// @return	The number of dropped messages.
+			virtual uint64_t dropped_messages() const = 0;
 
-			virtual bool can_open() = 0;
-			virtual bool can_close() = 0;
-			virtual size_t can_read(void* buffer, size_t size) = 0;
-			virtual size_t can_send(const void* buffer, size_t size) const = 0;
-			virtual core::communication::communication_status communication_status() const = 0;
 		};
+
 	}
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+/// @file	ports/io_backend.h.
+/// @brief	Declares the I/O backends available to the IP ports
+#pragma once
+#include <core/os.h>
+
+namespace communication
+{
+	namespace ports
+	{
+		/// @enum	io_backend
+		/// @brief	Values that represent the way a port receives data
+		enum class io_backend
+		{
+			/// A blocking read per message on the caller's thread (default)
+			blocking,
+			/// Linux io_uring: multishot receives into provided-buffer rings, completed by a single process-wide thread.
+			/// Ports fall back to blocking reads when io_uring is not supported by the running kernel.
+			io_uring
+		};
+
+		/// @class	io_uring_backend
+		/// @brief	Queries the io_uring backend availability
+		/// @date	19/10/2026
+		class DLL_EXPORT io_uring_backend
+		{
+		public:
+			/// @fn	static bool io_uring_backend::supported();
+			/// @brief	Checks whether the io_uring backend can be used in this process
+			/// @date	19/10/2026
+			/// @return	True if io_uring is supported by the build and the running kernel, false otherwise.
+			static bool supported();
+		};
+	}
+}
@@ -0,0 +1,51 @@
+/// @file	ports/shm_port.h.
+/// @brief	Declares the shared memory port class
+#pragma once
+#include <core/communication.h>
+
+namespace communication
+{
+	namespace ports
+	{
+		/// @class	shm_port
+		/// @brief	A port between processes of the same host, over lock-free rings in shared memory.
+		/// 		Each port receives from a ring it owns (named by its local name) and sends to its peer's ring
+		/// 		(named by the remote name), similarly to a pair of UDP ports.
+		/// 		Messages boundaries are kept, reads of a partial size are served like the UDP port does.
+		/// 		A record left unstamped by a sender dying while reserving it blocks the ring: after the stall timeout,
+		/// 		the ring is recreated and the messages it held are lost, see lost_messages().
+		/// @date	19/10/2026
+		class DLL_EXPORT shm_port : public core::communication::client_channel_interface
+		{
+		public:
+			/// @fn	virtual shm_port::~shm_port() = default;
+			/// @brief	Destructor
+			/// @date	19/10/2026
+			virtual ~shm_port() = default;
+
+			/// @fn	static bool shm_port::create(const char* local_name, const char* remote_name, size_t capacity, uint32_t stall_timeout_ms, core::communication::client_channel_interface** client);
+			/// @brief	Static factory: Creates a new shared memory port
+			/// @date	19/10/2026
+			/// @param 		   	local_name			The name of the ring this port receives from (created on connect).
+			/// @param 		   	remote_name			The name of the peer's ring this port sends to.
+			/// @param 		   	capacity   			The receive ring size in bytes (rounded up to a power of 2), messages are limited to half of it.
+			/// @param 		   	stall_timeout_ms	How long a record without a known sender may block the receive ring before it is recreated, 0 waits forever.
+			/// 									Records whose sender is alive are always waited for.
+			/// @param [out]	client	   			An address to a pointer to core::communication::client_channel_interface
+			/// @return	True if it succeeds, false if it fails.
+			static bool create(
+				const char* local_name,
+				const char* remote_name,
+				size_t capacity,
+				uint32_t stall_timeout_ms,
+				core::communication::client_channel_interface** client);
+
+			/// @fn	virtual uint64_t shm_port::lost_messages() const = 0;
+			/// @brief	Gets the number of messages lost by the receive ring: skipped since their sender died while
+			/// 		writing them, or dropped with the ring when it was recreated.
+			/// @date	19/10/2026
+			/// @return	The messages lost since the port was created.
+			virtual uint64_t lost_messages() const = 0;
+		};
+	}
+}
@@ -2,15 +2,17 @@
 /// @brief	Declares the TCP client port class
 #pragma once
 #include <core/communication.h>
+#include <communication/ports/io_backend.h>
 
 namespace communication
 {
 	namespace ports
 	{
 		/// @class	tcp_client_port
-		/// @brief	A TCP client port.
+		/// @brief	A TCP client port. With the io_uring backend, its stream reads can be delivered directly (core::communication::direct_receive_interface).
 		/// @date	15/05/2018
-		class DLL_EXPORT tcp_client_port : public core::communication::ip_client_channel_interface
+		class DLL_EXPORT tcp_client_port : public core::communication::ip_client_channel_interface,
+			public core::communication::direct_receive_interface
 		{
 		public:
 			/// @fn	virtual tcp_client_port::~tcp_client_port() = default;
@@ -40,6 +42,19 @@ namespace communication
 			/// @param [out]	channel			 	An address of a pointer to core::communication::client_channel_interface.
 			/// @return	True if it succeeds, false if it fails.
 			static bool create(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool bNoDelay, core::communication::client_channel_interface** channel);
+
+			/// @fn	static bool tcp_client_port::create(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool bNoDelay, communication::ports::io_backend backend, core::communication::client_channel_interface** channel);
+			/// @brief	Static factory: Creates a new TCP client instance using a specific I/O backend
+			/// @date	19/10/2026
+			/// @param 		   	strRemoteHostname	The remote host name (DNS resolved or IP address).
+			/// @param 		   	usRemotePort	 	The remote IP port.
+			/// @param 		   	strLocalHostname 	The local host name  (DNS resolved or IP address).
+			/// @param 		   	usLocalPort		 	The local IP port.
+			/// @param			bNoDelaySend		True to cancel Nagel Algorithm that is batching messages to one packet
+			/// @param			backend				The I/O backend used for receiving.
+			/// @param [out]	channel			 	An address of a pointer to core::communication::client_channel_interface.
+			/// @return	True if it succeeds, false if it fails.
+			static bool create(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool bNoDelay, communication::ports::io_backend backend, core::communication::client_channel_interface** channel);
 		};
 	}
 }
\ No newline at end of file
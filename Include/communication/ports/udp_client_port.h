@@ -2,14 +2,17 @@
 /// @brief	Declares the UDP client port class
 #pragma once
 #include <core/communication.h>
+#include <communication/ports/io_backend.h>
+
 namespace communication
 {
 	namespace ports
 	{
 		/// @class	udp_client_port
-		/// @brief	A UDP client port.
+		/// @brief	A UDP client port. With the io_uring backend, its datagrams can be delivered directly (core::communication::direct_receive_interface).
 		/// @date	15/05/2018
-		class DLL_EXPORT udp_client_port : public core::communication::ip_client_channel_interface
+		class DLL_EXPORT udp_client_port : public core::communication::ip_client_channel_interface,
+			public core::communication::direct_receive_interface
 		{
 		public:
 			/// @fn	virtual udp_client_port::~udp_client_port() = default;
@@ -38,6 +41,29 @@ namespace communication
 				int send_buffer_size,
 				core::communication::client_channel_interface** client);
 
+			/// @fn	static bool udp_client_port::create(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool multicast, int receive_buffer_size, int send_buffer_size, communication::ports::io_backend backend, core::communication::client_channel_interface** client);
+			/// @brief	Static factory: Creates a new UDP communication using a specific I/O backend
+			/// @date	19/10/2026
+			/// @param 		   	strRemoteHostname	The remote host name (DNS resolved or IP address).
+			/// @param 		   	usRemotePort	 	The remote IP port.
+			/// @param 		   	strLocalHostname 	The local host name (DNS resolved or IP address).
+			/// @param 		   	usLocalPort		 	The local IP port.
+			/// @param 		   	receive_buffer_size	The configured receive buffer size
+			/// @param			send_buffer_size	The configured send buffer size
+			/// @param			backend				The I/O backend used for receiving.
+			/// @param [out]	client			 	An address to a pointer to core::communication::client_channel_interface
+			/// @return	True if it succeeds, false if it fails.
+			static bool create(
+				const char* strRemoteHostname,
+				uint16_t usRemotePort,
+				const char* strLocalHostname,
+				uint16_t usLocalPort,
+				bool multicast,
+				int receive_buffer_size,
+				int send_buffer_size,
+				communication::ports::io_backend backend,
+				core::communication::client_channel_interface** client);
+
 			static bool create(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, core::communication::client_channel_interface** client);
 
 			static bool create(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool multicast, core::communication::client_channel_interface** client);
@@ -91,6 +91,53 @@ namespace core
 			virtual size_t recieve(void* buffer, size_t size, core::communication::communication_error* commError) = 0;
 		};
 
+		/// @class	frame_callback_interface
+		/// @brief	Gets the data of a client channel from the thread completing its reads.
+		/// @date	19/10/2026
+		class DLL_EXPORT frame_callback_interface : public core::ref_count_interface
+		{
+		public:
+			/// @fn	virtual frame_callback_interface::~frame_callback_interface() = default;
+			/// @brief	Destructor
+			/// @date	19/10/2026
+			virtual ~frame_callback_interface() = default;
+
+			/// @fn	virtual void frame_callback_interface::on_frame(const void* buffer, size_t size) = 0;
+			/// @brief	Called, in order, for each received frame: a whole datagram, or the bytes a single stream read returned.
+			/// @date	19/10/2026
+			/// @param	buffer	The frame data, only valid during the call.
+			/// @param	size  	The frame size.
+			virtual void on_frame(const void* buffer, size_t size) = 0;
+
+			/// @fn	virtual void frame_callback_interface::on_closed(core::communication::communication_error error) = 0;
+			/// @brief	Called once, after the last frame, when the channel stops receiving: end of stream, socket error or disconnection.
+			/// @date	19/10/2026
+			/// @param	error	The socket error, NO_ERRORS for an end of stream or a disconnection.
+			virtual void on_closed(core::communication::communication_error error) = 0;
+		};
+
+		/// @class	direct_receive_interface
+		/// @brief	Implemented by client channels which can deliver their frames straight from the thread completing the reads,
+		/// 		instead of to a thread blocked in recieve().
+		/// @date	19/10/2026
+		class DLL_EXPORT direct_receive_interface
+		{
+		public:
+			/// @fn	virtual direct_receive_interface::~direct_receive_interface() = default;
+			/// @brief	Destructor
+			/// @date	19/10/2026
+			virtual ~direct_receive_interface() = default;
+
+			/// @fn	virtual bool direct_receive_interface::set_frame_callback(core::communication::frame_callback_interface* callback) = 0;
+			/// @brief	Sets the callback getting the frames from the next connect() on, recieve() is not used meanwhile.
+			/// 		The callback may be called from a thread shared by all the channels of the process: it should not block, and must not disconnect the channel.
+			/// 		Should be called while the channel is disconnected.
+			/// @date	19/10/2026
+			/// @param [in]	callback	The callback, or null to go back to recieve().
+			/// @return	True if it succeeds, false if the channel is connected or cannot deliver its frames directly.
+			virtual bool set_frame_callback(core::communication::frame_callback_interface* callback) = 0;
+		};
+
 #pragma pack(1)
 		enum ip_address_type
 		{
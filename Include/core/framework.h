@@ -4,6 +4,11 @@
 #include <core/logging.h>
 #include <cstdint>
 
+namespace utils
+{
+	class worker_pool;
+}
+
 namespace core
 {
 	class DLL_EXPORT framework
@@ -47,6 +52,9 @@ namespace core
 		static bool add_logger_hook(core::framework::logger_hook_interface* logger_hook);
 		static bool remove_logger_hook(core::framework::logger_hook_interface* logger_hook);
 		static bool create_looger(const char* name, core::logging::severity filter, core::logging::logger** logger);
+
+		/// The worker pool shared by the modules of the process (utils::worker_pool::shared)
+		static utils::worker_pool& shared_worker_pool();
 	};
 
 	inline bool operator==(const core::framework::version_struct& lhs, const core::framework::version_struct& rhs)
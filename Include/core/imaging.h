@@ -2,6 +2,7 @@
 /// @brief	Declares the image interface class
 #pragma once
 #include <core/buffer_interface.h>
+#include <cstring>
 
 namespace core
 {
@@ -76,6 +77,50 @@ namespace core
 		public:
 			virtual ~image_algorithm_interface() = default;
 			virtual bool apply(core::imaging::image_interface* input, core::imaging::image_interface** output) = 0;
+
+			/// @fn	virtual bool image_algorithm_interface::apply_into(core::imaging::image_interface* input, core::imaging::image_interface* output);
+			/// @brief	Applies the algorithm into the buffer of an existing image, which is filled in place.
+			/// 		Unless the algorithm overrides it, the image produced by apply is copied into the output image.
+			/// @date	19/10/2026
+			/// @param [in]		input 	The input image.
+			/// @param [in,out]	output	The output image, its parameters must be the ones apply would have produced.
+			/// @return	True if it succeeds, false if it fails or the output image does not fit.
+			virtual bool apply_into(core::imaging::image_interface* input, core::imaging::image_interface* output)
+			{
+				if (output == nullptr)
+					return false;
+
+				core::imaging::image_interface* result = nullptr;
+				if (apply(input, &result) == false || result == nullptr)
+					return false;
+
+				core::imaging::image_params result_params = {};
+				core::imaging::image_params output_params = {};
+				core::buffer_interface* source = nullptr;
+				core::buffer_interface* target = nullptr;
+				bool retval =
+					result->query_image_params(result_params) == true &&
+					output->query_image_params(output_params) == true &&
+					result_params.width == output_params.width &&
+					result_params.height == output_params.height &&
+					result_params.format == output_params.format &&
+					result->query_buffer(&source) == true &&
+					output->query_buffer(&target) == true &&
+					source->size() >= result_params.size &&
+					target->size() >= result_params.size;
+
+				if (retval == true)
+					std::memcpy(target->data(), source->data(), result_params.size);
+
+				if (target != nullptr)
+					target->release();
+
+				if (source != nullptr)
+					source->release();
+
+				result->release();
+				return retval;
+			}
 		};
 	}
 }
\ No newline at end of file
@@ -30,6 +30,18 @@ namespace core
 			char name[MAX_NAME];
 			int64_t value;
 		};
+
+		/// A compiled accessor - a field path (e.g. "header.sensors[3].temp") resolved once into
+		/// the field's location in the root buffer, so reading it requires no lookup
+		struct binary_accessor
+		{
+			size_t offset = 0; //from the start of the root buffer
+			size_t size = 0;
+			core::types::type_enum type = core::types::type_enum::UNKNOWN;
+			bool swap = false; //the field's endian differs from the platform endian
+			uint64_t mask = 0; //bitmap fields only, the mask of the field's bits
+			uint8_t bit_offset = 0; //bitmap fields only
+		};
 		
 		enum json_details_level
 		{
@@ -244,6 +256,19 @@ namespace core
 			/// @return	True if it succeeds, false if it fails.
 			virtual bool create_parser(core::parsers::binary_parser_interface** parser) const = 0;
 
+			/// Compiles a field path into an accessor, nested fields are separated by '.' and array elements
+			/// are selected by an index in brackets (e.g. "header.sensors[3].temp")
+			/// @date	19/10/2026
+			/// @param 			path	 	The path of a simple, enum, string or bitmap field.
+			/// @param [out]	accessor	The compiled accessor.
+			/// @return	True if it succeeds, false if the path does not describe such a field.
+			virtual bool compile_accessor(const char* path, core::parsers::binary_accessor& accessor) const = 0;
+
+			/// Determines if the metadata is frozen - read-only, its nodes are queried without locks
+			/// @date	19/10/2026
+			/// @return	True if frozen, false if it is still built.
+			virtual bool frozen() const = 0;
+
 			/// Converts this metadata object to JSON
 			/// @date	23/12/2018
 			/// @param 			compact	True to compact false for readable JSON.
@@ -346,6 +371,13 @@ namespace core
 			/// @param	json	The JSON.
 			/// @return	True if it succeeds, false if it fails.
 			virtual bool from_json(const char *json_string) = 0;
+
+			/// Freezes the metadata once it is built, together with its nested metadata.
+			/// A frozen metadata is a flat read-only table of nodes queried without locks, names are found in O(1),
+			/// and every further change of the metadata (put, nest, array, namely, from_json...) is rejected.
+			/// @date	19/10/2026
+			/// @return	True if it succeeds, false if it fails.
+			virtual bool freeze() = 0;
 		};
 
 		class DLL_EXPORT binary_parser_interface : public ref_count_interface
@@ -400,6 +432,18 @@ namespace core
 			/// @return	Null if it fails, else a pointer to a const char.
 			virtual const char* check_and_get_json(json_details_level details_level, bool compact, bool& no_errors) = 0;
 
+			/// Writes the JSON of this object into a caller supplied buffer, the fields are streamed as they are read
+			/// without building a JSON document or allocating. The text is the same as check_and_get_json's.
+			/// @date	19/10/2026
+			/// @param [out]	json		 	If non-null, the buffer to write the null terminated JSON into.
+			/// @param 			json_size	 	Size of the buffer.
+			/// @param 			details_level	The enums details level.
+			/// @param 			compact		 	True to compact false for readable JSON.
+			/// @param [out]	length		 	The length of the JSON, the required length (without the terminator) when the buffer is too small.
+			/// @param [out]	no_errors	 	False if some fields are erroneous, they are written as an error message string.
+			/// @return	True if the JSON fits in the buffer, false otherwise.
+			virtual bool write_json(char* json, size_t json_size, json_details_level details_level, bool compact, size_t& length, bool& no_errors) const = 0;
+
 			/// Initializes this object from the given from JSON
 			/// the function will allow creating an object from json if fields are missing or there are extra fields
 			/// @date	03/10/2018
@@ -408,6 +452,15 @@ namespace core
 			/// @return	True if it succeeds, false if it fails.
 			virtual bool from_json(const char *json_string) = 0;
 
+			/// Initializes this object from a JSON object without building a JSON document - the text is read token by token
+			/// and the values are written straight into the buffer, keys are matched by perfect hash tables built once from the metadata.
+			/// Accepts the same objects as from_json, an invalid text fails instead of throwing. The buffer may be partially written on failure.
+			/// @date	19/10/2026
+			/// @param	json	 	The JSON.
+			/// @param	json_size	The size of the JSON, reading stops at a null character as well.
+			/// @return	True if it succeeds, false if it fails.
+			virtual bool from_json(const char* json, size_t json_size) = 0;
+
 			/// Reads a simple data (primitive) from the buffer
 			/// @date	03/10/2018
 			/// @param 		   	index				   	Zero-based index of the.
@@ -450,6 +503,14 @@ namespace core
 			/// @return	True if it succeeds, false if it fails.
 			virtual bool read_by_node(void* data, size_t number_of_bytes_to_read, const core::parsers::binary_node_interface *node, core::types::type_enum& type) const = 0;
 
+			/// Reads a field through an accessor compiled by this parser's metadata
+			/// @date	19/10/2026
+			/// @param 		   	accessor			   	The compiled accessor.
+			/// @param [out]	data				   	If non-null, the data read from the buffer.
+			/// @param 		   	number_of_bytes_to_read	Number of bytes to reads (size of the object).
+			/// @return	True if it succeeds, false if it fails.
+			virtual bool read_compiled(const core::parsers::binary_accessor& accessor, void* data, size_t number_of_bytes_to_read) const = 0;
+
 			/// Reads a complex data from the parser - complex data is usually a struct or a more complex data that requires a parser of its own.
 			/// @date	03/10/2018
 			/// @param 		   	name  	The name.
@@ -503,7 +564,9 @@ namespace core
 			/// @return	True if it succeeds, false if it fails.
 			virtual bool read_complex_at(size_t index, binary_parser_interface** parser, size_t array_index) const = 0;
 
-			/// Writes data to the buffer
+			/// Writes data to the buffer.
+			/// The data is copied as it is, in the field's endian: unlike reads, writes do not convert it from the platform endian
+			/// (the setters of generated structs do, see utils/binary_struct.hpp).
 			/// @date	03/10/2018
 			/// @param 		   	name						The name.
 			/// @param [in]	data						If non-null, the data.
@@ -511,7 +574,7 @@ namespace core
 			/// @return	True if it succeeds, false if it fails.
 			virtual bool write(const char* name, const void* data, size_t number_of_bytes_to_write, core::types::type_enum type) = 0;
 
-			/// Writes data to the buffer based on the size
+			/// Writes data to the buffer based on the size, copied as it is like write(name, ...)
 			/// @date	03/10/2018
 			/// @param	index						Zero-based index of the.
 			/// @param	data						The data.
@@ -618,6 +681,23 @@ namespace core
 			/// @param [out]	enum_instance	If non-null, return the enum instance.
 			/// @return	True if it succeeds, false if it fails.
 			virtual bool query_enum(const char* name, core::parsers::enum_data_interface** enum_instance) = 0;
+
+			/// Saves the metadata and the enums of the store, including their nested and array layouts, into a binary
+			/// cache file which is loaded by load_cache without parsing any text
+			/// @date	19/10/2026
+			/// @param	file_name  	The name of the cache file, replaced atomically.
+			/// @param	source_hash	The content hash of the sources the store was built from (see binary_metadata_store::hash_files).
+			/// @return	True if it succeeds, false if it fails.
+			virtual bool save_cache(const char* file_name, uint64_t source_hash) = 0;
+
+			/// Loads the metadata and the enums of a cache file into the store.
+			/// Names which already exist in the store are kept.
+			/// @date	19/10/2026
+			/// @param	file_name  	The name of the cache file.
+			/// @param	source_hash	The content hash of the current sources.
+			/// @return	False if the file is missing, invalid or was saved from different sources - the store is then
+			/// 		unchanged and should be built from the sources.
+			virtual bool load_cache(const char* file_name, uint64_t source_hash) = 0;
 		};
 
 		class DLL_EXPORT binary_parser_creator_interface : public ref_count_interface
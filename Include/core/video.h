@@ -56,6 +56,21 @@ namespace core
 			UNDEFINED_VIDEO_DATA_TYPE
 		};
 
+		/// @enum	video_hop
+		/// @brief	Values that represent the framework hops a frame passes through
+		enum video_hop
+		{
+			/// @brief	The frame was captured by its source (e.g. pulled from a GStreamer appsink)
+			CAPTURE_HOP,
+			/// @brief	The frame was written to shared memory by a publisher
+			PUBLISH_HOP,
+			/// @brief	The frame was read from shared memory by a subscriber
+			RECEIVE_HOP,
+			/// @brief	The frame was delivered to a frame callback (measured, never carried by frames)
+			DELIVER_HOP,
+			VIDEO_HOP_COUNT
+		};
+
 		/// @struct	video_params
 		/// @brief	A video stream parameters.
 		/// @date	14/05/2018
@@ -67,6 +82,46 @@ namespace core
 			core::video::framerate framerate;	//t:framerate
 			/// @brief	The video data type
 			core::video::video_data_type data_type;	//t:video_data_type
+			/// @brief	The monotonic (steady clock) time in nanoseconds at which the frame passed each hop, 0 when it did not
+			uint64_t timestamps[VIDEO_HOP_COUNT];
+		};
+
+		/// @brief	The number of buckets of a latency histogram
+		static constexpr uint32_t LATENCY_BUCKETS = 24;
+
+		/// @struct	latency_histogram
+		/// @brief	A histogram of latencies in microseconds: bucket i counts latencies in [2^i - 1, 2^(i+1) - 1),
+		/// 		the last bucket counts every longer latency.
+		/// @date	19/10/2026
+		struct DLL_EXPORT latency_histogram
+		{
+			/// @brief	The number of latencies
+			uint64_t count;
+			/// @brief	The sum of the latencies in microseconds
+			uint64_t total;
+			/// @brief	The longest latency in microseconds
+			uint64_t max;
+			/// @brief	The number of latencies by bucket
+			uint64_t buckets[LATENCY_BUCKETS];
+		};
+
+		/// @struct	video_statistics
+		/// @brief	A video stream's throughput and latency statistics, as seen by a source or a publisher.
+		/// @date	19/10/2026
+		struct DLL_EXPORT video_statistics
+		{
+			/// @brief	The number of frames
+			uint64_t frames;
+			/// @brief	The number of frames dropped (not published, skipped by a reader or not delivered to a callback)
+			uint64_t dropped;
+			/// @brief	The number of frame data bytes copied
+			uint64_t copied_bytes;
+			/// @brief	The frames per second over the last second
+			double fps;
+			/// @brief	The latencies from the capture of the frames to their last hop
+			core::video::latency_histogram end_to_end;
+			/// @brief	The latencies from the previous hop a frame passed to each hop
+			core::video::latency_histogram hops[VIDEO_HOP_COUNT];
 		};
 #pragma pack()
 
@@ -97,6 +152,25 @@ namespace core
 			virtual bool query_video_params(core::video::video_params& video_params) const = 0;
 		};
 
+		/// @class	video_statistics_interface
+		/// @brief	An interface implemented by video sources and publishers which measure their stream.
+		/// @date	19/10/2026
+		class DLL_EXPORT video_statistics_interface
+		{
+		public:
+			/// @fn	virtual video_statistics_interface::~video_statistics_interface() = default;
+			/// @brief	Destructor
+			/// @date	19/10/2026
+			virtual ~video_statistics_interface() = default;
+
+			/// @fn	virtual bool video_statistics_interface::query_statistics(core::video::video_statistics& statistics) const = 0;
+			/// @brief	Queries the statistics of the stream since it was created
+			/// @date	19/10/2026
+			/// @param	[out]	statistics	The result statistics.
+			/// @return	True if it succeeds, false if it fails.
+			virtual bool query_statistics(core::video::video_statistics& statistics) const = 0;
+		};
+
 		/// @enum	video_state
 		/// @brief	Values that represent video source states
 		enum video_state
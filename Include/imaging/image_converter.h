@@ -9,5 +9,27 @@ namespace imaging
         virtual ~image_converter() = default;
         static bool create(core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_heigh, core::imaging::image_algorithm_interface** algo);
         static bool create(core::imaging::pixel_format target_format, core::imaging::image_algorithm_interface** algo);
+
+        /// Creates a converter converting row bands of the images in parallel on the shared utils::worker_pool
+        /// @date	19/10/2026
+        /// @param 			target_format	The target pixel format.
+        /// @param 			target_width 	The target width, zero to keep the width of the images.
+        /// @param 			target_heigh 	The target height, zero to keep the height of the images.
+        /// @param 			threads		 	The number of threads converting an image, including the calling thread.
+        /// @param [out]	algo		 	The converter.
+        /// @return	True if it succeeds, false if it fails.
+        static bool create(core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_heigh, uint32_t threads, core::imaging::image_algorithm_interface** algo);
+
+        /// Creates a converter allocating the buffers of its output images from an allocator, e.g. utils::buffer_allocator
+        /// which pools the buffers per size so that converting a stream does not allocate once its pools are filled
+        /// @date	19/10/2026
+        /// @param 			target_format	The target pixel format.
+        /// @param 			target_width 	The target width, zero to keep the width of the images.
+        /// @param 			target_heigh 	The target height, zero to keep the height of the images.
+        /// @param 			threads		 	The number of threads converting an image, including the calling thread.
+        /// @param [in]		allocator	 	If non-null, the allocator of the output buffers, sized as the output images.
+        /// @param [out]	algo		 	The converter.
+        /// @return	True if it succeeds, false if it fails.
+        static bool create(core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_heigh, uint32_t threads, core::buffer_allocator* allocator, core::imaging::image_algorithm_interface** algo);
     };
 }
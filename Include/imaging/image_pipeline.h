@@ -0,0 +1,95 @@
+#pragma once
+#include <core/imaging.h>
+
+namespace imaging
+{
+    /// A graph of image processing stages fed by an input image, built by adding stages to the input or to other stages and
+    /// marking the stages of which the images are output.
+    /// Chains of per-pixel stages (convert, crop, scale and gain) are fused into a single pass over the image they start
+    /// from, no intermediate image is built unless a stage can not be fused (a crop of a scaled image, a color format after
+    /// a gray one), so branches such as a thumbnail and a full resolution feed read the input once each. Independent
+    /// branches run concurrently on the shared utils::worker_pool and images are allocated from pooled buffers.
+    /// Stages can not be added while processing, an algorithm added to several branches must allow concurrent apply calls.
+    /// @date	19/10/2026
+    class DLL_EXPORT image_pipeline : public core::ref_count_interface
+    {
+    public:
+        /// The node of the input images
+        static constexpr size_t INPUT_NODE = 0;
+
+        virtual ~image_pipeline() = default;
+
+        /// Adds a pixel format conversion
+        /// @date	19/10/2026
+        /// @param 			parent	The node of the converted images.
+        /// @param 			format	The pixel format.
+        /// @param [out]	node  	The node of the stage.
+        /// @return	True if it succeeds, false if the parent does not exist or the format is undefined.
+        virtual bool add_convert(size_t parent, core::imaging::pixel_format format, size_t& node) = 0;
+
+        /// Adds a crop, the rectangle must be inside the images of the parent when processing
+        /// @date	19/10/2026
+        /// @param 			parent	The node of the cropped images.
+        /// @param 			x	  	The left of the rectangle.
+        /// @param 			y	  	The top of the rectangle.
+        /// @param 			width 	The width of the rectangle.
+        /// @param 			height	The height of the rectangle.
+        /// @param [out]	node  	The node of the stage.
+        /// @return	True if it succeeds, false if the parent does not exist or the rectangle is empty.
+        virtual bool add_crop(size_t parent, uint32_t x, uint32_t y, uint32_t width, uint32_t height, size_t& node) = 0;
+
+        /// Adds a bilinear resize
+        /// @date	19/10/2026
+        /// @param 			parent	The node of the resized images.
+        /// @param 			width 	The width.
+        /// @param 			height	The height.
+        /// @param [out]	node  	The node of the stage.
+        /// @return	True if it succeeds, false if the parent does not exist or the size is empty.
+        virtual bool add_scale(size_t parent, uint32_t width, uint32_t height, size_t& node) = 0;
+
+        /// Adds a gain of the RGB levels of the pixels, the gains of a fused pass multiply
+        /// @date	19/10/2026
+        /// @param 			parent	The node of the images.
+        /// @param 			gain  	The gain, in [0, 128).
+        /// @param [out]	node  	The node of the stage.
+        /// @return	True if it succeeds, false if the parent does not exist or the gain is out of range.
+        virtual bool add_gain(size_t parent, float gain, size_t& node) = 0;
+
+        /// Adds an image algorithm (e.g. imaging::image_undistort), its input image is always built
+        /// @date	19/10/2026
+        /// @param 			parent   	The node of the input images of the algorithm.
+        /// @param [in]		algorithm	The algorithm.
+        /// @param [out]	node	 	The node of the stage.
+        /// @return	True if it succeeds, false if the parent does not exist or the algorithm is null.
+        virtual bool add_algorithm(size_t parent, core::imaging::image_algorithm_interface* algorithm, size_t& node) = 0;
+
+        /// Marks the images of a node as an output of the pipeline
+        /// @date	19/10/2026
+        /// @param 			node  	The node.
+        /// @param [out]	output	The index of the output, in the outputs of process.
+        /// @return	True if it succeeds, false if the node does not exist.
+        virtual bool add_output(size_t node, size_t& output) = 0;
+
+        /// The number of outputs
+        /// @date	19/10/2026
+        /// @return	The number of add_output calls.
+        virtual size_t outputs() const = 0;
+
+        /// Processes an image through the stages of the pipeline
+        /// @date	19/10/2026
+        /// @param [in]		input		  	The input image.
+        /// @param [out]	outputs		  	The output images, by output index.
+        /// @param 			outputs_count 	The number of outputs, the number of add_output calls.
+        /// @return	True if it succeeds, false if a stage failed (e.g. a crop outside of its image).
+        virtual bool process(core::imaging::image_interface* input, core::imaging::image_interface** outputs, size_t outputs_count) = 0;
+
+        /// Creates a pipeline
+        /// @date	19/10/2026
+        /// @param 			threads  	The number of threads processing an image, including the calling thread.
+        /// @param [in]		allocator	If non-null, the allocator of the images buffers, a utils::buffer_allocator otherwise.
+        /// @param [out]	pipeline 	The pipeline.
+        /// @return	True if it succeeds, false if it fails.
+        static bool create(uint32_t threads, core::buffer_allocator* allocator, image_pipeline** pipeline);
+        static bool create(uint32_t threads, image_pipeline** pipeline);
+    };
+}
@@ -12,5 +12,40 @@ namespace imaging
 			float (&camera_matrix_chess)[3][3],
 			float (&distCoeffs_chess)[5], 
 			core::imaging::image_algorithm_interface** algo);
+
+		/// Creates an undistort algorithm allocating the buffers of its output images from an allocator
+		/// @date	19/10/2026
+		/// @param 			width			   	The width of the images.
+		/// @param 			height			   	The height of the images.
+		/// @param 			camera_matrix_chess	The camera matrix.
+		/// @param 			distCoeffs_chess   	The distortion coefficients.
+		/// @param [in]		allocator		   	If non-null, the allocator of the output buffers, sized as the output images.
+		/// @param [out]	algo			   	The algorithm.
+		/// @return	True if it succeeds, false if it fails.
+		static bool create(
+			uint32_t width, uint32_t height,
+			float (&camera_matrix_chess)[3][3],
+			float (&distCoeffs_chess)[5],
+			core::buffer_allocator* allocator,
+			core::imaging::image_algorithm_interface** algo);
+
+		/// Creates an undistort algorithm remapping row bands of an image in parallel on the shared utils::worker_pool.
+		/// RGB, RGBA, BGR, BGRA, GRAY8, I420 and NV12 images are undistorted in their own format, other formats in RGBA.
+		/// @date	19/10/2026
+		/// @param 			width			   	The width of the images.
+		/// @param 			height			   	The height of the images.
+		/// @param 			camera_matrix_chess	The camera matrix.
+		/// @param 			distCoeffs_chess   	The distortion coefficients (k1, k2, p1, p2, k3).
+		/// @param 			threads			   	The number of threads undistorting an image, including the calling thread.
+		/// @param [in]		allocator		   	If non-null, the allocator of the output buffers, sized as the output images.
+		/// @param [out]	algo			   	The algorithm.
+		/// @return	True if it succeeds, false if it fails.
+		static bool create(
+			uint32_t width, uint32_t height,
+			float (&camera_matrix_chess)[3][3],
+			float (&distCoeffs_chess)[5],
+			uint32_t threads,
+			core::buffer_allocator* allocator,
+			core::imaging::image_algorithm_interface** algo);
     };
 }
\ No newline at end of file
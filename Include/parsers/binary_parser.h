@@ -45,5 +45,13 @@ namespace parsers
 		/// @param [out]	metadata_store	If non-null, the metadata store.
 		/// @return	True if it succeeds, false if it fails.
 		static bool create(core::parsers::binary_metadata_store_interface** metadata_store);
+
+		/// Hashes the content of the sources of a store (JSON or XML schema files) to key its cache
+		/// @date	19/10/2026
+		/// @param 			file_names	The names of the source files.
+		/// @param 			count	  	Number of files.
+		/// @param [out]	hash	  	The content hash.
+		/// @return	True if it succeeds, false if a file cannot be read.
+		static bool hash_files(const char* const* file_names, size_t count, uint64_t& hash);
 	};
 }
\ No newline at end of file
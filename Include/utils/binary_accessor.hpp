@@ -0,0 +1,81 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/endian.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace utils
+{
+	namespace parsers
+	{
+		/// Reads a field through a compiled accessor directly from a raw buffer (no lookup, locks or reference counting).
+		/// The buffer has to be laid out by the metadata that compiled the accessor.
+		/// @date	19/10/2026
+		/// @param 			accessor   	The compiled accessor.
+		/// @param 			buffer	   	The raw buffer.
+		/// @param 			buffer_size	Size of the buffer.
+		/// @param [out]	data	   	If non-null, the data read from the buffer.
+		/// @param 			data_size  	Number of bytes to read (size of the object).
+		/// @return	True if it succeeds, false if it fails.
+		inline bool read_accessor(const core::parsers::binary_accessor& accessor, const void* buffer, size_t buffer_size, void* data, size_t data_size)
+		{
+			if (data == nullptr || buffer == nullptr)
+				return false;
+
+			if (data_size > accessor.size || accessor.offset + accessor.size > buffer_size)
+				return false;
+
+			const uint8_t* source = static_cast<const uint8_t*>(buffer) + accessor.offset;
+			if (accessor.type == core::types::type_enum::BITMAP)
+			{
+				if (data_size > sizeof(uint64_t) || accessor.size > sizeof(uint64_t))
+					return false;
+
+				uint64_t bits = 0;
+				std::memcpy(&bits, source, accessor.size);
+				bits = (bits & accessor.mask) >> accessor.bit_offset;
+				std::memcpy(data, &bits, data_size);
+			}
+			else
+			{
+				std::memcpy(data, source, data_size);
+			}
+
+			if (accessor.swap)
+				utils::types::endian_swap_words(data, data_size);
+
+			return true;
+		}
+
+		/// Reads a simple field through a compiled accessor directly from a raw buffer.
+		/// Unchecked - the buffer has to be large enough and sizeof(T) must not exceed the field's size.
+		/// @date	19/10/2026
+		/// @tparam	T	The field's type.
+		/// @param	accessor	The compiled accessor.
+		/// @param	buffer  	The raw buffer.
+		/// @return	The value of the field.
+		template <typename T>
+		inline T read_accessor(const core::parsers::binary_accessor& accessor, const void* buffer)
+		{
+			T data;
+			const uint8_t* source = static_cast<const uint8_t*>(buffer) + accessor.offset;
+			if (accessor.type == core::types::type_enum::BITMAP)
+			{
+				uint64_t bits = 0;
+				std::memcpy(&bits, source, accessor.size);
+				bits = (bits & accessor.mask) >> accessor.bit_offset;
+				std::memcpy(&data, &bits, sizeof(T));
+			}
+			else
+			{
+				std::memcpy(&data, source, sizeof(T));
+			}
+
+			if (accessor.swap)
+				utils::types::endian_swap_words(&data, sizeof(T));
+
+			return data;
+		}
+	}
+}
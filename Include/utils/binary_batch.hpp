@@ -0,0 +1,307 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/endian.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace utils
+{
+	namespace parsers
+	{
+		/// Extracts fields of homogeneous records into columns (struct of arrays).
+		/// The fields are compiled once into accessors of the records' metadata, reading a batch walks every column over all the
+		/// records of a contiguous buffer without a parser per record. Fields of 2, 4 and 8 bytes are gathered by AVX2 when built
+		/// with ENABLE_AVX2 and the stride of the records allows 32 bits gather indices.
+		/// @date	19/10/2026
+		class batch_reader
+		{
+		public:
+			struct column
+			{
+				core::parsers::binary_accessor accessor;
+				// The size of an output element
+				size_t width;
+			};
+
+		private:
+			std::vector<column> m_columns;
+			size_t m_record_size;
+			const core::parsers::binary_metadata_interface* m_metadata;
+
+			template <typename T>
+			static void read_simple(const uint8_t* source, size_t stride, size_t count, bool swap, uint8_t* destination)
+			{
+				for (size_t i = 0; i < count; i++, source += stride, destination += sizeof(T))
+				{
+					T val;
+					std::memcpy(&val, source, sizeof(T));
+					if (swap)
+						val = utils::types::endian_swap_value(val);
+
+					std::memcpy(destination, &val, sizeof(T));
+				}
+			}
+
+			template <typename T, typename O>
+			static void read_bits(const uint8_t* source, size_t stride, size_t count, const core::parsers::binary_accessor& accessor, uint8_t* destination)
+			{
+				for (size_t i = 0; i < count; i++, source += stride, destination += sizeof(O))
+				{
+					T bits;
+					std::memcpy(&bits, source, sizeof(T));
+					uint64_t field = (static_cast<uint64_t>(bits) & accessor.mask) >> accessor.bit_offset;
+					O val;
+					std::memcpy(&val, &field, sizeof(O));
+					if (accessor.swap)
+						val = utils::types::endian_swap_value(val);
+
+					std::memcpy(destination, &val, sizeof(O));
+				}
+			}
+
+			template <typename T>
+			static void read_bits(const uint8_t* source, size_t stride, size_t count, const column& field, uint8_t* destination)
+			{
+				switch (field.width)
+				{
+				case sizeof(uint8_t): read_bits<T, uint8_t>(source, stride, count, field.accessor, destination); break;
+				case sizeof(uint16_t): read_bits<T, uint16_t>(source, stride, count, field.accessor, destination); break;
+				case sizeof(uint32_t): read_bits<T, uint32_t>(source, stride, count, field.accessor, destination); break;
+				case sizeof(uint64_t): read_bits<T, uint64_t>(source, stride, count, field.accessor, destination); break;
+				default:
+					for (size_t i = 0; i < count; i++, source += stride, destination += field.width)
+					{
+						T bits;
+						std::memcpy(&bits, source, sizeof(T));
+						uint64_t val = (static_cast<uint64_t>(bits) & field.accessor.mask) >> field.accessor.bit_offset;
+						std::memcpy(destination, &val, field.width);
+						if (field.accessor.swap)
+							utils::types::endian_swap_words(destination, field.width);
+					}
+					break;
+				}
+			}
+
+			static void read_any(const uint8_t* source, size_t stride, size_t count, const column& field, uint8_t* destination)
+			{
+				for (size_t i = 0; i < count; i++, source += stride, destination += field.width)
+				{
+					std::memcpy(destination, source, field.width);
+					if (field.accessor.swap)
+						utils::types::endian_swap_words(destination, field.width);
+				}
+			}
+
+#if defined(__AVX2__)
+			// Gathers 8 records per iteration, returns the number of records read
+			static size_t gather(const uint8_t* source, size_t available, size_t stride, size_t count, const column& field, uint8_t* destination)
+			{
+				size_t width = field.width;
+				if (width != sizeof(uint16_t) && width != sizeof(uint32_t) && width != sizeof(uint64_t))
+					return 0;
+
+				if (stride * 7 > static_cast<size_t>((std::numeric_limits<int32_t>::max)()))
+					return 0;
+
+				// A gather loads at least 32 bits, the last gathered record must not read beyond the buffer
+				size_t load_size = (width == sizeof(uint64_t)) ? sizeof(uint64_t) : sizeof(uint32_t);
+				if (available < load_size)
+					return 0;
+
+				size_t last = (available - load_size) / stride + 1;
+				size_t gathered = (std::min)(count, last) & ~static_cast<size_t>(7);
+
+				const int32_t step = static_cast<int32_t>(stride);
+				const __m256i indices = _mm256_setr_epi32(0, step, 2 * step, 3 * step, 4 * step, 5 * step, 6 * step, 7 * step);
+				const __m256i words = _mm256_setr_epi8(
+					1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+					1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+				// The low 16 bits of every 32 bits lane, swapped or not, packed into the low 8 bytes of each 128 bits half
+				const __m256i pack = field.accessor.swap ?
+					_mm256_setr_epi8(1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1,
+						1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1) :
+					_mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+						0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+
+				for (size_t i = 0; i < gathered; i += 8, source += 8 * stride)
+				{
+					if (width == sizeof(uint64_t))
+					{
+						const __m128i low_indices = _mm256_castsi256_si128(indices);
+						__m256i low = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(source), low_indices, 1);
+						__m256i high = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(source + 4 * stride), low_indices, 1);
+						if (field.accessor.swap)
+						{
+							low = _mm256_shuffle_epi8(low, words);
+							high = _mm256_shuffle_epi8(high, words);
+						}
+
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * width), low);
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + (i + 4) * width), high);
+						continue;
+					}
+
+					__m256i block = _mm256_i32gather_epi32(reinterpret_cast<const int*>(source), indices, 1);
+					if (width == sizeof(uint32_t))
+					{
+						if (field.accessor.swap)
+							block = _mm256_shuffle_epi8(block, words);
+
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * width), block);
+					}
+					else
+					{
+						block = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(block, pack), 0x08);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * width), _mm256_castsi256_si128(block));
+					}
+				}
+
+				return gathered;
+			}
+#endif
+
+		public:
+			/// Constructor
+			/// @date	19/10/2026
+			/// @exception	std::invalid_argument	Thrown when the metadata is null.
+			/// @param	metadata	The metadata of the records, it has to outlive the reader.
+			explicit batch_reader(const core::parsers::binary_metadata_interface* metadata) :
+				m_record_size(0),
+				m_metadata(metadata)
+			{
+				if (metadata == nullptr)
+					throw std::invalid_argument("metadata");
+
+				m_record_size = metadata->size();
+			}
+
+			/// Adds a column of a field
+			/// @date	19/10/2026
+			/// @exception	std::runtime_error	Thrown when the path is not a simple, enum, string or bitmap field,
+			/// 	or the width exceeds the field.
+			/// @param	path 	The path of the field (e.g. "header.sensors[3].temp").
+			/// @param	width	(Optional) The size of an output element, zero for the size of the field.
+			/// @return	The index of the column.
+			size_t add(const char* path, size_t width = 0)
+			{
+				column field;
+				if (false == m_metadata->compile_accessor(path, field.accessor))
+					throw std::runtime_error("batch_reader: failed to compile the field");
+
+				field.width = (width == 0) ? field.accessor.size : width;
+				if (field.width > field.accessor.size ||
+					(field.accessor.type == core::types::type_enum::BITMAP && field.width > sizeof(uint64_t)))
+					throw std::runtime_error("batch_reader: width exceeds the field");
+
+				m_columns.push_back(field);
+				return m_columns.size() - 1;
+			}
+
+			/// The size of a record
+			size_t record_size() const
+			{
+				return m_record_size;
+			}
+
+			const std::vector<column>& columns() const
+			{
+				return m_columns;
+			}
+
+			/// Reads a column of a batch of records
+			/// @date	19/10/2026
+			/// @param 			index	   	The index of the column.
+			/// @param 			records	   	The records.
+			/// @param 			size	   	The size of the records buffer.
+			/// @param 			stride	   	The distance between records, at least the record size.
+			/// @param 			count	   	Number of records to read.
+			/// @param [out]	destination	The column, count elements of the column's width.
+			/// @return	True if it succeeds, false if the buffer does not hold count records.
+			bool read_column(size_t index, const void* records, size_t size, size_t stride, size_t count, void* destination) const
+			{
+				if (index >= m_columns.size() || records == nullptr || destination == nullptr || stride < m_record_size)
+					return false;
+
+				if (count == 0)
+					return true;
+
+				if ((count - 1) * stride + m_record_size > size)
+					return false;
+
+				const column& field = m_columns[index];
+				const uint8_t* source = static_cast<const uint8_t*>(records) + field.accessor.offset;
+				uint8_t* output = static_cast<uint8_t*>(destination);
+				if (field.accessor.type == core::types::type_enum::BITMAP)
+				{
+					switch (field.accessor.size)
+					{
+					case sizeof(uint8_t): read_bits<uint8_t>(source, stride, count, field, output); return true;
+					case sizeof(uint16_t): read_bits<uint16_t>(source, stride, count, field, output); return true;
+					case sizeof(uint32_t): read_bits<uint32_t>(source, stride, count, field, output); return true;
+					case sizeof(uint64_t): read_bits<uint64_t>(source, stride, count, field, output); return true;
+					default: read_any(source, stride, count, field, output); return true;
+					}
+				}
+
+				size_t done = 0;
+#if defined(__AVX2__)
+				done = gather(source, size - field.accessor.offset, stride, count, field, output);
+				source += done * stride;
+				output += done * field.width;
+#endif
+				switch (field.width)
+				{
+				case sizeof(uint8_t): read_simple<uint8_t>(source, stride, count - done, false, output); break;
+				case sizeof(uint16_t): read_simple<uint16_t>(source, stride, count - done, field.accessor.swap, output); break;
+				case sizeof(uint32_t): read_simple<uint32_t>(source, stride, count - done, field.accessor.swap, output); break;
+				case sizeof(uint64_t): read_simple<uint64_t>(source, stride, count - done, field.accessor.swap, output); break;
+				default: read_any(source, stride, count - done, field, output); break;
+				}
+
+				return true;
+			}
+
+			/// Reads every column of a batch of records
+			/// @date	19/10/2026
+			/// @param 			records	   	The records.
+			/// @param 			size	   	The size of the records buffer.
+			/// @param 			stride	   	The distance between records, at least the record size.
+			/// @param 			count	   	Number of records to read.
+			/// @param [out]	destinations	The columns in the order they were added, each holds count elements of its width.
+			/// @return	True if it succeeds, false if the buffer does not hold count records.
+			bool read(const void* records, size_t size, size_t stride, size_t count, void* const* destinations) const
+			{
+				if (destinations == nullptr)
+					return false;
+
+				for (size_t i = 0; i < m_columns.size(); i++)
+				{
+					if (false == read_column(i, records, size, stride, count, destinations[i]))
+						return false;
+				}
+
+				return true;
+			}
+
+			/// Reads every column of a batch of contiguous records
+			/// @date	19/10/2026
+			/// @param 			records	   	The records.
+			/// @param 			size	   	The size of the records buffer, the number of records read is size / record size.
+			/// @param [out]	destinations	The columns in the order they were added.
+			/// @return	The number of records read.
+			size_t read(const void* records, size_t size, void* const* destinations) const
+			{
+				if (m_record_size == 0)
+					return 0;
+
+				size_t count = size / m_record_size;
+				return read(records, size, m_record_size, count, destinations) ? count : 0;
+			}
+		};
+	}
+}
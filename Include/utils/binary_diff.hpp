@@ -0,0 +1,370 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/ref_count_ptr.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace utils
+{
+	namespace parsers
+	{
+		/// Field level delta of two messages of the same metadata.
+		/// The metadata is flattened once into its leaf fields (complex fields and complex arrays are expanded, simple arrays,
+		/// strings, buffers and bits blocks are single fields). A diff compares the messages a vector at a time (AVX2 when
+		/// built with ENABLE_AVX2, SSE2 otherwise), skipping unchanged regions, and encodes the changed fields as a patch of
+		/// field indices and their bytes. Field sizes are known from the metadata, so a patch holds no lengths:
+		/// 	varint message size, varint fields count, then per field: varint index delta from the previous field, field bytes.
+		/// @date	19/10/2026
+		class binary_diff
+		{
+		public:
+			struct field
+			{
+				size_t offset;
+				size_t size;
+			};
+
+		private:
+			std::vector<field> m_fields;
+			size_t m_size;
+
+			static size_t first_set_bit(uint32_t mask)
+			{
+#if defined(_MSC_VER)
+				unsigned long index;
+				_BitScanForward(&index, mask);
+				return index;
+#else
+				return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+			}
+
+			static size_t varint_size(size_t val)
+			{
+				size_t size = 1;
+				for (; val >= 0x80; val >>= 7)
+					size++;
+
+				return size;
+			}
+
+			static uint8_t* write_varint(uint8_t* output, size_t val)
+			{
+				for (; val >= 0x80; val >>= 7)
+					*output++ = static_cast<uint8_t>(val | 0x80);
+
+				*output++ = static_cast<uint8_t>(val);
+				return output;
+			}
+
+			static bool read_varint(const uint8_t*& input, const uint8_t* end, size_t& val)
+			{
+				val = 0;
+				for (size_t shift = 0; input < end && shift < sizeof(size_t) * 8; shift += 7)
+				{
+					uint8_t byte = *input++;
+					val |= static_cast<size_t>(byte & 0x7F) << shift;
+					if ((byte & 0x80) == 0)
+						return true;
+				}
+
+				return false;
+			}
+
+			void add_field(size_t offset, size_t size)
+			{
+				// The bits nodes of a block share its offset
+				if (size == 0 || (m_fields.empty() == false && m_fields.back().offset == offset))
+					return;
+
+				m_fields.push_back({ offset, size });
+			}
+
+			void compile(const core::parsers::binary_metadata_interface* metadata, size_t base)
+			{
+				size_t count = metadata->node_count();
+				for (size_t i = 0; i < count; i++)
+				{
+					utils::ref_count_ptr<core::parsers::binary_node_interface> node;
+					if (false == metadata->query_node_by_index(i, &node))
+						throw std::runtime_error("binary_diff: failed to query node");
+
+					size_t offset = base + node->offset();
+					switch (node->type())
+					{
+					case core::types::type_enum::COMPLEX:
+					{
+						utils::ref_count_ptr<core::parsers::binary_metadata_interface> nested;
+						if (false == node->nested(&nested))
+							throw std::runtime_error("binary_diff: complex node without metadata");
+
+						compile(nested, offset);
+						break;
+					}
+					case core::types::type_enum::ARRAY:
+						compile_array(node, offset);
+						break;
+					default:
+						add_field(offset, node->size());
+						break;
+					}
+				}
+			}
+
+			void compile_array(core::parsers::binary_node_interface* node, size_t offset)
+			{
+				// The array metadata holds a single node describing the element
+				utils::ref_count_ptr<core::parsers::binary_metadata_interface> array_metadata;
+				utils::ref_count_ptr<core::parsers::binary_node_interface> element;
+				if (false == node->nested(&array_metadata) ||
+					false == array_metadata->query_node_by_index(0, &element))
+					throw std::runtime_error("binary_diff: array node without metadata");
+
+				if (element->type() != core::types::type_enum::COMPLEX)
+				{
+					add_field(offset, element->size() * node->count());
+					return;
+				}
+
+				utils::ref_count_ptr<core::parsers::binary_metadata_interface> element_metadata;
+				if (false == element->nested(&element_metadata))
+					throw std::runtime_error("binary_diff: complex node without metadata");
+
+				binary_diff element_diff(element_metadata);
+				for (size_t i = 0; i < node->count(); i++)
+				{
+					for (const field& element_field : element_diff.m_fields)
+						add_field(offset + i * element->size() + element_field.offset, element_field.size);
+				}
+			}
+
+		public:
+			/// Constructor - flattens the fields of the given metadata
+			/// @date	19/10/2026
+			/// @exception	std::invalid_argument	Thrown when the metadata is null.
+			/// @exception	std::runtime_error   	Thrown when the metadata is inconsistent.
+			/// @param	metadata	The metadata of the messages.
+			explicit binary_diff(const core::parsers::binary_metadata_interface* metadata) :
+				m_size(0)
+			{
+				if (metadata == nullptr)
+					throw std::invalid_argument("metadata");
+
+				m_size = metadata->size();
+				compile(metadata, 0);
+			}
+
+			/// The size of the messages
+			size_t size() const
+			{
+				return m_size;
+			}
+
+			/// The leaf fields in offset order, a field's index in a patch is its index here
+			const std::vector<field>& fields() const
+			{
+				return m_fields;
+			}
+
+			/// The size of the largest patch - every field changed
+			size_t max_patch_size() const
+			{
+				size_t size = varint_size(m_size) + varint_size(m_fields.size());
+				for (const field& current : m_fields)
+					size += 1 + current.size;
+
+				return size;
+			}
+
+			/// Finds the first byte which differs between two blocks
+			/// @date	19/10/2026
+			/// @param	first 	The first block.
+			/// @param	second	The second block.
+			/// @param	from  	The position to start from.
+			/// @param	to	  	The end of the blocks.
+			/// @return	The position of the first different byte, to if the blocks are equal.
+			static size_t first_difference(const uint8_t* first, const uint8_t* second, size_t from, size_t to)
+			{
+				size_t i = from;
+#if defined(__AVX2__)
+				for (; i + sizeof(__m256i) <= to; i += sizeof(__m256i))
+				{
+					__m256i equal = _mm256_cmpeq_epi8(
+						_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i)),
+						_mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i)));
+					uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+					if (mask != 0)
+						return i + first_set_bit(mask);
+				}
+#elif defined(__SSE2__) || defined(_M_X64)
+				for (; i + sizeof(__m128i) <= to; i += sizeof(__m128i))
+				{
+					__m128i equal = _mm_cmpeq_epi8(
+						_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i)),
+						_mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i)));
+					uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(equal)) & 0xFFFFU;
+					if (mask != 0)
+						return i + first_set_bit(mask);
+				}
+#endif
+				for (; i + sizeof(uint64_t) <= to; i += sizeof(uint64_t))
+				{
+					uint64_t first_word, second_word;
+					std::memcpy(&first_word, first + i, sizeof(uint64_t));
+					std::memcpy(&second_word, second + i, sizeof(uint64_t));
+					if (first_word != second_word)
+						break;
+				}
+
+				for (; i < to; i++)
+				{
+					if (first[i] != second[i])
+						return i;
+				}
+
+				return to;
+			}
+
+			/// Encodes the fields which changed between two messages
+			/// @date	19/10/2026
+			/// @param 			previous	The previous message.
+			/// @param 			current 	The current message.
+			/// @param 			size		The size of the messages.
+			/// @param [out]	patch   	The patch, at least max_patch_size() bytes.
+			/// @param 			capacity	The size of the patch buffer.
+			/// @return	The size of the patch, zero if the sizes do not match the metadata or the patch buffer is too small.
+			size_t diff(const void* previous, const void* current, size_t size, void* patch, size_t capacity) const
+			{
+				if (previous == nullptr || current == nullptr || patch == nullptr || size != m_size)
+					return 0;
+
+				const uint8_t* before = static_cast<const uint8_t*>(previous);
+				const uint8_t* after = static_cast<const uint8_t*>(current);
+				uint8_t* output = static_cast<uint8_t*>(patch);
+				uint8_t* end = output + capacity;
+
+				// The fields count is written once known, in the room of the largest count
+				size_t header_size = varint_size(m_size) + varint_size(m_fields.size());
+				if (capacity < header_size)
+					return 0;
+
+				uint8_t* position = output + header_size;
+				size_t changed = 0;
+				size_t previous_index = 0;
+				size_t offset = 0;
+				std::vector<field>::const_iterator it = m_fields.begin();
+				while (offset < m_size)
+				{
+					offset = first_difference(before, after, offset, m_size);
+					if (offset == m_size)
+						break;
+
+					// The field holding the changed byte, a change in a gap between fields is skipped up to the next field
+					it = std::upper_bound(it, m_fields.cend(), offset, [](size_t val, const field& candidate)
+					{
+						return val < candidate.offset;
+					});
+					if (it == m_fields.begin() || offset >= (it - 1)->offset + (it - 1)->size)
+					{
+						if (it == m_fields.end())
+							break;
+
+						offset = it->offset;
+						continue;
+					}
+
+					const field& changed_field = *(it - 1);
+					size_t index = static_cast<size_t>(it - 1 - m_fields.begin());
+					size_t delta = index - previous_index;
+					if (static_cast<size_t>(end - position) < varint_size(delta) + changed_field.size)
+						return 0;
+
+					position = write_varint(position, delta);
+					std::memcpy(position, after + changed_field.offset, changed_field.size);
+					position += changed_field.size;
+					previous_index = index;
+					offset = changed_field.offset + changed_field.size;
+					changed++;
+				}
+
+				// Padded varint of the count, so the header keeps its size
+				uint8_t* header = write_varint(output, m_size);
+				size_t count_size = static_cast<size_t>(output + header_size - header);
+				for (size_t i = 0; i + 1 < count_size; i++, changed >>= 7)
+					*header++ = static_cast<uint8_t>((changed & 0x7F) | 0x80);
+
+				*header = static_cast<uint8_t>(changed);
+				return static_cast<size_t>(position - output);
+			}
+
+			/// Encodes the fields which changed between two messages
+			/// @date	19/10/2026
+			/// @param 			previous	The previous message.
+			/// @param 			current 	The current message.
+			/// @param 			size		The size of the messages.
+			/// @param [out]	patch   	The patch.
+			/// @return	True if it succeeds, false if the size does not match the metadata.
+			bool diff(const void* previous, const void* current, size_t size, std::vector<uint8_t>& patch) const
+			{
+				patch.resize(max_patch_size());
+				size_t patch_size = diff(previous, current, size, patch.data(), patch.size());
+				patch.resize(patch_size);
+				return patch_size != 0;
+			}
+
+			/// Applies a patch to a message
+			/// @date	19/10/2026
+			/// @param 		   	patch	  	The patch.
+			/// @param 		   	patch_size	The size of the patch.
+			/// @param [in,out]	data	  	The message to update, the previous message of the patch.
+			/// @param 		   	size	  	The size of the message.
+			/// @return	True if it succeeds, false if the patch is invalid or of messages of another size. An invalid patch may
+			/// 		have updated some of the fields.
+			bool apply(const void* patch, size_t patch_size, void* data, size_t size) const
+			{
+				if (patch == nullptr || data == nullptr || size != m_size)
+					return false;
+
+				const uint8_t* input = static_cast<const uint8_t*>(patch);
+				const uint8_t* end = input + patch_size;
+				uint8_t* message = static_cast<uint8_t*>(data);
+				size_t message_size, count;
+				if (false == read_varint(input, end, message_size) || message_size != m_size ||
+					false == read_varint(input, end, count))
+					return false;
+
+				size_t index = 0;
+				for (size_t i = 0; i < count; i++)
+				{
+					size_t delta;
+					if (false == read_varint(input, end, delta) || delta >= m_fields.size() - index)
+						return false;
+
+					index += delta;
+					const field& changed_field = m_fields[index];
+					if (static_cast<size_t>(end - input) < changed_field.size)
+						return false;
+
+					std::memcpy(message + changed_field.offset, input, changed_field.size);
+					input += changed_field.size;
+				}
+
+				return input == end;
+			}
+		};
+	}
+}
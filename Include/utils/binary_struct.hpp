@@ -0,0 +1,250 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/endian.hpp>
+#include <utils/ref_count_ptr.hpp>
+#include <utils/types.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace utils
+{
+	namespace parsers
+	{
+		/// Whether the fields of an endian are converted on this platform
+		/// @date	19/10/2026
+		/// @param	big_endian	True for big endian fields.
+		/// @return	True if the fields are swapped when they are read and written.
+		inline bool field_swap(bool big_endian)
+		{
+			return big_endian != utils::types::is_big_endian();
+		}
+
+		/// Loads a field of a generated struct, converting it from the field's endian as the binary parser reads it
+		/// @date	19/10/2026
+		/// @tparam	T	The field's type.
+		/// @param	source	The field.
+		/// @param	swap  	True if the field's endian differs from the platform endian.
+		/// @return	The value of the field.
+		template <typename T>
+		inline T load_field(const void* source, bool swap)
+		{
+			T val;
+			std::memcpy(&val, source, sizeof(T));
+			if (swap)
+				utils::types::endian_swap_words(&val, sizeof(T));
+
+			return val;
+		}
+
+		/// Stores a field of a generated struct in the field's endian.
+		/// Unlike binary_parser_interface::write, which copies the bytes it is given as they are (already in the field's
+		/// endian), the setters of generated structs take native values, as the getters and the parser's reads return them.
+		/// @date	19/10/2026
+		/// @tparam	T	The field's type.
+		/// @param [out]	destination	The field.
+		/// @param 			val		   	The value.
+		/// @param 			swap	   	True if the field's endian differs from the platform endian.
+		template <typename T>
+		inline void store_field(void* destination, T val, bool swap)
+		{
+			if (swap)
+				utils::types::endian_swap_words(&val, sizeof(T));
+
+			std::memcpy(destination, &val, sizeof(T));
+		}
+
+		/// Loads the bits of a bitmap field from its block
+		/// @date	19/10/2026
+		/// @tparam	T	The field's type.
+		/// @param	block	  	The block of the field.
+		/// @param	size	  	The size of the field's block in bytes.
+		/// @param	mask	  	The mask of the field's bits in the block.
+		/// @param	bit_offset	The offset of the first bit of the field.
+		/// @param	swap	  	True if the field's endian differs from the platform endian.
+		/// @return	The value of the field.
+		template <typename T>
+		inline T load_bits(const void* block, size_t size, uint64_t mask, uint8_t bit_offset, bool swap)
+		{
+			uint64_t bits = 0;
+			std::memcpy(&bits, block, size);
+			bits = (bits & mask) >> bit_offset;
+			T val;
+			std::memcpy(&val, &bits, sizeof(T));
+			if (swap)
+				utils::types::endian_swap_words(&val, sizeof(T));
+
+			return val;
+		}
+
+		/// Stores the bits of a bitmap field into its block, the other bits of the block are kept
+		/// @date	19/10/2026
+		/// @tparam	T	The field's type.
+		/// @param [in,out]	block	  	The block of the field.
+		/// @param 			size	  	The size of the field's block in bytes.
+		/// @param 			mask	  	The mask of the field's bits in the block.
+		/// @param 			bit_offset	The offset of the first bit of the field.
+		/// @param 			swap	  	True if the field's endian differs from the platform endian.
+		/// @param 			val		  	The value, bits beyond the field are dropped.
+		template <typename T>
+		inline void store_bits(void* block, size_t size, uint64_t mask, uint8_t bit_offset, bool swap, T val)
+		{
+			if (swap)
+				utils::types::endian_swap_words(&val, sizeof(T));
+
+			uint64_t field = 0;
+			std::memcpy(&field, &val, sizeof(T));
+			uint64_t bits = 0;
+			std::memcpy(&bits, block, size);
+			bits = (bits & ~mask) | ((field << bit_offset) & mask);
+			std::memcpy(block, &bits, size);
+		}
+
+		/// Loads a string field of a generated struct
+		/// @date	19/10/2026
+		/// @param	source	The field.
+		/// @param	size  	The size of the field.
+		/// @param	swap  	True if the field's endian differs from the platform endian.
+		/// @return	The string, up to the first null character.
+		inline std::string load_string(const char* source, size_t size, bool swap)
+		{
+			std::string str(source, size);
+			if (swap)
+				utils::types::endian_swap_words(&str[0], size);
+
+			return std::string(str.c_str());
+		}
+
+		/// Stores a string field of a generated struct, truncated to the field and null terminated
+		/// @date	19/10/2026
+		/// @param [out]	destination	The field.
+		/// @param 			size	   	The size of the field.
+		/// @param 			swap	   	True if the field's endian differs from the platform endian.
+		/// @param 			val		   	The string.
+		inline void store_string(char* destination, size_t size, bool swap, const char* val)
+		{
+			if (size == 0)
+				return;
+
+			std::memset(destination, 0, size);
+			if (val != nullptr)
+				std::memcpy(destination, val, strnlen(val, size - 1));
+
+			if (swap)
+				utils::types::endian_swap_words(destination, size);
+		}
+
+		/// Loads a buffer field of a generated struct
+		/// @date	19/10/2026
+		/// @param	source	The field.
+		/// @param	size  	The size of the field.
+		/// @param	swap  	True if the field's endian differs from the platform endian.
+		/// @return	The bytes of the field.
+		inline std::vector<uint8_t> load_buffer(const uint8_t* source, size_t size, bool swap)
+		{
+			std::vector<uint8_t> data(source, source + size);
+			if (swap && size > 0)
+				utils::types::endian_swap_words(data.data(), size);
+
+			return data;
+		}
+
+		/// Stores a buffer field of a generated struct, truncated or zero padded to the field
+		/// @date	19/10/2026
+		/// @param [out]	destination	The field.
+		/// @param 			size	   	The size of the field.
+		/// @param 			swap	   	True if the field's endian differs from the platform endian.
+		/// @param 			val		   	The bytes.
+		inline void store_buffer(uint8_t* destination, size_t size, bool swap, const std::vector<uint8_t>& val)
+		{
+			std::memset(destination, 0, size);
+			std::memcpy(destination, val.data(), val.size() < size ? val.size() : size);
+			if (swap && size > 0)
+				utils::types::endian_swap_words(destination, size);
+		}
+
+		/// The layout of a field of a generated struct
+		/// @date	19/10/2026
+		struct generated_field
+		{
+			const char* name;
+			core::types::type_enum type;
+			size_t offset;
+			// The size of an element for arrays
+			size_t size;
+			size_t count;
+			core::types::type_enum element_type;
+			bool swap;
+			// Bitmap fields only
+			uint64_t mask;
+			uint8_t bit_offset;
+			// Complex fields and arrays of complex elements - validates the generated struct of the nested metadata
+			bool (*validate_nested)(const core::parsers::binary_metadata_interface* metadata);
+		};
+
+		/// Validates the layout of a generated struct against the runtime metadata it was generated from.
+		/// Every node has to match its generated field by name, type, offset, size, endian and bits.
+		/// @date	19/10/2026
+		/// @param	metadata	The runtime metadata.
+		/// @param	size		The size of the generated struct.
+		/// @param	fields  	The fields of the generated struct, in the order of the nodes.
+		/// @param	count   	Number of fields.
+		/// @return	True if the generated struct matches the metadata, false otherwise.
+		inline bool validate_generated(const core::parsers::binary_metadata_interface* metadata, size_t size, const generated_field* fields, size_t count)
+		{
+			if (metadata == nullptr || metadata->size() != size || metadata->node_count() != count)
+				return false;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const generated_field& field = fields[i];
+				utils::ref_count_ptr<core::parsers::binary_node_interface> node;
+				if (false == metadata->query_node_by_index(i, &node) ||
+					std::strcmp(node->name(), field.name) != 0 ||
+					node->type() != field.type ||
+					node->offset() != field.offset ||
+					node->size() != field.size ||
+					node->count() != field.count)
+					return false;
+
+				utils::ref_count_ptr<core::parsers::binary_node_interface> element;
+				const core::parsers::binary_node_interface* leaf = node;
+				std::string path = field.name;
+				if (field.type == core::types::type_enum::ARRAY)
+				{
+					utils::ref_count_ptr<core::parsers::binary_metadata_interface> array_metadata;
+					if (false == node->nested(&array_metadata) ||
+						false == array_metadata->query_node_by_index(0, &element) ||
+						element->type() != field.element_type)
+						return false;
+
+					leaf = element;
+					path += "[0]";
+				}
+
+				if (leaf->type() == core::types::type_enum::COMPLEX)
+				{
+					utils::ref_count_ptr<core::parsers::binary_metadata_interface> nested;
+					if (field.validate_nested == nullptr ||
+						false == leaf->nested(&nested) ||
+						false == field.validate_nested(nested))
+						return false;
+
+					continue;
+				}
+
+				core::parsers::binary_accessor accessor;
+				if (false == metadata->compile_accessor(path.c_str(), accessor) ||
+					accessor.offset != field.offset ||
+					accessor.swap != field.swap ||
+					accessor.mask != field.mask ||
+					accessor.bit_offset != field.bit_offset)
+					return false;
+			}
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,465 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/endian.hpp>
+#include <utils/types.hpp>
+#include <utils/ref_count_ptr.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace utils
+{
+	namespace parsers
+	{
+		/// The validation rules of a whole message, built once from its metadata.
+		/// Every field which can be invalid (a simple field with a min or a max, a bool or an enum) is flattened into a packed
+		/// table of offsets and typed bounds, enums into bitsets of their values. Checking a message walks the table in one
+		/// linear pass over the buffer, with the same rules as binary_parser_interface::validate.
+		/// A metadata with a field the table can not check the way the parser does (a bounded simple field of another size
+		/// than its type's, an enum of another size than 1, 2, 4 or 8 bytes) is rejected by the constructor, a frozen
+		/// metadata then keeps no table and its parsers validate by walking the nodes.
+		/// @date	19/10/2026
+		class validation_table
+		{
+		public:
+			enum class kind : uint8_t
+			{
+				INT8,
+				UINT8,
+				INT16,
+				UINT16,
+				INT32,
+				UINT32,
+				INT64,
+				UINT64,
+				FLOAT,
+				DOUBLE,
+				BOOL,
+				ENUM
+			};
+
+			struct field
+			{
+				size_t offset; //of the first element, from the start of the message
+				uint32_t count; //the elements of a simple array, 1 otherwise
+				uint32_t stride;
+				uint32_t bounds; //index of the typed bounds of the field's kind, or of its enum values
+				kind type;
+				bool swap;
+			};
+
+		private:
+			// Enums of a wider range of values are searched in their sorted values
+			static constexpr int64_t MAX_BITSET_RANGE = 4096;
+
+			struct enum_values
+			{
+				int64_t first;
+				std::vector<uint64_t> bits;
+				std::vector<int64_t> sorted;
+			};
+
+			std::vector<field> m_fields;
+			std::vector<std::string> m_paths;
+			std::vector<int64_t> m_signed_min;
+			std::vector<int64_t> m_signed_max;
+			std::vector<uint64_t> m_unsigned_min;
+			std::vector<uint64_t> m_unsigned_max;
+			std::vector<double> m_floating_min;
+			std::vector<double> m_floating_max;
+			std::vector<enum_values> m_enums;
+			size_t m_size;
+
+			validation_table() :
+				m_size(0)
+			{
+			}
+
+			// Loads a value of the stream, U is the unsigned type of the same size as T
+			template <typename T, typename U>
+			static T load(const uint8_t* source, bool swap)
+			{
+				U raw;
+				std::memcpy(&raw, source, sizeof(U));
+				if (swap)
+					raw = utils::types::endian_swap_value(raw);
+
+				T val;
+				std::memcpy(&val, &raw, sizeof(T));
+				return val;
+			}
+
+			template <typename T, typename U, typename B>
+			static bool check_range(const field& rule, const uint8_t* data, B min, B max)
+			{
+				const uint8_t* source = data + rule.offset;
+				for (uint32_t i = 0; i < rule.count; i++, source += rule.stride)
+				{
+					B val = static_cast<B>(load<T, U>(source, rule.swap));
+					if (val < min || val > max)
+						return false;
+				}
+
+				return true;
+			}
+
+			bool check_enum(const field& rule, const uint8_t* data) const
+			{
+				const enum_values& values = m_enums[rule.bounds];
+				const uint8_t* source = data + rule.offset;
+				int64_t val;
+				switch (rule.stride)
+				{
+				case sizeof(int8_t): val = load<int8_t, uint8_t>(source, rule.swap); break;
+				case sizeof(int16_t): val = load<int16_t, uint16_t>(source, rule.swap); break;
+				case sizeof(int32_t): val = load<int32_t, uint32_t>(source, rule.swap); break;
+				default: val = load<int64_t, uint64_t>(source, rule.swap); break;
+				}
+
+				if (values.bits.empty())
+					return std::binary_search(values.sorted.begin(), values.sorted.end(), val);
+
+				uint64_t bit = static_cast<uint64_t>(val) - static_cast<uint64_t>(values.first);
+				return bit < values.bits.size() * 64 && (values.bits[bit / 64] & (1ULL << (bit % 64))) != 0;
+			}
+
+			bool check(const field& rule, const uint8_t* data) const
+			{
+				switch (rule.type)
+				{
+				case kind::INT8: return check_range<int8_t, uint8_t, int64_t>(rule, data, m_signed_min[rule.bounds], m_signed_max[rule.bounds]);
+				case kind::UINT8: return check_range<uint8_t, uint8_t, uint64_t>(rule, data, m_unsigned_min[rule.bounds], m_unsigned_max[rule.bounds]);
+				case kind::INT16: return check_range<int16_t, uint16_t, int64_t>(rule, data, m_signed_min[rule.bounds], m_signed_max[rule.bounds]);
+				case kind::UINT16: return check_range<uint16_t, uint16_t, uint64_t>(rule, data, m_unsigned_min[rule.bounds], m_unsigned_max[rule.bounds]);
+				case kind::INT32: return check_range<int32_t, uint32_t, int64_t>(rule, data, m_signed_min[rule.bounds], m_signed_max[rule.bounds]);
+				case kind::UINT32: return check_range<uint32_t, uint32_t, uint64_t>(rule, data, m_unsigned_min[rule.bounds], m_unsigned_max[rule.bounds]);
+				case kind::INT64: return check_range<int64_t, uint64_t, int64_t>(rule, data, m_signed_min[rule.bounds], m_signed_max[rule.bounds]);
+				case kind::UINT64: return check_range<uint64_t, uint64_t, uint64_t>(rule, data, m_unsigned_min[rule.bounds], m_unsigned_max[rule.bounds]);
+				case kind::FLOAT: return check_range<float, uint32_t, double>(rule, data, m_floating_min[rule.bounds], m_floating_max[rule.bounds]);
+				case kind::DOUBLE: return check_range<double, uint64_t, double>(rule, data, m_floating_min[rule.bounds], m_floating_max[rule.bounds]);
+				case kind::BOOL:
+				{
+					// The first byte of the field as the parser reads it
+					const uint8_t* source = data + rule.offset + ((rule.swap && rule.stride > 1) ? 1 : 0);
+					for (uint32_t i = 0; i < rule.count; i++, source += rule.stride)
+					{
+						if (*source > 1)
+							return false;
+					}
+
+					return true;
+				}
+				case kind::ENUM: return check_enum(rule, data);
+				default: return true;
+				}
+			}
+
+			template <typename T>
+			static T bound(const uint8_t(&val)[core::parsers::VAL_SIZE])
+			{
+				T bound_val;
+				std::memcpy(&bound_val, val, sizeof(T));
+				return bound_val;
+			}
+
+			template <typename T>
+			void add_signed(field& rule, const core::parsers::simple_options_data& options)
+			{
+				rule.bounds = static_cast<uint32_t>(m_signed_min.size());
+				m_signed_min.push_back(options.has_min ? static_cast<int64_t>(bound<T>(options.minval)) : (std::numeric_limits<int64_t>::min)());
+				m_signed_max.push_back(options.has_max ? static_cast<int64_t>(bound<T>(options.maxval)) : (std::numeric_limits<int64_t>::max)());
+			}
+
+			template <typename T>
+			void add_unsigned(field& rule, const core::parsers::simple_options_data& options)
+			{
+				rule.bounds = static_cast<uint32_t>(m_unsigned_min.size());
+				m_unsigned_min.push_back(options.has_min ? static_cast<uint64_t>(bound<T>(options.minval)) : 0);
+				m_unsigned_max.push_back(options.has_max ? static_cast<uint64_t>(bound<T>(options.maxval)) : (std::numeric_limits<uint64_t>::max)());
+			}
+
+			template <typename T>
+			void add_floating(field& rule, const core::parsers::simple_options_data& options)
+			{
+				rule.bounds = static_cast<uint32_t>(m_floating_min.size());
+				m_floating_min.push_back(options.has_min ? static_cast<double>(bound<T>(options.minval)) : -std::numeric_limits<double>::infinity());
+				m_floating_max.push_back(options.has_max ? static_cast<double>(bound<T>(options.maxval)) : std::numeric_limits<double>::infinity());
+			}
+
+			void add_simple(const std::string& path, core::types::type_enum type, size_t offset, size_t size, size_t count,
+				bool big_endian, const core::parsers::simple_options_data& options)
+			{
+				if (type != core::types::type_enum::BOOL && options.has_min == false && options.has_max == false)
+					return;
+
+				// The parser reads such a field as its type, leaving it out would accept what the parser rejects
+				if (type != core::types::type_enum::BOOL && size != utils::types::sizeof_type(type))
+					throw std::runtime_error("validation_table: field of a size other than its type's: " + path);
+
+				field rule = { offset, static_cast<uint32_t>(count), static_cast<uint32_t>(size), 0, kind::BOOL,
+					big_endian != utils::types::is_big_endian() };
+				switch (type)
+				{
+				case core::types::type_enum::INT8:
+				case core::types::type_enum::CHAR: rule.type = kind::INT8; add_signed<int8_t>(rule, options); break;
+				case core::types::type_enum::UINT8:
+				case core::types::type_enum::BYTE: rule.type = kind::UINT8; add_unsigned<uint8_t>(rule, options); break;
+				case core::types::type_enum::INT16:
+				case core::types::type_enum::SHORT: rule.type = kind::INT16; add_signed<int16_t>(rule, options); break;
+				case core::types::type_enum::UINT16:
+				case core::types::type_enum::USHORT: rule.type = kind::UINT16; add_unsigned<uint16_t>(rule, options); break;
+				case core::types::type_enum::INT32: rule.type = kind::INT32; add_signed<int32_t>(rule, options); break;
+				case core::types::type_enum::UINT32: rule.type = kind::UINT32; add_unsigned<uint32_t>(rule, options); break;
+				case core::types::type_enum::INT64: rule.type = kind::INT64; add_signed<int64_t>(rule, options); break;
+				case core::types::type_enum::UINT64: rule.type = kind::UINT64; add_unsigned<uint64_t>(rule, options); break;
+				case core::types::type_enum::FLOAT: rule.type = kind::FLOAT; add_floating<float>(rule, options); break;
+				case core::types::type_enum::DOUBLE: rule.type = kind::DOUBLE; add_floating<double>(rule, options); break;
+				case core::types::type_enum::BOOL: break;
+				default: return;
+				}
+
+				m_fields.push_back(rule);
+				m_paths.push_back(path);
+			}
+
+			void add_enum(const std::string& path, core::parsers::binary_node_interface* node, size_t offset)
+			{
+				utils::ref_count_ptr<core::parsers::enum_data_interface> enum_data;
+				if (false == node->query_enum(&enum_data))
+					throw std::runtime_error("validation_table: enum node without enum");
+
+				// Enums are of 1, 2, 4 or 8 bytes
+				size_t size = node->size();
+				if (size != sizeof(int8_t) && size != sizeof(int16_t) && size != sizeof(int32_t) && size != sizeof(int64_t))
+					throw std::runtime_error("validation_table: enum of an unsupported size: " + path);
+
+				enum_values values;
+				for (size_t i = 0; i < enum_data->size(); i++)
+				{
+					core::parsers::enum_data_item item;
+					if (enum_data->item_by_index(i, item))
+						values.sorted.push_back(item.value);
+				}
+
+				std::sort(values.sorted.begin(), values.sorted.end());
+				values.first = values.sorted.empty() ? 0 : values.sorted.front();
+				if (values.sorted.empty() == false &&
+					static_cast<uint64_t>(values.sorted.back()) - static_cast<uint64_t>(values.first) < static_cast<uint64_t>(MAX_BITSET_RANGE))
+				{
+					values.bits.assign(static_cast<size_t>(values.sorted.back() - values.first) / 64 + 1, 0);
+					for (int64_t val : values.sorted)
+					{
+						uint64_t bit = static_cast<uint64_t>(val - values.first);
+						values.bits[bit / 64] |= 1ULL << (bit % 64);
+					}
+
+					values.sorted.clear();
+				}
+
+				field rule = { offset, 1, static_cast<uint32_t>(node->size()), static_cast<uint32_t>(m_enums.size()), kind::ENUM,
+					node->big_endian() != utils::types::is_big_endian() };
+				m_enums.push_back(std::move(values));
+				m_fields.push_back(rule);
+				m_paths.push_back(path);
+			}
+
+			// Appends the rules of another table at the given offset
+			void append(const validation_table& other, size_t base, const std::string& prefix)
+			{
+				for (size_t i = 0; i < other.m_fields.size(); i++)
+				{
+					field rule = other.m_fields[i];
+					rule.offset += base;
+					switch (rule.type)
+					{
+					case kind::INT8:
+					case kind::INT16:
+					case kind::INT32:
+					case kind::INT64:
+						m_signed_min.push_back(other.m_signed_min[rule.bounds]);
+						m_signed_max.push_back(other.m_signed_max[rule.bounds]);
+						rule.bounds = static_cast<uint32_t>(m_signed_min.size() - 1);
+						break;
+					case kind::UINT8:
+					case kind::UINT16:
+					case kind::UINT32:
+					case kind::UINT64:
+						m_unsigned_min.push_back(other.m_unsigned_min[rule.bounds]);
+						m_unsigned_max.push_back(other.m_unsigned_max[rule.bounds]);
+						rule.bounds = static_cast<uint32_t>(m_unsigned_min.size() - 1);
+						break;
+					case kind::FLOAT:
+					case kind::DOUBLE:
+						m_floating_min.push_back(other.m_floating_min[rule.bounds]);
+						m_floating_max.push_back(other.m_floating_max[rule.bounds]);
+						rule.bounds = static_cast<uint32_t>(m_floating_min.size() - 1);
+						break;
+					case kind::ENUM:
+						m_enums.push_back(other.m_enums[rule.bounds]);
+						rule.bounds = static_cast<uint32_t>(m_enums.size() - 1);
+						break;
+					default:
+						break;
+					}
+
+					m_fields.push_back(rule);
+					m_paths.push_back(prefix + other.m_paths[i]);
+				}
+			}
+
+			void compile(const core::parsers::binary_metadata_interface* metadata, size_t base, const std::string& prefix)
+			{
+				size_t count = metadata->node_count();
+				for (size_t i = 0; i < count; i++)
+				{
+					utils::ref_count_ptr<core::parsers::binary_node_interface> node;
+					if (false == metadata->query_node_by_index(i, &node))
+						throw std::runtime_error("validation_table: failed to query node");
+
+					size_t offset = base + node->offset();
+					std::string path = prefix + node->name();
+					switch (node->type())
+					{
+					case core::types::type_enum::COMPLEX:
+					{
+						utils::ref_count_ptr<core::parsers::binary_metadata_interface> nested;
+						if (false == node->nested(&nested))
+							throw std::runtime_error("validation_table: complex node without metadata");
+
+						compile(nested, offset, path + ".");
+						break;
+					}
+					case core::types::type_enum::ARRAY:
+						compile_array(node, offset, path);
+						break;
+					case core::types::type_enum::ENUM:
+						add_enum(path, node, offset);
+						break;
+					default:
+						add_simple(path, node->type(), offset, node->size(), 1, node->big_endian(), node->options());
+						break;
+					}
+				}
+			}
+
+			void compile_array(core::parsers::binary_node_interface* node, size_t offset, const std::string& path)
+			{
+				// The array metadata holds a single node describing the element
+				utils::ref_count_ptr<core::parsers::binary_metadata_interface> array_metadata;
+				utils::ref_count_ptr<core::parsers::binary_node_interface> element;
+				if (false == node->nested(&array_metadata) ||
+					false == array_metadata->query_node_by_index(0, &element))
+					throw std::runtime_error("validation_table: array node without metadata");
+
+				// The elements of enum and string arrays are not validated by the parser either
+				if (element->type() != core::types::type_enum::COMPLEX)
+				{
+					if (utils::types::is_simple_type(element->type()))
+						add_simple(path, element->type(), offset, element->size(), node->count(), element->big_endian(), node->options());
+
+					return;
+				}
+
+				utils::ref_count_ptr<core::parsers::binary_metadata_interface> element_metadata;
+				if (false == element->nested(&element_metadata))
+					throw std::runtime_error("validation_table: complex node without metadata");
+
+				validation_table element_table;
+				element_table.compile(element_metadata, 0, std::string());
+				for (size_t i = 0; i < node->count(); i++)
+					append(element_table, offset + i * element->size(), path + "[" + std::to_string(i) + "].");
+			}
+
+		public:
+			/// Constructor - builds the table of the given metadata
+			/// @date	19/10/2026
+			/// @exception	std::invalid_argument	Thrown when the metadata is null.
+			/// @exception	std::runtime_error   	Thrown when the metadata is inconsistent or has a field the table can not check.
+			/// @param	metadata	The metadata of the messages.
+			explicit validation_table(const core::parsers::binary_metadata_interface* metadata) :
+				m_size(0)
+			{
+				if (metadata == nullptr)
+					throw std::invalid_argument("metadata");
+
+				m_size = metadata->size();
+				compile(metadata, 0, std::string());
+			}
+
+			/// The size of the messages described by the table
+			size_t size() const
+			{
+				return m_size;
+			}
+
+			/// The checked fields, a field's index is its bit in the violations mask
+			const std::vector<field>& fields() const
+			{
+				return m_fields;
+			}
+
+			/// Gets the path of a checked field (e.g. "header.points[2].x")
+			/// @date	19/10/2026
+			/// @exception	std::out_of_range	Thrown when the index is not of a checked field.
+			/// @param	index	The index of the field.
+			/// @return	The path.
+			const std::string& path(size_t index) const
+			{
+				return m_paths.at(index);
+			}
+
+			/// The number of 64 bits words of a violations mask
+			size_t mask_words() const
+			{
+				return (m_fields.size() + 63) / 64;
+			}
+
+			/// Checks a whole message in one pass
+			/// @date	19/10/2026
+			/// @param 			data		The message in the stream byte order.
+			/// @param 			size		The size of the buffer, at least the size of the message.
+			/// @param [out]	violations	The bits of the violating fields, mask_words() words.
+			/// @return	True if the message was checked, false if the buffer is shorter than the message.
+			bool check(const void* data, size_t size, uint64_t* violations) const
+			{
+				if (data == nullptr || violations == nullptr || size < m_size)
+					return false;
+
+				std::fill(violations, violations + mask_words(), 0);
+				const uint8_t* message = static_cast<const uint8_t*>(data);
+				for (size_t i = 0; i < m_fields.size(); i++)
+				{
+					if (false == check(m_fields[i], message))
+						violations[i / 64] |= 1ULL << (i % 64);
+				}
+
+				return true;
+			}
+
+			/// Checks a whole message, stops at the first violating field
+			/// @date	19/10/2026
+			/// @param	data	The message in the stream byte order.
+			/// @param	size	The size of the buffer.
+			/// @return	True if every field is valid, false if a field is invalid or the buffer is shorter than the message.
+			bool validate(const void* data, size_t size) const
+			{
+				if (data == nullptr || size < m_size)
+					return false;
+
+				const uint8_t* message = static_cast<const uint8_t*>(data);
+				for (const field& rule : m_fields)
+				{
+					if (false == check(rule, message))
+						return false;
+				}
+
+				return true;
+			}
+		};
+	}
+}
@@ -9,6 +9,11 @@
 
 #include <atomic>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <deque>
 #include <stdexcept>
 #include <cstring>
 
@@ -21,6 +26,7 @@ namespace utils
 		private:
 			void* m_buffer;
 			size_t m_size;
+			core::buffer_interface* m_owner;
 
 			data_reader(const data_reader& other) = delete;       // non construction-copyable
 			data_reader& operator=(const data_reader&) = delete;	// non copyable				
@@ -30,7 +36,15 @@ namespace utils
 		public:
 			data_reader(void* buffer, size_t size) :
 				m_buffer(buffer),
-				m_size(size)
+				m_size(size),
+				m_owner(nullptr)
+			{
+			}
+
+			data_reader(core::buffer_interface* owner, size_t size) :
+				m_buffer(owner->data()),
+				m_size(size),
+				m_owner(owner)
 			{
 			}
 
@@ -39,6 +53,22 @@ namespace utils
 				return m_buffer;
 			}
 
+			/// Queries the ref-counted buffer holding the data (available when the channel uses pooled receive buffers).
+			/// Holding a reference keeps the data valid after the callback returns without copying it,
+			/// but also keeps the buffer out of the receive pool, so release it as soon as possible.
+			/// @date	19/10/2026
+			/// @param [out]	buffer	The buffer holding the data. Only the first size() bytes are valid.
+			/// @return	True if it succeeds, false if the data is not held by a ref-counted buffer.
+			bool query_buffer(core::buffer_interface** buffer) const
+			{
+				if (buffer == nullptr || m_owner == nullptr)
+					return false;
+
+				*buffer = m_owner;
+				(*buffer)->add_ref();
+				return true;
+			}
+
 			size_t size() const
 			{
 				return m_size;
@@ -138,6 +168,207 @@ namespace utils
 			}
 		};
 
+		/// Packs several application messages into a single transport frame (Nagle-like batching).
+		/// A pending frame is sent when it reaches the flush threshold, when the next message does not fit
+		/// into the frame budget, when the flush deadline of its first message expires or on an explicit flush().
+		/// Messages are concatenated as-is, so the receiving side must split them by a length based protocol
+		/// (e.g. communication::protocols::variable_length_protocol) which unpacks such frames transparently.
+		/// @date	19/10/2026
+		class send_coalescer : public utils::ref_count_base<core::ref_count_interface>
+		{
+		private:
+			utils::ref_count_ptr<core::communication::client_channel_interface> m_channel;
+			size_t m_max_frame_size;
+			size_t m_flush_threshold;
+			std::chrono::microseconds m_flush_deadline;
+
+			std::vector<uint8_t> m_frame;
+			size_t m_frame_messages;
+			std::chrono::steady_clock::time_point m_frame_deadline;
+
+			std::atomic<uint64_t> m_frames_sent;
+			std::atomic<uint64_t> m_messages_sent;
+
+			std::mutex m_mutex;
+			std::condition_variable m_flush_condition;
+			bool m_running;
+			std::thread m_flush_thread;
+
+			send_coalescer(const send_coalescer& other) = delete;			// non construction-copyable
+			send_coalescer& operator=(const send_coalescer&) = delete;		// non copyable
+
+			// Should be called while m_mutex is locked
+			bool send_frame(const void* buffer, size_t size, size_t messages)
+			{
+				bool retval = (m_channel->send(buffer, size) > 0);
+				if (retval == true)
+				{
+					m_frames_sent++;
+					m_messages_sent += messages;
+				}
+
+				return retval;
+			}
+
+			// Should be called while m_mutex is locked
+			bool flush_frame()
+			{
+				if (m_frame.empty() == true)
+					return true;
+
+				bool retval = send_frame(m_frame.data(), m_frame.size(), m_frame_messages);
+				m_frame.clear();
+				m_frame_messages = 0;
+				return retval;
+			}
+
+			void flush_on_deadline()
+			{
+				std::unique_lock<std::mutex> locker(m_mutex);
+				while (m_running == true)
+				{
+					if (m_frame.empty() == true)
+					{
+						m_flush_condition.wait(locker);
+					}
+					else if (m_flush_condition.wait_until(locker, m_frame_deadline) == std::cv_status::timeout)
+					{
+						if (m_frame.empty() == false && std::chrono::steady_clock::now() >= m_frame_deadline)
+							flush_frame();
+					}
+				}
+			}
+
+		public:
+			/// Constructor
+			/// @date	19/10/2026
+			/// @param [in]	channel				The channel used to send the coalesced frames.
+			/// @param 		max_frame_size		The frame budget in bytes (e.g. path MTU minus IP/UDP headers).
+			/// @param 		flush_threshold		A pending frame is sent as soon as it reaches this size (0 means max_frame_size).
+			/// @param 		flush_deadline		The maximal time a message may wait in a pending frame.
+			send_coalescer(
+				core::communication::client_channel_interface* channel,
+				size_t max_frame_size,
+				size_t flush_threshold,
+				std::chrono::microseconds flush_deadline) :
+				m_channel(channel),
+				m_max_frame_size(max_frame_size),
+				m_flush_threshold((flush_threshold == 0 || flush_threshold > max_frame_size) ? max_frame_size : flush_threshold),
+				m_flush_deadline(flush_deadline),
+				m_frame_messages(0),
+				m_frames_sent(0),
+				m_messages_sent(0),
+				m_running(true)
+			{
+				if (channel == nullptr)
+					throw std::invalid_argument("channel");
+
+				if (max_frame_size == 0)
+					throw std::invalid_argument("max_frame_size");
+
+				if (flush_deadline.count() < 0)
+					throw std::invalid_argument("flush_deadline");
+
+				m_frame.reserve(m_max_frame_size);
+				m_flush_thread = std::thread([this]() { flush_on_deadline(); });
+			}
+
+			~send_coalescer()
+			{
+				{
+					std::lock_guard<std::mutex> locker(m_mutex);
+					m_running = false;
+					flush_frame();
+				}
+
+				m_flush_condition.notify_one();
+				if (m_flush_thread.joinable() == true)
+					m_flush_thread.join();
+			}
+
+			size_t max_frame_size() const
+			{
+				return m_max_frame_size;
+			}
+
+			/// Number of transport frames sent so far
+			uint64_t frames_sent() const
+			{
+				return m_frames_sent;
+			}
+
+			/// Number of application messages sent so far
+			uint64_t messages_sent() const
+			{
+				return m_messages_sent;
+			}
+
+			/// Queues a message into the pending frame.
+			/// Messages of the flush threshold or larger are sent on their own, after flushing the pending frame.
+			/// @date	19/10/2026
+			/// @return	False if a frame that was sent during this call failed, true otherwise.
+			bool send(const void* buffer, size_t size)
+			{
+				if (buffer == nullptr || size == 0)
+					return false;
+
+				bool notify = false;
+				bool retval = true;
+				{
+					std::lock_guard<std::mutex> locker(m_mutex);
+
+					// A message sent on its own goes after the pending ones
+					if (m_frame.size() + size > m_max_frame_size || size >= m_flush_threshold)
+						retval = flush_frame();
+
+					if (size >= m_flush_threshold)
+						return (send_frame(buffer, size, 1) && retval);
+
+					const uint8_t* bytes = static_cast<const uint8_t*>(buffer);
+					notify = m_frame.empty();
+					if (notify == true)
+						m_frame_deadline = std::chrono::steady_clock::now() + m_flush_deadline;
+
+					m_frame.insert(m_frame.end(), bytes, bytes + size);
+					m_frame_messages++;
+
+					if (m_frame.size() >= m_flush_threshold)
+						return (flush_frame() && retval);
+				}
+
+				if (notify == true)
+					m_flush_condition.notify_one();
+
+				return retval;
+			}
+
+			/// Sends the pending frame immediately
+			/// @date	19/10/2026
+			/// @return	True if the pending frame was sent (or there was nothing to send), false otherwise.
+			bool flush()
+			{
+				std::lock_guard<std::mutex> locker(m_mutex);
+				return flush_frame();
+			}
+		};
+
+		/// The behavior of a channel using pooled receive buffers when all the pool's buffers are in use
+		enum class receive_overflow_policy
+		{
+			drop_oldest,	// Drop the oldest frame which was not dispatched yet
+			drop_newest,	// Drop the frame which was just received
+			block			// Stop reading from the channel until a buffer is released
+		};
+
+		struct receive_statistics
+		{
+			uint64_t frames_received;
+			uint64_t frames_dispatched;
+			uint64_t dropped_oldest;
+			uint64_t dropped_newest;
+			uint64_t blocked;
+		};
+
 		class comm_client_channel : public utils::ref_count_base<core::ref_count_interface>
 		{
 		private:
@@ -146,6 +377,219 @@ namespace utils
 			utils::ref_count_ptr<core::communication::client_channel_interface> m_channel;
 			bool m_automaticReconnect;
 			std::atomic<bool> m_thread_is_alive;
+			utils::ref_count_ptr<send_coalescer> m_coalescer;
+			mutable std::mutex m_coalescer_mutex;
+
+			// Pooled receive
+			utils::ref_count_ptr<utils::buffer_pool> m_receive_pool;
+			utils::ref_count_ptr<utils::dispatcher> m_receive_dispatcher;
+			receive_overflow_policy m_overflow_policy;
+			std::deque<std::pair<utils::ref_count_ptr<utils::ref_count_buffer>, size_t>> m_pending_frames;
+			std::mutex m_pending_frames_mutex;
+			std::condition_variable m_frame_released;
+
+			std::atomic<uint64_t> m_frames_received;
+			std::atomic<uint64_t> m_frames_dispatched;
+			std::atomic<uint64_t> m_dropped_oldest;
+			std::atomic<uint64_t> m_dropped_newest;
+			std::atomic<uint64_t> m_blocked;
+
+			// Direct receive: raises the frames delivered by the channel's I/O backend
+			class direct_receiver : public utils::ref_count_base<core::communication::frame_callback_interface>
+			{
+			private:
+				comm_client_channel* m_owner;
+
+			public:
+				direct_receiver(comm_client_channel* owner) :
+					m_owner(owner)
+				{
+				}
+
+				virtual void on_frame(const void* buffer, size_t size) override
+				{
+					m_owner->direct_frame(buffer, size);
+				}
+
+				virtual void on_closed(core::communication::communication_error error) override
+				{
+					m_owner->comm_err(error);
+					m_owner->comm_stat(core::communication::communication_status::DISCONNECTED);
+				}
+			};
+
+			utils::ref_count_ptr<direct_receiver> m_direct_receiver;
+
+			bool acquire_pooled_buffer(utils::ref_count_buffer** frame)
+			{
+				if (m_receive_pool->get_item(frame) == true)
+					return true;
+
+				switch (m_overflow_policy)
+				{
+				case receive_overflow_policy::drop_oldest:
+				{
+					std::unique_lock<std::mutex> locker(m_pending_frames_mutex);
+					while (m_pending_frames.empty() == false)
+					{
+						m_pending_frames.pop_front();
+						m_dropped_oldest++;
+
+						if (m_receive_pool->get_item(frame) == true)
+							return true;
+					}
+
+					// All buffers are held by subscribers, nothing left to drop but the new frame
+					return false;
+				}
+
+				case receive_overflow_policy::drop_newest:
+					return false;
+
+				case receive_overflow_policy::block:
+				{
+					m_blocked++;
+					std::unique_lock<std::mutex> locker(m_pending_frames_mutex);
+					while (m_thread_is_alive == true)
+					{
+						if (m_receive_pool->get_item(frame) == true)
+							return true;
+
+						// Subscribers may hold buffers without notifying, hence the periodic retry
+						m_frame_released.wait_for(locker, std::chrono::milliseconds(10));
+					}
+
+					return false;
+				}
+
+				default:
+					throw std::runtime_error("Invalid receive overflow policy");
+				}
+			}
+
+			// Reads a single message into 'frame'.
+			// 'frame' is set to nullptr when the message was dropped due to pool exhaustion.
+			size_t read_frame(utils::ref_count_buffer* buffer, utils::ref_count_ptr<utils::ref_count_buffer>& frame, core::communication::communication_error* err)
+			{
+				frame = buffer;
+				if (m_receive_pool == nullptr)
+					return m_channel->recieve(frame->data(), m_max_message_size, err);
+
+				// A pending frame is dropped for a message which arrived, not for the next read
+				utils::ref_count_ptr<utils::ref_count_buffer> pooled;
+				bool acquired = (m_overflow_policy == receive_overflow_policy::drop_oldest) ?
+					m_receive_pool->get_item(&pooled) :
+					acquire_pooled_buffer(&pooled);
+				if (acquired == false && m_thread_is_alive == false)
+					return 0;
+
+				if (acquired == true)
+					frame = pooled;
+
+				size_t bytes_read = m_channel->recieve(frame->data(), m_max_message_size, err);
+				if (bytes_read != 0)
+				{
+					m_frames_received++;
+					if (acquired == false && m_overflow_policy == receive_overflow_policy::drop_oldest &&
+						acquire_pooled_buffer(&pooled) == true)
+					{
+						std::memcpy(pooled->data(), frame->data(), bytes_read);
+						frame = pooled;
+					}
+					else if (acquired == false)
+					{
+						// The message was consumed into the scratch buffer
+						m_dropped_newest++;
+						frame.release();
+					}
+				}
+
+				return bytes_read;
+			}
+
+			void deliver_frame(utils::ref_count_buffer* frame, size_t size)
+			{
+				if (frame == nullptr)
+					return;
+
+				if (m_receive_pool == nullptr)
+				{
+					data_reader reader(frame->data(), size);
+					data_read(reader);
+					return;
+				}
+
+				{
+					std::lock_guard<std::mutex> locker(m_pending_frames_mutex);
+					m_pending_frames.emplace_back(frame, size);
+				}
+
+				m_receive_dispatcher->begin_invoke([this]()
+				{
+					dispatch_pending_frame();
+				});
+			}
+
+			void dispatch_pending_frame()
+			{
+				utils::ref_count_ptr<utils::ref_count_buffer> frame;
+				size_t size = 0;
+				{
+					std::lock_guard<std::mutex> locker(m_pending_frames_mutex);
+
+					// The frame might have been dropped (drop_oldest)
+					if (m_pending_frames.empty() == true)
+						return;
+
+					frame = m_pending_frames.front().first;
+					size = m_pending_frames.front().second;
+					m_pending_frames.pop_front();
+				}
+
+				{
+					data_reader reader(static_cast<core::buffer_interface*>(frame), size);
+					data_read(reader);
+				}
+
+				frame.release();
+				m_frames_dispatched++;
+				m_frame_released.notify_one();
+			}
+
+			core::communication::direct_receive_interface* direct_channel() const
+			{
+				return dynamic_cast<core::communication::direct_receive_interface*>(
+					static_cast<core::communication::client_channel_interface*>(m_channel));
+			}
+
+			void direct_frame(const void* buffer, size_t size)
+			{
+				if (m_receive_pool == nullptr)
+				{
+					// The channel does not modify the frame, subscribers are not supposed to either
+					data_reader reader(const_cast<void*>(buffer), size);
+					data_read(reader);
+					return;
+				}
+
+				// Blocking is not an option on the backend's thread, a frame without a buffer is dropped
+				m_frames_received++;
+				utils::ref_count_ptr<utils::ref_count_buffer> frame;
+				if (size > m_max_message_size || acquire_pooled_buffer(&frame) == false)
+				{
+					m_dropped_newest++;
+					return;
+				}
+
+				std::memcpy(frame->data(), buffer, size);
+				deliver_frame(frame, size);
+			}
+
+			utils::ref_count_ptr<send_coalescer> coalescer() const
+			{
+				std::lock_guard<std::mutex> locker(m_coalescer_mutex);
+				return m_coalescer;
+			}
 
 		public:
 			utils::signal<comm_client_channel, const data_reader&> data_read;
@@ -160,7 +604,8 @@ namespace utils
 			/// 	occurs.
 			void recieve()
 			{
-				utils::ref_count_buffer buffer(m_max_message_size);
+				utils::ref_count_ptr<utils::ref_count_buffer> buffer = utils::make_ref_count_ptr<utils::ref_count_buffer>(m_max_message_size);
+				utils::ref_count_ptr<utils::ref_count_buffer> frame;
 
 				size_t bytes_read;
 				core::communication::communication_error err = core::communication::communication_error::NO_ERRORS;
@@ -175,12 +620,9 @@ namespace utils
 						{
 						case core::communication::communication_status::CONNECTED:
 							status = core::communication::communication_status::CONNECTED;
-							bytes_read = m_channel->recieve(buffer.data(), m_max_message_size, &err);
+							bytes_read = read_frame(buffer, frame, &err);
 							if (bytes_read != 0)
-							{
-								data_reader reader(buffer.data(), bytes_read);
-								data_read(reader);
-							}
+								deliver_frame(frame, bytes_read);
 
 							comm_err(err);
 							comm_stat(status);
@@ -210,13 +652,12 @@ namespace utils
 				}
 				else
 				{
-					while ((bytes_read = m_channel->recieve(buffer.data(), m_max_message_size, &err)) != 0)
+					while ((bytes_read = read_frame(buffer, frame, &err)) != 0)
 					{
 						comm_err(err);
 						comm_stat(core::communication::communication_status::CONNECTED);
 
-						data_reader reader(buffer.data(), bytes_read);
-						data_read(reader);
+						deliver_frame(frame, bytes_read);
 					}
 
 					comm_err(err);
@@ -231,7 +672,13 @@ namespace utils
 				m_max_message_size(max_message_size),
 				m_channel(channel),
 				m_automaticReconnect(automaticReconnect),
-				m_thread_is_alive(false)
+				m_thread_is_alive(false),
+				m_overflow_policy(receive_overflow_policy::drop_oldest),
+				m_frames_received(0),
+				m_frames_dispatched(0),
+				m_dropped_oldest(0),
+				m_dropped_newest(0),
+				m_blocked(0)
 			{
 				if (max_message_size == 0)
 				{
@@ -268,10 +715,167 @@ namespace utils
 				if (size == 0 || size > m_max_message_size)
 					return false;
 
+				utils::ref_count_ptr<send_coalescer> local_coalescer = coalescer();
+				if (local_coalescer != nullptr)
+					return local_coalescer->send(buffer, size);
+
 				//if size > 0 return true
 				return  (m_channel->send(buffer, size) > 0);
 			}
 
+			/// Enables send coalescing: subsequent messages are packed into frames of up to max_frame_size bytes.
+			/// Should only be used on top of a length based protocol (e.g. variable_length_protocol) so the remote side can split the frames.
+			/// @date	19/10/2026
+			/// @param 	max_frame_size	 	The frame budget in bytes (e.g. path MTU minus IP/UDP headers).
+			/// @param 	flush_threshold  	A pending frame is sent as soon as it reaches this size (0 means max_frame_size).
+			/// @param 	flush_deadline   	The maximal time a message may wait before its frame is sent.
+			/// @return	True if it succeeds, false if it fails.
+			bool enable_send_coalescing(size_t max_frame_size, size_t flush_threshold, std::chrono::microseconds flush_deadline)
+			{
+				if (m_channel == nullptr)
+					return false;
+
+				utils::ref_count_ptr<send_coalescer> instance;
+				try
+				{
+					instance = utils::make_ref_count_ptr<send_coalescer>(m_channel, max_frame_size, flush_threshold, flush_deadline);
+				}
+				catch (...)
+				{
+					return false;
+				}
+
+				std::lock_guard<std::mutex> locker(m_coalescer_mutex);
+				m_coalescer = instance;
+				return true;
+			}
+
+			/// Disables send coalescing. Pending messages are sent first.
+			/// @date	19/10/2026
+			void disable_send_coalescing()
+			{
+				utils::ref_count_ptr<send_coalescer> local_coalescer;
+				{
+					std::lock_guard<std::mutex> locker(m_coalescer_mutex);
+					local_coalescer = m_coalescer;
+					m_coalescer.release();
+				}
+
+				if (local_coalescer != nullptr)
+					local_coalescer->flush();
+			}
+
+			/// Sends pending coalesced messages immediately (does nothing when send coalescing is disabled).
+			/// @date	19/10/2026
+			/// @return	True if it succeeds, false if it fails.
+			bool flush() const
+			{
+				utils::ref_count_ptr<send_coalescer> local_coalescer = coalescer();
+				if (local_coalescer == nullptr)
+					return true;
+
+				return local_coalescer->flush();
+			}
+
+			/// Enables pooled receive: each message is read into a buffer taken from a preallocated pool
+			/// and data_read is raised on the given dispatcher instead of the receiving thread.
+			/// Subscribers may keep the data without copying by taking a reference (data_reader::query_buffer).
+			/// Should be called while the channel is disconnected.
+			/// @date	19/10/2026
+			/// @param 		   	pool_size 	Number of preallocated receive buffers (each of max_message_size() bytes).
+			/// @param 		   	policy	  	What to do when all the buffers are in use.
+			/// @param [in]		dispatcher	(Optional) The dispatcher raising data_read. If null, a private dispatcher is created.
+			/// @return	True if it succeeds, false if it fails.
+			bool enable_pooled_receive(size_t pool_size, receive_overflow_policy policy, utils::dispatcher* dispatcher = nullptr)
+			{
+				if (pool_size == 0 || m_thread_is_alive == true)
+					return false;
+
+				if (policy == receive_overflow_policy::block && m_direct_receiver != nullptr)
+					return false;
+
+				try
+				{
+					m_receive_pool = utils::make_ref_count_ptr<utils::buffer_pool>(pool_size, false, m_max_message_size);
+					if (dispatcher != nullptr)
+						m_receive_dispatcher = dispatcher;
+					else
+						m_receive_dispatcher = utils::make_ref_count_ptr<utils::dispatcher>("CommClientChannel");
+				}
+				catch (...)
+				{
+					m_receive_pool.release();
+					m_receive_dispatcher.release();
+					return false;
+				}
+
+				m_overflow_policy = policy;
+				return true;
+			}
+
+			/// Enables direct receive: data_read is raised as soon as the channel's I/O backend completes a frame,
+			/// on the backend's completion thread (shared by the channels of the process) or on the pooled receive dispatcher,
+			/// without a receiving thread. The channel must implement core::communication::direct_receive_interface
+			/// (e.g. a UDP or TCP port using the io_uring backend, not a protocol on top of it): frames are its datagrams or stream reads.
+			/// Not available with automatic reconnection nor with receive_overflow_policy::block.
+			/// Should be called while the channel is disconnected.
+			/// @date	19/10/2026
+			/// @return	True if it succeeds, false if the channel cannot deliver its frames directly.
+			bool enable_direct_receive()
+			{
+				if (m_automaticReconnect == true || m_thread_is_alive == true)
+					return false;
+
+				if (m_receive_pool != nullptr && m_overflow_policy == receive_overflow_policy::block)
+					return false;
+
+				core::communication::direct_receive_interface* channel = direct_channel();
+				if (channel == nullptr)
+					return false;
+
+				utils::ref_count_ptr<direct_receiver> receiver;
+				try
+				{
+					receiver = utils::make_ref_count_ptr<direct_receiver>(this);
+				}
+				catch (...)
+				{
+					return false;
+				}
+
+				// The callback is set again on each connect, this checks the channel's backend supports it
+				if (channel->set_frame_callback(receiver) == false)
+					return false;
+
+				m_direct_receiver = receiver;
+				return true;
+			}
+
+			receive_statistics query_receive_statistics() const
+			{
+				receive_statistics retval;
+				retval.frames_received = m_frames_received;
+				retval.frames_dispatched = m_frames_dispatched;
+				retval.dropped_oldest = m_dropped_oldest;
+				retval.dropped_newest = m_dropped_newest;
+				retval.blocked = m_blocked;
+				return retval;
+			}
+
+			bool query_send_coalescer(send_coalescer** coalescer) const
+			{
+				if (coalescer == nullptr)
+					return false;
+
+				utils::ref_count_ptr<send_coalescer> local_coalescer = this->coalescer();
+				if (local_coalescer == nullptr)
+					return false;
+
+				*coalescer = local_coalescer;
+				(*coalescer)->add_ref();
+				return true;
+			}
+
 			core::communication::communication_status status() const
 			{
 				if (m_channel == nullptr)
@@ -293,6 +897,9 @@ namespace utils
 					{
 						disconnect();
 
+						if (m_direct_receiver != nullptr && direct_channel()->set_frame_callback(m_direct_receiver) == false)
+							return false;
+
 						if (m_channel->connect() == false)
 							return false;
 					}
@@ -304,7 +911,11 @@ namespace utils
 
 				if (create_thread == true)
 				{
-					m_recieving_thread = std::thread([this]() { recieve(); });
+					// With direct receive, the frames are raised by the channel's I/O backend
+					if (m_direct_receiver != nullptr)
+						comm_stat(core::communication::communication_status::CONNECTED);
+					else
+						m_recieving_thread = std::thread([this]() { recieve(); });
 				}
 
 				return true;
@@ -319,14 +930,32 @@ namespace utils
 				bool desired = false;
 				bool sync = (m_thread_is_alive.compare_exchange_strong(expected, desired) == true);
 
+				flush();
 				m_channel->disconnect();
 
+				// The channel delivers no frame once disconnected, the callback must not outlive this instance
+				if (m_direct_receiver != nullptr)
+					direct_channel()->set_frame_callback(nullptr);
+
 				if (sync == true)
 				{
+					m_frame_released.notify_all();
 					if (m_recieving_thread.joinable() == true)
 						m_recieving_thread.join();
 				}
 
+				if (m_receive_dispatcher != nullptr)
+				{
+					{
+						std::lock_guard<std::mutex> locker(m_pending_frames_mutex);
+						m_pending_frames.clear();
+					}
+
+					// Make sure no pending dispatch refers to this instance
+					if (m_receive_dispatcher->invoke_required() == true)
+						m_receive_dispatcher->sync();
+				}
+
 				return true;
 			}
 		};
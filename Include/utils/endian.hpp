@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace utils
+{
+	namespace types
+	{
+		/// Swaps the bytes of every 16 bits word of a block, this is the conversion the binary parser applies to data of a
+		/// mismatched endian. Uses AVX2 byte shuffles when built with ENABLE_AVX2, SSE2 otherwise and a 64 bits scalar loop
+		/// on other platforms.
+		/// @date	19/10/2026
+		/// @param [out]	destination	The converted block, may be the source itself.
+		/// @param 			source	   	The block to convert.
+		/// @param 			size	   	The size of the block, an odd trailing byte is copied as is.
+		inline void endian_swap_words(void* destination, const void* source, size_t size)
+		{
+			uint8_t* dst = static_cast<uint8_t*>(destination);
+			const uint8_t* src = static_cast<const uint8_t*>(source);
+			size_t words_size = size & ~static_cast<size_t>(1);
+			size_t i = 0;
+
+#if defined(__AVX2__)
+			const __m256i shuffle = _mm256_setr_epi8(
+				1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+				1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+			for (; i + sizeof(__m256i) <= words_size; i += sizeof(__m256i))
+			{
+				__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(block, shuffle));
+			}
+#elif defined(__SSE2__) || defined(_M_X64)
+			for (; i + sizeof(__m128i) <= words_size; i += sizeof(__m128i))
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				block = _mm_or_si128(_mm_slli_epi16(block, 8), _mm_srli_epi16(block, 8));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), block);
+			}
+#endif
+			for (; i + sizeof(uint64_t) <= words_size; i += sizeof(uint64_t))
+			{
+				uint64_t block;
+				std::memcpy(&block, src + i, sizeof(block));
+				block = ((block >> 8) & 0x00FF00FF00FF00FFULL) | ((block & 0x00FF00FF00FF00FFULL) << 8);
+				std::memcpy(dst + i, &block, sizeof(block));
+			}
+
+			for (; i < words_size; i += 2)
+			{
+				uint8_t temp = src[i];
+				dst[i] = src[i + 1];
+				dst[i + 1] = temp;
+			}
+
+			if (words_size != size && dst != src)
+				dst[words_size] = src[words_size];
+		}
+
+		/// Swaps the bytes of every 16 bits word of a block in place
+		/// @date	19/10/2026
+		/// @param [in,out]	data	The block to convert.
+		/// @param 			size	The size of the block, an odd trailing byte is left as is.
+		inline void endian_swap_words(void* data, size_t size)
+		{
+			endian_swap_words(data, data, size);
+		}
+
+		/// Swaps the bytes of every 16 bits word of a single value, as endian_swap_words converts it in a block
+		/// @date	19/10/2026
+		/// @param	val	The value.
+		/// @return	The converted value.
+		inline uint8_t endian_swap_value(uint8_t val)
+		{
+			return val;
+		}
+
+		inline uint16_t endian_swap_value(uint16_t val)
+		{
+			return static_cast<uint16_t>((val >> 8) | (val << 8));
+		}
+
+		inline uint32_t endian_swap_value(uint32_t val)
+		{
+			return ((val >> 8) & 0x00FF00FFU) | ((val & 0x00FF00FFU) << 8);
+		}
+
+		inline uint64_t endian_swap_value(uint64_t val)
+		{
+			return ((val >> 8) & 0x00FF00FF00FF00FFULL) | ((val & 0x00FF00FF00FF00FFULL) << 8);
+		}
+	}
+}
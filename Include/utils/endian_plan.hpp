@@ -0,0 +1,213 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/endian.hpp>
+#include <utils/types.hpp>
+#include <utils/ref_count_ptr.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace utils
+{
+	namespace parsers
+	{
+		/// A byte order normalization plan of a whole message, built once from its metadata.
+		/// The plan holds the regions of the buffer which are of a mismatched endian (adjacent fields merged into a single region),
+		/// normalizing converts a message in one pass so its fields can be read by plain loads (see normalized()).
+		/// The conversion is symmetric - normalizing a normalized buffer restores the stream byte order.
+		/// @date	19/10/2026
+		class endian_plan
+		{
+		public:
+			struct region
+			{
+				size_t offset;
+				size_t size;
+			};
+
+		private:
+			std::vector<region> m_regions;
+			size_t m_size;
+
+			void add_region(size_t offset, size_t size)
+			{
+				if (size < 2)
+					return;
+
+				// Only a region of an even size keeps the words of the next field aligned
+				if (m_regions.empty() == false)
+				{
+					region& last = m_regions.back();
+					if (last.offset + last.size == offset && last.size % 2 == 0)
+					{
+						last.size += size;
+						return;
+					}
+				}
+
+				m_regions.push_back({ offset, size });
+			}
+
+			void compile(const core::parsers::binary_metadata_interface* metadata, size_t base)
+			{
+				size_t count = metadata->node_count();
+				for (size_t i = 0; i < count; i++)
+				{
+					utils::ref_count_ptr<core::parsers::binary_node_interface> node;
+					if (false == metadata->query_node_by_index(i, &node))
+						throw std::runtime_error("endian_plan: failed to query node");
+
+					size_t offset = base + node->offset();
+					switch (node->type())
+					{
+					case core::types::type_enum::COMPLEX:
+					{
+						utils::ref_count_ptr<core::parsers::binary_metadata_interface> nested;
+						if (false == node->nested(&nested))
+							throw std::runtime_error("endian_plan: complex node without metadata");
+
+						compile(nested, offset);
+						break;
+					}
+					case core::types::type_enum::ARRAY:
+						compile_array(node, offset);
+						break;
+					case core::types::type_enum::BITMAP:
+						// Bits are converted after they are extracted from their block, the block is kept as is
+						break;
+					default:
+						if (node->big_endian() != utils::types::is_big_endian())
+							add_region(offset, node->size());
+						break;
+					}
+				}
+			}
+
+			void compile_array(core::parsers::binary_node_interface* node, size_t offset)
+			{
+				// The array metadata holds a single node describing the element
+				utils::ref_count_ptr<core::parsers::binary_metadata_interface> array_metadata;
+				utils::ref_count_ptr<core::parsers::binary_node_interface> element;
+				if (false == node->nested(&array_metadata) ||
+					false == array_metadata->query_node_by_index(0, &element))
+					throw std::runtime_error("endian_plan: array node without metadata");
+
+				size_t stride = element->size();
+				if (element->type() != core::types::type_enum::COMPLEX)
+				{
+					if (element->big_endian() == utils::types::is_big_endian())
+						return;
+
+					if (stride % 2 == 0)
+					{
+						add_region(offset, stride * node->count());
+						return;
+					}
+
+					for (size_t i = 0; i < node->count(); i++)
+						add_region(offset + i * stride, stride);
+
+					return;
+				}
+
+				utils::ref_count_ptr<core::parsers::binary_metadata_interface> element_metadata;
+				if (false == element->nested(&element_metadata))
+					throw std::runtime_error("endian_plan: complex node without metadata");
+
+				endian_plan element_plan(element_metadata);
+				for (size_t i = 0; i < node->count(); i++)
+				{
+					for (const region& element_region : element_plan.m_regions)
+						add_region(offset + i * stride + element_region.offset, element_region.size);
+				}
+			}
+
+		public:
+			/// Constructor - builds the plan of the given metadata
+			/// @date	19/10/2026
+			/// @exception	std::invalid_argument	Thrown when the metadata is null.
+			/// @exception	std::runtime_error   	Thrown when the metadata is inconsistent.
+			/// @param	metadata	The metadata of the messages.
+			explicit endian_plan(const core::parsers::binary_metadata_interface* metadata) :
+				m_size(0)
+			{
+				if (metadata == nullptr)
+					throw std::invalid_argument("metadata");
+
+				m_size = metadata->size();
+				compile(metadata, 0);
+			}
+
+			/// The size of the messages described by the plan
+			size_t size() const
+			{
+				return m_size;
+			}
+
+			/// True if the messages are already in the platform byte order
+			bool empty() const
+			{
+				return m_regions.empty();
+			}
+
+			const std::vector<region>& regions() const
+			{
+				return m_regions;
+			}
+
+			/// Converts a message in a single pass over the source buffer
+			/// @date	19/10/2026
+			/// @param 			source			The message in the stream byte order.
+			/// @param [out]	destination 	The normalized message, may be the source itself.
+			/// @param 			size			The size of the message.
+			/// @return	True if it succeeds, false if the size does not match the metadata.
+			bool normalize(const void* source, void* destination, size_t size) const
+			{
+				if (source == nullptr || destination == nullptr || size != m_size)
+					return false;
+
+				const uint8_t* src = static_cast<const uint8_t*>(source);
+				uint8_t* dst = static_cast<uint8_t*>(destination);
+				bool in_place = (src == dst);
+				size_t position = 0;
+				for (const region& current : m_regions)
+				{
+					if (in_place == false)
+						std::memcpy(dst + position, src + position, current.offset - position);
+
+					utils::types::endian_swap_words(dst + current.offset, src + current.offset, current.size);
+					position = current.offset + current.size;
+				}
+
+				if (in_place == false)
+					std::memcpy(dst + position, src + position, size - position);
+
+				return true;
+			}
+
+			/// Converts a message in place
+			/// @date	19/10/2026
+			/// @param [in,out]	data	The message.
+			/// @param 			size	The size of the message.
+			/// @return	True if it succeeds, false if the size does not match the metadata.
+			bool normalize(void* data, size_t size) const
+			{
+				return normalize(data, data, size);
+			}
+
+			/// Gets the accessor of a field in a normalized message, only bitmap fields are still converted when read
+			/// @date	19/10/2026
+			/// @param	accessor	The accessor compiled by the metadata.
+			/// @return	The accessor to use with normalized messages.
+			static core::parsers::binary_accessor normalized(const core::parsers::binary_accessor& accessor)
+			{
+				core::parsers::binary_accessor native = accessor;
+				if (native.type != core::types::type_enum::BITMAP)
+					native.swap = false;
+
+				return native;
+			}
+		};
+	}
+}
@@ -0,0 +1,387 @@
+#pragma once
+#include <core/compression.h>
+#include <core/imaging.h>
+#include <compression/lz4_compression_interface.h>
+
+#include <utils/ref_count_base.hpp>
+#include <utils/ref_count_ptr.hpp>
+
+#include <cstring>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace utils
+{
+	namespace video
+	{
+		/// Compresses the data of frames losslessly for transports which cannot carry raw frames (a network hop, a file,
+		/// a shared memory segment read remotely). The data is split per plane or per tile (a band of rows of a plane) and
+		/// each chunk is compressed on its own by a compression::lz4_compression_interface, chunks which do not shrink are
+		/// stored as they are. core::compression_interface::encode takes no output capacity, the codec relies on the LZ4
+		/// compression never writing more than its input size (it fails instead), other compressions are refused.
+		/// With a keyframe interval above 1 the frames in between keyframes are encoded as the byte difference to the frame
+		/// before them, which compresses static scenes to almost nothing. Such a frame is decoded only after the frame it
+		/// refers to, a decoder which missed it fails until the next keyframe.
+		/// The same codec encodes or decodes a stream, not both.
+		/// @date	19/10/2026
+		class frame_codec :
+			public utils::ref_count_base<core::ref_count_interface>
+		{
+		public:
+			enum chunking
+			{
+				PER_PLANE,
+				PER_TILE
+			};
+
+		private:
+			static constexpr uint32_t IDENTIFIER = 0x31434646; // "FFC1"
+			static constexpr uint32_t DELTA = 0x1;		// The frame is the difference to the frame 'reference'
+			static constexpr uint32_t REFERENCED = 0x2;	// The next frame may be the difference to this one
+
+#pragma pack(1)
+			struct header
+			{
+				uint32_t identifier;
+				uint32_t flags;
+				uint32_t sequence;
+				uint32_t reference;
+				uint32_t chunk_count;
+				uint32_t encoded_size; // The chunk table and the chunks following the header
+			};
+
+			struct chunk_entry
+			{
+				uint32_t size;
+				uint32_t stored_size; // The size itself when the chunk is stored uncompressed
+			};
+#pragma pack()
+
+			struct plane
+			{
+				size_t offset;
+				size_t row_size;
+				uint32_t rows;
+			};
+
+			struct chunk
+			{
+				size_t offset;
+				uint32_t size;
+			};
+
+			utils::ref_count_ptr<core::compression_interface> m_compression;
+			chunking m_chunking;
+			uint32_t m_keyframe_interval;
+			uint32_t m_tile_rows;
+
+			std::mutex m_mutex;
+			uint32_t m_sequence;
+			uint32_t m_frames_since_keyframe;
+			core::imaging::image_params m_previous_params;
+			std::vector<uint8_t> m_previous;	// The previous frame encoded or decoded, while a delta may refer to it
+			std::vector<uint8_t> m_difference;
+			std::vector<uint8_t> m_scratch;
+
+			// The planes of an image, a single plane of its size when the format is unknown or its rows padded
+			static std::vector<plane> planes(const core::imaging::image_params& params)
+			{
+				size_t width = params.width;
+				size_t height = params.height;
+				size_t chroma_width = (width + 1) / 2;
+				size_t chroma_height = (height + 1) / 2;
+
+				std::vector<plane> retval;
+				switch (params.format)
+				{
+				case core::imaging::pixel_format::RGB:
+				case core::imaging::pixel_format::BGR:
+					retval = { plane{ 0, width * 3, params.height } };
+					break;
+				case core::imaging::pixel_format::RGBA:
+				case core::imaging::pixel_format::BGRA:
+					retval = { plane{ 0, width * 4, params.height } };
+					break;
+				case core::imaging::pixel_format::YUY2:
+				case core::imaging::pixel_format::UYVY:
+				case core::imaging::pixel_format::GRAY16_LE:
+					retval = { plane{ 0, width * 2, params.height } };
+					break;
+				case core::imaging::pixel_format::GRAY8:
+					retval = { plane{ 0, width, params.height } };
+					break;
+				case core::imaging::pixel_format::I420:
+					retval = {
+						plane{ 0, width, params.height },
+						plane{ width * height, chroma_width, static_cast<uint32_t>(chroma_height) },
+						plane{ (width * height) + (chroma_width * chroma_height), chroma_width, static_cast<uint32_t>(chroma_height) } };
+					break;
+				case core::imaging::pixel_format::NV12:
+					retval = {
+						plane{ 0, width, params.height },
+						plane{ width * height, chroma_width * 2, static_cast<uint32_t>(chroma_height) } };
+					break;
+				default:
+					break;
+				}
+
+				size_t total = 0;
+				for (const plane& current : retval)
+					total += current.row_size * current.rows;
+
+				if (retval.empty() == true || total != params.size)
+					retval = { plane{ 0, params.size, 1 } };
+
+				return retval;
+			}
+
+			std::vector<chunk> chunks(const core::imaging::image_params& params) const
+			{
+				std::vector<chunk> retval;
+				for (const plane& current : planes(params))
+				{
+					uint32_t band = (m_chunking == chunking::PER_TILE) ? m_tile_rows : current.rows;
+					for (uint32_t row = 0; row < current.rows; row += band)
+					{
+						uint32_t rows = (current.rows - row < band) ? (current.rows - row) : band;
+						size_t size = current.row_size * rows;
+						if (size != 0)
+							retval.push_back(chunk{ current.offset + (current.row_size * row), static_cast<uint32_t>(size) });
+					}
+				}
+
+				return retval;
+			}
+
+			static bool same_params(const core::imaging::image_params& left, const core::imaging::image_params& right)
+			{
+				return (left.width == right.width && left.height == right.height && left.size == right.size && left.format == right.format);
+			}
+
+		public:
+			/// Creates a codec
+			/// @date	19/10/2026
+			/// @param	compression		  	The compression of the chunks, a compression::lz4_compression_interface.
+			/// @param	chunks			  	A chunk per plane or per tile of 'tile_rows' rows of a plane.
+			/// @param	keyframe_interval 	Every how many frames a frame is encoded on its own, 0 or 1 for all of them.
+			/// @param	tile_rows		  	The rows of a tile.
+			frame_codec(core::compression_interface* compression, chunking chunks = chunking::PER_PLANE, uint32_t keyframe_interval = 0, uint32_t tile_rows = 64) :
+				m_compression(compression),
+				m_chunking(chunks),
+				m_keyframe_interval(keyframe_interval),
+				m_tile_rows(tile_rows),
+				m_sequence(0),
+				m_frames_since_keyframe(0),
+				m_previous_params{}
+			{
+				if (dynamic_cast<compression::lz4_compression_interface*>(compression) == nullptr)
+					throw std::invalid_argument("compression");
+
+				if (tile_rows == 0)
+					throw std::invalid_argument("tile_rows");
+			}
+
+			virtual ~frame_codec() = default;
+
+			/// The largest encoding of a frame: its data stored uncompressed
+			/// @date	19/10/2026
+			/// @param	params	The parameters of the frame.
+			/// @return	The size in bytes.
+			size_t max_encoded_size(const core::imaging::image_params& params) const
+			{
+				return sizeof(header) + (chunks(params).size() * sizeof(chunk_entry)) + params.size;
+			}
+
+			/// Reads the size of an encoded frame from its beginning
+			/// @date	19/10/2026
+			/// @param 			encoded		  	The encoded frame.
+			/// @param 			available	  	The bytes available at 'encoded', at least header_size().
+			/// @param [out]	encoded_size  	The size of the encoded frame.
+			/// @return	True if it succeeds, false if the bytes are not an encoded frame.
+			static bool read_encoded_size(const uint8_t* encoded, size_t available, size_t& encoded_size)
+			{
+				header current;
+				if (encoded == nullptr || available < sizeof(header))
+					return false;
+
+				std::memcpy(&current, encoded, sizeof(header));
+				if (current.identifier != IDENTIFIER)
+					return false;
+
+				encoded_size = sizeof(header) + current.encoded_size;
+				return true;
+			}
+
+			static constexpr size_t header_size()
+			{
+				return sizeof(header);
+			}
+
+			/// Encodes the data of a frame
+			/// @date	19/10/2026
+			/// @param 			params		  	The parameters of the frame.
+			/// @param 			data		  	The data of the frame, of params.size bytes.
+			/// @param [out]	output		  	The encoded frame.
+			/// @param 			capacity	  	The size of 'output', max_encoded_size(params) always suffices.
+			/// @param [out]	encoded_size  	The size of the encoded frame.
+			/// @return	True if it succeeds, false if the output is too small.
+			bool encode(const core::imaging::image_params& params, const uint8_t* data, uint8_t* output, size_t capacity, size_t& encoded_size)
+			{
+				if (data == nullptr || output == nullptr || params.size == 0)
+					return false;
+
+				std::lock_guard<std::mutex> locker(m_mutex);
+
+				std::vector<chunk> frame_chunks = chunks(params);
+				size_t table_size = sizeof(header) + (frame_chunks.size() * sizeof(chunk_entry));
+				if (capacity < table_size)
+					return false;
+
+				bool referenced = (m_keyframe_interval > 1);
+				bool delta = (referenced == true &&
+					m_frames_since_keyframe + 1 < m_keyframe_interval &&
+					m_previous.empty() == false &&
+					same_params(params, m_previous_params) == true);
+
+				const uint8_t* source = data;
+				if (delta == true)
+				{
+					m_difference.resize(params.size);
+					for (size_t i = 0; i < params.size; i++)
+						m_difference[i] = static_cast<uint8_t>(data[i] - m_previous[i]);
+
+					source = m_difference.data();
+				}
+
+				uint8_t* pos = output + table_size;
+				for (size_t i = 0; i < frame_chunks.size(); i++)
+				{
+					const chunk& current = frame_chunks[i];
+					size_t remaining = capacity - static_cast<size_t>(pos - output);
+
+					// The LZ4 compression writes at most the chunk size and fails when the chunk does not shrink, so a chunk
+					// is compressed in place when the output has room for it stored uncompressed, in the scratch buffer otherwise
+					uint32_t stored_size = 0;
+					if (remaining >= current.size)
+					{
+						if (m_compression->encode(source + current.offset, current.size, pos, stored_size) == false)
+							stored_size = 0;
+					}
+					else
+					{
+						m_scratch.resize(current.size);
+						if (m_compression->encode(source + current.offset, current.size, m_scratch.data(), stored_size) == false ||
+							stored_size > remaining)
+							return false;
+
+						std::memcpy(pos, m_scratch.data(), stored_size);
+					}
+
+					if (stored_size == 0)
+					{
+						stored_size = current.size;
+						std::memcpy(pos, source + current.offset, current.size);
+					}
+
+					chunk_entry entry{ current.size, stored_size };
+					std::memcpy(output + sizeof(header) + (i * sizeof(chunk_entry)), &entry, sizeof(chunk_entry));
+					pos += stored_size;
+				}
+
+				uint32_t reference = m_sequence;
+				m_sequence = (m_sequence + 1 == 0) ? 1 : m_sequence + 1;
+
+				header current{
+					IDENTIFIER,
+					(delta ? DELTA : 0) | (referenced ? REFERENCED : 0),
+					m_sequence,
+					reference,
+					static_cast<uint32_t>(frame_chunks.size()),
+					static_cast<uint32_t>(static_cast<size_t>(pos - output) - sizeof(header)) };
+
+				std::memcpy(output, &current, sizeof(header));
+				encoded_size = static_cast<size_t>(pos - output);
+
+				m_frames_since_keyframe = (delta == true) ? m_frames_since_keyframe + 1 : 0;
+				if (referenced == true)
+				{
+					m_previous.assign(data, data + params.size);
+					m_previous_params = params;
+				}
+
+				return true;
+			}
+
+			/// Decodes the data of a frame
+			/// @date	19/10/2026
+			/// @param 			params		  	The parameters of the frame.
+			/// @param 			encoded		  	The encoded frame.
+			/// @param 			encoded_size  	The size of the encoded frame.
+			/// @param [out]	output		  	The data of the frame, of params.size bytes.
+			/// @return	True if it succeeds, false if the encoding is corrupted or refers to a frame which was not decoded.
+			bool decode(const core::imaging::image_params& params, const uint8_t* encoded, size_t encoded_size, uint8_t* output)
+			{
+				if (encoded == nullptr || output == nullptr || encoded_size < sizeof(header))
+					return false;
+
+				std::lock_guard<std::mutex> locker(m_mutex);
+
+				header current;
+				std::memcpy(&current, encoded, sizeof(header));
+				size_t table_size = sizeof(header) + (static_cast<size_t>(current.chunk_count) * sizeof(chunk_entry));
+				if (current.identifier != IDENTIFIER ||
+					encoded_size < sizeof(header) + static_cast<size_t>(current.encoded_size) ||
+					current.encoded_size < table_size - sizeof(header))
+					return false;
+
+				bool delta = ((current.flags & DELTA) != 0);
+				if (delta == true &&
+					(m_sequence != current.reference || m_previous.empty() == true || same_params(params, m_previous_params) == false))
+					return false;
+
+				const uint8_t* pos = encoded + table_size;
+				const uint8_t* end = encoded + sizeof(header) + current.encoded_size;
+				size_t offset = 0;
+				for (uint32_t i = 0; i < current.chunk_count; i++)
+				{
+					chunk_entry entry;
+					std::memcpy(&entry, encoded + sizeof(header) + (i * sizeof(chunk_entry)), sizeof(chunk_entry));
+					if (offset + entry.size > params.size || entry.stored_size > static_cast<size_t>(end - pos))
+						return false;
+
+					if (entry.stored_size == entry.size)
+						std::memcpy(output + offset, pos, entry.size);
+					else if (m_compression->decode(pos, entry.stored_size, output + offset, entry.size) == false)
+						return false;
+
+					offset += entry.size;
+					pos += entry.stored_size;
+				}
+
+				if (offset != params.size)
+					return false;
+
+				if (delta == true)
+				{
+					for (size_t i = 0; i < params.size; i++)
+						output[i] = static_cast<uint8_t>(output[i] + m_previous[i]);
+				}
+
+				m_sequence = current.sequence;
+				if ((current.flags & REFERENCED) != 0)
+				{
+					m_previous.assign(output, output + params.size);
+					m_previous_params = params;
+				}
+				else
+				{
+					m_previous.clear();
+				}
+
+				return true;
+			}
+		};
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace utils
+{
+	/// A bounded lock-free single producer, single consumer queue.
+	/// try_push may only be called by a single (producer) thread and try_pop by a single (consumer) thread.
+	template <typename T>
+	class spsc_queue
+	{
+	private:
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+
+		std::vector<T> m_items;
+		size_t m_mask;
+
+		// The producer and consumer indices are kept on separate cache lines to avoid false sharing
+		char m_head_padding[CACHE_LINE_SIZE];
+		std::atomic<size_t> m_head;
+		char m_tail_padding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+		std::atomic<size_t> m_tail;
+		char m_end_padding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+		static size_t round_capacity(size_t capacity)
+		{
+			if (capacity == 0)
+				throw std::invalid_argument("capacity");
+
+			size_t rounded = 1;
+			while (rounded < capacity)
+				rounded <<= 1;
+
+			return rounded;
+		}
+
+		spsc_queue(const spsc_queue&) = delete;
+		spsc_queue& operator=(const spsc_queue&) = delete;
+
+	public:
+		/// Constructor
+		/// @param	capacity	The maximum number of items, rounded up to a power of 2.
+		explicit spsc_queue(size_t capacity) :
+			m_items(round_capacity(capacity)),
+			m_mask(m_items.size() - 1),
+			m_head(0),
+			m_tail(0)
+		{
+		}
+
+		size_t capacity() const
+		{
+			return m_items.size();
+		}
+
+		/// Approximated when called while the queue is being used
+		size_t size() const
+		{
+			return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+		}
+
+		bool empty() const
+		{
+			return (size() == 0);
+		}
+
+		/// Producer side: returns false if the queue is full
+		bool try_push(const T& item)
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_head.load(std::memory_order_acquire) == m_items.size())
+				return false;
+
+			m_items[tail & m_mask] = item;
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// Consumer side: returns false if the queue is empty
+		bool try_pop(T& item)
+		{
+			size_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_tail.load(std::memory_order_acquire))
+				return false;
+
+			item = m_items[head & m_mask];
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// Consumer side: pops up to 'count' items, returns the number of popped items
+		size_t try_pop(T* items, size_t count)
+		{
+			size_t head = m_head.load(std::memory_order_relaxed);
+			size_t available = m_tail.load(std::memory_order_acquire) - head;
+			if (count > available)
+				count = available;
+
+			for (size_t i = 0; i < count; i++)
+				items[i] = m_items[(head + i) & m_mask];
+
+			m_head.store(head + count, std::memory_order_release);
+			return count;
+		}
+
+		/// Should be called only while both the producer and the consumer are idle
+		void clear()
+		{
+			m_head.store(0, std::memory_order_relaxed);
+			m_tail.store(0, std::memory_order_relaxed);
+		}
+	};
+}
@@ -6,6 +6,8 @@
 #include <utils/ref_count_ptr.hpp>
 #include <utils/dispatcher.hpp>
 #include <utils/buffer_allocator.hpp>
+#include <utils/frame_codec.hpp>
+#include <utils/video_statistics.hpp>
 
 #include <utils/thread_safe_object.hpp>
 
@@ -15,6 +17,7 @@
 #include <exception>
 #include <cstring>
 #include <cstddef>
+#include <memory>
 
 #if defined(__clang__)
 #	pragma clang diagnostic push
@@ -153,7 +156,9 @@ namespace utils
 		};
 
 		template <typename T>
-		class video_source_base : public video_controller_base<T>
+		class video_source_base :
+			public video_controller_base<T>,
+			public core::video::video_statistics_interface
 		{
 		private:
 			class callback_invoker :
@@ -163,12 +168,13 @@ namespace utils
 				utils::ref_count_ptr<core::video::frame_callback> m_callback;
 				utils::ref_count_ptr<utils::dispatcher> m_incvocation_thread;
 				std::atomic<size_t> m_pending_frames_count;				
+				utils::ref_count_ptr<video_statistics_collector> m_statistics;
 
 			public:
-				callback_invoker(core::video::frame_callback* callback, size_t max_pending_frames) :
+				callback_invoker(core::video::frame_callback* callback, size_t max_pending_frames, video_statistics_collector* statistics) :
 					m_callback(callback),
-					m_pending_frames_count(max_pending_frames)
-
+					m_pending_frames_count(max_pending_frames),
+					m_statistics(statistics)
 				{
 					if (callback == nullptr)
 						throw std::invalid_argument("callback");
@@ -179,6 +185,10 @@ namespace utils
 
 				void invoke(core::video::frame_interface* frame)
 				{
+					core::video::video_params video_params;
+					if (frame->query_video_params(video_params) == true)
+						m_statistics->add_latency(video_params, core::video::video_hop::DELIVER_HOP, true);
+
 					try
 					{
 						m_callback->on_frame(frame);
@@ -234,10 +244,17 @@ namespace utils
 			using frame_callbacks = std::vector<utils::ref_count_ptr<callback_invoker>>;
 			utils::thread_safe_object<frame_callbacks> m_frame_callbacks;
 			size_t m_max_pending_frames;
+			utils::ref_count_ptr<video_statistics_collector> m_statistics;
 
 		protected:
 			static constexpr size_t DEFAULT_MAX_PENDING_FRAMES = 10;
 
+			// The statistics of the frames raised, for derived sources to record their own hops
+			video_statistics_collector* statistics() const
+			{
+				return m_statistics;
+			}
+
 			uint32_t callback_count()
 			{
 				return m_frame_callbacks.template use<uint32_t>([](frame_callbacks& callbacks)
@@ -257,6 +274,7 @@ namespace utils
 				on_frame_raising(frame, cancel);
 				if (cancel == false)
 				{
+					m_statistics->add_frame();
 					m_frame_callbacks.use([&](frame_callbacks& callbacks)
 					{
 						if (async == true)
@@ -265,7 +283,8 @@ namespace utils
 							{
 								if (cb->invoke_async(frame) == false)
 								{
-									// TODO: virtually report to derived class (don't forget to supply the cb)
+									// Max pending invocations reached, the frame is dropped for this callback
+									m_statistics->add_dropped();
 								}
 							}
 						}
@@ -293,7 +312,8 @@ namespace utils
 
 		public:
 			video_source_base(size_t max_pending_frames = DEFAULT_MAX_PENDING_FRAMES) :
-				m_max_pending_frames(max_pending_frames)
+				m_max_pending_frames(max_pending_frames),
+				m_statistics(utils::make_ref_count_ptr<video_statistics_collector>())
 			{
 				if (max_pending_frames == 0)
 					throw std::invalid_argument("max_pending_frames");
@@ -306,6 +326,12 @@ namespace utils
 				sync_frame_callbacks();
 			}
 
+			virtual bool query_statistics(core::video::video_statistics& statistics) const override
+			{
+				m_statistics->query(statistics);
+				return true;
+			}
+
 			virtual bool add_frame_callback(core::video::frame_callback* callback) override
 			{
 				if (callback == nullptr)
@@ -323,7 +349,7 @@ namespace utils
 					if (it != callbacks.end())
 						return false;
 
-					callbacks.push_back(utils::make_ref_count_ptr<callback_invoker>(callback, m_max_pending_frames));
+					callbacks.push_back(utils::make_ref_count_ptr<callback_invoker>(callback, m_max_pending_frames, m_statistics));
 					return true;
 				});
 			}
@@ -422,9 +448,15 @@ namespace utils
 			}
 		};
 
+		/// Serializes a frame as its parameters, a data offset and its data.
+		/// With a frame_codec the data is encoded and the COMPRESSED flag is set in the data offset, a serializer given a
+		/// codec decodes such frames (and reads uncompressed ones as usual).
 		class frame_binary_serializer :
 			public core::serializable_interface
 		{
+		public:
+			static constexpr uint32_t COMPRESSED = 0x80000000;
+
 		private:
 			class frame : public frame_base<core::video::frame_interface>
 			{
@@ -448,17 +480,57 @@ namespace utils
 			utils::ref_count_ptr<core::video::frame_interface> m_frame;
 			utils::ref_count_ptr<core::buffer_allocator> m_buffer_allocator;
 			uint32_t m_data_alignment;
+			utils::ref_count_ptr<frame_codec> m_codec;
+			bool m_referenced; // The data of the frame is in the buffer it was deserialized from
+
+			// The buffer of the previous frame is reused when nobody else holds the frame or the buffer
+			bool allocate(uint32_t size, core::buffer_interface** buffer)
+			{
+				utils::ref_count_ptr<core::buffer_interface> instance;
+				if (m_frame != nullptr)
+				{
+					if (m_referenced == true ||
+						m_frame->ref_count() > 1 ||
+						m_frame->query_buffer(&instance) == false ||
+						instance->ref_count() > 2 ||
+						instance->size() < static_cast<size_t>(size))
+						instance = nullptr;
+
+					m_frame.release();
+				}
+
+				if (instance == nullptr)
+				{
+					if (m_buffer_allocator != nullptr)
+					{
+						if (m_buffer_allocator->allocate(size, &instance) == false)
+							return false;
+					}
+					else
+					{
+						instance = utils::make_ref_count_ptr<utils::ref_count_buffer>(size);
+					}
+				}
+
+				*buffer = instance;
+				(*buffer)->add_ref();
+				return true;
+			}
 
 		public:
-			frame_binary_serializer(core::video::frame_interface* frame, uint32_t data_alignment = 0) :
+			frame_binary_serializer(core::video::frame_interface* frame, uint32_t data_alignment = 0, frame_codec* codec = nullptr) :
 				m_frame(frame),
-				m_data_alignment(data_alignment)
+				m_data_alignment(data_alignment),
+				m_codec(codec),
+				m_referenced(false)
 			{
 			}
 
-			frame_binary_serializer(core::buffer_allocator* buffer_allocator, uint32_t data_alignment = 0) :
+			frame_binary_serializer(core::buffer_allocator* buffer_allocator, uint32_t data_alignment = 0, frame_codec* codec = nullptr) :
 				m_buffer_allocator(buffer_allocator),
-				m_data_alignment(data_alignment)
+				m_data_alignment(data_alignment),
+				m_codec(codec),
+				m_referenced(false)
 			{
 			}
 
@@ -495,7 +567,8 @@ namespace utils
 				if (m_frame->query_video_params(video_params) == false)
 					return 0;
 
-				return (sizeof(core::imaging::image_params) + sizeof(core::video::display_params) + sizeof(core::video::video_params) + sizeof(uint32_t) + m_data_alignment + image_params.size);
+				uint64_t data_size = (m_codec != nullptr) ? m_codec->max_encoded_size(image_params) : image_params.size;
+				return (sizeof(core::imaging::image_params) + sizeof(core::video::display_params) + sizeof(core::video::video_params) + sizeof(uint32_t) + m_data_alignment + data_size);
 			}
 
 			virtual bool serialize(core::stream_interface& stream) const override
@@ -528,12 +601,24 @@ namespace utils
 				if (stream.write_object<core::video::video_params>(video_params) != core::stream_status::status_no_error)
 					return false;
 
-				if (stream.write_object<uint32_t>(0) != core::stream_status::status_no_error)
+				if (stream.write_object<uint32_t>((m_codec != nullptr) ? COMPRESSED : 0) != core::stream_status::status_no_error)
 					return false;
 
+				const uint8_t* data = buffer->data();
+				size_t data_size = image_params.size;
+				std::vector<uint8_t> encoded;
+				if (m_codec != nullptr)
+				{
+					encoded.resize(m_codec->max_encoded_size(image_params));
+					if (m_codec->encode(image_params, buffer->data(), encoded.data(), encoded.size(), data_size) == false)
+						return false;
+
+					data = encoded.data();
+				}
+
 				size_t bytes_written = 0;
-				if (stream.write_bytes(buffer->data(), image_params.size, bytes_written) != core::stream_status::status_no_error ||
-					bytes_written != image_params.size)
+				if (stream.write_bytes(data, data_size, bytes_written) != core::stream_status::status_no_error ||
+					bytes_written != data_size)
 					return false;
 
 				return true;
@@ -562,6 +647,7 @@ namespace utils
 
 				pos += sizeof(core::imaging::image_params);
 
+				// An encoded frame is checked against the buffer as it is encoded
 				uint32_t data_size = image_params->size;
 				if (buffer_size <
 					(sizeof(core::imaging::image_params) +
@@ -569,7 +655,7 @@ namespace utils
 						sizeof(core::video::video_params) +
 						sizeof(uint32_t) +
 						m_data_alignment +
-						data_size))
+						((m_codec != nullptr) ? frame_codec::header_size() : data_size)))
 					return false;
 
 				core::video::display_params* display_params = reinterpret_cast<core::video::display_params*>(pos);
@@ -595,9 +681,16 @@ namespace utils
 				}
 
 				uint32_t data_offset = static_cast<uint32_t>((static_cast<uint8_t*>(aligned_ptr) - static_cast<uint8_t*>(unaligned_ptr)));
-				*(reinterpret_cast<uint32_t*>(pos)) = data_offset;
+				*(reinterpret_cast<uint32_t*>(pos)) = (m_codec != nullptr) ? (data_offset | COMPRESSED) : data_offset;
 				pos += (sizeof(uint32_t) + data_offset);
 
+				if (m_codec != nullptr)
+				{
+					size_t encoded_size;
+					return m_codec->encode(*image_params, data_buffer->data(), pos,
+						static_cast<size_t>((buffer->data() + buffer_size) - pos), encoded_size);
+				}
+
 				std::memcpy(pos, data_buffer->data(), data_size);
 				return true;
 			}
@@ -622,39 +715,90 @@ namespace utils
 				if (stream.read_object<uint32_t>(offset) != core::stream_status::status_no_error)
 					return false;
 
+				bool compressed = ((offset & COMPRESSED) != 0);
+				offset &= ~COMPRESSED;
+				if (compressed == true && m_codec == nullptr)
+					return false;
+
 				if (offset > 0)
 					stream.set_position(offset, core::stream_interface::relative_position::current);
 
 				utils::ref_count_ptr<core::buffer_interface> buffer;
-				if (m_frame != nullptr)
+				if (allocate(image_params.size, &buffer) == false)
+					return false;
+
+				size_t bytes_read = 0;
+				if (compressed == true)
 				{
-					if (m_frame->query_buffer(&buffer) == false ||
-						buffer->ref_count() > 2 ||
-						buffer->size() < static_cast<size_t>(image_params.size))
-						buffer = nullptr;
+					// The header of the encoded frame tells its size
+					std::vector<uint8_t> encoded(frame_codec::header_size());
+					size_t encoded_size = 0;
+					if (stream.read_bytes(encoded.data(), encoded.size(), bytes_read) != core::stream_status::status_no_error ||
+						bytes_read != encoded.size() ||
+						frame_codec::read_encoded_size(encoded.data(), encoded.size(), encoded_size) == false)
+						return false;
 
-					m_frame.release();
+					encoded.resize(encoded_size);
+					size_t remaining = encoded_size - frame_codec::header_size();
+					if (stream.read_bytes(encoded.data() + frame_codec::header_size(), remaining, bytes_read) != core::stream_status::status_no_error ||
+						bytes_read != remaining ||
+						m_codec->decode(image_params, encoded.data(), encoded.size(), buffer->data()) == false)
+						return false;
 				}
+				else if (stream.read_bytes(buffer->data(), image_params.size, bytes_read) != core::stream_status::status_no_error ||
+					bytes_read != image_params.size)
+					return false;
 
-				if (buffer == nullptr)
+				m_frame = utils::make_ref_count_ptr<frame>(image_params, display_params, video_params, buffer);
+				m_referenced = false;
+				return true;
+			}
+
+			// Reads a frame serialized in a buffer: uncompressed data is referenced in the buffer, compressed data is decoded
+			virtual bool deserialize(core::buffer_interface* buffer)
+			{
+				static constexpr size_t HEADER_SIZE = sizeof(core::imaging::image_params) + sizeof(core::video::display_params) +
+					sizeof(core::video::video_params) + sizeof(uint32_t);
+
+				if (buffer == nullptr || buffer->size() < HEADER_SIZE)
+					return false;
+
+				core::imaging::image_params image_params;
+				core::video::display_params display_params;
+				core::video::video_params video_params;
+				uint32_t offset;
+
+				const uint8_t* pos = buffer->data();
+				std::memcpy(&image_params, pos, sizeof(core::imaging::image_params));
+				pos += sizeof(core::imaging::image_params);
+				std::memcpy(&display_params, pos, sizeof(core::video::display_params));
+				pos += sizeof(core::video::display_params);
+				std::memcpy(&video_params, pos, sizeof(core::video::video_params));
+				pos += sizeof(core::video::video_params);
+				std::memcpy(&offset, pos, sizeof(uint32_t));
+
+				bool compressed = ((offset & COMPRESSED) != 0);
+				size_t data_offset = HEADER_SIZE + (offset & ~COMPRESSED);
+				if (image_params.size == 0 || data_offset > buffer->size() || (compressed == true && m_codec == nullptr))
+					return false;
+
+				utils::ref_count_ptr<core::buffer_interface> data;
+				if (compressed == true)
 				{
-					if (m_buffer_allocator != nullptr)
-					{
-						if (m_buffer_allocator->allocate(image_params.size, &buffer) == false)
-							return false;
-					}
-					else
-					{
-						buffer = utils::make_ref_count_ptr<utils::ref_count_buffer>(image_params.size);
-					}
+					if (allocate(image_params.size, &data) == false ||
+						m_codec->decode(image_params, buffer->data() + data_offset, buffer->size() - data_offset, data->data()) == false)
+						return false;
 				}
+				else
+				{
+					if (data_offset + image_params.size > buffer->size())
+						return false;
 
-				size_t bytes_read = 0;
-				if (stream.read_bytes(buffer->data(), image_params.size, bytes_read) != core::stream_status::status_no_error ||
-					bytes_read != image_params.size)
-					return false;
+					data = utils::make_ref_count_ptr<utils::ref_count_relative_buffer>(buffer, data_offset, image_params.size);
+				}
 
-				m_frame = utils::make_ref_count_ptr<frame>(image_params, display_params, video_params, buffer);
+				m_frame = utils::make_ref_count_ptr<frame>(image_params, display_params, video_params, data);
+				m_referenced = (compressed == false);
 				return true;
 			}
 		};
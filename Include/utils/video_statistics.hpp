@@ -0,0 +1,148 @@
+#pragma once
+#include <core/video.h>
+
+#include <utils/ref_count_base.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+
+namespace utils
+{
+	namespace video
+	{
+		/// The monotonic time frames are stamped with at each core::video::video_hop, in nanoseconds.
+		/// steady_clock is CLOCK_MONOTONIC on Linux, stamps taken by different processes of a machine compare.
+		/// @date	19/10/2026
+		inline uint64_t monotonic_now()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		/// Stamps video parameters with the time a frame passed a hop
+		/// @date	19/10/2026
+		inline void stamp(core::video::video_params& video_params, core::video::video_hop hop, uint64_t time = monotonic_now())
+		{
+			video_params.timestamps[hop] = time;
+		}
+
+		/// The latency in microseconds under which 'ratio' (e.g. 0.99) of the latencies of a histogram are, rounded up to their bucket
+		/// @date	19/10/2026
+		inline uint64_t latency_percentile(const core::video::latency_histogram& histogram, double ratio)
+		{
+			if (histogram.count == 0)
+				return 0;
+
+			uint64_t target = static_cast<uint64_t>(std::ceil(ratio * static_cast<double>(histogram.count)));
+			uint64_t seen = 0;
+			for (uint32_t i = 0; i < core::video::LATENCY_BUCKETS - 1; i++)
+			{
+				seen += histogram.buckets[i];
+				if (seen >= target)
+					return (std::min)((uint64_t(1) << (i + 1)) - 1, histogram.max);
+			}
+
+			return histogram.max;
+		}
+
+		/// Aggregates the statistics of a video stream as frames pass a source or a publisher, for
+		/// core::video::video_statistics_interface implementations. Thread safe.
+		/// @date	19/10/2026
+		class video_statistics_collector :
+			public utils::ref_count_base<core::ref_count_interface>
+		{
+		private:
+			static constexpr uint64_t FPS_WINDOW = 1000000000; // 1 second
+
+			mutable std::mutex m_mutex;
+			core::video::video_statistics m_statistics;
+			uint64_t m_window_start;
+			uint64_t m_window_frames;
+
+			static void add(core::video::latency_histogram& histogram, uint64_t from, uint64_t to)
+			{
+				uint64_t latency = (to > from) ? (to - from) / 1000 : 0;
+
+				uint32_t bucket = 0;
+				for (uint64_t value = latency + 1; value > 1 && bucket < core::video::LATENCY_BUCKETS - 1; value >>= 1)
+					bucket++;
+
+				histogram.count++;
+				histogram.total += latency;
+				histogram.max = (std::max)(histogram.max, latency);
+				histogram.buckets[bucket]++;
+			}
+
+		public:
+			video_statistics_collector() :
+				m_statistics({}),
+				m_window_start(0),
+				m_window_frames(0)
+			{
+			}
+
+			// Counts a frame passing at 'time'
+			void add_frame(uint64_t time = monotonic_now())
+			{
+				std::lock_guard<std::mutex> locker(m_mutex);
+				m_statistics.frames++;
+
+				if (m_window_start == 0)
+					m_window_start = time;
+
+				m_window_frames++;
+				if (time - m_window_start >= FPS_WINDOW)
+				{
+					m_statistics.fps = static_cast<double>(m_window_frames) * 1e9 / static_cast<double>(time - m_window_start);
+					m_window_start = time;
+					m_window_frames = 0;
+				}
+			}
+
+			// Records a frame reaching 'hop' at 'time': the latency from the last hop it was stamped at before it and,
+			// when 'end_to_end', the latency from its capture
+			void add_latency(const core::video::video_params& video_params, core::video::video_hop hop, bool end_to_end, uint64_t time = monotonic_now())
+			{
+				std::lock_guard<std::mutex> locker(m_mutex);
+				for (int previous = static_cast<int>(hop) - 1; previous >= 0; previous--)
+				{
+					if (video_params.timestamps[previous] != 0)
+					{
+						add(m_statistics.hops[hop], video_params.timestamps[previous], time);
+						break;
+					}
+				}
+
+				if (end_to_end == true && hop != core::video::video_hop::CAPTURE_HOP && video_params.timestamps[core::video::video_hop::CAPTURE_HOP] != 0)
+					add(m_statistics.end_to_end, video_params.timestamps[core::video::video_hop::CAPTURE_HOP], time);
+			}
+
+			void add_dropped(uint64_t count = 1)
+			{
+				std::lock_guard<std::mutex> locker(m_mutex);
+				m_statistics.dropped += count;
+			}
+
+			void add_copied(uint64_t bytes)
+			{
+				std::lock_guard<std::mutex> locker(m_mutex);
+				m_statistics.copied_bytes += bytes;
+			}
+
+			void query(core::video::video_statistics& statistics) const
+			{
+				uint64_t time = monotonic_now();
+
+				std::lock_guard<std::mutex> locker(m_mutex);
+				statistics = m_statistics;
+
+				// Until a window completes, or once frames stop coming, the rate of the current window
+				uint64_t elapsed = time - m_window_start;
+				if (m_window_start != 0 && elapsed != 0 && (statistics.fps == 0 || elapsed >= 2 * FPS_WINDOW))
+					statistics.fps = static_cast<double>(m_window_frames) * 1e9 / static_cast<double>(elapsed);
+			}
+		};
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include <core/framework.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils
+{
+	/// A pool of worker threads running the tasks of a job in parallel (e.g. the row bands of an image).
+	/// The thread which runs a job works on its tasks as well and returns once all of them completed, so a pool without
+	/// workers runs jobs serially. Jobs of several threads share the workers, in the order they were run.
+	/// @date	19/10/2026
+	class worker_pool
+	{
+	private:
+		struct job
+		{
+			const std::function<void(size_t)>* task;
+			size_t count;
+			std::atomic<size_t> next;
+			std::atomic<size_t> done;
+			std::mutex mutex;
+			std::condition_variable completed;
+			std::exception_ptr error;
+
+			job(const std::function<void(size_t)>& job_task, size_t tasks_count) :
+				task(&job_task),
+				count(tasks_count),
+				next(0),
+				done(0)
+			{
+			}
+		};
+
+		std::vector<std::thread> m_workers;
+		std::deque<std::shared_ptr<job>> m_jobs;
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		bool m_stop;
+
+		worker_pool(const worker_pool&) = delete;
+		worker_pool& operator=(const worker_pool&) = delete;
+
+		// Claims and runs tasks of a job until none is left
+		static void work(job& current)
+		{
+			for (size_t i = current.next++; i < current.count; i = current.next++)
+			{
+				try
+				{
+					(*current.task)(i);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> locker(current.mutex);
+					if (current.error == nullptr)
+						current.error = std::current_exception();
+				}
+
+				if (++current.done == current.count)
+				{
+					std::lock_guard<std::mutex> locker(current.mutex);
+					current.completed.notify_all();
+				}
+			}
+		}
+
+		void worker()
+		{
+			std::unique_lock<std::mutex> locker(m_mutex);
+			while (true)
+			{
+				m_wake.wait(locker, [this]() { return m_stop || m_jobs.empty() == false; });
+				if (m_stop)
+					return;
+
+				std::shared_ptr<job> current = m_jobs.front();
+				if (current->next >= current->count)
+				{
+					m_jobs.pop_front();
+					continue;
+				}
+
+				locker.unlock();
+				work(*current);
+				locker.lock();
+			}
+		}
+
+	public:
+		/// Constructor
+		/// @date	19/10/2026
+		/// @param	workers	The number of worker threads, besides the threads running jobs.
+		explicit worker_pool(size_t workers = 0) :
+			m_stop(false)
+		{
+			reserve(workers);
+		}
+
+		~worker_pool()
+		{
+			{
+				std::lock_guard<std::mutex> locker(m_mutex);
+				m_stop = true;
+			}
+
+			m_wake.notify_all();
+			for (std::thread& current : m_workers)
+				current.join();
+		}
+
+		/// The pool shared by the modules of the process, it has no workers until one reserves them.
+		/// A single instance is owned by ezframework, the modules using it link with ezframework.
+		static worker_pool& shared()
+		{
+			return core::framework::shared_worker_pool();
+		}
+
+		size_t workers()
+		{
+			std::lock_guard<std::mutex> locker(m_mutex);
+			return m_workers.size();
+		}
+
+		/// Adds workers up to the given number, a pool never shrinks
+		/// @date	19/10/2026
+		/// @param	workers	The number of worker threads.
+		void reserve(size_t workers)
+		{
+			std::lock_guard<std::mutex> locker(m_mutex);
+			while (m_workers.size() < workers)
+				m_workers.emplace_back(&worker_pool::worker, this);
+		}
+
+		/// Runs the tasks of a job in parallel and waits for all of them to complete
+		/// @date	19/10/2026
+		/// @exception	Rethrows the first exception thrown by a task, after all of the tasks completed.
+		/// @param	count	The number of tasks.
+		/// @param	task 	The task, called with the index of the task.
+		void run(size_t count, const std::function<void(size_t)>& task)
+		{
+			if (count == 0)
+				return;
+
+			std::shared_ptr<job> current = std::make_shared<job>(task, count);
+			if (count > 1)
+			{
+				std::lock_guard<std::mutex> locker(m_mutex);
+				if (m_workers.empty() == false)
+					m_jobs.push_back(current);
+			}
+
+			m_wake.notify_all();
+			work(*current);
+			{
+				std::unique_lock<std::mutex> locker(current->mutex);
+				current->completed.wait(locker, [&current]() { return current->done == current->count; });
+			}
+
+			{
+				std::lock_guard<std::mutex> locker(m_mutex);
+				m_jobs.erase(std::remove(m_jobs.begin(), m_jobs.end(), current), m_jobs.end());
+			}
+
+			if (current->error != nullptr)
+				std::rethrow_exception(current->error);
+		}
+	};
+}
@@ -0,0 +1,73 @@
+/// @file	publishers/shared_memory_frame_allocator.h.
+/// @brief	Declares the shared memory frame allocator class
+#pragma once
+#include <core/buffer_interface.h>
+
+namespace video
+{
+	namespace publishers
+	{
+		/// @class	shared_memory_frame_allocator
+		/// @brief	Allocates frame buffers directly in the shared memory segment of a video.
+		/// 		Frames made of these buffers are published by a shared_memory_video_publisher created with this allocator
+		/// 		without copying their data: only the frame parameters are written in front of the buffer. Any frame
+		/// 		producer which accepts a core::buffer_allocator (video sources, image algorithms, frame messages) can
+		/// 		fill them, frames from other buffers are still copied.
+		/// 		A buffer stays reserved for its frame until the last reference to it is released, so at most
+		/// 		'buffer_pool_size' frames can be alive at once.
+		/// @date	19/10/2026
+		class DLL_EXPORT shared_memory_frame_allocator :
+			public core::buffer_allocator
+		{
+		public:
+			/// @fn	virtual shared_memory_frame_allocator::~shared_memory_frame_allocator() = default;
+			/// @brief	Destructor
+			/// @date	19/10/2026
+			virtual ~shared_memory_frame_allocator() = default;
+
+			/// @fn	virtual size_t shared_memory_frame_allocator::max_buffer_size() const = 0;
+			/// @brief	The largest frame data buffer which can be allocated
+			/// @date	19/10/2026
+			/// @return	The buffer size of the pool less the frame parameters and the data alignment.
+			virtual size_t max_buffer_size() const = 0;
+
+			/// @fn	virtual bool shared_memory_frame_allocator::enable_compression(bool per_tile, uint32_t keyframe_interval, uint32_t acceleration) = 0;
+			/// @brief	Compresses the frames published from now on with LZ4 (see utils::video::frame_codec), subscribers decode them.
+			/// 		Compressed frames are copied into the shared memory, including the frames allocated here.
+			/// @date	19/10/2026
+			/// @param	per_tile		 	True to compress bands of 64 rows of each plane separately, false for whole planes.
+			/// @param	keyframe_interval	Every how many frames a frame is compressed on its own, the frames in between are compressed
+			/// 							as their difference to the previous frame. 0 or 1 to compress every frame on its own.
+			/// 							Subscribers which miss a frame (e.g. falling behind) skip the frames until the next keyframe.
+			/// @param	acceleration	 	The LZ4 acceleration, 1 for the best ratio, higher values compress faster.
+			/// @return	True if it succeeds, false if the library was built without LZ4.
+			virtual bool enable_compression(bool per_tile, uint32_t keyframe_interval, uint32_t acceleration = 1) = 0;
+
+			/// @fn	virtual bool shared_memory_frame_allocator::enable_backpressure(uint32_t timeout_ms) = 0;
+			/// @brief	Makes allocating and publishing wait for LOSSLESS readers (see shared_memory::reader_policy) when every
+			/// 		buffer of the pool holds a publication one of them did not read yet, instead of dropping the frame.
+			/// 		Off by default: the publisher never waits for its subscribers.
+			/// @date	19/10/2026
+			/// @param	timeout_ms	How long to wait for a reader to release a buffer before dropping the frame, 0 to never wait.
+			/// @return	True if it succeeds, false if the allocator does not publish lock-free (readers have no policy then).
+			virtual bool enable_backpressure(uint32_t timeout_ms) = 0;
+
+			/// @fn	static bool shared_memory_frame_allocator::create(const char* video_name, uint32_t buffer_size, uint32_t buffer_pool_size, bool lock_free, shared_memory_frame_allocator** allocator);
+			/// @brief	Static factory: Creates the shared memory segment of a video and an allocator of its frame buffers
+			/// @date	19/10/2026
+			/// @param 		   	video_name			The name of the video (Also the name of the shared memory segment)
+			/// @param 		   	buffer_size			The memory size to be allocated for each frame.
+			/// 									Note that it's required to set this number to at least 128 bytes bigger than the actual frame data size.
+			/// @param 		   	buffer_pool_size	The number of frame buffers to allocate as the publishing pool.
+			/// @param 		   	lock_free			True to publish lock-free, false for the interprocess mutexes.
+			/// @param [out]	allocator			An address of a pointer to video::publishers::shared_memory_frame_allocator
+			/// @return	True if it succeeds, false if it fails.
+			static bool create(
+				const char* video_name,
+				uint32_t buffer_size,
+				uint32_t buffer_pool_size,
+				bool lock_free,
+				shared_memory_frame_allocator** allocator);
+		};
+	}
+}
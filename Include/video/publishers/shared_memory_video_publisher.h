@@ -2,6 +2,7 @@
 /// @brief	Declares the shared memory video publisher class
 #pragma once
 #include <core/video.h>
+#include <video/publishers/shared_memory_frame_allocator.h>
 
 namespace video
 {
@@ -32,6 +33,27 @@ namespace video
 				core::video::video_source_interface* source,
 				core::video::video_publisher_interface** publisher);
 
+			/// @fn	static bool shared_memory_video_publisher::create(const char* video_name, core::video::video_source_interface* source, uint32_t buffer_size, uint32_t buffer_pool_size, bool lock_free, core::video::video_publisher_interface** publisher);
+			/// @brief	Static factory: Creates a new shared memory video publisher instance, choosing how frames are published.
+			/// 		Lock-free publishing hands frames to subscribers through atomic slots and futex wakeups instead of
+			/// 		interprocess mutexes: the publisher never waits for a subscriber, a frame is dropped when every
+			/// 		buffer is still held by subscribers. Subscribers detect the mode by themselves.
+			/// @date	19/10/2026
+			/// @param 		   	video_name			The name of the video (Also the name of the shared memory segment)
+			/// @param 		   	source				The video source to be published.
+			/// @param 		   	buffer_size			The memory size to be allocated for each frame.
+			/// @param 		   	buffer_pool_size	The number of frame buffers to allocate as the publishing pool.
+			/// @param 		   	lock_free			True to publish lock-free, false for the interprocess mutexes.
+			/// @param [out]	publisher			An address of a pointer to core::video::video_publisher_interface
+			/// @return	True if it succeeds, false if it fails.
+			static bool create(
+				const char* video_name,
+				core::video::video_source_interface* source,
+				uint32_t buffer_size,
+				uint32_t buffer_pool_size,
+				bool lock_free,
+				core::video::video_publisher_interface** publisher);
+
 			/// @fn	static bool shared_memory_video_publisher::create(const char* video_name, const core::video::video_source_factory_interface* source_factory, uint32_t buffer_size, uint32_t buffer_pool_size, core::video::video_publisher_interface** publisher);
 			/// @brief	Static factory: Creates a new shared memory video publisher instance
 			/// @date	15/05/2018
@@ -64,6 +86,37 @@ namespace video
 				const char* video_name,
 				const core::video::video_source_factory_interface* source_factory,
 				core::video::video_publisher_interface** publisher);
+
+			/// @fn	static bool shared_memory_video_publisher::create(const char* video_name, const core::video::video_source_factory_interface* source_factory, uint32_t buffer_size, uint32_t buffer_pool_size, bool lock_free, core::video::video_publisher_interface** publisher);
+			/// @brief	Static factory: Creates a new shared memory video publisher instance, choosing how frames are published.
+			/// @date	19/10/2026
+			/// @param 		   	video_name			The name of the video (Also the name of the shared memory segment)
+			/// @param 		   	source_factory  	The factory which creates the video source to be published.
+			/// @param 		   	buffer_size			The memory size to be allocated for each frame.
+			/// @param 		   	buffer_pool_size	The number of frame buffers to allocate as the publishing pool.
+			/// @param 		   	lock_free			True to publish lock-free, false for the interprocess mutexes.
+			/// @param [out]	publisher			An address of a pointer to core::video::video_publisher_interface
+			/// @return	True if it succeeds, false if it fails.
+			static bool create(
+				const char* video_name,
+				const core::video::video_source_factory_interface* source_factory,
+				uint32_t buffer_size,
+				uint32_t buffer_pool_size,
+				bool lock_free,
+				core::video::video_publisher_interface** publisher);
+
+			/// @fn	static bool shared_memory_video_publisher::create(video::publishers::shared_memory_frame_allocator* allocator, core::video::video_source_interface* source, core::video::video_publisher_interface** publisher);
+			/// @brief	Static factory: Creates a new shared memory video publisher instance on the shared memory of an allocator.
+			/// 		Frames whose buffer comes from the allocator are published without copying their data.
+			/// @date	19/10/2026
+			/// @param [in]		allocator	The allocator owning the shared memory segment (and its video name, pool and mode).
+			/// @param 		   	source		The video source to be published.
+			/// @param [out]	publisher	An address of a pointer to core::video::video_publisher_interface
+			/// @return	True if it succeeds, false if it fails.
+			static bool create(
+				video::publishers::shared_memory_frame_allocator* allocator,
+				core::video::video_source_interface* source,
+				core::video::video_publisher_interface** publisher);
 		};
 	}
 }
\ No newline at end of file
@@ -7,6 +7,11 @@
 #include <core/parser.h>
 
 #include <utils/parser.hpp>
+#include <utils/binary_accessor.hpp>
+#include <utils/endian_plan.hpp>
+#include <utils/binary_batch.hpp>
+#include <utils/binary_validation.hpp>
+#include <utils/binary_diff.hpp>
 #include <Buffers.hpp>
 
 #include <string>
@@ -19,6 +24,11 @@ namespace Parsers
 	using SimpleOptions = utils::parsers::simple_options;
 	using EnumDataItem = core::parsers::enum_data_item;
 	using JsonDetailsLevel = core::parsers::json_details_level;
+	using BinaryAccessor = core::parsers::binary_accessor;
+	using EndianPlan = utils::parsers::endian_plan;
+	using BatchReader = utils::parsers::batch_reader;
+	using ValidationTable = utils::parsers::validation_table;
+	using BinaryDiff = utils::parsers::binary_diff;
 	class BinaryParser;
 	
 	/// A binary meta data is helper class of BinaryParser that hold the schema of a data structure.
@@ -141,6 +151,45 @@ namespace Parsers
 
 		BinaryParser CreateParser() const;
 
+		/// Compiles a field path (e.g. "header.sensors[3].temp") into an accessor,
+		/// fields read through the accessor require no lookup
+		/// @date	19/10/2026
+		/// @exception	std::runtime_error	Raised when the path does not describe a simple, enum, string or bitmap field.
+		/// @param	path	The path of the field.
+		/// @return	The compiled accessor.
+		BinaryAccessor CompileAccessor(const char* path) const
+		{
+			ThrowOnEmpty("BinaryMetaData");
+
+			BinaryAccessor accessor;
+			if (false == m_core_object->compile_accessor(path, accessor))
+				throw std::runtime_error("compile_accessor failed");
+
+			return accessor;
+		}
+
+		/// Determines if the metadata is frozen (see BinaryMetaDataBuilder::Freeze)
+		/// @date	19/10/2026
+		/// @return	True if frozen, false if it is still built.
+		bool Frozen() const
+		{
+			ThrowOnEmpty("BinaryMetaData");
+
+			return m_core_object->frozen();
+		}
+
+		/// Validates a struct generated by BinaryParserCodeGen against this metadata
+		/// @date	19/10/2026
+		/// @tparam	T	The generated struct.
+		/// @return	True if the layout of the struct matches the metadata, false otherwise.
+		template <typename T>
+		bool ValidateStruct() const
+		{
+			ThrowOnEmpty("BinaryMetaData");
+
+			return T::validate_schema(m_core_object);
+		}
+
 		const char* ToJson(bool compact = true)
 		{
 			ThrowOnEmpty("BinaryMetaData");
@@ -352,6 +401,52 @@ namespace Parsers
 		
 			return m_core_object->add_enum(name, static_cast<core::parsers::enum_data_interface*>(metadata));
 		}
+
+		/// Saves the metadata and the enums of the store into a binary cache file
+		/// @date	19/10/2026
+		/// @param	fileName  	The name of the cache file.
+		/// @param	sourceHash	The content hash of the sources of the store (see HashFiles).
+		/// @return	True if it succeeds, false if it fails.
+		bool SaveCache(const char* fileName, uint64_t sourceHash)
+		{
+			ThrowOnEmpty("BinaryMetadataStore");
+			if (fileName == nullptr)
+				throw std::invalid_argument("fileName");
+
+			return m_core_object->save_cache(fileName, sourceHash);
+		}
+
+		/// Loads the metadata and the enums of a binary cache file into the store, without parsing the sources
+		/// @date	19/10/2026
+		/// @param	fileName  	The name of the cache file.
+		/// @param	sourceHash	The content hash of the current sources (see HashFiles).
+		/// @return	False if the cache is missing, invalid or stale - the store should then be built from the sources.
+		bool LoadCache(const char* fileName, uint64_t sourceHash)
+		{
+			ThrowOnEmpty("BinaryMetadataStore");
+			if (fileName == nullptr)
+				throw std::invalid_argument("fileName");
+
+			return m_core_object->load_cache(fileName, sourceHash);
+		}
+
+		/// Hashes the content of the source files of a store to key its cache
+		/// @date	19/10/2026
+		/// @exception	std::runtime_error	Raised when a file cannot be read.
+		/// @param	fileNames	The names of the source files.
+		/// @return	The content hash.
+		static uint64_t HashFiles(const std::vector<std::string>& fileNames)
+		{
+			std::vector<const char*> names;
+			for (const std::string& fileName : fileNames)
+				names.push_back(fileName.c_str());
+
+			uint64_t hash = 0;
+			if (false == parsers::binary_metadata_store::hash_files(names.data(), names.size(), hash))
+				throw std::runtime_error("Failed to hash the source files");
+
+			return hash;
+		}
 	};
 
 	/// A binary meta data builder extend BinaryMetaData with functions that allow creating the metadata structure.
@@ -448,6 +543,20 @@ namespace Parsers
 
 			return *this;
 		}
+
+		/// Freezes the metadata once it is built, together with its nested metadata.
+		/// The nodes of a frozen metadata are read without locks by every parser, further changes are rejected.
+		/// @date	19/10/2026
+		/// @exception	std::runtime_error	Raised when the metadata cannot be frozen.
+		/// @return	A reference to this object.
+		BinaryMetaDataBuilder& Freeze()
+		{
+			ThrowOnEmpty("BinaryMetaDataBuilder");
+			if (false == metadata()->freeze())
+				throw std::runtime_error("freeze failed");
+
+			return *this;
+		}
 		
 		BinaryMetaDataBuilder& Simple(const char* name, size_t size, TypeEnum type,const SimpleOptions& options)
 		{
@@ -1053,6 +1162,23 @@ namespace Parsers
 			return no_errors;
 		}
 
+		/// Writes the JSON into a caller supplied buffer without building a JSON document (as snprintf)
+		/// @date	19/10/2026
+		/// @param [out]	json		   	The buffer, null terminated when the JSON fits.
+		/// @param 			size		   	Size of the buffer.
+		/// @param 			detailsLevel   	(Optional) The enums details level.
+		/// @param 			compact		   	(Optional) True to compact.
+		/// @return	The length of the JSON, the buffer is too small when it is not smaller than size.
+		size_t WriteJson(char* json, size_t size, JsonDetailsLevel detailsLevel = JsonDetailsLevel::JSON_ENUM_VALUES, bool compact = true) const
+		{
+			ThrowOnEmpty("BinaryParser");
+			size_t length = 0;
+			bool no_errors = true;
+
+			m_core_object->write_json(json, size, detailsLevel, compact, length, no_errors);
+			return length;
+		}
+
 		/// Initializes this object from the given from JSON
 		/// the function will allow creating an object from json if fields are missing or there are extra fields
 		/// @date	03/10/2018
@@ -1068,6 +1194,20 @@ namespace Parsers
 			return m_core_object->from_json(json);
 		}
 
+		/// Initializes this object from a JSON object without building a JSON document, the values are written straight into the buffer
+		/// @date	19/10/2026
+		/// @param	json	The JSON.
+		/// @param	size	The size of the JSON.
+		/// @return	True if it succeeds, false if it fails (also on an invalid JSON).
+		bool FromJson(const char* json, size_t size)
+		{
+			ThrowOnEmpty("BinaryParser");
+			if (json == nullptr)
+				throw std::invalid_argument("json");
+
+			return m_core_object->from_json(json, size);
+		}
+
 		bool Validate(const char* fieldName) const
 		{
 			ThrowOnEmpty("BinaryParser");
@@ -1159,6 +1299,23 @@ namespace Parsers
 			return data;			
 		}
 
+		/// Reads a simple type from the parser through a compiled accessor
+		/// @date	19/10/2026
+		/// @exception	std::runtime_error	Raised when a runtime error condition occurs.
+		/// @tparam	T	Generic type parameter.
+		/// @param	accessor	The accessor compiled by the parser's metadata.
+		/// @return	The the value.
+		template <typename T>
+		T Read(const BinaryAccessor& accessor) const
+		{
+			ThrowOnEmpty("BinaryParser");
+			T data;
+			if (false == m_core_object->read_compiled(accessor, &data, sizeof(T)))
+				throw std::runtime_error("read_compiled");
+
+			return data;
+		}
+
 		/// eads a simple type from the parser
 		/// @date	10/10/2018
 		/// @exception	std::invalid_argument	Thrown when an invalid argument
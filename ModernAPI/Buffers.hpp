@@ -73,4 +73,30 @@ namespace Buffers
 		}
 		
 	};
+
+	class BufferAllocator :
+		public Common::CoreObjectWrapper<core::buffer_allocator>
+	{
+	public:
+		BufferAllocator()
+		{
+			// Empty BufferAllocator
+		}
+
+		BufferAllocator(core::buffer_allocator* allocator) :
+			CoreObjectWrapperBase(allocator)
+		{
+		}
+
+		Buffer Allocate(size_t size)
+		{
+			ThrowOnEmpty("Buffers::BufferAllocator");
+
+			utils::ref_count_ptr<core::buffer_interface> buffer;
+			if (m_core_object->allocate(size, &buffer) == false)
+				return Buffer(); // Empty Buffer
+
+			return Buffer(buffer);
+		}
+	};
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <Common.h>
 #include <Common.hpp>
+#include <Buffers.hpp>
 #include <Database.hpp>
 #include <Utils.hpp>
 
@@ -14,6 +15,8 @@ namespace Communication
 {
 	using CommStatus = core::communication::communication_status;
 	using CommError = core::communication::communication_error;
+	using ReceiveOverflowPolicy = utils::communication::receive_overflow_policy;
+	using ReceiveStatistics = utils::communication::receive_statistics;
 
 	class DataReader
 	{
@@ -41,6 +44,17 @@ namespace Communication
 			return m_reader.size();
 		}
 
+		/// Gets the ref-counted buffer holding the data, allowing to keep it beyond the callback without copying.
+		/// Empty unless the channel uses pooled receive buffers.
+		Buffers::Buffer UnderlyingBuffer() const
+		{
+			utils::ref_count_ptr<core::buffer_interface> buffer;
+			if (m_reader.query_buffer(&buffer) == false)
+				return Buffers::Buffer();
+
+			return Buffers::Buffer(buffer);
+		}
+
 		template <typename T>
 		void Read(T& val) const
 		{
@@ -384,6 +398,69 @@ namespace Communication
 			return m_core_object->send(buffer, size);
 		}
 
+		/// Packs subsequent sent messages into transport frames of up to maxFrameSize bytes.
+		/// The remote side must split messages by length (e.g. VariableLengthProtocol).
+		/// @date	19/10/2026
+		/// @param	maxFrameSize		   	The frame budget in bytes (e.g. MTU minus IP/UDP headers).
+		/// @param	flushThreshold		   	A pending frame is sent as soon as it reaches this size (0 means maxFrameSize).
+		/// @param	flushDeadlineMicroseconds	The maximal time a message may wait before its frame is sent.
+		/// @return	True if it succeeds, false if it fails.
+		bool EnableSendCoalescing(size_t maxFrameSize, size_t flushThreshold, uint64_t flushDeadlineMicroseconds)
+		{
+			ThrowOnEmpty("CommClientChannel");
+			return m_core_object->enable_send_coalescing(
+				maxFrameSize,
+				flushThreshold,
+				std::chrono::microseconds(static_cast<std::chrono::microseconds::rep>(flushDeadlineMicroseconds)));
+		}
+
+		void DisableSendCoalescing()
+		{
+			ThrowOnEmpty("CommClientChannel");
+			m_core_object->disable_send_coalescing();
+		}
+
+		bool Flush() const
+		{
+			ThrowOnEmpty("CommClientChannel");
+			return m_core_object->flush();
+		}
+
+		/// Reads each message into a buffer from a preallocated pool and raises OnData on a dispatcher thread.
+		/// Should be called while the channel is disconnected.
+		/// @date	19/10/2026
+		/// @param	poolSize	Number of preallocated receive buffers.
+		/// @param	policy  	What to do when all the buffers are in use (drop oldest, drop newest or block).
+		/// @return	True if it succeeds, false if it fails.
+		bool EnablePooledReceive(size_t poolSize, ReceiveOverflowPolicy policy)
+		{
+			ThrowOnEmpty("CommClientChannel");
+			return m_core_object->enable_pooled_receive(poolSize, policy);
+		}
+
+		bool EnablePooledReceive(size_t poolSize, ReceiveOverflowPolicy policy, const Utils::Context& context)
+		{
+			ThrowOnEmpty("CommClientChannel");
+			return m_core_object->enable_pooled_receive(poolSize, policy, static_cast<utils::dispatcher*>(context));
+		}
+
+		/// Raises OnData as soon as the channel's I/O backend completes a frame, without a receiving thread.
+		/// Requires a UDP or TCP port using the io_uring backend (not a protocol on top of it), its datagrams or stream reads are the frames.
+		/// Should be called while the channel is disconnected.
+		/// @date	19/10/2026
+		/// @return	True if it succeeds, false if the channel cannot deliver its frames directly.
+		bool EnableDirectReceive()
+		{
+			ThrowOnEmpty("CommClientChannel");
+			return m_core_object->enable_direct_receive();
+		}
+
+		ReceiveStatistics QueryReceiveStatistics() const
+		{
+			ThrowOnEmpty("CommClientChannel");
+			return m_core_object->query_receive_statistics();
+		}
+
 		DataReadSignal& OnData()
 		{
 			ThrowOnEmpty("CommClientChannel");
@@ -2369,6 +2369,7 @@ namespace Database
 			}
 			
 			parser.Namely(structInfo.structName.c_str());
+			parser.Freeze();
 			return std::move(parser);
 
 		}
@@ -2940,7 +2941,36 @@ namespace Database
 				Core::Console::ColorPrint(Core::Console::Colors::RED, "Failed to Load Schema - %s", e.what());
 				return false;
 			}
-		}		
+		}
+
+		/// Loads data base schema from a file, the parsers metadata are restored from a binary cache of the data set
+		/// instead of being built from it. A missing or stale cache is rebuilt after the schema was loaded.
+		/// @date	19/10/2026
+		/// @param [in]		dataset	   	The dataset.
+		/// @param 			dataSetPath	Full pathname of the data set file.
+		/// @param 			cachePath  	Full pathname of the metadata cache file.
+		/// @return	True if it succeeds, false if it fails.
+		static bool LoadCached(DataSet &dataset, const std::string& dataSetPath, const std::string& cachePath, bool verbose = false, bool setDefaultsOnLoad = true)
+		{
+			uint64_t sourceHash = 0;
+			const char* sourceName = dataSetPath.c_str();
+			if (false == parsers::binary_metadata_store::hash_files(&sourceName, 1, sourceHash))
+				return Load(dataset, dataSetPath, verbose, setDefaultsOnLoad);
+
+			//The schema reuses the metadata it finds in the default store
+			Parsers::BinaryMetadataStore store;
+			bool cached = store.LoadCache(cachePath.c_str(), sourceHash);
+			if (verbose)
+				Core::Console::ColorPrint(Core::Console::Colors::WHITE, "Metadata cache %s: %s\n", cachePath.c_str(), cached ? "loaded" : "rebuilt");
+
+			if (false == Load(dataset, dataSetPath, verbose, setDefaultsOnLoad))
+				return false;
+
+			if (false == cached)
+				store.SaveCache(cachePath.c_str(), sourceHash);
+
+			return true;
+		}
 	};	
 
 	class DataBinder : public Common::CoreObjectWrapper<utils::database::data_binder>
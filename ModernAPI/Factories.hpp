@@ -5,6 +5,7 @@
 #include <communication/ports/tcp_client_port.h>
 #include <communication/ports/udp_client_port.h>
 #include <communication/ports/tcp_server_port.h>
+#include <communication/ports/shm_port.h>
 #include <communication/protocols/delimiter_protocol.h>
 #include <communication/protocols/fixed_length_protocol.h>
 #include <communication/protocols/variable_length_protocol.h>
@@ -22,6 +23,8 @@
 #include <parsers/binary_parser.h>
 
 #include <imaging/image_utils.h>
+#include <imaging/image_converter.h>
+#include <imaging/image_pipeline.h>
 
 #include <video/sources/gstreamer_auto_source.h>
 #include <video/sources/gstreamer_file_source.h>
@@ -82,6 +85,27 @@ namespace Buffers
 		}
 	};
 
+	class PooledBufferAllocator :
+		public Common::NonConstructible
+	{
+	public:
+		/// Creates an allocator pooling its buffers per size, allocated buffers return to their pool once released
+		/// @date	19/10/2026
+		/// @param	maxMemoryPerSize	The memory of the pool of a size, in bytes.
+		/// @param	lazy				True to allocate the buffers of a pool when first used.
+		/// @return	The allocator.
+		static BufferAllocator Create(size_t maxMemoryPerSize, bool lazy = true)
+		{
+			if (maxMemoryPerSize == 0)
+				throw std::invalid_argument("maxMemoryPerSize");
+
+			utils::ref_count_ptr<core::buffer_allocator> instance =
+				utils::make_ref_count_ptr<utils::buffer_allocator>(maxMemoryPerSize, lazy);
+
+			return BufferAllocator(instance);
+		}
+	};
+
 	class SafeMemoryBuffer :
 		public Common::NonConstructible
 	{
@@ -150,6 +174,8 @@ namespace Communication
 {
 	namespace Ports
 	{
+		using IOBackend = communication::ports::io_backend;
+
 		/// A serial port factory.
 		///Non Constructible
 		/// @date	05/06/2018
@@ -220,13 +246,15 @@ namespace Communication
 			/// @param	localHostName 	Name of the local host.
 			/// @param	localPort	  	The local port.
 			/// @param	bNoDelaySend	True to cancel Nagel Algorithm that is batching messages to one packet
+			/// @param	backend			The I/O backend used to receive data.
 			/// @return	A ClientChannel.
 			static ::Communication::ClientChannel Create(
 				const char* remoteHostName,
 				uint16_t remotePort,
 				const char* localHostName,
 				uint16_t localPort,
-				bool bNoDelaySend = false)
+				bool bNoDelaySend = false,
+				IOBackend backend = IOBackend::blocking)
 			{
 				if (remoteHostName == nullptr)
 					throw std::invalid_argument("remoteHostName");
@@ -241,6 +269,7 @@ namespace Communication
 					localHostName,
 					localPort,
 					bNoDelaySend,
+					backend,
 					&instance) == false)
 					throw std::runtime_error("Failed to create TCP port");
 
@@ -302,6 +331,10 @@ namespace Communication
 			/// @param	remotePort	  	The remote port.
 			/// @param	localHostName 	Name of the local host.
 			/// @param	localPort	  	The local port.
+			/// @param	multicast	  	True to join the remote multicast group.
+			/// @param	receiveBufferSize	Size of the socket's receive buffer (0 for the system's default).
+			/// @param	sendBufferSize	Size of the socket's send buffer (0 for the system's default).
+			/// @param	backend			The I/O backend used to receive data.
 			/// @return	A ClientChannel.
 			static ::Communication::ClientChannel Create(
 				const char* remoteHostName,
@@ -310,7 +343,8 @@ namespace Communication
 				uint16_t localPort,
 				bool multicast = false,
 				int receiveBufferSize = 0,
-				int sendBufferSize = 0)
+				int sendBufferSize = 0,
+				IOBackend backend = IOBackend::blocking)
 			{
 				if (remoteHostName == nullptr)
 					throw std::invalid_argument("remoteHostName");
@@ -327,6 +361,7 @@ namespace Communication
 					multicast,
 					receiveBufferSize,
 					sendBufferSize,
+					backend,
 					&instance) == false)
 					throw std::runtime_error("Failed to create UDP port");
 
@@ -334,6 +369,52 @@ namespace Communication
 			}
 		};
 
+		/// A shared memory port Factory
+		///Non Constructible
+		/// @date	19/10/2026
+		class ShmPort :
+			public Common::NonConstructible
+		{
+		public:
+
+			/// Static constructor of a shared memory Client Channel, for peers of the same host.
+			/// The peer port is created with the names swapped.
+			///
+			/// @date	19/10/2026
+			///
+			/// @exception	std::invalid_argument	Thrown when localName or remoteName argument is null
+			/// @exception	std::runtime_error   	Raised when a creation fails
+			///
+			/// @param	localName 	Name of the ring this port receives from.
+			/// @param	remoteName	Name of the peer's ring this port sends to.
+			/// @param	capacity  	The receive ring size in bytes, messages are limited to half of it.
+			/// @param	stallTimeoutMs	How long a record without a known sender may block the receive ring before it is recreated, 0 waits forever.
+			/// @return	A ClientChannel.
+			static ::Communication::ClientChannel Create(
+				const char* localName,
+				const char* remoteName,
+				size_t capacity = 1024 * 1024,
+				uint32_t stallTimeoutMs = 1000)
+			{
+				if (localName == nullptr)
+					throw std::invalid_argument("localName");
+
+				if (remoteName == nullptr)
+					throw std::invalid_argument("remoteName");
+
+				utils::ref_count_ptr<core::communication::client_channel_interface> instance;
+				if (communication::ports::shm_port::create(
+					localName,
+					remoteName,
+					capacity,
+					stallTimeoutMs,
+					&instance) == false)
+					throw std::runtime_error("Failed to create shared memory port");
+
+				return ::Communication::ClientChannel(instance);
+			}
+		};
+
 		/// A TCP server port Factory.
 		///Non Constructible
 		/// @date	05/06/2018
@@ -805,15 +886,103 @@ namespace Imaging
 			uint32_t width,
 			uint32_t height,
 			float(&camera_matrix_chess)[3][3],
-			float(&distCoeffs_chess)[5])
+			float(&distCoeffs_chess)[5],
+			uint32_t threads = 1)
+		{
+			utils::ref_count_ptr<core::imaging::image_algorithm_interface> instance;
+			if (imaging::image_undistort::create(width, height, camera_matrix_chess, distCoeffs_chess, threads, nullptr, &instance) == false)
+				throw std::runtime_error("Failed to create Image Algorithm");
+
+			return Imaging::ImageAlgorithm(instance);
+		}
+
+		static Imaging::ImageAlgorithm Create(
+			uint32_t width,
+			uint32_t height,
+			float(&camera_matrix_chess)[3][3],
+			float(&distCoeffs_chess)[5],
+			const Buffers::BufferAllocator& allocator)
+		{
+			utils::ref_count_ptr<core::imaging::image_algorithm_interface> instance;
+			if (imaging::image_undistort::create(width, height, camera_matrix_chess, distCoeffs_chess,
+				static_cast<core::buffer_allocator*>(allocator), &instance) == false)
+				throw std::runtime_error("Failed to create Image Algorithm");
+
+			return Imaging::ImageAlgorithm(instance);
+		}
+
+		static Imaging::ImageAlgorithm Create(
+			uint32_t width,
+			uint32_t height,
+			float(&camera_matrix_chess)[3][3],
+			float(&distCoeffs_chess)[5],
+			uint32_t threads,
+			const Buffers::BufferAllocator& allocator)
 		{
 			utils::ref_count_ptr<core::imaging::image_algorithm_interface> instance;
-			if (imaging::image_undistort::create(width, height, camera_matrix_chess, distCoeffs_chess, &instance) == false)
+			if (imaging::image_undistort::create(width, height, camera_matrix_chess, distCoeffs_chess, threads,
+				static_cast<core::buffer_allocator*>(allocator), &instance) == false)
 				throw std::runtime_error("Failed to create Image Algorithm");
 
 			return Imaging::ImageAlgorithm(instance);
 		}
 	};
+
+	class ImageConverterAlgorithm :
+		public Common::NonConstructible
+	{
+	public:
+		static Imaging::ImageAlgorithm Create(
+			Imaging::PixelFormat format,
+			uint32_t width = 0,
+			uint32_t height = 0,
+			uint32_t threads = 1)
+		{
+			utils::ref_count_ptr<core::imaging::image_algorithm_interface> instance;
+			if (imaging::image_converter::create(format, width, height, threads, &instance) == false)
+				throw std::runtime_error("Failed to create Image Algorithm");
+
+			return Imaging::ImageAlgorithm(instance);
+		}
+
+		static Imaging::ImageAlgorithm Create(
+			Imaging::PixelFormat format,
+			uint32_t width,
+			uint32_t height,
+			uint32_t threads,
+			const Buffers::BufferAllocator& allocator)
+		{
+			utils::ref_count_ptr<core::imaging::image_algorithm_interface> instance;
+			if (imaging::image_converter::create(format, width, height, threads,
+				static_cast<core::buffer_allocator*>(allocator), &instance) == false)
+				throw std::runtime_error("Failed to create Image Algorithm");
+
+			return Imaging::ImageAlgorithm(instance);
+		}
+	};
+
+	class ImageProcessingPipeline :
+		public Common::NonConstructible
+	{
+	public:
+		static Imaging::ImagePipeline Create(uint32_t threads = 1)
+		{
+			utils::ref_count_ptr<imaging::image_pipeline> instance;
+			if (imaging::image_pipeline::create(threads, &instance) == false)
+				throw std::runtime_error("Failed to create Image Pipeline");
+
+			return Imaging::ImagePipeline(instance);
+		}
+
+		static Imaging::ImagePipeline Create(uint32_t threads, const Buffers::BufferAllocator& allocator)
+		{
+			utils::ref_count_ptr<imaging::image_pipeline> instance;
+			if (imaging::image_pipeline::create(threads, static_cast<core::buffer_allocator*>(allocator), &instance) == false)
+				throw std::runtime_error("Failed to create Image Pipeline");
+
+			return Imaging::ImagePipeline(instance);
+		}
+	};
 }
 
 namespace Video
@@ -1112,6 +1281,27 @@ namespace Video
 
 	namespace Publishers
 	{
+		class SharedMemoryFrameAllocator :
+			public Common::NonConstructible
+		{
+		public:
+			static constexpr uint32_t DEFAULT_VIDEO_BUFFER_SIZE = 10485760; // 10 MBs
+			static constexpr uint32_t DEFAULT_VIDEO_BUFFER_POOL_SIZE = 20;
+
+			static Video::FrameAllocator Create(
+				const char* name,
+				uint32_t buffer_size = DEFAULT_VIDEO_BUFFER_SIZE,
+				uint32_t buffer_pool_size = DEFAULT_VIDEO_BUFFER_POOL_SIZE,
+				bool lock_free = false)
+			{
+				utils::ref_count_ptr<video::publishers::shared_memory_frame_allocator> instance;
+				if (video::publishers::shared_memory_frame_allocator::create(name, buffer_size, buffer_pool_size, lock_free, &instance) == false)
+					throw std::runtime_error("Failed to create Frame Allocator");
+
+				return Video::FrameAllocator(instance);
+			}
+		};
+
 		class SharedMemoryVideoPublisher :
 			public Common::NonConstructible
 		{
@@ -1119,14 +1309,27 @@ namespace Video
 			static constexpr uint32_t DEFAULT_VIDEO_BUFFER_SIZE = 10485760; // 10 MBs
 			static constexpr uint32_t DEFAULT_VIDEO_BUFFER_POOL_SIZE = 20;
 
+			static Video::VideoPublisher Create(
+				const Video::FrameAllocator& allocator,
+				const Video::VideoSource source)
+			{
+				utils::ref_count_ptr<core::video::video_publisher_interface> instance;
+				if (video::publishers::shared_memory_video_publisher::create(static_cast<video::publishers::shared_memory_frame_allocator*>(allocator),
+					static_cast<core::video::video_source_interface*>(source), &instance) == false)
+					throw std::runtime_error("Failed to create Video Publisher");
+
+				return Video::VideoPublisher(instance);
+			}
+
 			static Video::VideoPublisher Create(
 				const char* name,
 				const Video::VideoSource source,
 				uint32_t buffer_size = DEFAULT_VIDEO_BUFFER_SIZE,
-				uint32_t buffer_pool_size = DEFAULT_VIDEO_BUFFER_POOL_SIZE)
+				uint32_t buffer_pool_size = DEFAULT_VIDEO_BUFFER_POOL_SIZE,
+				bool lock_free = false)
 			{
 				utils::ref_count_ptr<core::video::video_publisher_interface> instance;
-				if (video::publishers::shared_memory_video_publisher::create(name, static_cast<core::video::video_source_interface*>(source), buffer_size, buffer_pool_size, &instance) == false)
+				if (video::publishers::shared_memory_video_publisher::create(name, static_cast<core::video::video_source_interface*>(source), buffer_size, buffer_pool_size, lock_free, &instance) == false)
 					throw std::runtime_error("Failed to create Video Publisher");
 
 				return Video::VideoPublisher(instance);
@@ -1136,10 +1339,11 @@ namespace Video
 				const char* name,
 				const Video::VideoSourceFactory factory,
 				uint32_t buffer_size = DEFAULT_VIDEO_BUFFER_SIZE,
-				uint32_t buffer_pool_size = DEFAULT_VIDEO_BUFFER_POOL_SIZE)
+				uint32_t buffer_pool_size = DEFAULT_VIDEO_BUFFER_POOL_SIZE,
+				bool lock_free = false)
 			{
 				utils::ref_count_ptr<core::video::video_publisher_interface> instance;
-				if (video::publishers::shared_memory_video_publisher::create(name, static_cast<core::video::video_source_factory_interface*>(factory), buffer_size, buffer_pool_size, &instance) == false)
+				if (video::publishers::shared_memory_video_publisher::create(name, static_cast<core::video::video_source_factory_interface*>(factory), buffer_size, buffer_pool_size, lock_free, &instance) == false)
 					throw std::runtime_error("Failed to create Video Publisher");
 
 				return Video::VideoPublisher(instance);
@@ -1,8 +1,11 @@
 #pragma once
 #include <core/imaging.h>
+#include <imaging/image_pipeline.h>
 
 #include <Common.hpp>
 
+#include <vector>
+
 namespace Imaging
 {
 	using PixelFormat = core::imaging::pixel_format;
@@ -117,5 +120,128 @@ namespace Imaging
 
 			return Imaging::Image(output);
 		}
+
+		/// Applies the algorithm into an existing image (e.g. one applied before) instead of a new one
+		/// @date	19/10/2026
+		/// @param 		   	input 	The input image.
+		/// @param [in,out]	output	The output image, of the parameters Apply would have produced.
+		/// @return	True if it succeeds, false if it fails or the output image does not fit.
+		bool ApplyInto(const Imaging::Image& input, Imaging::Image& output)
+		{
+			ThrowOnEmpty("Imaging::ImageAlgorithm");
+			if (output.Empty() == true)
+				throw std::invalid_argument("output");
+
+			return m_core_object->apply_into(static_cast<core::imaging::image_interface*>(input),
+				static_cast<core::imaging::image_interface*>(output));
+		}
+	};
+
+	class ImagePipeline : public Common::CoreObjectWrapper<imaging::image_pipeline>
+	{
+	private:
+		std::vector<core::imaging::image_interface*> m_outputs;
+
+		static void ThrowOnFailure(bool succeeded)
+		{
+			if (succeeded == false)
+				throw std::runtime_error("Failed to add Image Pipeline stage");
+		}
+
+	public:
+		/// The node of the input images
+		static constexpr size_t INPUT_NODE = imaging::image_pipeline::INPUT_NODE;
+
+		ImagePipeline()
+		{
+			// Empty ImagePipeline
+		}
+
+		ImagePipeline(imaging::image_pipeline* pipeline) :
+			Common::CoreObjectWrapper<imaging::image_pipeline>(pipeline)
+		{
+		}
+
+		size_t AddConvert(size_t parent, Imaging::PixelFormat format)
+		{
+			ThrowOnEmpty("Imaging::ImagePipeline");
+
+			size_t node = 0;
+			ThrowOnFailure(m_core_object->add_convert(parent, format, node));
+			return node;
+		}
+
+		size_t AddCrop(size_t parent, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+		{
+			ThrowOnEmpty("Imaging::ImagePipeline");
+
+			size_t node = 0;
+			ThrowOnFailure(m_core_object->add_crop(parent, x, y, width, height, node));
+			return node;
+		}
+
+		size_t AddScale(size_t parent, uint32_t width, uint32_t height)
+		{
+			ThrowOnEmpty("Imaging::ImagePipeline");
+
+			size_t node = 0;
+			ThrowOnFailure(m_core_object->add_scale(parent, width, height, node));
+			return node;
+		}
+
+		size_t AddGain(size_t parent, float gain)
+		{
+			ThrowOnEmpty("Imaging::ImagePipeline");
+
+			size_t node = 0;
+			ThrowOnFailure(m_core_object->add_gain(parent, gain, node));
+			return node;
+		}
+
+		size_t AddAlgorithm(size_t parent, const Imaging::ImageAlgorithm& algorithm)
+		{
+			ThrowOnEmpty("Imaging::ImagePipeline");
+
+			size_t node = 0;
+			ThrowOnFailure(m_core_object->add_algorithm(parent, static_cast<core::imaging::image_algorithm_interface*>(algorithm), node));
+			return node;
+		}
+
+		/// Marks the images of a node as an output
+		/// @date	19/10/2026
+		/// @param	node	The node.
+		/// @return	The index of the output in the images of Process.
+		size_t AddOutput(size_t node)
+		{
+			ThrowOnEmpty("Imaging::ImagePipeline");
+
+			size_t output = 0;
+			ThrowOnFailure(m_core_object->add_output(node, output));
+			return output;
+		}
+
+		/// Processes an image through the pipeline
+		/// @date	19/10/2026
+		/// @param 		   	input  	The input image.
+		/// @param [out]	outputs	The output images, by output index.
+		/// @return	True if it succeeds, false if a stage failed.
+		bool Process(const Imaging::Image& input, std::vector<Imaging::Image>& outputs)
+		{
+			ThrowOnEmpty("Imaging::ImagePipeline");
+
+			m_outputs.assign(m_core_object->outputs(), nullptr);
+			if (m_core_object->process(static_cast<core::imaging::image_interface*>(input), m_outputs.data(), m_outputs.size()) == false)
+				return false;
+
+			// The output images are referenced by the wrappers only
+			outputs.resize(m_outputs.size());
+			for (size_t i = 0; i < m_outputs.size(); i++)
+			{
+				outputs[i] = Imaging::Image(m_outputs[i]);
+				m_outputs[i]->release();
+			}
+
+			return true;
+		}
 	};
-}
+}
\ No newline at end of file
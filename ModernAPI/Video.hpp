@@ -1,9 +1,11 @@
 #pragma once
 #include <utils/video.hpp>
+#include <video/publishers/shared_memory_frame_allocator.h>
 
 #include <Common.hpp>
 #include <Utils.hpp>
 #include <Imaging.hpp>
+#include <Buffers.hpp>
 
 namespace Video
 {
@@ -11,6 +13,9 @@ namespace Video
 	using InterlaceMode = core::video::interlace_mode;
 	using Framerate = core::video::framerate;
 	using VideoDataType = core::video::video_data_type;
+	using VideoHop = core::video::video_hop;
+	using LatencyHistogram = core::video::latency_histogram;
+	using VideoStatistics = core::video::video_statistics;
 
 	class Frame : public Imaging::ImageTemplate<core::video::frame_interface>
 	{
@@ -161,6 +166,20 @@ namespace Video
             this->ThrowOnEmpty("Video::VideoSource");
             return ErrorSignal(this->smart_controller_base()->on_error);
 		}
+
+		// The frames, drops, copied bytes and hop latencies of the stream, false when the controller does not measure it
+		bool QueryStatistics(Video::VideoStatistics& statistics) const
+		{
+			this->ThrowOnEmpty("Video::VideoSource");
+
+			const core::video::video_statistics_interface* measured =
+				dynamic_cast<const core::video::video_statistics_interface*>(this->smart_controller_base()->controller());
+
+			if (measured == nullptr)
+				return false;
+
+			return measured->query_statistics(statistics);
+		}
 	};
 
 	class VideoController : public VideoControllerTemplate<core::video::video_controller_interface>
@@ -381,6 +400,60 @@ namespace Video
 		}
 	};
 
+	/// Frame buffers in the shared memory of a video, frames made of them are published without a copy by the
+	/// SharedMemoryVideoPublisher created with this allocator
+	class FrameAllocator : public Common::CoreObjectWrapper<video::publishers::shared_memory_frame_allocator>
+	{
+	public:
+		FrameAllocator()
+		{
+			// Empty FrameAllocator
+		}
+
+		FrameAllocator(video::publishers::shared_memory_frame_allocator* allocator) :
+			CoreObjectWrapperBase(allocator)
+		{
+		}
+
+		size_t MaxBufferSize() const
+		{
+			ThrowOnEmpty("Video::FrameAllocator");
+			return m_core_object->max_buffer_size();
+		}
+
+		Buffers::Buffer Allocate(size_t size)
+		{
+			ThrowOnEmpty("Video::FrameAllocator");
+
+			utils::ref_count_ptr<core::buffer_interface> buffer;
+			if (m_core_object->allocate(size, &buffer) == false)
+				return Buffers::Buffer(); // Empty Buffer
+
+			return Buffers::Buffer(buffer);
+		}
+
+		// Compresses the published frames with LZ4, false when the library was built without it
+		bool EnableCompression(bool perTile, uint32_t keyframeInterval, uint32_t acceleration = 1)
+		{
+			ThrowOnEmpty("Video::FrameAllocator");
+			return m_core_object->enable_compression(perTile, keyframeInterval, acceleration);
+		}
+
+		// Waits up to timeoutMs for LOSSLESS readers to release a buffer instead of dropping frames, false unless lock-free
+		bool EnableBackpressure(uint32_t timeoutMs)
+		{
+			ThrowOnEmpty("Video::FrameAllocator");
+			return m_core_object->enable_backpressure(timeoutMs);
+		}
+
+		// The allocator for frame producers taking a Buffers::BufferAllocator (e.g. image algorithms)
+		Buffers::BufferAllocator BufferAllocator() const
+		{
+			ThrowOnEmpty("Video::FrameAllocator");
+			return Buffers::BufferAllocator(static_cast<core::buffer_allocator*>(static_cast<video::publishers::shared_memory_frame_allocator*>(m_core_object)));
+		}
+	};
+
 	inline VideoSourceFactory::VideoSourceFactory()
 	{
 		// Empty Factory
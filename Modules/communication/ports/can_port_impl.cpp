@@ -1,5 +1,7 @@
 #include "can_port_impl.h"
 
+#include <cerrno>
+
 
 
 bool communication::ports::can_port_adapter::create(
@@ -30,3 +32,381 @@ bool communication::ports::can_port_adapter::create(
 	(*client)->add_ref();
 	return true;
 }
+
+bool communication::ports::can_port_adapter::create(
+	communication::ports::can_port_interface* can_port_interface,
+	core::communication::client_channel_interface** client)
+{
+	if (can_port_interface == nullptr || client == nullptr)
+		return false;
+
+	utils::ref_count_ptr<core::communication::client_channel_interface> instance;
+	try
+	{
+		instance = utils::make_ref_count_ptr<can_port_adapter_impl>(can_port_interface);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	if (instance == nullptr)
+		return false;
+
+	*client = instance;
+	(*client)->add_ref();
+	return true;
+}
+
+//--------------------------------------------------------
+// socketcan_interface_impl
+//--------------------------------------------------------
+void communication::ports::socketcan_interface_impl::to_can_msg(const void* frame, communication::ports::can_msg& msg) const
+{
+#ifndef _WIN32
+	const canfd_frame* received = static_cast<const canfd_frame*>(frame);
+	uint32_t id = received->can_id;
+	msg.id = static_cast<int>(is_extended(id) ? (id & CAN_EFF_MASK) : (id & CAN_SFF_MASK));
+
+	// can_msg holds a classic CAN payload, CAN FD payloads are truncated
+	size_t length = (std::min)(static_cast<size_t>(received->len), sizeof(msg.data));
+	memset(msg.data, 0, sizeof(msg.data));
+	memcpy(msg.data, received->data, length);
+
+#ifdef VERBOS
+	printf("id: %x, data: %02x %02x %02x %02x %02x %02x %02x %02x  \n", msg.id,
+		msg.data[0], msg.data[1], msg.data[2], msg.data[3],
+		msg.data[4], msg.data[5], msg.data[6], msg.data[7]);
+#endif
+#endif
+}
+
+#ifndef _WIN32
+bool communication::ports::socketcan_interface_impl::apply_filters()
+{
+	if (m_socket < 0)
+		return true;
+
+	// No filters means receiving everything (the socket's default is a single match-all filter)
+	std::vector<can_filter> filters;
+	if (m_filters.empty() == true)
+	{
+		can_filter all = {};
+		filters.push_back(all);
+	}
+
+	for (const communication::ports::can_id_filter& filter : m_filters)
+	{
+		can_filter kernel_filter;
+		kernel_filter.can_id = filter.id;
+		kernel_filter.can_mask = filter.mask;
+		filters.push_back(kernel_filter);
+	}
+
+	return (setsockopt(m_socket, SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(), static_cast<socklen_t>(filters.size() * sizeof(can_filter))) == 0);
+}
+
+uint64_t communication::ports::socketcan_interface_impl::receive_timestamp(msghdr& header)
+{
+	uint64_t timestamp = 0;
+	for (cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg))
+	{
+		if (cmsg->cmsg_level != SOL_SOCKET)
+			continue;
+
+		const timespec* ts = nullptr;
+		if (cmsg->cmsg_type == SCM_TIMESTAMPING)
+		{
+			// [0] software, [1] deprecated, [2] raw hardware
+			const timespec* stamps = reinterpret_cast<const timespec*>(CMSG_DATA(cmsg));
+			ts = (stamps[2].tv_sec != 0 || stamps[2].tv_nsec != 0) ? &stamps[2] : &stamps[0];
+		}
+		else if (cmsg->cmsg_type == SCM_TIMESTAMPNS)
+		{
+			ts = reinterpret_cast<const timespec*>(CMSG_DATA(cmsg));
+		}
+
+		if (ts != nullptr)
+			timestamp = static_cast<uint64_t>(ts->tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts->tv_nsec);
+	}
+
+	return timestamp;
+}
+#endif
+
+size_t communication::ports::socketcan_interface_impl::can_read_batch(communication::ports::can_timestamped_msg* messages, size_t count, core::communication::communication_error* error)
+{
+	*error = core::communication::communication_error::NO_ERRORS;
+#ifndef _WIN32
+	if (messages == nullptr || count == 0)
+		return 0;
+
+	if (m_batch_headers.empty() == true)
+	{
+		m_batch_frames.resize(READ_BATCH_SIZE);
+		m_batch_iovecs.resize(READ_BATCH_SIZE);
+		m_batch_headers.resize(READ_BATCH_SIZE);
+		m_batch_control.resize(READ_BATCH_SIZE * CONTROL_BUFFER_SIZE);
+	}
+
+	unsigned int batch_size = static_cast<unsigned int>((std::min)(count, READ_BATCH_SIZE));
+	for (unsigned int i = 0; i < batch_size; i++)
+	{
+		m_batch_iovecs[i].iov_base = &m_batch_frames[i];
+		m_batch_iovecs[i].iov_len = sizeof(canfd_frame);
+
+		msghdr& header = m_batch_headers[i].msg_hdr;
+		memset(&header, 0, sizeof(header));
+		header.msg_iov = &m_batch_iovecs[i];
+		header.msg_iovlen = 1;
+		header.msg_control = m_batch_control.data() + (i * CONTROL_BUFFER_SIZE);
+		header.msg_controllen = CONTROL_BUFFER_SIZE;
+		m_batch_headers[i].msg_len = 0;
+	}
+
+	// Blocks for the first frame only, then drains whatever is already queued in the socket
+	int received = ::recvmmsg(m_socket, m_batch_headers.data(), batch_size, MSG_WAITFORONE, nullptr);
+	if (received < 0)
+	{
+		switch (errno)
+		{
+		case EAGAIN:
+		case EINTR:
+			// SO_RCVTIMEO expired (or a signal), nothing was received
+			*error = core::communication::communication_error::TIMED_OUT;
+			break;
+
+		case EPERM:
+			*error = core::communication::communication_error::NO_PERMISSION;
+			break;
+
+		case EACCES:
+			*error = core::communication::communication_error::ACCESS_DENIED;
+			break;
+
+		case ENETDOWN:
+		case ENODEV:
+			*error = core::communication::communication_error::HOST_UNREACHABLE;
+			break;
+
+		default:
+			*error = core::communication::communication_error::UNKNOWN_ERROR;
+			break;
+		}
+
+		return 0;
+	}
+
+	size_t total = 0;
+	for (int i = 0; i < received; i++)
+	{
+		if (m_batch_headers[i].msg_len != CAN_MTU && m_batch_headers[i].msg_len != CANFD_MTU)
+			continue;
+
+		to_can_msg(&m_batch_frames[i], messages[total].msg);
+		messages[total].timestamp_ns = receive_timestamp(m_batch_headers[i].msg_hdr);
+		total++;
+	}
+
+	// Only malformed frames were received
+	if (total == 0)
+		*error = core::communication::communication_error::TIMED_OUT;
+
+	return total;
+#else
+	*error = core::communication::communication_error::UNKNOWN_ERROR;
+	return 0;
+#endif
+}
+
+bool communication::ports::socketcan_interface_impl::can_set_filters(const communication::ports::can_id_filter* filters, size_t count)
+{
+	if (filters == nullptr && count > 0)
+		return false;
+
+	m_filters.assign(filters, filters + count);
+#ifndef _WIN32
+	return apply_filters();
+#else
+	return false;
+#endif
+}
+
+//--------------------------------------------------------
+// can_port_adapter_impl
+//--------------------------------------------------------
+communication::ports::can_port_adapter_impl::can_port_adapter_impl(
+	communication::ports::can_interface ican,
+	communication::ports::can_mode mode,
+	const char* channel_name,
+	uint32_t buadrate,
+	bool extension_mode) :
+	m_msg_queue(MAX_QUEUE_SIZE),
+	m_is_running(false),
+	m_dropped(0),
+	m_error(core::communication::communication_error::NO_ERRORS)
+{
+	if (channel_name == nullptr)
+		throw std::invalid_argument("channel_name");
+
+	if (ican != socket_can)
+		throw std::invalid_argument("ican");
+
+	m_can_interface = utils::make_ref_count_ptr<socketcan_interface_impl>(channel_name, buadrate, extension_mode, mode);
+}
+
+communication::ports::can_port_adapter_impl::can_port_adapter_impl(communication::ports::can_port_interface* can_interface) :
+	m_can_interface(can_interface),
+	m_msg_queue(MAX_QUEUE_SIZE),
+	m_is_running(false),
+	m_dropped(0),
+	m_error(core::communication::communication_error::NO_ERRORS)
+{
+	if (can_interface == nullptr)
+		throw std::invalid_argument("can_interface");
+}
+
+communication::ports::can_port_adapter_impl::~can_port_adapter_impl()
+{
+	disconnect();
+}
+
+void communication::ports::can_port_adapter_impl::receive_loop()
+{
+	communication::ports::can_timestamped_msg batch[READ_BATCH_SIZE];
+	while (m_is_running)
+	{
+		core::communication::communication_error error = core::communication::communication_error::NO_ERRORS;
+		size_t count = m_can_interface->can_read_batch(batch, READ_BATCH_SIZE, &error);
+		if (count == 0)
+		{
+			// Reads time out periodically so a disconnection is noticed
+			if (error == core::communication::communication_error::TIMED_OUT || error == core::communication::communication_error::NO_ERRORS)
+				continue;
+
+			// A failed socket fails every read at once: stop receiving (the port is disconnected)
+			// and wake up the reader, which gets the error once the received messages are consumed
+			m_error = error;
+			m_is_running = false;
+			{
+				std::lock_guard<std::mutex> lock(m_cv_msg_mutex);
+			}
+			m_cv_msg.notify_all();
+			break;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			// The consumer owns the queue's head, so the newest messages are dropped when it falls behind
+			if (m_msg_queue.try_push(batch[i]) == false)
+				m_dropped++;
+		}
+
+		// A single wake up per batch
+		{
+			std::lock_guard<std::mutex> lock(m_cv_msg_mutex);
+		}
+		m_cv_msg.notify_all();
+	}
+}
+
+bool communication::ports::can_port_adapter_impl::wait_for_messages()
+{
+	if (m_msg_queue.empty() == false)
+		return true;
+
+	std::unique_lock<std::mutex> lock(m_cv_msg_mutex);
+	m_cv_msg.wait(lock, [this]()
+	{
+		return (m_msg_queue.empty() == false || m_is_running == false);
+	});
+
+	return (m_msg_queue.empty() == false);
+}
+
+bool communication::ports::can_port_adapter_impl::connect()
+{
+	disconnect();
+
+	if (m_can_interface->can_open() == false)
+		return false;
+
+	m_msg_queue.clear();
+	m_error = core::communication::communication_error::NO_ERRORS;
+	m_is_running = true;
+	m_recv_thread = std::thread([this]()
+	{
+		receive_loop();
+	});
+
+	return true;
+}
+
+bool communication::ports::can_port_adapter_impl::disconnect()
+{
+	m_is_running = false;
+	{
+		std::lock_guard<std::mutex> lock(m_cv_msg_mutex);
+	}
+	m_cv_msg.notify_all();
+
+	// Reads time out periodically, so the receiving thread exits before the socket is closed
+	if (m_recv_thread.joinable())
+		m_recv_thread.join();
+
+	// The socket is still open after the receiving thread stopped on a failure
+	if (m_can_interface->communication_status() != core::communication::communication_status::CONNECTED)
+		return true;
+
+	return m_can_interface->can_close();
+}
+
+size_t communication::ports::can_port_adapter_impl::recieve(void* buffer, size_t size, core::communication::communication_error* commError)
+{
+	if (buffer == nullptr || size < sizeof(communication::ports::can_msg))
+	{
+		if (commError != nullptr)
+			*commError = core::communication::communication_error::UNKNOWN_ERROR;
+
+		return 0;
+	}
+
+	communication::ports::can_timestamped_msg message;
+	if (recieve_batch(&message, 1, commError) == 0)
+		return 0;
+
+	memcpy(buffer, &message.msg, sizeof(message.msg));
+	return sizeof(message.msg);
+}
+
+size_t communication::ports::can_port_adapter_impl::recieve_batch(communication::ports::can_timestamped_msg* messages, size_t count, core::communication::communication_error* commError)
+{
+	if (messages == nullptr || count == 0)
+	{
+		if (commError != nullptr)
+			*commError = core::communication::communication_error::UNKNOWN_ERROR;
+
+		return 0;
+	}
+
+	if (wait_for_messages() == false)
+	{
+		if (commError != nullptr)
+		{
+			core::communication::communication_error error = m_error;
+			*commError = (error != core::communication::communication_error::NO_ERRORS) ? error : core::communication::communication_error::UNKNOWN_ERROR;
+		}
+
+		return 0;
+	}
+
+	if (commError != nullptr)
+		*commError = core::communication::communication_error::NO_ERRORS;
+
+	return m_msg_queue.try_pop(messages, count);
+}
+
+bool communication::ports::can_port_adapter_impl::set_filters(const communication::ports::can_id_filter* filters, size_t count)
+{
+	return m_can_interface->can_set_filters(filters, count);
+}
@@ -7,6 +7,7 @@
 #include <sys/ioctl.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <linux/net_tstamp.h>
 #endif
 
 #include <boost/asio.hpp>
@@ -15,9 +16,16 @@
 #include <communication/ports/can_port.h>
 #include <utils/ref_count_base.hpp>
 #include <utils/ref_count_ptr.hpp>
-#include <utils/thread_safe_object.hpp>
+#include <utils/spsc_queue.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
-#include <queue>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+static_assert(communication::ports::MODE_CAN_MTU == CAN_MTU && communication::ports::MODE_CANFD_MTU == CANFD_MTU, "can_mode must match the SocketCAN frame sizes");
+#endif
 
 namespace communication
 {
@@ -25,7 +33,7 @@ namespace communication
     {
 		class socketcan_interface_impl : public utils::ref_count_base <communication::ports::can_port_interface>
 		{
-			bool is_extended(uint32_t id)
+			static bool is_extended(uint32_t id)
 			{
 #ifndef _WIN32
 				return ((id & CAN_EFF_FLAG) != 0);
@@ -35,7 +43,7 @@ namespace communication
 
 			}
 
-			uint32_t extend_id(uint32_t id, bool extention_mode)
+			static uint32_t extend_id(uint32_t id, bool extention_mode)
 			{
 				if (extention_mode == true && is_extended(id) == false)
 				{
@@ -57,8 +65,23 @@ namespace communication
 			int m_socket;
 			core::communication::communication_status m_communication_status;
 
+			// Kernel-side receive filters, applied when the socket is opened
+			std::vector<communication::ports::can_id_filter> m_filters;
 
+#ifndef _WIN32
+			// recvmmsg batch state
+			static constexpr size_t READ_BATCH_SIZE = 32;
+			static constexpr size_t CONTROL_BUFFER_SIZE = CMSG_SPACE(sizeof(timespec) * 3) + CMSG_SPACE(sizeof(timespec));
+			std::vector<canfd_frame> m_batch_frames;
+			std::vector<iovec> m_batch_iovecs;
+			std::vector<mmsghdr> m_batch_headers;
+			std::vector<uint8_t> m_batch_control;
+
+			bool apply_filters();
+			static uint64_t receive_timestamp(msghdr& header);
+#endif
 
+			void to_can_msg(const void* frame, communication::ports::can_msg& msg) const;
 
 		public:
 			socketcan_interface_impl(const char* channel_name,
@@ -69,6 +92,7 @@ namespace communication
 				m_baudrate(buadrate),
 				m_extention_mode(extension_mode),
 				m_can_mode(mode),
+				m_socket(-1),
 				m_communication_status(core::communication::communication_status::DISCONNECTED)
 			{
 			}
@@ -82,7 +106,7 @@ namespace communication
 				struct canfd_frame frame;
 				memset(&frame, 0, sizeof(frame)); /* init CAN FD frame, e.g. LEN = 0 */
 				//convert CanFrame to canfd_frame
-				frame.can_id = extend_id(frame_buffer.id);
+				frame.can_id = extend_id(static_cast<uint32_t>(frame_buffer.id), m_extention_mode);
 				frame.len = 8;
 				// frame.flags = msg.flags;
 
@@ -93,7 +117,7 @@ namespace communication
 				memcpy(frame.data, frame_buffer.data, frame.len);
 
 				/* send frame */
-				if (::write(m_socket, &frame, int(m_can_mode)) != int(m_can_mode)).
+				if (::write(m_socket, &frame, int(m_can_mode)) != int(m_can_mode))
 				{
 					return 0;//STATUS_WRITE_ERROR;
 				}
@@ -107,30 +131,25 @@ namespace communication
 			virtual size_t can_read(void* buffer, size_t size) override
 			{
 #ifndef _WIN32
-				struct can_frame frame;
-				auto num_bytes = ::read(m_socket, &frame, CAN_MTU);
-				while (num_bytes != CAN_MTU)// && num_bytes != CANFD_MTU)
+				struct canfd_frame frame;
+				auto num_bytes = ::read(m_socket, &frame, sizeof(frame));
+				while (num_bytes != CAN_MTU && num_bytes != CANFD_MTU)
 				{
-					num_bytes = ::read(m_socket, &frame, CAN_MTU);
-				}
-				communication::ports::can_msg* frame_buffer = static_cast<communication::ports::can_msg*>(buffer);
-
-				frame.can_id = (is_extended(frame.can_id)) ? (frame.can_id & CAN_EFF_MASK) : (frame.can_id & CAN_SFF_MASK);
+					if (m_communication_status != core::communication::communication_status::CONNECTED)
+						return 0;
 
-				frame_buffer->id = frame.can_id;
-				memcpy(frame_buffer->data, frame.data, frame.len);
-
-#ifdef VERBOS
-				printf("id: %x, data: %02x %02x %02x %02x %02x %02x %02x %02x  \n", frame_buffer->nID,
-					frame_buffer->data[0], frame_buffer->data[1], frame_buffer->data[2], frame_buffer->data[3],
-					frame_buffer->data[4], frame_buffer->data[5], frame_buffer->data[6], frame_buffer->data[7]);
-#endif
+					num_bytes = ::read(m_socket, &frame, sizeof(frame));
+				}
 
+				to_can_msg(&frame, *static_cast<communication::ports::can_msg*>(buffer));
 #else 
 				return 0;
 #endif
 				return sizeof(communication::ports::can_msg);
 			}
+
+			virtual size_t can_read_batch(communication::ports::can_timestamped_msg* messages, size_t count, core::communication::communication_error* error) override;
+			virtual bool can_set_filters(const communication::ports::can_id_filter* filters, size_t count) override;
 			 
 			virtual bool can_open() override
 			{
@@ -181,13 +200,31 @@ namespace communication
 
 				}
 
+				// Reads time out periodically so a disconnection is noticed by the reading thread
 				struct timeval tv;
-				tv.tv_sec = 30; 
+				tv.tv_sec = 1; 
 				tv.tv_usec = 0; 
 				setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(struct timeval));
 
+				// Kernel receive timestamps, hardware ones are used when the device provides them
+				int timestamping = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+				if (setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPING, &timestamping, sizeof(timestamping)) < 0)
+				{
+					int enable_timestamp = 1;
+					setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, &enable_timestamp, sizeof(enable_timestamp));
+				}
+
+				if (apply_filters() == false)
+				{
+					::close(m_socket);
+					m_socket = -1;
+					return false;
+				}
+
 				if (bind(m_socket, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
 					perror("errorn bind");
+					::close(m_socket);
+					m_socket = -1;
 					return false; //STATUS_BIND_ERROR
 				}
 
@@ -201,7 +238,10 @@ namespace communication
 			virtual bool can_close() override
 			{
 #ifndef _WIN32
-				::close(m_socket);
+				if (m_socket >= 0)
+					::close(m_socket);
+
+				m_socket = -1;
 #endif
 				m_communication_status = core::communication::communication_status::DISCONNECTED;
 				return true;
@@ -236,127 +276,65 @@ namespace communication
 
 		class can_port_adapter_impl : public utils::ref_count_base<communication::ports::can_port_adapter>
         {
+			// Messages read by a single recvmmsg call
+			static constexpr size_t READ_BATCH_SIZE = 32;
+			static constexpr size_t MAX_QUEUE_SIZE = 2048;
+
 			utils::ref_count_ptr<communication::ports::can_port_interface> m_can_interface;
-			utils::thread_safe_object<std::queue<communication::ports::can_msg>> m_msg_queue;
+
+			// Filled by the receiving thread and drained by the reading thread, without locking
+			utils::spsc_queue<communication::ports::can_timestamped_msg> m_msg_queue;
 			std::atomic<bool> m_is_running;
+			std::atomic<uint64_t> m_dropped;
+
+			// Set when the port failed and the receiving thread stopped, reported to the reader
+			std::atomic<core::communication::communication_error> m_error;
 
 			std::thread m_recv_thread;
 
-			size_t m_max_queue_size;
 			std::condition_variable m_cv_msg;
 			std::mutex m_cv_msg_mutex;
 
+			void receive_loop();
+			bool wait_for_messages();
+
 		public:
 			can_port_adapter_impl(
 				communication::ports::can_interface ican,
 				communication::ports::can_mode mode,
 				const char* channel_name,
 				uint32_t buadrate,
-				bool extension_mode):
-				m_ch_name(channel_name),
-				m_baudrate(buadrate),
-				m_extention_mode(extension_mode),
-				m_communication_status(core::communication::communication_status::DISCONNECTED),
-				m_max_queue_size(2000)
-			{
-				if (ican == socket_can)
-				{
-					m_can_interface = utils::make_ref_count_ptr<socketcan_interface_impl>(m_ch_name, m_baudrate, m_extention_mode, mode);
-				}
-
-
-				
-			}
-
-
-			can_port_adapter_impl(communication::ports::can_port_interface* can_interface) :
-				m_can_interface(can_interface)
-			{
+				bool extension_mode);
 
-			}
+			can_port_adapter_impl(communication::ports::can_port_interface* can_interface);
+			virtual ~can_port_adapter_impl();
 
 			// Inherited via ref_count_base
 			virtual core::communication::communication_status status() const override
 			{
-				return m_can_interface->communication_status();
-			}
-
-			virtual bool connect() override
-			{
-				m_is_running = m_can_interface->can_open();
-
-				if (m_recv_thread.joinable())
-				{
-					m_recv_thread.join();
-				}
-
-				m_recv_thread = std::thread([&]()
-				{
-					while (m_is_running)
-					{
-						communication::ports::can_msg msg = {};
-						if (m_can_interface->can_read((void*)&msg, sizeof(msg)) > 0)
-						{
-							m_msg_queue.use([&, msg](std::queue<communication::ports::can_msg>& q)
-							{
-								if (q.size() >= m_max_queue_size)
-								{
-									q.pop();
-								}
-								q.push(msg);
-								m_cv_msg.notify_all();
-							});
-						}
-					}
-				});
+				// A failed port is disconnected until it is connected again
+				if (m_is_running == false)
+					return core::communication::communication_status::DISCONNECTED;
 
-				return m_is_running;
+				return m_can_interface->communication_status();
 			}
 
-			virtual bool disconnect() override
-			{
-				bool ret = m_can_interface->can_close();
-				m_is_running = false;
-				return ret;
-			}
+			virtual bool connect() override;
+			virtual bool disconnect() override;
 
 			virtual size_t send(const void* buffer, size_t size) const override
 			{
 				return m_can_interface->can_send(buffer, size);
 			}
 
-			virtual size_t recieve(void* buffer, size_t size, core::communication::communication_error* commError) override
-			{
-				std::unique_lock<std::mutex> lock(m_cv_msg_mutex);
-				m_cv_msg.wait(lock, [&]()
-				{
-					return m_msg_queue.use<bool>([&](std::queue<communication::ports::can_msg>& q)
-					{
-						if (q.size() > 0)
-						{
-							return true;
-						}
-						return false;
-					});
-				});
-
+			virtual size_t recieve(void* buffer, size_t size, core::communication::communication_error* commError) override;
+			virtual size_t recieve_batch(communication::ports::can_timestamped_msg* messages, size_t count, core::communication::communication_error* commError) override;
+			virtual bool set_filters(const communication::ports::can_id_filter* filters, size_t count) override;
 
-				return m_msg_queue.use<size_t>([&](std::queue<communication::ports::can_msg>& q)
-				{
-					communication::ports::can_msg msg = q.front();
-					q.pop();
-					memcpy(buffer, &msg, sizeof(msg));
-					return sizeof(msg);
-				});
+			virtual uint64_t dropped_messages() const override
+			{
+				return m_dropped;
 			}
-
-
-        private:					
-			std::string m_ch_name;
-			uint32_t m_baudrate;
-			bool m_extention_mode;
-			core::communication::communication_status m_communication_status;
 		};
 	}	
 }
-
@@ -0,0 +1,14 @@
+#include <communication/ports/io_backend.h>
+
+#ifdef HAVE_IO_URING
+#include "io_uring_reactor.h"
+#endif
+
+bool communication::ports::io_uring_backend::supported()
+{
+#ifdef HAVE_IO_URING
+	return (communication::ports::io_uring_reactor::instance() != nullptr);
+#else
+	return false;
+#endif
+}
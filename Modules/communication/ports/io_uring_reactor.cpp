@@ -0,0 +1,743 @@
+#include "io_uring_reactor.h"
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+// Receivers are identified by the SQE's user_data,
+// 0 is reserved for requests whose completion is ignored (e.g. cancellations) and 1 for the reactor's wake up reads
+static constexpr uint64_t IGNORED_USER_DATA = 0;
+static constexpr uint64_t WAKEUP_USER_DATA = 1;
+static constexpr unsigned SQ_ENTRIES = 64;
+static constexpr unsigned CQ_ENTRIES = 4096;
+
+static int io_uring_setup(unsigned entries, io_uring_params* params)
+{
+	return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+	return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int io_uring_register(int ring_fd, unsigned opcode, void* arg, unsigned nr_args)
+{
+	return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+//--------------------------------------------------------
+// io_uring_receiver
+//--------------------------------------------------------
+communication::ports::io_uring_receiver::io_uring_receiver(int fd, bool datagram, size_t buffer_size, uint16_t buffer_count, const source_filter& filter) :
+	m_reactor(io_uring_reactor::instance()),
+	m_fd(fd),
+	m_datagram(datagram),
+	m_buffer_size(buffer_size),
+	m_buffer_count(buffer_count),
+	m_filter(filter),
+	m_id(0),
+	m_bgid(0),
+	m_ring(nullptr),
+	m_ring_size(0),
+	m_msghdr({}),
+	m_running(false),
+	m_armed(false),
+	m_needs_rearm(false),
+	m_closed(true),
+	m_close_reported(false),
+	m_error(0),
+	m_current_valid(false),
+	m_current_bid(0),
+	m_current_data(nullptr),
+	m_current_offset(0),
+	m_current_length(0)
+{
+	if (m_reactor == nullptr)
+		throw std::runtime_error("io_uring is not supported");
+
+	if (fd < 0)
+		throw std::invalid_argument("fd");
+
+	// The kernel requires a power of 2 ring size
+	if (buffer_count == 0 || (buffer_count & (buffer_count - 1)) != 0)
+		throw std::invalid_argument("buffer_count");
+
+	if (buffer_size == 0 || buffer_size > UINT32_MAX)
+		throw std::invalid_argument("buffer_size");
+
+	m_ring_size = sizeof(io_uring_buf) * buffer_count;
+	void* ring = ::mmap(nullptr, m_ring_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+	if (ring == MAP_FAILED)
+		throw std::runtime_error("Failed to allocate io_uring buffer ring");
+
+	m_ring = static_cast<io_uring_buf_ring*>(ring);
+	m_buffers.resize(buffer_size * buffer_count);
+
+	// Multishot recvmsg lays out the source address in each buffer, ahead of the payload
+	m_msghdr.msg_namelen = sizeof(sockaddr_storage);
+}
+
+communication::ports::io_uring_receiver::~io_uring_receiver()
+{
+	stop();
+	::munmap(m_ring, m_ring_size);
+}
+
+uint8_t* communication::ports::io_uring_receiver::buffer_address(uint16_t bid)
+{
+	return m_buffers.data() + (static_cast<size_t>(bid) * m_buffer_size);
+}
+
+io_uring_buf& communication::ports::io_uring_receiver::ring_entry(unsigned index)
+{
+	// io_uring_buf_ring::bufs cannot be used from C++: its flexible array wrapper holds an empty struct
+	// which takes a byte in C++ (but none in C), so the array would be misplaced by 8 bytes
+	return reinterpret_cast<io_uring_buf*>(m_ring)[index & (m_buffer_count - 1u)];
+}
+
+void communication::ports::io_uring_receiver::recycle(uint16_t bid)
+{
+	unsigned short tail = m_ring->tail;
+	io_uring_buf& buf = ring_entry(tail);
+	buf.addr = reinterpret_cast<uint64_t>(buffer_address(bid));
+	buf.len = static_cast<uint32_t>(m_buffer_size);
+	buf.bid = bid;
+	__atomic_store_n(&m_ring->tail, static_cast<unsigned short>(tail + 1), __ATOMIC_RELEASE);
+
+	if (m_needs_rearm == true && m_running == true)
+		arm();
+}
+
+bool communication::ports::io_uring_receiver::arm()
+{
+	m_needs_rearm = false;
+	m_armed = true;
+
+	uint64_t id = m_id;
+	int fd = m_fd;
+	uint16_t bgid = m_bgid;
+	msghdr* hdr = &m_msghdr;
+	bool datagram = m_datagram;
+
+	bool retval = m_reactor->submit([id, fd, bgid, hdr, datagram](io_uring_sqe& sqe)
+	{
+		sqe.opcode = datagram ? IORING_OP_RECVMSG : IORING_OP_RECV;
+		sqe.fd = fd;
+		sqe.addr = datagram ? reinterpret_cast<uint64_t>(hdr) : 0;
+		sqe.len = datagram ? 1 : 0;
+		sqe.flags = IOSQE_BUFFER_SELECT;
+		sqe.buf_group = bgid;
+		sqe.ioprio = IORING_RECV_MULTISHOT;
+		sqe.user_data = id;
+	});
+
+	if (retval == false)
+		m_armed = false;
+
+	return retval;
+}
+
+bool communication::ports::io_uring_receiver::start()
+{
+	std::unique_lock<std::mutex> locker(m_mutex);
+	if (m_running == true)
+		return true;
+
+	m_frames.clear();
+	m_current_valid = false;
+	m_closed = false;
+	m_close_reported = false;
+	m_error = 0;
+	m_ring->tail = 0;
+
+	locker.unlock();
+	if (m_reactor->add_receiver(this) == false)
+		return false;
+
+	locker.lock();
+	for (uint16_t bid = 0; bid < m_buffer_count; bid++)
+	{
+		io_uring_buf& buf = ring_entry(bid);
+		buf.addr = reinterpret_cast<uint64_t>(buffer_address(bid));
+		buf.len = static_cast<uint32_t>(m_buffer_size);
+		buf.bid = bid;
+	}
+
+	__atomic_store_n(&m_ring->tail, m_buffer_count, __ATOMIC_RELEASE);
+	m_running = true;
+	if (arm() == false)
+	{
+		m_running = false;
+		m_closed = true;
+		locker.unlock();
+		m_reactor->remove_receiver(this);
+		return false;
+	}
+
+	return true;
+}
+
+void communication::ports::io_uring_receiver::stop()
+{
+	std::unique_lock<std::mutex> locker(m_mutex);
+	if (m_running == false)
+		return;
+
+	m_running = false;
+	if (m_armed == true)
+	{
+		uint64_t id = m_id;
+		m_reactor->submit([id](io_uring_sqe& sqe)
+		{
+			sqe.opcode = IORING_OP_ASYNC_CANCEL;
+			sqe.fd = -1;
+			sqe.addr = id;
+			sqe.user_data = IGNORED_USER_DATA;
+		});
+
+		// The buffer ring must not be unregistered while the kernel may still use it
+		m_terminated.wait_for(locker, std::chrono::seconds(1), [this]() { return m_armed == false; });
+	}
+
+	m_closed = true;
+	m_frames.clear();
+	m_current_valid = false;
+	m_frame_arrived.notify_all();
+
+	// The receive ended without a final completion (e.g. while waiting for buffers)
+	bool report = (m_close_handler != nullptr && m_close_reported == false);
+	m_close_reported = true;
+
+	locker.unlock();
+	if (report == true)
+		m_close_handler(0);
+
+	m_reactor->remove_receiver(this);
+}
+
+bool communication::ports::io_uring_receiver::set_handlers(const frame_handler& on_frame, const close_handler& on_close)
+{
+	std::lock_guard<std::mutex> locker(m_mutex);
+	if (m_running == true)
+		return false;
+
+	m_frame_handler = on_frame;
+	m_close_handler = on_close;
+	return true;
+}
+
+void communication::ports::io_uring_receiver::on_completion(int32_t res, uint32_t flags)
+{
+	if (m_frame_handler != nullptr)
+	{
+		on_handled_completion(res, flags);
+		return;
+	}
+
+	std::lock_guard<std::mutex> locker(m_mutex);
+
+	if (res > 0 && (flags & IORING_CQE_F_BUFFER) != 0)
+	{
+		frame received;
+		received.bid = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+		received.length = static_cast<uint32_t>(res);
+		m_frames.push_back(received);
+	}
+
+	if ((flags & IORING_CQE_F_MORE) == 0)
+	{
+		// The multishot request was terminated
+		m_armed = false;
+
+		if (res == -ENOBUFS && m_running == true)
+		{
+			// Rearmed as soon as a buffer is given back to the ring, unless the reader
+			// has already given all of them back while this completion was in flight
+			if (m_frames.empty() == true && m_current_valid == false)
+				arm();
+			else
+				m_needs_rearm = true;
+		}
+		else if (res <= 0)
+		{
+			// Stream EOF (0), cancellation (once stopped) or socket error
+			m_closed = true;
+			m_error = (res < 0 && m_running == true) ? -res : 0;
+		}
+		else if (m_running == true)
+		{
+			arm();
+		}
+
+		m_terminated.notify_all();
+	}
+
+	m_frame_arrived.notify_one();
+}
+
+void communication::ports::io_uring_receiver::on_handled_completion(int32_t res, uint32_t flags)
+{
+	// The handlers are set before the receiver is registered to the reactor and only called from
+	// its completion thread, they run without the lock so they may read or send through the port
+	if (res > 0 && (flags & IORING_CQE_F_BUFFER) != 0)
+	{
+		uint16_t bid = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		if (payload(bid, static_cast<size_t>(res), &data, &size) == true)
+			m_frame_handler(data, size);
+
+		std::lock_guard<std::mutex> locker(m_mutex);
+		recycle(bid);
+	}
+
+	if ((flags & IORING_CQE_F_MORE) != 0)
+		return;
+
+	bool report = false;
+	int error = 0;
+	{
+		std::lock_guard<std::mutex> locker(m_mutex);
+
+		// The multishot request was terminated
+		m_armed = false;
+
+		// Out of buffers: they were all given back to the ring as their frames were handled
+		if ((res > 0 || res == -ENOBUFS) && m_running == true)
+		{
+			arm();
+		}
+		else if (m_close_reported == false)
+		{
+			// Stream EOF (0), cancellation (once stopped) or socket error
+			m_closed = true;
+			m_error = (res < 0 && m_running == true) ? -res : 0;
+			m_close_reported = true;
+			report = true;
+			error = m_error;
+		}
+
+		m_terminated.notify_all();
+	}
+
+	if (report == true && m_close_handler != nullptr)
+		m_close_handler(error);
+}
+
+bool communication::ports::io_uring_receiver::payload(uint16_t bid, size_t length, const uint8_t** data, size_t* size)
+{
+	const uint8_t* received = buffer_address(bid);
+	if (m_datagram == true)
+	{
+		const io_uring_recvmsg_out* out = reinterpret_cast<const io_uring_recvmsg_out*>(received);
+		size_t header_size = sizeof(io_uring_recvmsg_out) + m_msghdr.msg_namelen + m_msghdr.msg_controllen;
+		if (length < header_size)
+			return false;
+
+		const sockaddr* address = reinterpret_cast<const sockaddr*>(received + sizeof(io_uring_recvmsg_out));
+		if (m_filter != nullptr && m_filter(address, static_cast<socklen_t>(out->namelen)) == false)
+			return false;
+
+		received += header_size;
+		length -= header_size;
+		if (length > out->payloadlen)
+			length = out->payloadlen;
+	}
+
+	*data = received;
+	*size = length;
+	return true;
+}
+
+bool communication::ports::io_uring_receiver::next_frame(std::unique_lock<std::mutex>& locker)
+{
+	while (true)
+	{
+		m_frame_arrived.wait(locker, [this]() { return (m_frames.empty() == false || m_closed == true); });
+		if (m_frames.empty() == true)
+			return false;
+
+		frame received = m_frames.front();
+		m_frames.pop_front();
+
+		const uint8_t* data = nullptr;
+		size_t length = 0;
+		if (payload(received.bid, received.length, &data, &length) == false)
+		{
+			// Ignoring this message
+			recycle(received.bid);
+			continue;
+		}
+
+		m_current_valid = true;
+		m_current_bid = received.bid;
+		m_current_data = data;
+		m_current_offset = 0;
+		m_current_length = length;
+		return true;
+	}
+}
+
+size_t communication::ports::io_uring_receiver::read(void* buffer, size_t size, int* error)
+{
+	std::unique_lock<std::mutex> locker(m_mutex);
+
+	uint8_t* target_buffer = static_cast<uint8_t*>(buffer);
+	size_t total = 0;
+	do
+	{
+		if (m_current_valid == false && next_frame(locker) == false)
+		{
+			if (error != nullptr)
+				*error = m_error;
+
+			return 0;
+		}
+
+		size_t available = m_current_length - m_current_offset;
+		size_t read_size = (size == 0) ? available : (std::min)(available, size - total);
+		std::memcpy(target_buffer + total, m_current_data + m_current_offset, read_size);
+		m_current_offset += read_size;
+		total += read_size;
+
+		if (m_current_offset == m_current_length)
+		{
+			m_current_valid = false;
+			recycle(m_current_bid);
+		}
+	} while (total < size);
+
+	if (error != nullptr)
+		*error = 0;
+
+	return total;
+}
+
+//--------------------------------------------------------
+// io_uring_reactor
+//--------------------------------------------------------
+communication::ports::io_uring_reactor::io_uring_reactor() :
+	m_ring_fd(-1),
+	m_sq_ring(MAP_FAILED),
+	m_sq_ring_size(0),
+	m_cq_ring(MAP_FAILED),
+	m_cq_ring_size(0),
+	m_sqes(static_cast<io_uring_sqe*>(MAP_FAILED)),
+	m_sqes_size(0),
+	m_sq_head(nullptr),
+	m_sq_tail(nullptr),
+	m_sq_mask(0),
+	m_sq_entries(0),
+	m_sq_array(nullptr),
+	m_cq_head(nullptr),
+	m_cq_tail(nullptr),
+	m_cq_mask(0),
+	m_cqes(nullptr),
+	m_wakeup_fd(-1),
+	m_wakeup_value(0),
+	m_wakeup_armed(false),
+	m_pending(0),
+	m_next_id(WAKEUP_USER_DATA + 1),
+	m_next_bgid(0),
+	m_running(false)
+{
+	if (setup() == false)
+	{
+		teardown();
+		throw std::runtime_error("Failed to setup io_uring");
+	}
+
+	m_running = true;
+	m_completion_thread = std::thread([this]() { complete(); });
+}
+
+communication::ports::io_uring_reactor::~io_uring_reactor()
+{
+	m_running = false;
+	wake();
+	if (m_completion_thread.joinable() == true)
+		m_completion_thread.join();
+
+	teardown();
+}
+
+communication::ports::io_uring_reactor* communication::ports::io_uring_reactor::instance()
+{
+	static std::unique_ptr<io_uring_reactor> reactor = []() -> std::unique_ptr<io_uring_reactor>
+	{
+		try
+		{
+			return std::unique_ptr<io_uring_reactor>(new io_uring_reactor());
+		}
+		catch (...)
+		{
+			return nullptr;
+		}
+	}();
+
+	return reactor.get();
+}
+
+bool communication::ports::io_uring_reactor::setup()
+{
+	io_uring_params params = {};
+	params.flags = IORING_SETUP_CQSIZE;
+	params.cq_entries = CQ_ENTRIES;
+
+	m_ring_fd = io_uring_setup(SQ_ENTRIES, &params);
+	if (m_ring_fd < 0)
+		return false;
+
+	// Multishot completions may outrun the reader, they must never be dropped
+	if ((params.features & IORING_FEAT_NODROP) == 0)
+		return false;
+
+	m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+		m_sq_ring_size = m_cq_ring_size = (std::max)(m_sq_ring_size, m_cq_ring_size);
+
+	m_sq_ring = ::mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQ_RING);
+	if (m_sq_ring == MAP_FAILED)
+		return false;
+
+	if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+	{
+		m_cq_ring = m_sq_ring;
+	}
+	else
+	{
+		m_cq_ring = ::mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_CQ_RING);
+		if (m_cq_ring == MAP_FAILED)
+			return false;
+	}
+
+	m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+	m_sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQES));
+	if (m_sqes == MAP_FAILED)
+		return false;
+
+	uint8_t* sq = static_cast<uint8_t*>(m_sq_ring);
+	m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+	m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+	m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+	m_sq_entries = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+	m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+	uint8_t* cq = static_cast<uint8_t*>(m_cq_ring);
+	m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+	m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+	m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+	m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+	m_wakeup_fd = ::eventfd(0, EFD_CLOEXEC);
+	return (m_wakeup_fd >= 0);
+}
+
+void communication::ports::io_uring_reactor::teardown()
+{
+	if (m_sqes != MAP_FAILED)
+		::munmap(m_sqes, m_sqes_size);
+
+	if (m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring)
+		::munmap(m_cq_ring, m_cq_ring_size);
+
+	if (m_sq_ring != MAP_FAILED)
+		::munmap(m_sq_ring, m_sq_ring_size);
+
+	if (m_ring_fd >= 0)
+		::close(m_ring_fd);
+
+	if (m_wakeup_fd >= 0)
+		::close(m_wakeup_fd);
+
+	m_wakeup_fd = -1;
+	m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+	m_cq_ring = m_sq_ring = MAP_FAILED;
+	m_ring_fd = -1;
+}
+
+void communication::ports::io_uring_reactor::wake()
+{
+	uint64_t value = 1;
+	while (::write(m_wakeup_fd, &value, sizeof(value)) < 0 && errno == EINTR);
+}
+
+unsigned communication::ports::io_uring_reactor::available_entries() const
+{
+	return m_sq_entries - (*m_sq_tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE));
+}
+
+bool communication::ports::io_uring_reactor::flush()
+{
+	while (m_pending > 0)
+	{
+		int submitted = io_uring_enter(m_ring_fd, m_pending, 0, 0);
+		if (submitted < 0 && errno == EINTR)
+			continue;
+
+		if (submitted <= 0)
+			return false;
+
+		m_pending -= static_cast<unsigned>(submitted);
+	}
+
+	return true;
+}
+
+void communication::ports::io_uring_reactor::queue(const std::function<void(io_uring_sqe&)>& prepare)
+{
+	unsigned tail = *m_sq_tail;
+	unsigned index = tail & m_sq_mask;
+	io_uring_sqe& sqe = m_sqes[index];
+	std::memset(&sqe, 0, sizeof(sqe));
+	prepare(sqe);
+
+	m_sq_array[index] = index;
+	__atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+	m_pending++;
+}
+
+bool communication::ports::io_uring_reactor::submit_backlog()
+{
+	while (m_backlog.empty() == false)
+	{
+		if (available_entries() == 0 && flush() == false)
+			return false;
+
+		queue(m_backlog.front());
+		m_backlog.pop_front();
+	}
+
+	return flush();
+}
+
+bool communication::ports::io_uring_reactor::submit(const std::function<void(io_uring_sqe&)>& prepare)
+{
+	std::unique_lock<std::mutex> locker(m_submit_mutex);
+
+	// The kernel cancels the requests of a thread once it exits, so requests are submitted
+	// only by the long lived completion thread: other threads queue them and wake it up
+	bool completion_thread = (std::this_thread::get_id() == m_completion_thread_id);
+	if (m_running == false)
+		return false;
+
+	if (completion_thread == true && available_entries() == 0)
+		flush();
+
+	// Never waiting for a free entry: callers may hold locks the completion thread needs to make progress
+	// (e.g. a receiver rearming under its lock), so a full queue overflows to the backlog, in order
+	if (m_backlog.empty() == false || available_entries() == 0)
+		m_backlog.push_back(prepare);
+	else
+		queue(prepare);
+
+	if (completion_thread == true)
+		return submit_backlog();
+
+	locker.unlock();
+	wake();
+	return true;
+}
+
+void communication::ports::io_uring_reactor::complete()
+{
+	{
+		std::lock_guard<std::mutex> locker(m_submit_mutex);
+		m_completion_thread_id = std::this_thread::get_id();
+	}
+
+	while (m_running == true)
+	{
+		if (m_wakeup_armed == false)
+		{
+			int fd = m_wakeup_fd;
+			uint64_t* value = &m_wakeup_value;
+			m_wakeup_armed = submit([fd, value](io_uring_sqe& sqe)
+			{
+				sqe.opcode = IORING_OP_READ;
+				sqe.fd = fd;
+				sqe.addr = reinterpret_cast<uint64_t>(value);
+				sqe.len = sizeof(*value);
+				sqe.user_data = WAKEUP_USER_DATA;
+			});
+		}
+		else
+		{
+			std::lock_guard<std::mutex> locker(m_submit_mutex);
+			submit_backlog();
+		}
+
+		if (io_uring_enter(m_ring_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+			break;
+
+		unsigned head = *m_cq_head;
+		unsigned tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+
+		std::lock_guard<std::mutex> locker(m_receivers_mutex);
+		for (; head != tail; head++)
+		{
+			const io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+			if (cqe.user_data == IGNORED_USER_DATA)
+				continue;
+
+			if (cqe.user_data == WAKEUP_USER_DATA)
+			{
+				m_wakeup_armed = false;
+				continue;
+			}
+
+			auto it = m_receivers.find(cqe.user_data);
+			if (it != m_receivers.end())
+				it->second->on_completion(cqe.res, cqe.flags);
+		}
+
+		__atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+	}
+}
+
+bool communication::ports::io_uring_reactor::add_receiver(io_uring_receiver* receiver)
+{
+	if (receiver == nullptr)
+		return false;
+
+	std::lock_guard<std::mutex> locker(m_receivers_mutex);
+	if (m_buffer_groups.size() > UINT16_MAX)
+		return false;
+
+	while (m_buffer_groups.count(m_next_bgid) != 0)
+		m_next_bgid++;
+
+	io_uring_buf_reg reg = {};
+	reg.ring_addr = reinterpret_cast<uint64_t>(receiver->m_ring);
+	reg.ring_entries = receiver->m_buffer_count;
+	reg.bgid = m_next_bgid;
+	if (io_uring_register(m_ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+		return false;
+
+	receiver->m_bgid = m_next_bgid++;
+	receiver->m_id = m_next_id++;
+	m_buffer_groups.insert(receiver->m_bgid);
+	m_receivers.emplace(receiver->m_id, receiver);
+	return true;
+}
+
+void communication::ports::io_uring_reactor::remove_receiver(io_uring_receiver* receiver)
+{
+	if (receiver == nullptr)
+		return;
+
+	std::lock_guard<std::mutex> locker(m_receivers_mutex);
+	if (m_receivers.erase(receiver->m_id) == 0)
+		return;
+
+	io_uring_buf_reg reg = {};
+	reg.bgid = receiver->m_bgid;
+	io_uring_register(m_ring_fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+	m_buffer_groups.erase(receiver->m_bgid);
+}
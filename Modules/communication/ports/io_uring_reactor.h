@@ -0,0 +1,188 @@
+#pragma once
+#include <core/ref_count_interface.h>
+#include <utils/ref_count_base.hpp>
+#include <utils/ref_count_ptr.hpp>
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace communication
+{
+	namespace ports
+	{
+		class io_uring_reactor;
+
+		/// A multishot receive of a single socket served by the process-wide io_uring reactor.
+		/// The kernel fills the receiver's provided-buffer ring and the reactor's completion thread either
+		/// queues the filled buffers, which are consumed (and given back to the ring) by the owning port's reading thread,
+		/// or hands them straight to the receiver's handlers.
+		class io_uring_receiver : public utils::ref_count_base<core::ref_count_interface>
+		{
+			friend class io_uring_reactor;
+
+		public:
+			/// Returns false for datagrams which should be ignored (datagram receivers only)
+			using source_filter = std::function<bool(const sockaddr* address, socklen_t address_length)>;
+
+			/// Gets the received bytes of a stream, or the payload of a datagram, on the completion thread
+			using frame_handler = std::function<void(const uint8_t* data, size_t size)>;
+
+			/// Called once the receive ends, with the errno value of the failure (0 for an end of stream or a stop)
+			using close_handler = std::function<void(int error)>;
+
+			io_uring_receiver(int fd, bool datagram, size_t buffer_size, uint16_t buffer_count, const source_filter& filter = nullptr);
+			virtual ~io_uring_receiver();
+
+			/// Registers the buffer ring and arms the multishot receive
+			bool start();
+
+			/// Cancels the multishot receive and wakes up blocked readers
+			void stop();
+
+			/// Delivers the frames to 'on_frame' as they complete instead of queueing them for read(),
+			/// each buffer is given back to the ring as soon as the handler returns.
+			/// Should be called before start(). The handlers must not stop the receiver.
+			bool set_handlers(const frame_handler& on_frame, const close_handler& on_close);
+
+			/// Blocking: reads exactly 'size' bytes, possibly across several received frames, or a single whole frame when size is 0.
+			/// Returns 0 when the receiver was stopped or the socket failed/closed, in which case 'error' holds the errno value.
+			size_t read(void* buffer, size_t size, int* error);
+
+		private:
+			struct frame
+			{
+				uint16_t bid;
+				uint32_t length;
+			};
+
+			io_uring_reactor* m_reactor;
+			int m_fd;
+			bool m_datagram;
+			size_t m_buffer_size;
+			uint16_t m_buffer_count;
+			source_filter m_filter;
+			frame_handler m_frame_handler;
+			close_handler m_close_handler;
+
+			uint64_t m_id;
+			uint16_t m_bgid;
+			io_uring_buf_ring* m_ring;
+			size_t m_ring_size;
+			std::vector<uint8_t> m_buffers;
+			msghdr m_msghdr;
+
+			std::mutex m_mutex;
+			std::condition_variable m_frame_arrived;
+			std::condition_variable m_terminated;
+			std::deque<frame> m_frames;
+			bool m_running;
+			bool m_armed;
+			bool m_needs_rearm;
+			bool m_closed;
+			bool m_close_reported;
+			int m_error;
+
+			bool m_current_valid;
+			uint16_t m_current_bid;
+			const uint8_t* m_current_data;
+			size_t m_current_offset;
+			size_t m_current_length;
+
+			uint8_t* buffer_address(uint16_t bid);
+			io_uring_buf& ring_entry(unsigned index);
+
+			// Should be called while m_mutex is locked
+			void recycle(uint16_t bid);
+			bool arm();
+			bool next_frame(std::unique_lock<std::mutex>& locker);
+
+			// Locates the data of a received buffer, false for malformed or filtered out datagrams
+			bool payload(uint16_t bid, size_t length, const uint8_t** data, size_t* size);
+
+			// Called on the reactor's completion thread
+			void on_completion(int32_t res, uint32_t flags);
+			void on_handled_completion(int32_t res, uint32_t flags);
+		};
+
+		/// Process-wide io_uring instance with a single completion thread serving all the io_uring based ports
+		class io_uring_reactor
+		{
+		private:
+			int m_ring_fd;
+			void* m_sq_ring;
+			size_t m_sq_ring_size;
+			void* m_cq_ring;
+			size_t m_cq_ring_size;
+			io_uring_sqe* m_sqes;
+			size_t m_sqes_size;
+
+			unsigned* m_sq_head;
+			unsigned* m_sq_tail;
+			unsigned m_sq_mask;
+			unsigned m_sq_entries;
+			unsigned* m_sq_array;
+			unsigned* m_cq_head;
+			unsigned* m_cq_tail;
+			unsigned m_cq_mask;
+			io_uring_cqe* m_cqes;
+
+			// Requests queued by other threads are submitted by the completion thread, woken up through this eventfd
+			int m_wakeup_fd;
+			uint64_t m_wakeup_value;
+			bool m_wakeup_armed;
+			unsigned m_pending;
+
+			// Requests waiting for free submission queue entries
+			std::deque<std::function<void(io_uring_sqe&)>> m_backlog;
+
+			std::mutex m_submit_mutex;
+			std::mutex m_receivers_mutex;
+			std::map<uint64_t, io_uring_receiver*> m_receivers;
+			std::set<uint16_t> m_buffer_groups;
+			uint64_t m_next_id;
+			uint16_t m_next_bgid;
+
+			std::atomic<bool> m_running;
+			std::thread m_completion_thread;
+			std::thread::id m_completion_thread_id;
+
+			io_uring_reactor();
+			io_uring_reactor(const io_uring_reactor&) = delete;
+			io_uring_reactor& operator=(const io_uring_reactor&) = delete;
+
+			bool setup();
+			void teardown();
+			void complete();
+			void wake();
+
+			// Should be called while m_submit_mutex is locked
+			unsigned available_entries() const;
+			bool flush();
+			void queue(const std::function<void(io_uring_sqe&)>& prepare);
+			bool submit_backlog();
+
+		public:
+			~io_uring_reactor();
+
+			/// Gets the process-wide reactor. Returns nullptr if io_uring is not supported.
+			static io_uring_reactor* instance();
+
+			/// Queues a request, it is submitted to the kernel by the completion thread.
+			/// Never blocks: requests exceeding the free submission queue entries wait in a backlog.
+			bool submit(const std::function<void(io_uring_sqe&)>& prepare);
+
+			bool add_receiver(io_uring_receiver* receiver);
+			void remove_receiver(io_uring_receiver* receiver);
+		};
+	}
+}
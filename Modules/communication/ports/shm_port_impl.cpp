@@ -0,0 +1,238 @@
+#include "shm_port_impl.h"
+#include <utils/ref_count_ptr.hpp>
+
+#include <cstring>
+
+// Blocking calls wake up periodically to notice disconnections
+static constexpr uint32_t SHM_RECEIVE_POLL_TIMEOUT_MS = 100;
+// How long a send waits for the peer to release space in a full ring
+static constexpr uint32_t SHM_SEND_TIMEOUT_MS = 100;
+
+bool communication::ports::shm_port::create(const char* local_name, const char* remote_name, size_t capacity, uint32_t stall_timeout_ms, core::communication::client_channel_interface** client)
+{
+	if (client == nullptr)
+		return false;
+
+	utils::ref_count_ptr<core::communication::client_channel_interface> instance;
+	try
+	{
+		instance = utils::make_ref_count_ptr<shm_port_impl>(local_name, remote_name, capacity, stall_timeout_ms);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	if (instance == nullptr)
+		return false;
+
+	*client = instance;
+	(*client)->add_ref();
+	return true;
+}
+
+communication::ports::shm_port_impl::shm_port_impl(const char* local_name, const char* remote_name, size_t capacity, uint32_t stall_timeout_ms) :
+	m_stall_timeout(stall_timeout_ms),
+	m_eStatus(core::communication::communication_status::DISCONNECTED),
+	m_read_offset(0),
+	m_lost_messages(0)
+{
+	if (local_name == nullptr || local_name[0] == '\0')
+		throw std::invalid_argument("local_name");
+
+	if (remote_name == nullptr || remote_name[0] == '\0')
+		throw std::invalid_argument("remote_name");
+
+	if (std::strcmp(local_name, remote_name) == 0)
+		throw std::invalid_argument("remote_name");
+
+	if (capacity == 0)
+		throw std::invalid_argument("capacity");
+
+	m_local_name = local_name;
+	m_remote_name = remote_name;
+	m_capacity = capacity;
+}
+
+communication::ports::shm_port_impl::~shm_port_impl()
+{
+	disconnect();
+}
+
+core::communication::communication_status communication::ports::shm_port_impl::status() const
+{
+	return m_eStatus;
+}
+
+bool communication::ports::shm_port_impl::connect()
+{
+	disconnect();
+
+	std::lock_guard<std::mutex> locker(m_read_mutex);
+	std::unique_ptr<communication::ports::shm_ring> inbound;
+	try
+	{
+		inbound.reset(new communication::ports::shm_ring(m_local_name, m_capacity, m_stall_timeout));
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> inbound_locker(m_inbound_mutex);
+		m_inbound = std::move(inbound);
+	}
+
+	m_read_offset = 0;
+	m_eStatus = core::communication::communication_status::CONNECTED;
+
+	// The peer might not be up yet, sending reopens its ring when needed
+	std::lock_guard<std::mutex> send_locker(m_send_mutex);
+	open_outbound();
+	return true;
+}
+
+bool communication::ports::shm_port_impl::disconnect()
+{
+	m_eStatus = core::communication::communication_status::DISCONNECTED;
+
+	{
+		std::lock_guard<std::mutex> send_locker(m_send_mutex);
+		m_outbound.reset();
+	}
+
+	// Waking a blocked reader up before releasing the ring
+	std::unique_lock<std::mutex> locker(m_read_mutex, std::defer_lock);
+	{
+		std::lock_guard<std::mutex> inbound_locker(m_inbound_mutex);
+		if (m_inbound != nullptr)
+			m_inbound->close();
+	}
+
+	locker.lock();
+	std::lock_guard<std::mutex> inbound_locker(m_inbound_mutex);
+	release_inbound();
+	return true;
+}
+
+void communication::ports::shm_port_impl::release_inbound()
+{
+	if (m_inbound == nullptr)
+		return;
+
+	// Messages left in the ring on disconnect were not missed, the peer was told the port was closed
+	m_lost_messages += m_inbound->skipped_messages();
+	m_inbound.reset();
+}
+
+bool communication::ports::shm_port_impl::recreate_inbound()
+{
+	std::lock_guard<std::mutex> inbound_locker(m_inbound_mutex);
+	m_lost_messages += m_inbound->pending_messages();
+	release_inbound();
+	m_read_offset = 0;
+	try
+	{
+		m_inbound.reset(new communication::ports::shm_ring(m_local_name, m_capacity, m_stall_timeout));
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool communication::ports::shm_port_impl::open_outbound() const
+{
+	if (m_outbound != nullptr && m_outbound->closed() == false)
+		return true;
+
+	try
+	{
+		m_outbound.reset(new communication::ports::shm_ring(m_remote_name));
+	}
+	catch (...)
+	{
+		m_outbound.reset();
+		return false;
+	}
+
+	return (m_outbound->closed() == false);
+}
+
+size_t communication::ports::shm_port_impl::send(const void* buffer, size_t size) const
+{
+	if (buffer == nullptr || size == 0 || m_eStatus != core::communication::communication_status::CONNECTED)
+		return 0;
+
+	std::lock_guard<std::mutex> locker(m_send_mutex);
+
+	// Like a UDP port, messages sent while the peer is down are lost
+	if (open_outbound() == false)
+		return 0;
+
+	if (m_outbound->write(buffer, size, SHM_SEND_TIMEOUT_MS) == false)
+		return 0;
+
+	return size;
+}
+
+size_t communication::ports::shm_port_impl::recieve(void* buffer, size_t size, core::communication::communication_error* commError)
+{
+	std::lock_guard<std::mutex> locker(m_read_mutex);
+
+	size_t nTotal = 0;
+	uint8_t* target_buffer = static_cast<uint8_t*>(buffer);
+	do
+	{
+		size_t message_size = 0;
+		const uint8_t* message = nullptr;
+		while (m_inbound != nullptr && (message = m_inbound->front(message_size)) == nullptr)
+		{
+			if (m_eStatus != core::communication::communication_status::CONNECTED || m_inbound->closed() == true)
+				break;
+
+			// A producer died without leaving a way past its record, the ring is replaced (the old one is removed first)
+			if (m_inbound->wedged() == true && recreate_inbound() == false)
+				break;
+
+			m_inbound->wait(SHM_RECEIVE_POLL_TIMEOUT_MS);
+		}
+
+		if (message == nullptr)
+		{
+			*commError = core::communication::communication_error::UNKNOWN_ERROR;
+			return 0;
+		}
+
+		// A size of 0 reads the rest of the current message
+		size_t read_size = message_size - m_read_offset;
+		if (size > 0)
+			read_size = (std::min)(read_size, size - nTotal);
+
+		std::memcpy(target_buffer + nTotal, message + m_read_offset, read_size);
+		m_read_offset += read_size;
+		nTotal += read_size;
+
+		if (m_read_offset == message_size)
+		{
+			m_inbound->pop();
+			m_read_offset = 0;
+		}
+	} while (nTotal < size);
+
+	*commError = core::communication::communication_error::NO_ERRORS;
+	return nTotal;
+}
+
+uint64_t communication::ports::shm_port_impl::lost_messages() const
+{
+	std::lock_guard<std::mutex> inbound_locker(m_inbound_mutex);
+	uint64_t lost = m_lost_messages;
+	if (m_inbound != nullptr)
+		lost += m_inbound->skipped_messages();
+
+	return lost;
+}
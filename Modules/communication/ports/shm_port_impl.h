@@ -0,0 +1,54 @@
+#pragma once
+#include <communication/ports/shm_port.h>
+#include <utils/ref_count_base.hpp>
+
+#include "shm_ring.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace communication
+{
+	namespace ports
+	{
+		class shm_port_impl : public utils::ref_count_base<communication::ports::shm_port>
+		{
+		public:
+			shm_port_impl(const char* local_name, const char* remote_name, size_t capacity, uint32_t stall_timeout_ms);
+			virtual ~shm_port_impl();
+
+			// Inherited via ref_count_base
+			virtual core::communication::communication_status status() const override;
+			virtual bool connect() override;
+			virtual bool disconnect() override;
+			virtual size_t send(const void* buffer, size_t size) const override;
+			virtual size_t recieve(void* buffer, size_t size, core::communication::communication_error* commError) override;
+			virtual uint64_t lost_messages() const override;
+
+		private:
+			std::string m_local_name;
+			std::string m_remote_name;
+			size_t m_capacity;
+			std::chrono::milliseconds m_stall_timeout;
+			std::atomic<core::communication::communication_status> m_eStatus;
+
+			// Receiving side, owned by this port
+			std::mutex m_read_mutex;
+			mutable std::mutex m_inbound_mutex; // Closing the ring from disconnect while the reader may replace it
+			std::unique_ptr<communication::ports::shm_ring> m_inbound;
+			size_t m_read_offset;
+			uint64_t m_lost_messages; // By the rings released, under m_inbound_mutex
+
+			// Sending side, (re)opened once the peer has created its ring
+			mutable std::mutex m_send_mutex;
+			mutable std::unique_ptr<communication::ports::shm_ring> m_outbound;
+
+			bool recreate_inbound();
+			void release_inbound();
+			bool open_outbound() const;
+		};
+	}
+}
@@ -0,0 +1,407 @@
+#include "shm_ring.h"
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <signal.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+static constexpr uint64_t SHM_RING_MAGIC = 0x474E495250524853ULL; // "SHRPRING"
+static constexpr uint32_t SHM_RING_VERSION = 2;
+static constexpr uint64_t SHM_RING_MIN_CAPACITY = 4096;
+
+// A record is an 8 bytes header (length, flags) followed by the message, padded to 8 bytes.
+// A header is 0 until its record is reserved (stamped with the length and the producer's pid) then committed,
+// the consumer zeroes the records it releases.
+static constexpr uint64_t RECORD_COMMITTED = 1ULL << 32;
+static constexpr uint64_t RECORD_PADDING = 1ULL << 33;
+static constexpr uint64_t RECORD_RESERVED = 1ULL << 34;
+static constexpr uint32_t RECORD_OWNER_SHIFT = 35;
+static constexpr uint64_t RECORD_LENGTH_MASK = 0xFFFFFFFFULL;
+static constexpr uint64_t RECORD_HEADER_SIZE = sizeof(uint64_t);
+
+// How long the head may stay on an uncommitted record before its owner is checked, and between checks
+static constexpr std::chrono::milliseconds SHM_RING_OWNER_CHECK_INTERVAL(10);
+
+// Polls before sleeping on the futex, a peer which is actively sending is then served without a system call.
+// Only when the peer can run in parallel.
+static constexpr uint32_t CONSUMER_SPIN_ITERATIONS = 4000;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "The shared memory ring requires lock-free atomics");
+
+struct communication::ports::shm_ring::header
+{
+	std::atomic<uint64_t> magic;
+	uint32_t version;
+	uint32_t reserved;
+	uint64_t capacity;
+	std::atomic<uint32_t> closed;
+	std::atomic<uint32_t> consumer_waiting;
+	std::atomic<uint32_t> data_sequence;
+	std::atomic<uint32_t> producers_waiting;
+	std::atomic<uint32_t> space_sequence;
+	uint8_t padding0[20];
+
+	// Consumer and producers indices on separate cache lines
+	std::atomic<uint64_t> head;
+	uint8_t padding1[56];
+	std::atomic<uint64_t> tail;
+	// Records reserved by the producers, counted right after the tail's CAS on its cache line
+	std::atomic<uint64_t> reserved_messages;
+	uint8_t padding2[48];
+};
+
+static_assert(sizeof(communication::ports::shm_ring::header) == 192, "Unexpected shared memory ring header layout");
+
+static uint64_t record_size(uint64_t length)
+{
+	return (RECORD_HEADER_SIZE + length + 7) & ~7ULL;
+}
+
+static void wait_on(std::atomic<uint32_t>& word, uint32_t expected, uint32_t timeout_ms)
+{
+#ifdef __linux__
+	// Not a private futex: the word is shared between processes
+	timespec timeout;
+	timeout.tv_sec = timeout_ms / 1000;
+	timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+	::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+	if (word.load() == expected)
+		std::this_thread::sleep_for(std::chrono::milliseconds((std::min)(timeout_ms, 1u)));
+#endif
+}
+
+static void wake_all(std::atomic<uint32_t>& word)
+{
+#ifdef __linux__
+	::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+	(void)word;
+#endif
+}
+
+static uint64_t current_owner()
+{
+#ifdef __linux__
+	return static_cast<uint64_t>(::getpid());
+#else
+	return 0;
+#endif
+}
+
+// False only when the owner is known to be gone, an unknown owner is presumed alive
+static bool owner_alive(uint64_t owner)
+{
+#ifdef __linux__
+	return (owner == 0 || ::kill(static_cast<pid_t>(owner), 0) == 0 || errno != ESRCH);
+#else
+	(void)owner;
+	return true;
+#endif
+}
+
+communication::ports::shm_ring::shm_ring(const std::string& name, size_t capacity, std::chrono::milliseconds stall_timeout) :
+	m_name(name),
+	m_owner(true),
+	m_header(nullptr),
+	m_data(nullptr),
+	m_capacity(SHM_RING_MIN_CAPACITY),
+	m_stall_timeout(stall_timeout),
+	m_stall_position(UINT64_MAX),
+	m_wedged(false),
+	m_consumed(0),
+	m_skipped(0)
+{
+	while (m_capacity < capacity)
+		m_capacity <<= 1;
+
+	// A segment left by a crashed consumer
+	boost::interprocess::shared_memory_object::remove(m_name.c_str());
+
+	m_segment.reset(new boost::interprocess::shared_memory_object(boost::interprocess::create_only, m_name.c_str(), boost::interprocess::read_write));
+	m_segment->truncate(static_cast<boost::interprocess::offset_t>(sizeof(header) + m_capacity));
+	m_region = boost::interprocess::mapped_region(*m_segment, boost::interprocess::read_write);
+
+	// The truncated segment is zero filled, so every record header starts uncommitted
+	m_header = new (m_region.get_address()) header();
+	m_data = static_cast<uint8_t*>(m_region.get_address()) + sizeof(header);
+	m_header->version = SHM_RING_VERSION;
+	m_header->capacity = m_capacity;
+	m_header->closed = 0;
+	m_header->consumer_waiting = 0;
+	m_header->data_sequence = 0;
+	m_header->producers_waiting = 0;
+	m_header->space_sequence = 0;
+	m_header->head = 0;
+	m_header->tail = 0;
+	m_header->reserved_messages = 0;
+
+	// Published last, producers ignore the ring until then
+	m_header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+}
+
+communication::ports::shm_ring::shm_ring(const std::string& name) :
+	m_name(name),
+	m_owner(false),
+	m_header(nullptr),
+	m_data(nullptr),
+	m_capacity(0),
+	m_stall_timeout(0),
+	m_stall_position(UINT64_MAX),
+	m_wedged(false),
+	m_consumed(0),
+	m_skipped(0)
+{
+	m_segment.reset(new boost::interprocess::shared_memory_object(boost::interprocess::open_only, m_name.c_str(), boost::interprocess::read_write));
+	m_region = boost::interprocess::mapped_region(*m_segment, boost::interprocess::read_write);
+	if (m_region.get_size() < sizeof(header))
+		throw std::runtime_error("Invalid shared memory ring");
+
+	m_header = static_cast<header*>(m_region.get_address());
+	if (m_header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC || m_header->version != SHM_RING_VERSION)
+		throw std::runtime_error("Shared memory ring is not initialized");
+
+	m_capacity = m_header->capacity;
+	if (m_region.get_size() < sizeof(header) + m_capacity || (m_capacity & (m_capacity - 1)) != 0)
+		throw std::runtime_error("Invalid shared memory ring");
+
+	m_data = static_cast<uint8_t*>(m_region.get_address()) + sizeof(header);
+}
+
+communication::ports::shm_ring::~shm_ring()
+{
+	if (m_owner == true)
+	{
+		close();
+		boost::interprocess::shared_memory_object::remove(m_name.c_str());
+	}
+}
+
+std::atomic<uint64_t>& communication::ports::shm_ring::record_header(uint64_t position)
+{
+	return *reinterpret_cast<std::atomic<uint64_t>*>(m_data + (position & (m_capacity - 1)));
+}
+
+size_t communication::ports::shm_ring::max_message_size() const
+{
+	// Half of the ring guarantees a record always fits, either at the current position or after a padding record
+	return static_cast<size_t>(m_capacity / 2 - RECORD_HEADER_SIZE);
+}
+
+bool communication::ports::shm_ring::closed() const
+{
+	return (m_header->closed.load(std::memory_order_acquire) != 0);
+}
+
+void communication::ports::shm_ring::close()
+{
+	m_header->closed.store(1, std::memory_order_release);
+
+	m_header->data_sequence.fetch_add(1);
+	wake_all(m_header->data_sequence);
+	m_header->space_sequence.fetch_add(1);
+	wake_all(m_header->space_sequence);
+}
+
+bool communication::ports::shm_ring::write(const void* data, size_t size, uint32_t timeout_ms)
+{
+	if (size > max_message_size())
+		return false;
+
+	uint64_t record = record_size(size);
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+	uint64_t tail;
+	uint64_t padding;
+	while (true)
+	{
+		if (closed() == true)
+			return false;
+
+		tail = m_header->tail.load(std::memory_order_relaxed);
+		uint64_t position = tail & (m_capacity - 1);
+		padding = (m_capacity - position < record) ? (m_capacity - position) : 0;
+
+		uint64_t head = m_header->head.load(std::memory_order_acquire);
+		if (tail + padding + record - head <= m_capacity)
+		{
+			if (m_header->tail.compare_exchange_weak(tail, tail + padding + record, std::memory_order_acq_rel))
+			{
+				m_header->reserved_messages.fetch_add(1, std::memory_order_relaxed);
+				break;
+			}
+
+			continue;
+		}
+
+		// Full, waiting for the consumer to release records
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now >= deadline)
+			return false;
+
+		m_header->producers_waiting.fetch_add(1);
+		uint32_t sequence = m_header->space_sequence.load();
+		if (m_header->head.load() == head)
+		{
+			uint32_t remaining = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1;
+			wait_on(m_header->space_sequence, sequence, remaining);
+		}
+
+		m_header->producers_waiting.fetch_sub(1);
+	}
+
+	if (padding > 0)
+		record_header(tail).store(padding | RECORD_PADDING | RECORD_COMMITTED, std::memory_order_release);
+
+	// Stamped before writing, the consumer can skip the record if this process dies before committing it
+	uint64_t position = tail + padding;
+	record_header(position).store(static_cast<uint64_t>(size) | RECORD_RESERVED | (current_owner() << RECORD_OWNER_SHIFT), std::memory_order_release);
+	std::memcpy(m_data + (position & (m_capacity - 1)) + RECORD_HEADER_SIZE, data, size);
+	record_header(position).store(static_cast<uint64_t>(size) | RECORD_COMMITTED, std::memory_order_release);
+
+	m_header->data_sequence.fetch_add(1);
+	if (m_header->consumer_waiting.load() != 0)
+		wake_all(m_header->data_sequence);
+
+	return true;
+}
+
+const uint8_t* communication::ports::shm_ring::front(size_t& size)
+{
+	while (true)
+	{
+		uint64_t head = m_header->head.load(std::memory_order_relaxed);
+		if (head == m_header->tail.load(std::memory_order_acquire))
+			return nullptr;
+
+		// Reserved but not committed yet
+		uint64_t value = record_header(head).load(std::memory_order_acquire);
+		if ((value & RECORD_COMMITTED) == 0)
+		{
+			if (abandoned(head, value) == false)
+				return nullptr;
+
+			// Its producer died while writing it
+			uint64_t record = record_size(value & RECORD_LENGTH_MASK);
+			std::memset(m_data + (head & (m_capacity - 1)), 0, static_cast<size_t>(record));
+			m_header->head.store(head + record, std::memory_order_seq_cst);
+			m_consumed++;
+			m_skipped++;
+
+			m_header->space_sequence.fetch_add(1);
+			if (m_header->producers_waiting.load() != 0)
+				wake_all(m_header->space_sequence);
+
+			continue;
+		}
+
+		uint64_t length = value & RECORD_LENGTH_MASK;
+		if ((value & RECORD_PADDING) == 0)
+		{
+			size = static_cast<size_t>(length);
+			return m_data + (head & (m_capacity - 1)) + RECORD_HEADER_SIZE;
+		}
+
+		// Skipping the padding up to the end of the ring
+		std::memset(m_data + (head & (m_capacity - 1)), 0, static_cast<size_t>(length));
+		m_header->head.store(head + length, std::memory_order_release);
+	}
+}
+
+bool communication::ports::shm_ring::abandoned(uint64_t head, uint64_t value)
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (head != m_stall_position)
+	{
+		m_stall_position = head;
+		m_stall_since = now;
+		m_next_owner_check = now + SHM_RING_OWNER_CHECK_INTERVAL;
+		m_wedged = false;
+		return false;
+	}
+
+	if (now < m_next_owner_check)
+		return false;
+
+	m_next_owner_check = now + SHM_RING_OWNER_CHECK_INTERVAL;
+
+	// A stamped record is skipped once its owner is gone, a live owner may be stopped, swapped out or starved
+	uint64_t owner = value >> RECORD_OWNER_SHIFT;
+	if ((value & RECORD_RESERVED) != 0 && owner != 0)
+		return (owner_alive(owner) == false);
+
+	// Not stamped yet or without a known owner, its producer might have died right after reserving it
+	if (m_stall_timeout.count() > 0 && now - m_stall_since >= m_stall_timeout)
+		m_wedged = true;
+
+	return false;
+}
+
+bool communication::ports::shm_ring::wedged() const
+{
+	return m_wedged;
+}
+
+uint64_t communication::ports::shm_ring::pending_messages() const
+{
+	// A producer counts its record after reserving it, the record may be consumed first
+	uint64_t reserved = m_header->reserved_messages.load(std::memory_order_relaxed);
+	return (reserved > m_consumed) ? reserved - m_consumed : 0;
+}
+
+uint64_t communication::ports::shm_ring::skipped_messages() const
+{
+	return m_skipped;
+}
+
+void communication::ports::shm_ring::pop()
+{
+	uint64_t head = m_header->head.load(std::memory_order_relaxed);
+	uint64_t value = record_header(head).load(std::memory_order_acquire);
+	if ((value & RECORD_COMMITTED) == 0)
+		return;
+
+	uint64_t record = ((value & RECORD_PADDING) != 0) ? (value & RECORD_LENGTH_MASK) : record_size(value & RECORD_LENGTH_MASK);
+	std::memset(m_data + (head & (m_capacity - 1)), 0, static_cast<size_t>(record));
+	m_header->head.store(head + record, std::memory_order_seq_cst);
+	if ((value & RECORD_PADDING) == 0)
+		m_consumed++;
+
+	m_header->space_sequence.fetch_add(1);
+	if (m_header->producers_waiting.load() != 0)
+		wake_all(m_header->space_sequence);
+}
+
+bool communication::ports::shm_ring::wait(uint32_t timeout_ms)
+{
+	static const uint32_t spin_iterations = (std::thread::hardware_concurrency() > 1) ? CONSUMER_SPIN_ITERATIONS : 1;
+
+	size_t size;
+	for (uint32_t i = 0; i < spin_iterations; i++)
+	{
+		if (front(size) != nullptr)
+			return true;
+
+		if (closed() == true)
+			return false;
+	}
+
+	// Producers wake the consumer up only while it is flagged as waiting
+	m_header->consumer_waiting.store(1);
+	uint32_t sequence = m_header->data_sequence.load();
+	if (front(size) == nullptr && closed() == false)
+		wait_on(m_header->data_sequence, sequence, timeout_ms);
+
+	m_header->consumer_waiting.store(0);
+	return (front(size) != nullptr);
+}
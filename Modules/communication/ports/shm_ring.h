@@ -0,0 +1,98 @@
+#pragma once
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace communication
+{
+	namespace ports
+	{
+		/// A multi-producer, single-consumer ring of variable length messages in a named shared memory segment.
+		/// The consumer creates (and owns) the segment, producers from any process open it by name.
+		/// Producers reserve space with a CAS on the tail and commit each record by publishing its header,
+		/// the consumer waits on a futex when the ring is empty and producers wait on another one when it is full.
+		/// Right after its CAS, a producer stamps the record header with its pid. A record whose owner died before
+		/// committing it is skipped by the consumer, so a crashed producer does not wedge the ring, while a live owner
+		/// (even stopped or starved) is waited for. A record left unstamped by a producer dying between the CAS and the
+		/// stamp (a single store) can not be sized: once such a record, or one without a known owner, stays uncommitted for
+		/// the stall timeout, wedged() asks the consumer to recreate the ring. Producers reopen it as they do after a
+		/// consumer restart and the messages in flight are lost (pending_messages).
+		/// Owners are checked with kill(pid, 0), producers and the consumer must share a PID namespace.
+		class shm_ring
+		{
+		public:
+			struct header;
+
+			/// Creates the ring as its consumer, replacing a stale segment of the same name.
+			/// 'stall_timeout' is how long an unstamped record may block the ring before it is wedged, 0 waits forever.
+			shm_ring(const std::string& name, size_t capacity, std::chrono::milliseconds stall_timeout);
+
+			/// Opens an existing ring as a producer, throws if the ring does not exist
+			explicit shm_ring(const std::string& name);
+
+			/// The consumer removes the segment, producers only unmap it
+			~shm_ring();
+
+			/// Largest message which can be written to the ring
+			size_t max_message_size() const;
+
+			/// True once the consumer has closed the ring (producers should reopen it)
+			bool closed() const;
+
+			/// Consumer: marks the ring as closed and wakes up everyone waiting on it
+			void close();
+
+			/// Producer: writes a message, waiting up to 'timeout_ms' for free space. Returns false when the message
+			/// is too large, the ring stays full or it was closed.
+			bool write(const void* data, size_t size, uint32_t timeout_ms);
+
+			/// Consumer: gets the oldest committed message, or nullptr if there is none
+			const uint8_t* front(size_t& size);
+
+			/// Consumer: releases the message returned by front
+			void pop();
+
+			/// Consumer: waits up to 'timeout_ms' for a message. Returns true if a message is available.
+			bool wait(uint32_t timeout_ms);
+
+			/// Consumer: true when the oldest record can neither be committed nor skipped anymore, the ring should be recreated
+			bool wedged() const;
+
+			/// Consumer: messages reserved by the producers and not consumed yet, lost if the ring is recreated
+			uint64_t pending_messages() const;
+
+			/// Consumer: records skipped because their producer died while writing them
+			uint64_t skipped_messages() const;
+
+		private:
+			std::string m_name;
+			bool m_owner;
+			std::unique_ptr<boost::interprocess::shared_memory_object> m_segment;
+			boost::interprocess::mapped_region m_region;
+			header* m_header;
+			uint8_t* m_data;
+			uint64_t m_capacity;
+			std::chrono::milliseconds m_stall_timeout;
+
+			// Consumer: the uncommitted record the head is stalled on, since when and when to check its owner next
+			uint64_t m_stall_position;
+			std::chrono::steady_clock::time_point m_stall_since;
+			std::chrono::steady_clock::time_point m_next_owner_check;
+			bool m_wedged;
+
+			// Consumer: messages popped or skipped, the messages skipped
+			uint64_t m_consumed;
+			std::atomic<uint64_t> m_skipped;
+
+			std::atomic<uint64_t>& record_header(uint64_t position);
+			bool abandoned(uint64_t head, uint64_t value);
+
+			shm_ring(const shm_ring&) = delete;
+			shm_ring& operator=(const shm_ring&) = delete;
+		};
+	}
+}
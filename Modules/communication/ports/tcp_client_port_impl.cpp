@@ -11,7 +11,17 @@ bool communication::ports::tcp_client_port::create(const char* strRemoteHostname
 	return create(strRemoteHostname, nRemotePort, strLocalHostname, nLocalPort, false, channel);
 }
 
+#ifdef HAVE_IO_URING
+static constexpr size_t TCP_URING_BUFFER_SIZE = 16384;
+static constexpr uint16_t TCP_URING_BUFFER_COUNT = 64;
+#endif
+
 bool communication::ports::tcp_client_port::create(const char* strRemoteHostname, uint16_t nRemotePort, const char* strLocalHostname, uint16_t nLocalPort, bool bNoDelaySend, core::communication::client_channel_interface** channel)
+{
+	return create(strRemoteHostname, nRemotePort, strLocalHostname, nLocalPort, bNoDelaySend, communication::ports::io_backend::blocking, channel);
+}
+
+bool communication::ports::tcp_client_port::create(const char* strRemoteHostname, uint16_t nRemotePort, const char* strLocalHostname, uint16_t nLocalPort, bool bNoDelaySend, communication::ports::io_backend backend, core::communication::client_channel_interface** channel)
 {
 	if (channel == nullptr)
 		return false;
@@ -19,7 +29,7 @@ bool communication::ports::tcp_client_port::create(const char* strRemoteHostname
 	utils::ref_count_ptr<core::communication::client_channel_interface> instance;
 	try
 	{
-		instance = utils::make_ref_count_ptr<tcp_client_port_impl>(strRemoteHostname, nRemotePort, strLocalHostname, nLocalPort, bNoDelaySend);
+		instance = utils::make_ref_count_ptr<tcp_client_port_impl>(strRemoteHostname, nRemotePort, strLocalHostname, nLocalPort, bNoDelaySend, backend);
 	}
 	catch (...)
 	{
@@ -34,7 +44,7 @@ bool communication::ports::tcp_client_port::create(const char* strRemoteHostname
 	return true;
 }
 
-communication::ports::tcp_client_port_impl::tcp_client_port_impl(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool bNoDelaySend) :
+communication::ports::tcp_client_port_impl::tcp_client_port_impl(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool bNoDelaySend, communication::ports::io_backend backend) :
 	m_strRemoteHostname(strRemoteHostname),
 	m_usRemotePort(usRemotePort),
 	m_strLocalHostname(strLocalHostname),
@@ -42,17 +52,40 @@ communication::ports::tcp_client_port_impl::tcp_client_port_impl(const char* str
 	m_eStatus(core::communication::communication_status::DISCONNECTED),
 	m_socket(m_io_service),
 	m_resolver(m_io_service),
-	m_noDelay(bNoDelaySend)
+	m_noDelay(bNoDelaySend),
+	m_backend(backend)
 {
 }
 
 
 
+#ifdef HAVE_IO_URING
+utils::ref_count_ptr<communication::ports::io_uring_receiver> communication::ports::tcp_client_port_impl::uring_receiver()
+{
+	std::lock_guard<std::mutex> locker(m_uring_mutex);
+	return m_uring_receiver;
+}
+#endif
+
 core::communication::communication_status communication::ports::tcp_client_port_impl::status() const
 {
 	return m_eStatus;
 }
 
+bool communication::ports::tcp_client_port_impl::set_frame_callback(core::communication::frame_callback_interface* callback)
+{
+	if (m_eStatus == core::communication::communication_status::CONNECTED)
+		return false;
+
+	// Only io_uring completions are delivered directly
+	if (callback != nullptr &&
+		(m_backend != communication::ports::io_backend::io_uring || communication::ports::io_uring_backend::supported() == false))
+		return false;
+
+	m_frame_callback = callback;
+	return true;
+}
+
 bool communication::ports::tcp_client_port_impl::connect()
 {
 	disconnect();
@@ -81,6 +114,52 @@ bool communication::ports::tcp_client_port_impl::connect()
 		{
 			return false;
 		}
+
+#ifdef HAVE_IO_URING
+		if (m_backend == communication::ports::io_backend::io_uring)
+		{
+			utils::ref_count_ptr<communication::ports::io_uring_receiver> receiver;
+			utils::ref_count_ptr<core::communication::frame_callback_interface> callback = m_frame_callback;
+			try
+			{
+				receiver = utils::make_ref_count_ptr<communication::ports::io_uring_receiver>(
+					static_cast<int>(m_socket.native_handle()), false, TCP_URING_BUFFER_SIZE, TCP_URING_BUFFER_COUNT);
+
+				if (callback != nullptr)
+				{
+					receiver->set_handlers(
+						[callback](const uint8_t* data, size_t size)
+						{
+							callback->on_frame(data, size);
+						},
+						[this, callback](int error)
+						{
+							m_eStatus = core::communication::communication_status::DISCONNECTED;
+							callback->on_closed(ParseError(boost::system::error_code(error, boost::system::system_category())));
+						});
+				}
+
+				// Falling back to blocking reads when the kernel does not support multishot receives/buffer rings
+				if (receiver->start() == false)
+					receiver.release();
+			}
+			catch (...)
+			{
+				receiver.release();
+			}
+
+			// Without io_uring, nothing would deliver the frames to the callback
+			if (receiver == nullptr && callback != nullptr)
+			{
+				m_socket.close(ec);
+				return false;
+			}
+
+			std::lock_guard<std::mutex> locker(m_uring_mutex);
+			m_uring_receiver = receiver;
+		}
+#endif
+
 		m_eStatus = core::communication::communication_status::CONNECTED;
 		return true;
 	}
@@ -95,6 +174,20 @@ bool communication::ports::tcp_client_port_impl::disconnect()
 	try
 	{
 		boost::system::error_code ec;
+
+#ifdef HAVE_IO_URING
+		// Readers hold their own reference, the receiver is stopped (waking them up) once no new reader can get it
+		utils::ref_count_ptr<communication::ports::io_uring_receiver> receiver;
+		{
+			std::lock_guard<std::mutex> locker(m_uring_mutex);
+			receiver = m_uring_receiver;
+			m_uring_receiver.release();
+		}
+
+		if (receiver != nullptr)
+			receiver->stop();
+#endif
+
 		m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
 		if (ec.value() != 0)
 		{
@@ -137,6 +230,20 @@ size_t communication::ports::tcp_client_port_impl::recieve(void* buffer, size_t
 	boost::system::error_code ec;
 	try
 	{
+#ifdef HAVE_IO_URING
+		utils::ref_count_ptr<communication::ports::io_uring_receiver> receiver = uring_receiver();
+		if (receiver != nullptr)
+		{
+			int error = 0;
+			size_t nRead = receiver->read(buffer, size, &error);
+			if (nRead == 0)
+				m_eStatus = core::communication::communication_status::DISCONNECTED;
+
+			*commError = ParseError(boost::system::error_code(error, boost::system::system_category()));
+			return nRead;
+		}
+#endif
+
 		size_t nTotal = 0;
 		size_t nDataleft = size;
 		size_t nCurrentRead = 0;
@@ -8,6 +8,10 @@
 #include <mutex>
 #include <string>
 
+#ifdef HAVE_IO_URING
+#include "io_uring_reactor.h"
+#endif
+
 namespace communication
 {
 	namespace ports
@@ -19,7 +23,7 @@ namespace communication
 			//--------------------------------------------------------
 			//Class constructor
 			//--------------------------------------------------------
-			tcp_client_port_impl(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool bNoDelaySend);
+			tcp_client_port_impl(const char* strRemoteHostname, uint16_t usRemotePort, const char* strLocalHostname, uint16_t usLocalPort, bool bNoDelaySend, communication::ports::io_backend backend = communication::ports::io_backend::blocking);
 
 			
 			// Inherited via ref_count_base
@@ -30,6 +34,7 @@ namespace communication
 			virtual size_t recieve(void* buffer, size_t size, core::communication::communication_error* commError) override;
 			virtual bool query_local_endpoint(core::communication::ip_endpoint& end_point)  const override ;
 			virtual bool query_remote_endpoint(core::communication::ip_endpoint& end_point)const override ;			
+			virtual bool set_frame_callback(core::communication::frame_callback_interface* callback) override;
 			
 		private:
 			//--------------------------------------------------------
@@ -44,6 +49,14 @@ namespace communication
 			mutable boost::asio::ip::tcp::socket m_socket;
 			boost::asio::ip::tcp::resolver m_resolver;
 			bool m_noDelay;
+			communication::ports::io_backend m_backend;
+			utils::ref_count_ptr<core::communication::frame_callback_interface> m_frame_callback;
+#ifdef HAVE_IO_URING
+			std::mutex m_uring_mutex;
+			utils::ref_count_ptr<communication::ports::io_uring_receiver> m_uring_receiver;
+
+			utils::ref_count_ptr<communication::ports::io_uring_receiver> uring_receiver();
+#endif
 
 			core::communication::communication_error ParseError(boost::system::error_code ec);
 		};
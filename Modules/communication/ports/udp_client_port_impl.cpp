@@ -13,12 +13,19 @@
 // is 65,507 bytes (65,535 - 8 byte UDP header - 20 byte IP header)
 static constexpr size_t UDP_CACHE_SIZE = 65507;
 
+// io_uring receive ring: each buffer holds a whole datagram preceded by the recvmsg header and the source address
+#ifdef HAVE_IO_URING
+static constexpr size_t UDP_URING_BUFFER_SIZE = UDP_CACHE_SIZE + sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_storage);
+static constexpr uint16_t UDP_URING_BUFFER_COUNT = 32;
+#endif
+
 bool communication::ports::udp_client_port::create(
 	const char* strRemoteHostname, uint16_t nRemotePort, 
 	const char* strLocalHostname, uint16_t nLocalPort,
 	bool multicast,
 	int receive_buffer_size,
 	int send_buffer_size,
+	communication::ports::io_backend backend,
 	core::communication::client_channel_interface** client)
 {
 	if (client == nullptr)
@@ -27,7 +34,7 @@ bool communication::ports::udp_client_port::create(
 	utils::ref_count_ptr<core::communication::client_channel_interface> instance;
 	try
 	{
-		instance = utils::make_ref_count_ptr<udp_client_port_impl>(strRemoteHostname, nRemotePort, strLocalHostname, nLocalPort, multicast, receive_buffer_size, send_buffer_size);
+		instance = utils::make_ref_count_ptr<udp_client_port_impl>(strRemoteHostname, nRemotePort, strLocalHostname, nLocalPort, multicast, receive_buffer_size, send_buffer_size, backend);
 	}
 	catch (...)
 	{
@@ -42,6 +49,17 @@ bool communication::ports::udp_client_port::create(
 	return true;
 }
 
+bool communication::ports::udp_client_port::create(
+	const char* strRemoteHostname, uint16_t nRemotePort,
+	const char* strLocalHostname, uint16_t nLocalPort,
+	bool multicast,
+	int receive_buffer_size,
+	int send_buffer_size,
+	core::communication::client_channel_interface** client)
+{
+	return communication::ports::udp_client_port::create(strRemoteHostname, nRemotePort, strLocalHostname, nLocalPort, multicast, receive_buffer_size, send_buffer_size, communication::ports::io_backend::blocking, client);
+}
+
 bool communication::ports::udp_client_port::create(
 	const char* strRemoteHostname, uint16_t nRemotePort,
 	const char* strLocalHostname, uint16_t nLocalPort,
@@ -66,7 +84,8 @@ communication::ports::udp_client_port_impl::udp_client_port_impl(
 	uint16_t usLocalPort,
 	bool multicast,
 	int receive_buffer_size,
-	int send_buffer_size) :
+	int send_buffer_size,
+	communication::ports::io_backend backend) :
 	m_local_endpoint(boost::asio::ip::address::from_string(strLocalHostname), usLocalPort),
 	m_remote_endpoint(boost::asio::ip::address::from_string(strRemoteHostname), usRemotePort),
 	m_multicast(multicast),
@@ -77,15 +96,38 @@ communication::ports::udp_client_port_impl::udp_client_port_impl(
 	m_socket(m_io_service),
 	m_resolver(m_io_service),
 	m_receive_buffer_size(receive_buffer_size),
-	m_send_buffer_size(send_buffer_size)
+	m_send_buffer_size(send_buffer_size),
+	m_backend(backend)
 {	
 }
 
+#ifdef HAVE_IO_URING
+utils::ref_count_ptr<communication::ports::io_uring_receiver> communication::ports::udp_client_port_impl::uring_receiver()
+{
+	std::lock_guard<std::mutex> locker(m_uring_mutex);
+	return m_uring_receiver;
+}
+#endif
+
 core::communication::communication_status communication::ports::udp_client_port_impl::status() const
 {
 	return m_eStatus;
 }
 
+bool communication::ports::udp_client_port_impl::set_frame_callback(core::communication::frame_callback_interface* callback)
+{
+	if (m_eStatus == core::communication::communication_status::CONNECTED)
+		return false;
+
+	// Only io_uring completions are delivered directly
+	if (callback != nullptr &&
+		(m_backend != communication::ports::io_backend::io_uring || communication::ports::io_uring_backend::supported() == false))
+		return false;
+
+	m_frame_callback = callback;
+	return true;
+}
+
 bool communication::ports::udp_client_port_impl::connect()
 {	
 	disconnect();
@@ -140,6 +182,68 @@ bool communication::ports::udp_client_port_impl::connect()
 			}
 		}				
 
+#ifdef HAVE_IO_URING
+		if (ans == true && m_backend == communication::ports::io_backend::io_uring)
+		{
+			boost::asio::ip::address remote_address = m_remote_endpoint.address();
+			communication::ports::io_uring_receiver::source_filter filter;
+			if (m_multicast == false && remote_address.is_unspecified() == false)
+			{
+				filter = [remote_address](const sockaddr* address, socklen_t address_length)
+				{
+					boost::asio::ip::udp::endpoint recieve_endpoint;
+					if (static_cast<size_t>(address_length) > recieve_endpoint.capacity())
+						return false;
+
+					std::memcpy(recieve_endpoint.data(), address, address_length);
+					recieve_endpoint.resize(address_length);
+					return (recieve_endpoint.address() == remote_address);
+				};
+			}
+
+			utils::ref_count_ptr<communication::ports::io_uring_receiver> receiver;
+			utils::ref_count_ptr<core::communication::frame_callback_interface> callback = m_frame_callback;
+			try
+			{
+				receiver = utils::make_ref_count_ptr<communication::ports::io_uring_receiver>(
+					static_cast<int>(m_socket.native_handle()), true, UDP_URING_BUFFER_SIZE, UDP_URING_BUFFER_COUNT, filter);
+
+				if (callback != nullptr)
+				{
+					receiver->set_handlers(
+						[callback](const uint8_t* data, size_t size)
+						{
+							callback->on_frame(data, size);
+						},
+						[this, callback](int error)
+						{
+							m_eStatus = core::communication::communication_status::DISCONNECTED;
+							callback->on_closed(ParseError(boost::system::error_code(error, boost::system::system_category())));
+						});
+				}
+
+				// Falling back to blocking reads when the kernel does not support multishot receives/buffer rings
+				if (receiver->start() == false)
+					receiver.release();
+			}
+			catch (...)
+			{
+				receiver.release();
+			}
+
+			// Without io_uring, nothing would deliver the frames to the callback
+			if (receiver == nullptr && callback != nullptr)
+			{
+				m_socket.close(ec);
+				m_eStatus = core::communication::communication_status::DISCONNECTED;
+				return false;
+			}
+
+			std::lock_guard<std::mutex> locker(m_uring_mutex);
+			m_uring_receiver = receiver;
+		}
+#endif
+
 		if (ans ==false)
 		{
 			m_eStatus = core::communication::communication_status::DISCONNECTED;
@@ -165,6 +269,19 @@ bool communication::ports::udp_client_port_impl::disconnect()
 	{
 		boost::system::error_code ec;
 
+#ifdef HAVE_IO_URING
+		// Readers hold their own reference, the receiver is stopped (waking them up) once no new reader can get it
+		utils::ref_count_ptr<communication::ports::io_uring_receiver> receiver;
+		{
+			std::lock_guard<std::mutex> locker(m_uring_mutex);
+			receiver = m_uring_receiver;
+			m_uring_receiver.release();
+		}
+
+		if (receiver != nullptr)
+			receiver->stop();
+#endif
+
 		if (m_multicast == true)
 		{			
 			m_socket.set_option(boost::asio::ip::multicast::leave_group(m_remote_endpoint.address().to_v4(), m_local_endpoint.address().to_v4()), ec);
@@ -219,6 +336,20 @@ size_t communication::ports::udp_client_port_impl::recieve(void* buffer, size_t
 	{
 		size_t nTotal = 0;
 
+#ifdef HAVE_IO_URING
+		utils::ref_count_ptr<communication::ports::io_uring_receiver> receiver = uring_receiver();
+		if (receiver != nullptr)
+		{
+			int error = 0;
+			nTotal = receiver->read(buffer, size, &error);
+			if (nTotal == 0)
+				m_eStatus = core::communication::communication_status::DISCONNECTED;
+
+			*commError = ParseError(boost::system::error_code(error, boost::system::system_category()));
+			return nTotal;
+		}
+#endif
+
 		if (size == 0)
 		{
 			m_cache_index = 0;
@@ -7,6 +7,10 @@
 #include <utils/ref_count_ptr.hpp>
 #include <mutex>
 
+#ifdef HAVE_IO_URING
+#include "io_uring_reactor.h"
+#endif
+
 namespace communication
 {
 	namespace ports
@@ -25,7 +29,8 @@ namespace communication
 				uint16_t usLocalPort, 
 				bool multicast, 
 				int receive_buffer_size,
-				int send_buffer_size);
+				int send_buffer_size,
+				communication::ports::io_backend backend = communication::ports::io_backend::blocking);
 
 			// Inherited via ref_count_base
 			virtual core::communication::communication_status status() const override;
@@ -35,6 +40,7 @@ namespace communication
 			virtual size_t recieve(void* buffer, size_t size, core::communication::communication_error* commError) override;			
 			virtual bool query_local_endpoint(core::communication::ip_endpoint& end_point)  const override;
 			virtual bool query_remote_endpoint(core::communication::ip_endpoint& end_point) const override;
+			virtual bool set_frame_callback(core::communication::frame_callback_interface* callback) override;
 
         private:					
 			boost::asio::ip::udp::endpoint m_local_endpoint;
@@ -50,6 +56,14 @@ namespace communication
 
 			int m_receive_buffer_size;
 			int m_send_buffer_size;
+			communication::ports::io_backend m_backend;
+			utils::ref_count_ptr<core::communication::frame_callback_interface> m_frame_callback;
+#ifdef HAVE_IO_URING
+			std::mutex m_uring_mutex;
+			utils::ref_count_ptr<communication::ports::io_uring_receiver> m_uring_receiver;
+
+			utils::ref_count_ptr<communication::ports::io_uring_receiver> uring_receiver();
+#endif
 
 			core::communication::communication_error ParseError(boost::system::error_code ec);			
 		};
@@ -62,12 +62,20 @@ bool compression::lz4_compression::decode(const void* input, uint32_t input_size
 		return false;
 	}
 	
-	int compressed_size = LZ4_decompress_fast(
+	if (input == nullptr || output == nullptr)
+	{
+		// TODO: log error...
+		return false;
+	}
+
+	// Bounded by the input size as well as the output size, corrupted input can not read or write out of the buffers
+	int decompressed_size = LZ4_decompress_safe(
 		reinterpret_cast<const char*>(input), 
 		reinterpret_cast<char*>(output), 
+		static_cast<int>(input_size),
 		static_cast<int>(target_output_size));
 
-	if (compressed_size != static_cast<int>(input_size))
+	if (decompressed_size != static_cast<int>(target_output_size))
 	{
 		// TODO: log error...
 		return false;
@@ -3,6 +3,7 @@
 #include <utils/console_synchronizer.hpp>
 #include <utils/strings.hpp>
 #include <utils/callback_handler.hpp>
+#include <utils/worker_pool.hpp>
 
 #include <mutex>
 #include <string>
@@ -30,6 +31,14 @@ static utils::console_synchronizer* CONSOLE_PRINTER()
 
 static utils::callback_handler<core::framework::logger_hook_interface> m_logger_hooks;
 
+utils::worker_pool& core::framework::shared_worker_pool()
+{
+	// Like the console printer, the pool is never destroyed, joining its workers
+	// while the dll/so is unloaded might never return.
+	static utils::worker_pool* INSTANCE = new utils::worker_pool();
+	return *INSTANCE;
+}
+
 const char* core::framework::version()
 {
 	static std::once_flag flag;
@@ -0,0 +1,1112 @@
+#include "pixel_converter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#define PIXEL_CONVERTER_SSE2
+#endif
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#define PIXEL_CONVERTER_SSSE3
+#endif
+
+namespace
+{
+	using core::imaging::pixel_format;
+
+	enum class chroma_layout
+	{
+		PLANAR,
+		SEMI_PLANAR,
+		YUYV,
+		UYVY
+	};
+
+	constexpr uint32_t WEIGHT_BITS = 11;
+	constexpr int WEIGHT_ONE = 1 << WEIGHT_BITS;
+
+	// Gains in 8 bits fixed point, below 128 so that a scaled level fits a signed 16 bits lane
+	constexpr uint32_t GAIN_BITS = 8;
+	constexpr uint16_t GAIN_ONE = 1 << GAIN_BITS;
+	constexpr float GAIN_MAX = 128.0f;
+
+	inline uint32_t chroma_size(uint32_t size)
+	{
+		return (size + 1) / 2;
+	}
+
+	inline uint8_t saturate(int val)
+	{
+		return static_cast<uint8_t>(val < 0 ? 0 : (val > 255 ? 255 : val));
+	}
+
+	inline bool is_yuv(pixel_format format)
+	{
+		return format == pixel_format::I420 || format == pixel_format::NV12 ||
+			format == pixel_format::YUY2 || format == pixel_format::UYVY;
+	}
+
+	// BT.601 limited range in 6 bits fixed point, the vector kernels compute exactly the same values
+	template <bool BGR>
+	inline void write_yuv_pixel(int y, int u, int v, uint8_t* output)
+	{
+		int c = (y - 16) * 75;
+		int d = u - 128;
+		int e = v - 128;
+		uint8_t r = saturate((c + 102 * e + 32) >> 6);
+		uint8_t g = saturate((c - 52 * e - 25 * d + 32) >> 6);
+		uint8_t b = saturate((c + 129 * d + 32) >> 6);
+		output[0] = BGR ? b : r;
+		output[1] = g;
+		output[2] = BGR ? r : b;
+		output[3] = 0xFF;
+	}
+
+	inline uint8_t rgb_to_gray(const uint8_t* pixel)
+	{
+		return static_cast<uint8_t>((77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2] + 128) >> 8);
+	}
+
+	inline uint8_t rgb_to_y(int r, int g, int b)
+	{
+		return static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+	}
+
+	inline uint8_t rgb_to_u(int r, int g, int b)
+	{
+		return static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+	}
+
+	inline uint8_t rgb_to_v(int r, int g, int b)
+	{
+		return static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+	}
+
+	// The luma and chroma of a pixel, for a packed layout the luma row is the packed row and the chroma rows are unused
+	template <chroma_layout L>
+	inline void load_yuv_pixel(const uint8_t* luma, const uint8_t* u, const uint8_t* v, uint32_t x, int& y_val, int& u_val, int& v_val)
+	{
+		const uint8_t* pair = luma + (x / 2) * 4;
+		switch (L)
+		{
+		case chroma_layout::PLANAR:
+			y_val = luma[x];
+			u_val = u[x / 2];
+			v_val = v[x / 2];
+			break;
+		case chroma_layout::SEMI_PLANAR:
+			y_val = luma[x];
+			u_val = u[(x / 2) * 2];
+			v_val = v[(x / 2) * 2];
+			break;
+		case chroma_layout::YUYV:
+			y_val = pair[(x & 1) * 2];
+			u_val = pair[1];
+			v_val = pair[3];
+			break;
+		case chroma_layout::UYVY:
+			y_val = pair[1 + (x & 1) * 2];
+			u_val = pair[0];
+			v_val = pair[2];
+			break;
+		}
+	}
+
+#if defined(__AVX2__)
+	// 32 pixels: luma and per pixel chroma as 16 bits, [0] holds pixels 0-7 and 16-23, [1] pixels 8-15 and 24-31 (the
+	// order of unpacking bytes in 128 bits lanes)
+	template <chroma_layout L>
+	inline void load_yuv_block(const uint8_t* luma, const uint8_t* u, const uint8_t* v, uint32_t x,
+		__m256i (&y_val)[2], __m256i (&u_val)[2], __m256i (&v_val)[2])
+	{
+		const __m256i low_bytes = _mm256_set1_epi16(0x00FF);
+		if (L == chroma_layout::PLANAR || L == chroma_layout::SEMI_PLANAR)
+		{
+			__m256i luma_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(luma + x));
+			y_val[0] = _mm256_unpacklo_epi8(luma_bytes, _mm256_setzero_si256());
+			y_val[1] = _mm256_unpackhi_epi8(luma_bytes, _mm256_setzero_si256());
+
+			__m256i u16, v16;
+			if (L == chroma_layout::PLANAR)
+			{
+				u16 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x / 2)));
+				v16 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v + x / 2)));
+			}
+			else
+			{
+				__m256i uv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(u + x));
+				u16 = _mm256_and_si256(uv, low_bytes);
+				v16 = _mm256_srli_epi16(uv, 8);
+			}
+
+			u_val[0] = _mm256_unpacklo_epi16(u16, u16);
+			u_val[1] = _mm256_unpackhi_epi16(u16, u16);
+			v_val[0] = _mm256_unpacklo_epi16(v16, v16);
+			v_val[1] = _mm256_unpackhi_epi16(v16, v16);
+			return;
+		}
+
+		// Packed pairs: the first load holds pixels 0-15, the second pixels 16-31
+		const __m256i low_byte = _mm256_set1_epi32(0xFF);
+		__m256i y16[2], u16[2], v16[2];
+		for (size_t i = 0; i < 2; i++)
+		{
+			__m256i pairs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(luma + x * 2 + i * 32));
+			__m256i u32, v32;
+			if (L == chroma_layout::YUYV)
+			{
+				y16[i] = _mm256_and_si256(pairs, low_bytes);
+				u32 = _mm256_and_si256(_mm256_srli_epi32(pairs, 8), low_byte);
+				v32 = _mm256_srli_epi32(pairs, 24);
+			}
+			else
+			{
+				y16[i] = _mm256_srli_epi16(pairs, 8);
+				u32 = _mm256_and_si256(pairs, low_byte);
+				v32 = _mm256_and_si256(_mm256_srli_epi32(pairs, 16), low_byte);
+			}
+
+			u16[i] = _mm256_or_si256(u32, _mm256_slli_epi32(u32, 16));
+			v16[i] = _mm256_or_si256(v32, _mm256_slli_epi32(v32, 16));
+		}
+
+		y_val[0] = _mm256_permute2x128_si256(y16[0], y16[1], 0x20);
+		y_val[1] = _mm256_permute2x128_si256(y16[0], y16[1], 0x31);
+		u_val[0] = _mm256_permute2x128_si256(u16[0], u16[1], 0x20);
+		u_val[1] = _mm256_permute2x128_si256(u16[0], u16[1], 0x31);
+		v_val[0] = _mm256_permute2x128_si256(v16[0], v16[1], 0x20);
+		v_val[1] = _mm256_permute2x128_si256(v16[0], v16[1], 0x31);
+	}
+
+	inline void yuv_to_rgb(__m256i y, __m256i u, __m256i v, __m256i& r, __m256i& g, __m256i& b)
+	{
+		const __m256i round = _mm256_set1_epi16(32);
+		__m256i c = _mm256_mullo_epi16(_mm256_sub_epi16(y, _mm256_set1_epi16(16)), _mm256_set1_epi16(75));
+		__m256i d = _mm256_sub_epi16(u, _mm256_set1_epi16(128));
+		__m256i e = _mm256_sub_epi16(v, _mm256_set1_epi16(128));
+		r = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_adds_epi16(c, _mm256_mullo_epi16(e, _mm256_set1_epi16(102))), round), 6);
+		g = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_sub_epi16(c, _mm256_add_epi16(
+			_mm256_mullo_epi16(e, _mm256_set1_epi16(52)), _mm256_mullo_epi16(d, _mm256_set1_epi16(25)))), round), 6);
+		b = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_adds_epi16(c, _mm256_mullo_epi16(d, _mm256_set1_epi16(129))), round), 6);
+	}
+
+	// Interleaves 32 pixels of planar channels into RGBA (or BGRA)
+	template <bool BGR>
+	inline void store_rgba(uint8_t* output, __m256i r, __m256i g, __m256i b)
+	{
+		const __m256i alpha = _mm256_set1_epi8(-1);
+		__m256i first = BGR ? b : r;
+		__m256i third = BGR ? r : b;
+		__m256i first_second_low = _mm256_unpacklo_epi8(first, g);
+		__m256i first_second_high = _mm256_unpackhi_epi8(first, g);
+		__m256i third_alpha_low = _mm256_unpacklo_epi8(third, alpha);
+		__m256i third_alpha_high = _mm256_unpackhi_epi8(third, alpha);
+		__m256i pixels0 = _mm256_unpacklo_epi16(first_second_low, third_alpha_low);
+		__m256i pixels1 = _mm256_unpackhi_epi16(first_second_low, third_alpha_low);
+		__m256i pixels2 = _mm256_unpacklo_epi16(first_second_high, third_alpha_high);
+		__m256i pixels3 = _mm256_unpackhi_epi16(first_second_high, third_alpha_high);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permute2x128_si256(pixels0, pixels1, 0x20));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 32), _mm256_permute2x128_si256(pixels2, pixels3, 0x20));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 64), _mm256_permute2x128_si256(pixels0, pixels1, 0x31));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 96), _mm256_permute2x128_si256(pixels2, pixels3, 0x31));
+	}
+#elif defined(PIXEL_CONVERTER_SSE2)
+	// 16 pixels: luma and per pixel chroma as 16 bits, [0] holds pixels 0-7, [1] pixels 8-15
+	template <chroma_layout L>
+	inline void load_yuv_block(const uint8_t* luma, const uint8_t* u, const uint8_t* v, uint32_t x,
+		__m128i (&y_val)[2], __m128i (&u_val)[2], __m128i (&v_val)[2])
+	{
+		const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+		if (L == chroma_layout::PLANAR || L == chroma_layout::SEMI_PLANAR)
+		{
+			__m128i luma_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(luma + x));
+			y_val[0] = _mm_unpacklo_epi8(luma_bytes, _mm_setzero_si128());
+			y_val[1] = _mm_unpackhi_epi8(luma_bytes, _mm_setzero_si128());
+
+			__m128i u16, v16;
+			if (L == chroma_layout::PLANAR)
+			{
+				u16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2)), _mm_setzero_si128());
+				v16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2)), _mm_setzero_si128());
+			}
+			else
+			{
+				__m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x));
+				u16 = _mm_and_si128(uv, low_bytes);
+				v16 = _mm_srli_epi16(uv, 8);
+			}
+
+			u_val[0] = _mm_unpacklo_epi16(u16, u16);
+			u_val[1] = _mm_unpackhi_epi16(u16, u16);
+			v_val[0] = _mm_unpacklo_epi16(v16, v16);
+			v_val[1] = _mm_unpackhi_epi16(v16, v16);
+			return;
+		}
+
+		const __m128i low_byte = _mm_set1_epi32(0xFF);
+		for (size_t i = 0; i < 2; i++)
+		{
+			__m128i pairs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(luma + x * 2 + i * 16));
+			__m128i u32, v32;
+			if (L == chroma_layout::YUYV)
+			{
+				y_val[i] = _mm_and_si128(pairs, low_bytes);
+				u32 = _mm_and_si128(_mm_srli_epi32(pairs, 8), low_byte);
+				v32 = _mm_srli_epi32(pairs, 24);
+			}
+			else
+			{
+				y_val[i] = _mm_srli_epi16(pairs, 8);
+				u32 = _mm_and_si128(pairs, low_byte);
+				v32 = _mm_and_si128(_mm_srli_epi32(pairs, 16), low_byte);
+			}
+
+			u_val[i] = _mm_or_si128(u32, _mm_slli_epi32(u32, 16));
+			v_val[i] = _mm_or_si128(v32, _mm_slli_epi32(v32, 16));
+		}
+	}
+
+	inline void yuv_to_rgb(__m128i y, __m128i u, __m128i v, __m128i& r, __m128i& g, __m128i& b)
+	{
+		const __m128i round = _mm_set1_epi16(32);
+		__m128i c = _mm_mullo_epi16(_mm_sub_epi16(y, _mm_set1_epi16(16)), _mm_set1_epi16(75));
+		__m128i d = _mm_sub_epi16(u, _mm_set1_epi16(128));
+		__m128i e = _mm_sub_epi16(v, _mm_set1_epi16(128));
+		r = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(c, _mm_mullo_epi16(e, _mm_set1_epi16(102))), round), 6);
+		g = _mm_srai_epi16(_mm_adds_epi16(_mm_sub_epi16(c, _mm_add_epi16(
+			_mm_mullo_epi16(e, _mm_set1_epi16(52)), _mm_mullo_epi16(d, _mm_set1_epi16(25)))), round), 6);
+		b = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(c, _mm_mullo_epi16(d, _mm_set1_epi16(129))), round), 6);
+	}
+
+	// Interleaves 16 pixels of planar channels into RGBA (or BGRA)
+	template <bool BGR>
+	inline void store_rgba(uint8_t* output, __m128i r, __m128i g, __m128i b)
+	{
+		const __m128i alpha = _mm_set1_epi8(-1);
+		__m128i first = BGR ? b : r;
+		__m128i third = BGR ? r : b;
+		__m128i first_second_low = _mm_unpacklo_epi8(first, g);
+		__m128i first_second_high = _mm_unpackhi_epi8(first, g);
+		__m128i third_alpha_low = _mm_unpacklo_epi8(third, alpha);
+		__m128i third_alpha_high = _mm_unpackhi_epi8(third, alpha);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi16(first_second_low, third_alpha_low));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi16(first_second_low, third_alpha_low));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output + 32), _mm_unpacklo_epi16(first_second_high, third_alpha_high));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output + 48), _mm_unpackhi_epi16(first_second_high, third_alpha_high));
+	}
+#endif
+
+	template <chroma_layout L, bool BGR>
+	void decode_yuv_row(const uint8_t* luma, const uint8_t* u, const uint8_t* v, uint8_t* output, uint32_t width)
+	{
+		uint32_t x = 0;
+#if defined(__AVX2__)
+		for (; x + 32 <= width; x += 32)
+		{
+			__m256i y_val[2], u_val[2], v_val[2], r[2], g[2], b[2];
+			load_yuv_block<L>(luma, u, v, x, y_val, u_val, v_val);
+			for (size_t i = 0; i < 2; i++)
+				yuv_to_rgb(y_val[i], u_val[i], v_val[i], r[i], g[i], b[i]);
+
+			store_rgba<BGR>(output + x * 4, _mm256_packus_epi16(r[0], r[1]), _mm256_packus_epi16(g[0], g[1]), _mm256_packus_epi16(b[0], b[1]));
+		}
+#elif defined(PIXEL_CONVERTER_SSE2)
+		for (; x + 16 <= width; x += 16)
+		{
+			__m128i y_val[2], u_val[2], v_val[2], r[2], g[2], b[2];
+			load_yuv_block<L>(luma, u, v, x, y_val, u_val, v_val);
+			for (size_t i = 0; i < 2; i++)
+				yuv_to_rgb(y_val[i], u_val[i], v_val[i], r[i], g[i], b[i]);
+
+			store_rgba<BGR>(output + x * 4, _mm_packus_epi16(r[0], r[1]), _mm_packus_epi16(g[0], g[1]), _mm_packus_epi16(b[0], b[1]));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			int y_val, u_val, v_val;
+			load_yuv_pixel<L>(luma, u, v, x, y_val, u_val, v_val);
+			write_yuv_pixel<BGR>(y_val, u_val, v_val, output + x * 4);
+		}
+	}
+
+	// The luma of a YUV row expanded to full range, the gray level of the pixels decoded into RGB
+	template <chroma_layout L>
+	void expand_luma_row(const uint8_t* input, uint8_t* output, uint32_t width)
+	{
+		const bool packed = L == chroma_layout::YUYV || L == chroma_layout::UYVY;
+		const size_t step = packed ? 2 : 1;
+		const size_t luma_offset = L == chroma_layout::UYVY ? 1 : 0;
+		uint32_t x = 0;
+#if defined(PIXEL_CONVERTER_SSE2)
+		const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+		const __m128i black = _mm_set1_epi16(16);
+		const __m128i scale = _mm_set1_epi16(75);
+		const __m128i round = _mm_set1_epi16(32);
+		for (; x + 16 <= width; x += 16)
+		{
+			__m128i first, second;
+			if (packed == false)
+			{
+				__m128i luma = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x));
+				first = _mm_unpacklo_epi8(luma, _mm_setzero_si128());
+				second = _mm_unpackhi_epi8(luma, _mm_setzero_si128());
+			}
+			else
+			{
+				first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x * 2));
+				second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x * 2 + 16));
+				first = L == chroma_layout::YUYV ? _mm_and_si128(first, low_bytes) : _mm_srli_epi16(first, 8);
+				second = L == chroma_layout::YUYV ? _mm_and_si128(second, low_bytes) : _mm_srli_epi16(second, 8);
+			}
+
+			first = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(first, black), scale), round), 6);
+			second = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(second, black), scale), round), 6);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + x), _mm_packus_epi16(first, second));
+		}
+#endif
+		for (; x < width; x++)
+			output[x] = saturate(((input[x * step + luma_offset] - 16) * 75 + 32) >> 6);
+	}
+
+	// A row of a YUV image: its luma and chroma samples and the distance between samples, the chroma of a 4:2:0 image
+	// is shared by two rows
+	struct yuv_row
+	{
+		uint8_t* luma;
+		uint8_t* u;
+		uint8_t* v;
+		size_t luma_step;
+		size_t chroma_step;
+	};
+
+	yuv_row query_yuv_row(const uint8_t* image, pixel_format format, uint32_t width, uint32_t height, uint32_t row)
+	{
+		uint8_t* data = const_cast<uint8_t*>(image);
+		const size_t luma_size = static_cast<size_t>(width) * height;
+		const size_t chroma_width = chroma_size(width);
+		yuv_row yuv = {};
+		switch (format)
+		{
+		case pixel_format::I420:
+			yuv.luma = data + static_cast<size_t>(row) * width;
+			yuv.u = data + luma_size + (row / 2) * chroma_width;
+			yuv.v = yuv.u + chroma_width * chroma_size(height);
+			yuv.luma_step = 1;
+			yuv.chroma_step = 1;
+			break;
+		case pixel_format::NV12:
+			yuv.luma = data + static_cast<size_t>(row) * width;
+			yuv.u = data + luma_size + (row / 2) * chroma_width * 2;
+			yuv.v = yuv.u + 1;
+			yuv.luma_step = 1;
+			yuv.chroma_step = 2;
+			break;
+		default:
+		{
+			uint8_t* pairs = data + static_cast<size_t>(row) * chroma_width * 4;
+			bool yuyv = format == pixel_format::YUY2;
+			yuv.luma = pairs + (yuyv ? 0 : 1);
+			yuv.u = pairs + (yuyv ? 1 : 0);
+			yuv.v = yuv.u + 2;
+			yuv.luma_step = 2;
+			yuv.chroma_step = 4;
+			break;
+		}
+		}
+
+		return yuv;
+	}
+
+	// Repacks a YUV image into another YUV layout of the same size, without going through RGB: 4:2:0 chroma is
+	// repeated on both rows of a 4:2:2 image and 4:2:2 chroma is averaged on two rows into 4:2:0
+	void repack_yuv(const uint8_t* source, pixel_format source_format, uint8_t* target, pixel_format target_format,
+		uint32_t width, uint32_t height, uint32_t first_row, uint32_t last_row)
+	{
+		const bool source_420 = source_format == pixel_format::I420 || source_format == pixel_format::NV12;
+		const bool target_420 = target_format == pixel_format::I420 || target_format == pixel_format::NV12;
+		const uint32_t chroma_width = chroma_size(width);
+		for (uint32_t row = first_row; row < last_row; row++)
+		{
+			yuv_row input = query_yuv_row(source, source_format, width, height, row);
+			yuv_row output = query_yuv_row(target, target_format, width, height, row);
+			if (input.luma_step == 1 && output.luma_step == 1)
+			{
+				std::memcpy(output.luma, input.luma, width);
+			}
+			else
+			{
+				for (uint32_t x = 0; x < width; x++)
+					output.luma[x * output.luma_step] = input.luma[x * input.luma_step];
+			}
+
+			if (target_420 && (row & 1) != 0)
+				continue;
+
+			if (target_420 == true && source_420 == false)
+			{
+				yuv_row next = row + 1 < height ? query_yuv_row(source, source_format, width, height, row + 1) : input;
+				for (uint32_t x = 0; x < chroma_width; x++)
+				{
+					output.u[x * output.chroma_step] = static_cast<uint8_t>((input.u[x * input.chroma_step] + next.u[x * next.chroma_step] + 1) >> 1);
+					output.v[x * output.chroma_step] = static_cast<uint8_t>((input.v[x * input.chroma_step] + next.v[x * next.chroma_step] + 1) >> 1);
+				}
+			}
+			else
+			{
+				for (uint32_t x = 0; x < chroma_width; x++)
+				{
+					output.u[x * output.chroma_step] = input.u[x * input.chroma_step];
+					output.v[x * output.chroma_step] = input.v[x * input.chroma_step];
+				}
+			}
+		}
+
+		// The second pixel of the last pair of an odd width
+		if (target_420 == false && (width & 1) != 0)
+		{
+			for (uint32_t row = first_row; row < last_row; row++)
+			{
+				yuv_row output = query_yuv_row(target, target_format, width, height, row);
+				output.luma[width * 2] = output.luma[(width - 1) * 2];
+			}
+		}
+	}
+
+	// RGB to RGBA, swapping the red and blue channels when asked
+	template <bool SWAP>
+	void expand_row(const uint8_t* input, uint8_t* output, uint32_t width)
+	{
+		uint32_t x = 0;
+#if defined(PIXEL_CONVERTER_SSSE3)
+		const __m128i shuffle = SWAP ?
+			_mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1) :
+			_mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+		const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000U));
+		for (; x + 16 <= width; x += 16)
+		{
+			const uint8_t* pixels = input + x * 3;
+			uint8_t* target = output + x * 4;
+			__m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+			__m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 16));
+			__m128i third = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 32));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_or_si128(_mm_shuffle_epi8(first, shuffle), alpha));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 16), _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(second, first, 12), shuffle), alpha));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 32), _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(third, second, 8), shuffle), alpha));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 48), _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(third, 4), shuffle), alpha));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			const uint8_t* pixel = input + x * 3;
+			uint8_t* target = output + x * 4;
+			target[0] = pixel[SWAP ? 2 : 0];
+			target[1] = pixel[1];
+			target[2] = pixel[SWAP ? 0 : 2];
+			target[3] = 0xFF;
+		}
+	}
+
+	// RGBA to RGB, swapping the red and blue channels when asked
+	template <bool SWAP>
+	void compact_row(const uint8_t* input, uint8_t* output, uint32_t width)
+	{
+		uint32_t x = 0;
+#if defined(PIXEL_CONVERTER_SSSE3)
+		const __m128i shuffle = SWAP ?
+			_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1) :
+			_mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+		for (; x + 16 <= width; x += 16)
+		{
+			const uint8_t* pixels = input + x * 4;
+			uint8_t* target = output + x * 3;
+			__m128i first = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels)), shuffle);
+			__m128i second = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 16)), shuffle);
+			__m128i third = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 32)), shuffle);
+			__m128i fourth = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 48)), shuffle);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_or_si128(first, _mm_slli_si128(second, 12)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 16), _mm_or_si128(_mm_srli_si128(second, 4), _mm_slli_si128(third, 8)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 32), _mm_or_si128(_mm_srli_si128(third, 8), _mm_slli_si128(fourth, 4)));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			const uint8_t* pixel = input + x * 4;
+			uint8_t* target = output + x * 3;
+			target[0] = pixel[SWAP ? 2 : 0];
+			target[1] = pixel[1];
+			target[2] = pixel[SWAP ? 0 : 2];
+		}
+	}
+
+	// RGBA to BGRA and back
+	void swap_row(const uint8_t* input, uint8_t* output, uint32_t width)
+	{
+		uint32_t x = 0;
+#if defined(__AVX2__)
+		const __m256i keep = _mm256_set1_epi32(static_cast<int>(0xFF00FF00U));
+		const __m256i low_byte = _mm256_set1_epi32(0xFF);
+		for (; x + 8 <= width; x += 8)
+		{
+			__m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + x * 4));
+			__m256i swapped = _mm256_or_si256(_mm256_and_si256(pixels, keep), _mm256_or_si256(
+				_mm256_and_si256(_mm256_srli_epi32(pixels, 16), low_byte), _mm256_slli_epi32(_mm256_and_si256(pixels, low_byte), 16)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + x * 4), swapped);
+		}
+#elif defined(PIXEL_CONVERTER_SSE2)
+		const __m128i keep = _mm_set1_epi32(static_cast<int>(0xFF00FF00U));
+		const __m128i low_byte = _mm_set1_epi32(0xFF);
+		for (; x + 4 <= width; x += 4)
+		{
+			__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x * 4));
+			__m128i swapped = _mm_or_si128(_mm_and_si128(pixels, keep), _mm_or_si128(
+				_mm_and_si128(_mm_srli_epi32(pixels, 16), low_byte), _mm_slli_epi32(_mm_and_si128(pixels, low_byte), 16)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + x * 4), swapped);
+		}
+#endif
+		for (; x < width; x++)
+		{
+			const uint8_t* pixel = input + x * 4;
+			uint8_t* target = output + x * 4;
+			uint8_t first = pixel[0];
+			target[0] = pixel[2];
+			target[1] = pixel[1];
+			target[2] = first;
+			target[3] = pixel[3];
+		}
+	}
+
+	void gray_row(const uint8_t* input, uint8_t* output, uint32_t width)
+	{
+		uint32_t x = 0;
+#if defined(PIXEL_CONVERTER_SSE2)
+		const __m128i alpha = _mm_set1_epi8(-1);
+		for (; x + 16 <= width; x += 16)
+		{
+			__m128i gray = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x));
+			__m128i gray_gray_low = _mm_unpacklo_epi8(gray, gray);
+			__m128i gray_gray_high = _mm_unpackhi_epi8(gray, gray);
+			__m128i gray_alpha_low = _mm_unpacklo_epi8(gray, alpha);
+			__m128i gray_alpha_high = _mm_unpackhi_epi8(gray, alpha);
+			uint8_t* target = output + x * 4;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_unpacklo_epi16(gray_gray_low, gray_alpha_low));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 16), _mm_unpackhi_epi16(gray_gray_low, gray_alpha_low));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 32), _mm_unpacklo_epi16(gray_gray_high, gray_alpha_high));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 48), _mm_unpackhi_epi16(gray_gray_high, gray_alpha_high));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			uint8_t* target = output + x * 4;
+			target[0] = target[1] = target[2] = input[x];
+			target[3] = 0xFF;
+		}
+	}
+
+	// Scales the RGB levels of an RGBA (or BGRA) row, alpha is kept
+	void gain_row(uint8_t* row, uint32_t width, uint16_t gain)
+	{
+		uint32_t x = 0;
+#if defined(__AVX2__)
+		// (level << 8 | 0x80) * gain >> 16 rounds level * gain >> 8, the alpha lanes are multiplied by one
+		const __m256i gains = _mm256_set1_epi64x(static_cast<int64_t>(
+			gain | (static_cast<uint64_t>(gain) << 16) | (static_cast<uint64_t>(gain) << 32) | (static_cast<uint64_t>(GAIN_ONE) << 48)));
+		const __m256i half = _mm256_set1_epi16(0x80);
+		for (; x + 8 <= width; x += 8)
+		{
+			__m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x * 4));
+			__m256i low = _mm256_mulhi_epu16(_mm256_or_si256(_mm256_unpacklo_epi8(_mm256_setzero_si256(), pixels), half), gains);
+			__m256i high = _mm256_mulhi_epu16(_mm256_or_si256(_mm256_unpackhi_epi8(_mm256_setzero_si256(), pixels), half), gains);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(row + x * 4), _mm256_packus_epi16(low, high));
+		}
+#elif defined(PIXEL_CONVERTER_SSE2)
+		const __m128i gains = _mm_set_epi16(static_cast<short>(GAIN_ONE), static_cast<short>(gain), static_cast<short>(gain), static_cast<short>(gain),
+			static_cast<short>(GAIN_ONE), static_cast<short>(gain), static_cast<short>(gain), static_cast<short>(gain));
+		const __m128i half = _mm_set1_epi16(0x80);
+		for (; x + 4 <= width; x += 4)
+		{
+			__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4));
+			__m128i low = _mm_mulhi_epu16(_mm_or_si128(_mm_unpacklo_epi8(_mm_setzero_si128(), pixels), half), gains);
+			__m128i high = _mm_mulhi_epu16(_mm_or_si128(_mm_unpackhi_epi8(_mm_setzero_si128(), pixels), half), gains);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(row + x * 4), _mm_packus_epi16(low, high));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			uint8_t* pixel = row + x * 4;
+			for (size_t channel = 0; channel < 3; channel++)
+			{
+				uint32_t level = (((static_cast<uint32_t>(pixel[channel]) << 8) | 0x80) * gain) >> 16;
+				pixel[channel] = static_cast<uint8_t>(level > 255 ? 255 : level);
+			}
+		}
+	}
+
+	// Decodes width pixels of a source row from column x into RGBA (or BGRA), x is even for YUV sources
+	template <bool BGR>
+	void decode_row(const uint8_t* source, const core::imaging::image_params& params, uint32_t row, uint32_t x, uint32_t width,
+		uint8_t* output)
+	{
+		const size_t offset = static_cast<size_t>(row) * params.width + x;
+		const size_t luma_size = static_cast<size_t>(params.width) * params.height;
+		const size_t chroma_width = chroma_size(params.width);
+		const size_t chroma_offset = (row / 2) * chroma_width + x / 2;
+		switch (params.format)
+		{
+		case pixel_format::RGB:
+			expand_row<BGR>(source + offset * 3, output, width);
+			break;
+		case pixel_format::BGR:
+			expand_row<!BGR>(source + offset * 3, output, width);
+			break;
+		case pixel_format::RGBA:
+		case pixel_format::BGRA:
+			if ((params.format == pixel_format::BGRA) == BGR)
+				std::memcpy(output, source + offset * 4, static_cast<size_t>(width) * 4);
+			else
+				swap_row(source + offset * 4, output, width);
+			break;
+		case pixel_format::I420:
+		{
+			const uint8_t* u = source + luma_size + chroma_offset;
+			const uint8_t* v = u + chroma_width * chroma_size(params.height);
+			decode_yuv_row<chroma_layout::PLANAR, BGR>(source + offset, u, v, output, width);
+			break;
+		}
+		case pixel_format::NV12:
+		{
+			const uint8_t* uv = source + luma_size + chroma_offset * 2;
+			decode_yuv_row<chroma_layout::SEMI_PLANAR, BGR>(source + offset, uv, uv + 1, output, width);
+			break;
+		}
+		case pixel_format::YUY2:
+			decode_yuv_row<chroma_layout::YUYV, BGR>(source + (static_cast<size_t>(row) * chroma_width + x / 2) * 4, nullptr, nullptr, output, width);
+			break;
+		case pixel_format::UYVY:
+			decode_yuv_row<chroma_layout::UYVY, BGR>(source + (static_cast<size_t>(row) * chroma_width + x / 2) * 4, nullptr, nullptr, output, width);
+			break;
+		case pixel_format::GRAY8:
+			gray_row(source + offset, output, width);
+			break;
+		case pixel_format::GRAY16_LE:
+		{
+			const uint8_t* input = source + offset * 2;
+			for (uint32_t i = 0; i < width; i++)
+			{
+				uint8_t* target = output + i * 4;
+				target[0] = target[1] = target[2] = static_cast<uint8_t>((static_cast<uint32_t>(input[i * 2] | (input[i * 2 + 1] << 8)) + 128) / 257);
+				target[3] = 0xFF;
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// Encodes an RGBA row into a target of one row per RGBA row (every format but I420 and NV12)
+	void encode_row(const uint8_t* rgba, uint8_t* target, pixel_format format, uint32_t width, uint32_t row)
+	{
+		switch (format)
+		{
+		case pixel_format::RGB:
+			compact_row<false>(rgba, target + static_cast<size_t>(row) * width * 3, width);
+			break;
+		case pixel_format::BGR:
+			compact_row<true>(rgba, target + static_cast<size_t>(row) * width * 3, width);
+			break;
+		case pixel_format::RGBA:
+			std::memcpy(target + static_cast<size_t>(row) * width * 4, rgba, static_cast<size_t>(width) * 4);
+			break;
+		case pixel_format::BGRA:
+			swap_row(rgba, target + static_cast<size_t>(row) * width * 4, width);
+			break;
+		case pixel_format::GRAY8:
+		{
+			uint8_t* output = target + static_cast<size_t>(row) * width;
+			for (uint32_t x = 0; x < width; x++)
+				output[x] = rgb_to_gray(rgba + x * 4);
+
+			break;
+		}
+		case pixel_format::GRAY16_LE:
+		{
+			// gray * 257 in little endian, both bytes hold the gray level
+			uint8_t* output = target + static_cast<size_t>(row) * width * 2;
+			for (uint32_t x = 0; x < width; x++)
+				output[x * 2] = output[x * 2 + 1] = rgb_to_gray(rgba + x * 4);
+
+			break;
+		}
+		case pixel_format::YUY2:
+		case pixel_format::UYVY:
+		{
+			const size_t luma_offset = format == pixel_format::YUY2 ? 0 : 1;
+			const size_t chroma_offset = 1 - luma_offset;
+			uint8_t* output = target + static_cast<size_t>(row) * chroma_size(width) * 4;
+			for (uint32_t x = 0; x < width; x += 2, output += 4)
+			{
+				const uint8_t* first = rgba + x * 4;
+				const uint8_t* second = x + 1 < width ? first + 4 : first;
+				int r = (first[0] + second[0] + 1) >> 1;
+				int g = (first[1] + second[1] + 1) >> 1;
+				int b = (first[2] + second[2] + 1) >> 1;
+				output[luma_offset] = rgb_to_y(first[0], first[1], first[2]);
+				output[luma_offset + 2] = rgb_to_y(second[0], second[1], second[2]);
+				output[chroma_offset] = rgb_to_u(r, g, b);
+				output[chroma_offset + 2] = rgb_to_v(r, g, b);
+			}
+
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// Encodes two RGBA rows into I420 or NV12, row is even and second is first for the last row of an odd height
+	void encode_rows_420(const uint8_t* first, const uint8_t* second, uint8_t* target, pixel_format format,
+		uint32_t width, uint32_t height, uint32_t row)
+	{
+		const size_t luma_size = static_cast<size_t>(width) * height;
+		const size_t chroma_width = chroma_size(width);
+		uint8_t* luma = target + static_cast<size_t>(row) * width;
+		for (uint32_t x = 0; x < width; x++)
+			luma[x] = rgb_to_y(first[x * 4], first[x * 4 + 1], first[x * 4 + 2]);
+
+		if (row + 1 < height)
+		{
+			luma += width;
+			for (uint32_t x = 0; x < width; x++)
+				luma[x] = rgb_to_y(second[x * 4], second[x * 4 + 1], second[x * 4 + 2]);
+		}
+
+		uint8_t* u;
+		uint8_t* v;
+		size_t step;
+		if (format == pixel_format::I420)
+		{
+			u = target + luma_size + (row / 2) * chroma_width;
+			v = u + chroma_width * chroma_size(height);
+			step = 1;
+		}
+		else
+		{
+			u = target + luma_size + (row / 2) * chroma_width * 2;
+			v = u + 1;
+			step = 2;
+		}
+
+		for (uint32_t x = 0; x < width; x += 2, u += step, v += step)
+		{
+			const size_t next = x + 1 < width ? 4 : 0;
+			const uint8_t* top = first + x * 4;
+			const uint8_t* bottom = second + x * 4;
+			int r = (top[0] + top[next] + bottom[0] + bottom[next] + 2) >> 2;
+			int g = (top[1] + top[next + 1] + bottom[1] + bottom[next + 1] + 2) >> 2;
+			int b = (top[2] + top[next + 2] + bottom[2] + bottom[next + 2] + 2) >> 2;
+			*u = rgb_to_u(r, g, b);
+			*v = rgb_to_v(r, g, b);
+		}
+	}
+
+	// Copies a band of rows of an image into an image of the same format and size
+	void copy_rows(const uint8_t* source, uint8_t* target, pixel_format format, uint32_t width, uint32_t height,
+		uint32_t first_row, uint32_t last_row)
+	{
+		if (format != pixel_format::I420 && format != pixel_format::NV12)
+		{
+			const size_t row_size = imaging::pixel_converter::image_size(format, width, 1);
+			std::memcpy(target + first_row * row_size, source + first_row * row_size, (last_row - first_row) * row_size);
+			return;
+		}
+
+		std::memcpy(target + static_cast<size_t>(first_row) * width, source + static_cast<size_t>(first_row) * width,
+			static_cast<size_t>(last_row - first_row) * width);
+
+		// The chroma rows of the band, the last one is shared with the next band unless the band ends the image
+		const size_t chroma_width = chroma_size(width);
+		const size_t first_chroma_row = first_row / 2;
+		const size_t chroma_rows = chroma_size(last_row) - first_chroma_row;
+		const size_t planes_offset = static_cast<size_t>(width) * height;
+		if (format == pixel_format::NV12)
+		{
+			const size_t offset = planes_offset + first_chroma_row * chroma_width * 2;
+			std::memcpy(target + offset, source + offset, chroma_rows * chroma_width * 2);
+			return;
+		}
+
+		for (size_t plane = 0; plane < 2; plane++)
+		{
+			const size_t offset = planes_offset + plane * chroma_width * chroma_size(height) + first_chroma_row * chroma_width;
+			std::memcpy(target + offset, source + offset, chroma_rows * chroma_width);
+		}
+	}
+
+	// Source position and weight of a target position, centers aligned as OpenCV's INTER_LINEAR
+	void map_position(uint32_t target, uint32_t source_size, uint32_t target_size, uint32_t& index, uint16_t& weight)
+	{
+		double position = (target + 0.5) * source_size / target_size - 0.5;
+		double floor = std::floor(position);
+		if (position < 0 || floor >= source_size - 1)
+		{
+			index = position < 0 ? 0 : source_size - 1;
+			weight = 0;
+			return;
+		}
+
+		index = static_cast<uint32_t>(floor);
+		weight = static_cast<uint16_t>(std::lround((position - floor) * WEIGHT_ONE));
+	}
+}
+
+imaging::pixel_converter::pixel_converter() :
+	m_region{},
+	m_gain(GAIN_ONE),
+	m_cached_rows{ -1, -1 },
+	m_source_width(0),
+	m_target_width(0)
+{
+}
+
+size_t imaging::pixel_converter::image_size(core::imaging::pixel_format format, uint32_t width, uint32_t height)
+{
+	const size_t pixels = static_cast<size_t>(width) * height;
+	switch (format)
+	{
+	case pixel_format::RGB:
+	case pixel_format::BGR:
+		return pixels * 3;
+	case pixel_format::RGBA:
+	case pixel_format::BGRA:
+		return pixels * 4;
+	case pixel_format::GRAY8:
+		return pixels;
+	case pixel_format::GRAY16_LE:
+		return pixels * 2;
+	case pixel_format::YUY2:
+	case pixel_format::UYVY:
+		return static_cast<size_t>(chroma_size(width)) * 4 * height;
+	case pixel_format::I420:
+	case pixel_format::NV12:
+		return pixels + static_cast<size_t>(chroma_size(width)) * chroma_size(height) * 2;
+	default:
+		return 0;
+	}
+}
+
+void imaging::pixel_converter::prepare(uint32_t target_width)
+{
+	m_unaligned.resize((static_cast<size_t>(m_region.width) + 1) * 4);
+	m_decoded.resize(static_cast<size_t>(m_region.width) * 4);
+	m_lines.resize(static_cast<size_t>(target_width) * 4 * 2);
+	m_rows.resize(static_cast<size_t>(target_width) * 4 * 2);
+	m_cached_rows[0] = m_cached_rows[1] = -1;
+	if (m_source_width == m_region.width && m_target_width == target_width)
+		return;
+
+	m_source_width = m_region.width;
+	m_target_width = target_width;
+	m_x_index.resize(target_width);
+	m_x_weight.resize(target_width);
+	for (uint32_t x = 0; x < target_width; x++)
+		map_position(x, m_source_width, m_target_width, m_x_index[x], m_x_weight[x]);
+}
+
+template <bool BGR>
+void imaging::pixel_converter::decode(const uint8_t* source, const core::imaging::image_params& source_params, uint32_t row, uint8_t* output)
+{
+	// The chroma of a YUV pixel is shared with its pair, a region starting at an odd column is decoded from the pair
+	if (is_yuv(source_params.format) && (m_region.x & 1) != 0)
+	{
+		decode_row<BGR>(source, source_params, m_region.y + row, m_region.x - 1, m_region.width + 1, m_unaligned.data());
+		std::memcpy(output, m_unaligned.data() + 4, static_cast<size_t>(m_region.width) * 4);
+		return;
+	}
+
+	decode_row<BGR>(source, source_params, m_region.y + row, m_region.x, m_region.width, output);
+}
+
+const uint8_t* imaging::pixel_converter::query_line(const uint8_t* source, const core::imaging::image_params& source_params, uint32_t row)
+{
+	// A row and the next one never share a slot
+	const size_t slot = row & 1;
+	uint8_t* line = m_lines.data() + slot * m_target_width * 4;
+	if (m_cached_rows[slot] == row)
+		return line;
+
+	m_cached_rows[slot] = row;
+	if (m_source_width == m_target_width)
+	{
+		decode<false>(source, source_params, row, line);
+		return line;
+	}
+
+	decode<false>(source, source_params, row, m_decoded.data());
+	for (uint32_t x = 0; x < m_target_width; x++)
+	{
+		const uint8_t* left = m_decoded.data() + static_cast<size_t>(m_x_index[x]) * 4;
+		const uint8_t* right = m_x_index[x] + 1 < m_source_width ? left + 4 : left;
+		const int weight = m_x_weight[x];
+		for (size_t channel = 0; channel < 4; channel++)
+			line[x * 4 + channel] = static_cast<uint8_t>((left[channel] * (WEIGHT_ONE - weight) + right[channel] * weight + WEIGHT_ONE / 2) >> WEIGHT_BITS);
+	}
+
+	return line;
+}
+
+const uint8_t* imaging::pixel_converter::query_row(const uint8_t* source, const core::imaging::image_params& source_params,
+	uint32_t target_height, uint32_t row, size_t slot)
+{
+	uint8_t* output = m_rows.data() + slot * m_target_width * 4;
+	const size_t size = static_cast<size_t>(m_target_width) * 4;
+	if (m_region.height == target_height && m_region.width == m_target_width)
+	{
+		decode<false>(source, source_params, row, output);
+	}
+	else
+	{
+		uint32_t source_row;
+		uint16_t weight;
+		map_position(row, m_region.height, target_height, source_row, weight);
+		const uint8_t* top = query_line(source, source_params, source_row);
+		if (weight == 0)
+		{
+			std::memcpy(output, top, size);
+		}
+		else
+		{
+			const uint8_t* bottom = query_line(source, source_params, source_row + 1);
+			for (size_t i = 0; i < size; i++)
+				output[i] = static_cast<uint8_t>((top[i] * (WEIGHT_ONE - weight) + bottom[i] * weight + WEIGHT_ONE / 2) >> WEIGHT_BITS);
+		}
+	}
+
+	if (m_gain != GAIN_ONE)
+		gain_row(output, m_target_width, m_gain);
+
+	return output;
+}
+
+bool imaging::pixel_converter::convert(const uint8_t* source, size_t source_size, const core::imaging::image_params& source_params,
+	uint8_t* target, size_t target_size, core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_height)
+{
+	return convert(source, source_size, source_params, target, target_size, target_format, target_width, target_height, 0, target_height);
+}
+
+bool imaging::pixel_converter::convert(const uint8_t* source, size_t source_size, const core::imaging::image_params& source_params,
+	uint8_t* target, size_t target_size, core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_height,
+	uint32_t first_row, uint32_t last_row)
+{
+	return convert(source, source_size, source_params, region{ 0, 0, source_params.width, source_params.height }, 1.0f,
+		target, target_size, target_format, target_width, target_height, first_row, last_row);
+}
+
+bool imaging::pixel_converter::convert(const uint8_t* source, size_t source_size, const core::imaging::image_params& source_params,
+	const region& source_region, float gain,
+	uint8_t* target, size_t target_size, core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_height,
+	uint32_t first_row, uint32_t last_row)
+{
+	const size_t required_source_size = image_size(source_params.format, source_params.width, source_params.height);
+	const size_t required_target_size = image_size(target_format, target_width, target_height);
+	if (source == nullptr || target == nullptr ||
+		required_source_size == 0 || source_size < required_source_size ||
+		required_target_size == 0 || target_size < required_target_size ||
+		first_row > last_row || last_row > target_height)
+		return false;
+
+	if (source_region.width == 0 || source_region.height == 0 ||
+		source_region.x > source_params.width - source_region.width ||
+		source_region.y > source_params.height - source_region.height ||
+		source_region.width > source_params.width || source_region.height > source_params.height ||
+		(gain >= 0.0f && gain < GAIN_MAX) == false)
+		return false;
+
+	const bool target_420 = target_format == pixel_format::I420 || target_format == pixel_format::NV12;
+	if (target_420 && (first_row & 1) != 0)
+		return false;
+
+	m_region = source_region;
+	m_gain = static_cast<uint16_t>(std::lround(gain * GAIN_ONE));
+
+	// The whole image without gain allows copies and conversions which do not go through RGBA
+	const bool whole = m_gain == GAIN_ONE &&
+		source_region.width == source_params.width && source_region.height == source_params.height;
+	const bool resizing = source_region.width != target_width || source_region.height != target_height;
+	if (whole && resizing == false && source_params.format == target_format)
+	{
+		copy_rows(source, target, target_format, target_width, target_height, first_row, last_row);
+		return true;
+	}
+
+	prepare(target_width);
+	if (resizing == false)
+	{
+		// Rows decoded straight into the target
+		if (target_format == pixel_format::RGBA || target_format == pixel_format::BGRA)
+		{
+			const size_t row_size = static_cast<size_t>(target_width) * 4;
+			for (uint32_t row = first_row; row < last_row; row++)
+			{
+				if (target_format == pixel_format::BGRA)
+					decode<true>(source, source_params, row, target + row * row_size);
+				else
+					decode<false>(source, source_params, row, target + row * row_size);
+
+				if (m_gain != GAIN_ONE)
+					gain_row(target + row * row_size, target_width, m_gain);
+			}
+
+			return true;
+		}
+
+		if (whole && target_format == pixel_format::GRAY8 && is_yuv(source_params.format))
+		{
+			for (uint32_t row = first_row; row < last_row; row++)
+			{
+				yuv_row input = query_yuv_row(source, source_params.format, target_width, target_height, row);
+				uint8_t* output = target + static_cast<size_t>(row) * target_width;
+				if (source_params.format == pixel_format::YUY2)
+					expand_luma_row<chroma_layout::YUYV>(input.luma, output, target_width);
+				else if (source_params.format == pixel_format::UYVY)
+					expand_luma_row<chroma_layout::UYVY>(input.luma - 1, output, target_width);
+				else
+					expand_luma_row<chroma_layout::PLANAR>(input.luma, output, target_width);
+			}
+
+			return true;
+		}
+
+		if (whole && is_yuv(target_format) && is_yuv(source_params.format))
+		{
+			repack_yuv(source, source_params.format, target, target_format, target_width, target_height, first_row, last_row);
+			return true;
+		}
+	}
+
+	if (target_420)
+	{
+		for (uint32_t row = first_row; row < last_row; row += 2)
+		{
+			const uint8_t* first = query_row(source, source_params, target_height, row, 0);
+			const uint8_t* second = row + 1 < target_height ? query_row(source, source_params, target_height, row + 1, 1) : first;
+			encode_rows_420(first, second, target, target_format, target_width, target_height, row);
+		}
+
+		return true;
+	}
+
+	for (uint32_t row = first_row; row < last_row; row++)
+		encode_row(query_row(source, source_params, target_height, row, 0), target, target_format, target_width, row);
+
+	return true;
+}
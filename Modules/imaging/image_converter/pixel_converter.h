@@ -0,0 +1,114 @@
+#pragma once
+#include <core/imaging.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace imaging
+{
+	/// Converts images between every pair of core::imaging::pixel_format, resizing (bilinear) in the same pass.
+	/// The source is converted a row at a time: a row is decoded into an RGBA line, resampled when resizing and encoded
+	/// into the target, an intermediate image is never built. YUV decoding and channels reordering use AVX2 kernels when
+	/// built with ENABLE_AVX2, SSE2 kernels otherwise and a scalar loop on other platforms.
+	/// YUV is BT.601 limited range, GRAY8 from colors is the BT.601 luma (as OpenCV's cvtColor).
+	/// A region of the source can be converted alone (a crop) and a gain applied to the colors, in the same pass.
+	/// Planes and rows are tightly packed, I420 and NV12 chroma planes are ((width + 1) / 2) x ((height + 1) / 2).
+	/// @date	19/10/2026
+	class pixel_converter
+	{
+	public:
+		/// A rectangle of an image, in pixels
+		struct region
+		{
+			uint32_t x;
+			uint32_t y;
+			uint32_t width;
+			uint32_t height;
+		};
+
+	private:
+		region m_region;
+		uint16_t m_gain;
+		std::vector<uint8_t> m_unaligned;
+		std::vector<uint8_t> m_decoded;
+		std::vector<uint8_t> m_lines;
+		std::vector<uint8_t> m_rows;
+		std::vector<uint32_t> m_x_index;
+		std::vector<uint16_t> m_x_weight;
+		int64_t m_cached_rows[2];
+		uint32_t m_source_width;
+		uint32_t m_target_width;
+
+		void prepare(uint32_t target_width);
+		template <bool BGR>
+		void decode(const uint8_t* source, const core::imaging::image_params& source_params, uint32_t row, uint8_t* output);
+		const uint8_t* query_line(const uint8_t* source, const core::imaging::image_params& source_params, uint32_t row);
+		const uint8_t* query_row(const uint8_t* source, const core::imaging::image_params& source_params,
+			uint32_t target_height, uint32_t row, size_t slot);
+
+	public:
+		pixel_converter();
+
+		/// The size of an image
+		/// @date	19/10/2026
+		/// @param	format	The pixel format.
+		/// @param	width 	The width.
+		/// @param	height	The height.
+		/// @return	The size in bytes, zero for an undefined format or an empty image.
+		static size_t image_size(core::imaging::pixel_format format, uint32_t width, uint32_t height);
+
+		/// Converts an image
+		/// @date	19/10/2026
+		/// @param 			source		  	The source image.
+		/// @param 			source_size   	The size of the source buffer.
+		/// @param 			source_params 	The source image parameters.
+		/// @param [out]	target		  	The target image.
+		/// @param 			target_size   	The size of the target buffer.
+		/// @param 			target_format 	The target pixel format.
+		/// @param 			target_width  	The target width.
+		/// @param 			target_height 	The target height.
+		/// @return	True if it succeeds, false if a format is undefined or a buffer is too small.
+		bool convert(const uint8_t* source, size_t source_size, const core::imaging::image_params& source_params,
+			uint8_t* target, size_t target_size, core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_height);
+
+		/// Converts a band of rows of an image, the bands of an image may be converted in parallel by converters of their own
+		/// @date	19/10/2026
+		/// @param 			source		  	The source image.
+		/// @param 			source_size   	The size of the source buffer.
+		/// @param 			source_params 	The source image parameters.
+		/// @param [out]	target		  	The target image.
+		/// @param 			target_size   	The size of the target buffer.
+		/// @param 			target_format 	The target pixel format.
+		/// @param 			target_width  	The target width.
+		/// @param 			target_height 	The target height.
+		/// @param 			first_row	  	The first target row of the band, even when the target is I420 or NV12.
+		/// @param 			last_row	  	The target row after the band.
+		/// @return	True if it succeeds, false if a format is undefined, a buffer is too small or the band is invalid.
+		bool convert(const uint8_t* source, size_t source_size, const core::imaging::image_params& source_params,
+			uint8_t* target, size_t target_size, core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_height,
+			uint32_t first_row, uint32_t last_row);
+
+		/// Converts a band of rows of a region of an image (a crop), scaling the RGB levels of its pixels by a gain. The region
+		/// is resized to the target size, the gain is applied in 8 bits fixed point to the RGBA pixels before encoding them.
+		/// @date	19/10/2026
+		/// @param 			source		  	The source image.
+		/// @param 			source_size   	The size of the source buffer.
+		/// @param 			source_params 	The source image parameters.
+		/// @param 			source_region 	The converted region of the source image.
+		/// @param 			gain		  	The gain of the RGB levels, in [0, 128).
+		/// @param [out]	target		  	The target image.
+		/// @param 			target_size   	The size of the target buffer.
+		/// @param 			target_format 	The target pixel format.
+		/// @param 			target_width  	The target width.
+		/// @param 			target_height 	The target height.
+		/// @param 			first_row	  	The first target row of the band, even when the target is I420 or NV12.
+		/// @param 			last_row	  	The target row after the band.
+		/// @return	True if it succeeds, false if a format is undefined, a buffer is too small or the region, the gain or the band
+		/// 		is invalid.
+		bool convert(const uint8_t* source, size_t source_size, const core::imaging::image_params& source_params,
+			const region& source_region, float gain,
+			uint8_t* target, size_t target_size, core::imaging::pixel_format target_format, uint32_t target_width, uint32_t target_height,
+			uint32_t first_row, uint32_t last_row);
+	};
+}
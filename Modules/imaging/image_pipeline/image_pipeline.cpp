@@ -0,0 +1,463 @@
+#include "image_pipeline.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	inline bool is_gray(core::imaging::pixel_format format)
+	{
+		return format == core::imaging::pixel_format::GRAY8 || format == core::imaging::pixel_format::GRAY16_LE;
+	}
+}
+
+imaging::image_pipeline_impl::image_pipeline_impl(uint32_t threads, core::buffer_allocator* allocator) :
+	m_threads(threads),
+	m_allocator(allocator),
+	m_image_pool(POOLS_INITIAL_SIZE,
+		utils::ref_count_object_pool<utils::imaging::ref_count_image>::growing_mode::doubling,
+		true),
+	m_planned(false),
+	m_levels(0)
+{
+	if (threads == 0)
+	{
+		throw std::invalid_argument("threads");
+	}
+
+	if (m_allocator == nullptr)
+		m_allocator = utils::make_ref_count_ptr<utils::buffer_allocator>(MEMORY_PER_BUFFER_SIZE);
+
+	node input = {};
+	input.type = stage::INPUT;
+	m_nodes.push_back(input);
+
+	utils::worker_pool::shared().reserve(threads - 1);
+}
+
+bool imaging::image_pipeline_impl::add(size_t parent, const node& stage_node, size_t& index)
+{
+	std::lock_guard<std::mutex> locker(m_mutex);
+	if (parent >= m_nodes.size())
+		return false;
+
+	index = m_nodes.size();
+	m_nodes.push_back(stage_node);
+	m_nodes.back().parent = parent;
+	m_planned = false;
+	return true;
+}
+
+bool imaging::image_pipeline_impl::add_convert(size_t parent, core::imaging::pixel_format format, size_t& node)
+{
+	if (format == core::imaging::pixel_format::UNDEFINED_PIXEL_FORMAT)
+		return false;
+
+	image_pipeline_impl::node stage_node = {};
+	stage_node.type = stage::CONVERT;
+	stage_node.format = format;
+	return add(parent, stage_node, node);
+}
+
+bool imaging::image_pipeline_impl::add_crop(size_t parent, uint32_t x, uint32_t y, uint32_t width, uint32_t height, size_t& node)
+{
+	if (width == 0 || height == 0)
+		return false;
+
+	image_pipeline_impl::node stage_node = {};
+	stage_node.type = stage::CROP;
+	stage_node.rectangle = imaging::pixel_converter::region{ x, y, width, height };
+	return add(parent, stage_node, node);
+}
+
+bool imaging::image_pipeline_impl::add_scale(size_t parent, uint32_t width, uint32_t height, size_t& node)
+{
+	if (width == 0 || height == 0)
+		return false;
+
+	image_pipeline_impl::node stage_node = {};
+	stage_node.type = stage::SCALE;
+	stage_node.rectangle = imaging::pixel_converter::region{ 0, 0, width, height };
+	return add(parent, stage_node, node);
+}
+
+bool imaging::image_pipeline_impl::add_gain(size_t parent, float gain, size_t& node)
+{
+	if ((gain >= 0.0f && gain < 128.0f) == false)
+		return false;
+
+	image_pipeline_impl::node stage_node = {};
+	stage_node.type = stage::GAIN;
+	stage_node.gain = gain;
+	return add(parent, stage_node, node);
+}
+
+bool imaging::image_pipeline_impl::add_algorithm(size_t parent, core::imaging::image_algorithm_interface* algorithm, size_t& node)
+{
+	if (algorithm == nullptr)
+		return false;
+
+	image_pipeline_impl::node stage_node = {};
+	stage_node.type = stage::ALGORITHM;
+	stage_node.algorithm = algorithm;
+	return add(parent, stage_node, node);
+}
+
+bool imaging::image_pipeline_impl::add_output(size_t node, size_t& output)
+{
+	std::lock_guard<std::mutex> locker(m_mutex);
+	if (node >= m_nodes.size())
+		return false;
+
+	m_nodes[node].output = true;
+	output = m_outputs.size();
+	m_outputs.push_back(node);
+	m_planned = false;
+	return true;
+}
+
+size_t imaging::image_pipeline_impl::outputs() const
+{
+	std::lock_guard<std::mutex> locker(m_mutex);
+	return m_outputs.size();
+}
+
+size_t imaging::image_pipeline_impl::split(const std::vector<size_t>& stages) const
+{
+	// A pass crops its source and then resizes it, a crop of a resized image needs the resized image. Colors lost by a
+	// gray format can not come back in a later format of the same pass.
+	bool scaled = false;
+	bool gray = false;
+	for (size_t i = 0; i < stages.size(); i++)
+	{
+		const node& current = m_nodes[stages[i]];
+		if (current.type == stage::CROP && scaled)
+			return i;
+
+		if (current.type == stage::CONVERT && gray && is_gray(current.format) == false)
+			return i;
+
+		scaled = scaled || current.type == stage::SCALE;
+		if (current.type == stage::CONVERT)
+			gray = is_gray(current.format);
+	}
+
+	return stages.size();
+}
+
+void imaging::image_pipeline_impl::plan()
+{
+	// The nodes leading to an output, the parents of nodes are always added before them
+	std::vector<uint8_t> needed(m_nodes.size(), 0);
+	for (size_t output : m_outputs)
+	{
+		for (size_t i = output; needed[i] == 0; i = m_nodes[i].parent)
+		{
+			needed[i] = 1;
+			if (i == INPUT_NODE)
+				break;
+		}
+	}
+
+	// Images are built for the input, the outputs, the algorithms and their inputs, the rest of the stages are fused
+	for (size_t i = 0; i < m_nodes.size(); i++)
+	{
+		node& current = m_nodes[i];
+		current.built = needed[i] != 0 &&
+			(current.type == stage::INPUT || current.type == stage::ALGORITHM || current.output);
+		if (current.built && current.type == stage::ALGORITHM)
+			m_nodes[current.parent].built = true;
+	}
+
+	auto query_stages = [this](size_t index)
+	{
+		std::vector<size_t> stages;
+		for (size_t i = index; m_nodes[i].built == false || i == index; i = m_nodes[i].parent)
+			stages.push_back(i);
+
+		std::reverse(stages.begin(), stages.end());
+		return stages;
+	};
+
+	// Passes which can not be fused are split by building the image of the last stage which can
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (size_t i = 1; i < m_nodes.size(); i++)
+		{
+			if (m_nodes[i].built == false || m_nodes[i].type == stage::ALGORITHM)
+				continue;
+
+			std::vector<size_t> stages = query_stages(i);
+			size_t at = split(stages);
+			if (at < stages.size())
+			{
+				m_nodes[stages[at - 1]].built = true;
+				changed = true;
+			}
+		}
+	}
+
+	std::vector<size_t> levels(m_nodes.size(), 0);
+	m_jobs.clear();
+	m_levels = 0;
+	for (size_t i = 1; i < m_nodes.size(); i++)
+	{
+		if (m_nodes[i].built == false)
+			continue;
+
+		job current = {};
+		current.target = i;
+		if (m_nodes[i].type == stage::ALGORITHM)
+		{
+			current.source = m_nodes[i].parent;
+		}
+		else
+		{
+			current.stages = query_stages(i);
+			current.source = m_nodes[current.stages.front()].parent;
+			current.converters.resize(m_threads);
+		}
+
+		levels[i] = levels[current.source] + 1;
+		current.level = levels[i];
+		m_levels = std::max(m_levels, current.level);
+		m_jobs.push_back(std::move(current));
+	}
+
+	std::stable_sort(m_jobs.begin(), m_jobs.end(), [](const job& first, const job& second) { return first.level < second.level; });
+	m_images.assign(m_nodes.size(), nullptr);
+	m_planned = true;
+}
+
+bool imaging::image_pipeline_impl::prepare(job& current, uint32_t threads)
+{
+	current.bands = 1;
+	if (m_nodes[current.target].type == stage::ALGORITHM)
+		return true;
+
+	const utils::ref_count_ptr<core::imaging::image_interface>& source = m_images[current.source];
+	if (source->query_image_params(current.source_params) == false)
+		return false;
+
+	if (source->query_buffer(&current.source_buffer) == false)
+		return false;
+
+	// The stages of the pass applied to the source parameters
+	const core::imaging::image_params& source_params = current.source_params;
+	current.region = imaging::pixel_converter::region{ 0, 0, source_params.width, source_params.height };
+	current.gain = 1.0f;
+	core::imaging::image_params& target_params = current.target_params;
+	target_params = source_params;
+	for (size_t index : current.stages)
+	{
+		const node& stage_node = m_nodes[index];
+		switch (stage_node.type)
+		{
+		case stage::CONVERT:
+			target_params.format = stage_node.format;
+			break;
+		case stage::CROP:
+		{
+			const imaging::pixel_converter::region& rectangle = stage_node.rectangle;
+			if (rectangle.width > target_params.width || rectangle.height > target_params.height ||
+				rectangle.x > target_params.width - rectangle.width || rectangle.y > target_params.height - rectangle.height)
+				return false;
+
+			current.region.x += rectangle.x;
+			current.region.y += rectangle.y;
+			current.region.width = target_params.width = rectangle.width;
+			current.region.height = target_params.height = rectangle.height;
+			break;
+		}
+		case stage::SCALE:
+			target_params.width = stage_node.rectangle.width;
+			target_params.height = stage_node.rectangle.height;
+			break;
+		case stage::GAIN:
+			current.gain *= stage_node.gain;
+			break;
+		default:
+			break;
+		}
+	}
+
+	size_t target_size = imaging::pixel_converter::image_size(target_params.format, target_params.width, target_params.height);
+	if (target_size == 0)
+		return false;
+
+	target_params.size = static_cast<uint32_t>(target_size);
+
+	// A pass which changes nothing shares its source image
+	if (current.gain == 1.0f && target_params.format == source_params.format &&
+		current.region.width == source_params.width && current.region.height == source_params.height &&
+		target_params.width == source_params.width && target_params.height == source_params.height)
+	{
+		current.bands = 0;
+		m_images[current.target] = source;
+		return true;
+	}
+
+	if (m_image_pool.get_item(&current.image) == false)
+		throw std::runtime_error("Failed to allocate output image. Out of memory?");
+
+	// A pooled image holds the buffer of its previous output until reused, the buffer is released before allocating
+	current.image->reset(core::imaging::image_params{}, nullptr);
+	if (m_allocator->allocate(target_size, &current.target_buffer) == false)
+		throw std::runtime_error("Failed to allocate buffer for image pipeline. Out of memory?");
+
+	// Bands of an even number of rows, as image_converter
+	current.bands = std::max(1U, std::min(threads, target_params.height / BAND_MIN_ROWS));
+	current.band_rows = (((target_params.height + current.bands - 1) / current.bands) + 1) & ~1U;
+	return true;
+}
+
+bool imaging::image_pipeline_impl::run(job& current, uint32_t band)
+{
+	if (m_nodes[current.target].type == stage::ALGORITHM)
+	{
+		utils::ref_count_ptr<core::imaging::image_interface> image;
+		if (m_nodes[current.target].algorithm->apply(m_images[current.source], &image) == false)
+			return false;
+
+		m_images[current.target] = image;
+		return true;
+	}
+
+	uint32_t first_row = band * current.band_rows;
+	uint32_t last_row = std::min(current.target_params.height, first_row + current.band_rows);
+	return first_row >= last_row || current.converters[band].convert(
+		current.source_buffer->data(), current.source_buffer->size(), current.source_params, current.region, current.gain,
+		current.target_buffer->data(), current.target_buffer->size(), current.target_params.format,
+		current.target_params.width, current.target_params.height, first_row, last_row);
+}
+
+void imaging::image_pipeline_impl::release_images()
+{
+	// Buffers of images which are not outputs go back to the allocator, an output sharing the image of a pass which
+	// changes nothing keeps it
+	for (job& current : m_jobs)
+	{
+		if (current.image != nullptr && m_nodes[current.target].output == false &&
+			std::none_of(m_outputs.begin(), m_outputs.end(), [&](size_t output) { return m_images[output] == current.image; }))
+			current.image->reset(core::imaging::image_params{}, nullptr);
+
+		current.image = nullptr;
+		current.source_buffer = nullptr;
+		current.target_buffer = nullptr;
+	}
+
+	std::fill(m_images.begin(), m_images.end(), nullptr);
+}
+
+bool imaging::image_pipeline_impl::process(
+	core::imaging::image_interface* input,
+	core::imaging::image_interface** outputs,
+	size_t outputs_count)
+{
+	if (input == nullptr)
+		return false;
+
+	if (outputs == nullptr && outputs_count > 0)
+		return false;
+
+	std::lock_guard<std::mutex> locker(m_mutex);
+	if (outputs_count != m_outputs.size())
+		return false;
+
+	if (m_planned == false)
+		plan();
+
+	bool succeeded = true;
+	m_images[INPUT_NODE] = input;
+	try
+	{
+		auto first = m_jobs.begin();
+		for (size_t level = 1; level <= m_levels && succeeded; level++)
+		{
+			auto last = std::find_if(first, m_jobs.end(), [level](const job& current) { return current.level > level; });
+
+			// The threads are shared by the jobs of a level, a pass is converted by bands as image_converter
+			uint32_t threads = std::max(1U, m_threads / static_cast<uint32_t>(last - first));
+			m_tasks.clear();
+			for (auto it = first; it != last && succeeded; ++it)
+			{
+				succeeded = prepare(*it, threads);
+				for (uint32_t band = 0; band < it->bands; band++)
+					m_tasks.emplace_back(static_cast<size_t>(it - m_jobs.begin()), band);
+			}
+
+			if (succeeded == false)
+				break;
+
+			m_results.assign(m_tasks.size(), 0);
+			if (m_threads == 1 || m_tasks.size() == 1)
+			{
+				for (size_t i = 0; i < m_tasks.size(); i++)
+					m_results[i] = run(m_jobs[m_tasks[i].first], m_tasks[i].second);
+			}
+			else
+			{
+				utils::worker_pool::shared().run(m_tasks.size(), [this](size_t i)
+				{
+					m_results[i] = run(m_jobs[m_tasks[i].first], m_tasks[i].second);
+				});
+			}
+
+			succeeded = std::find(m_results.begin(), m_results.end(), 0) == m_results.end();
+			for (auto it = first; it != last && succeeded; ++it)
+			{
+				if (it->image == nullptr)
+					continue;
+
+				it->image->reset(it->target_params, it->target_buffer);
+				m_images[it->target] = it->image;
+			}
+
+			first = last;
+		}
+	}
+	catch (...)
+	{
+		release_images();
+		throw;
+	}
+
+	for (size_t i = 0; i < outputs_count && succeeded; i++)
+	{
+		outputs[i] = m_images[m_outputs[i]];
+		outputs[i]->add_ref();
+	}
+
+	release_images();
+	return succeeded;
+}
+
+bool imaging::image_pipeline::create(uint32_t threads, core::buffer_allocator* allocator, imaging::image_pipeline** pipeline)
+{
+	if (pipeline == nullptr)
+		return false;
+
+	utils::ref_count_ptr<imaging::image_pipeline> instance;
+	try
+	{
+		instance = utils::make_ref_count_ptr<imaging::image_pipeline_impl>(threads, allocator);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	if (instance == nullptr)
+		return false;
+
+	*pipeline = instance;
+	(*pipeline)->add_ref();
+	return true;
+}
+
+bool imaging::image_pipeline::create(uint32_t threads, imaging::image_pipeline** pipeline)
+{
+	return imaging::image_pipeline::create(threads, nullptr, pipeline);
+}
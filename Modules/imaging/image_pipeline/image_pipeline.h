@@ -0,0 +1,105 @@
+#pragma once
+
+#include <imaging/image_pipeline.h>
+
+#include <utils/ref_count_base.hpp>
+#include <utils/buffer_allocator.hpp>
+#include <utils/ref_count_object_pool.hpp>
+#include <utils/imaging.hpp>
+#include <utils/worker_pool.hpp>
+
+#include "../image_converter/pixel_converter.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace imaging
+{
+    class image_pipeline_impl : public utils::ref_count_base<imaging::image_pipeline>
+    {
+    private:
+        static constexpr size_t POOLS_INITIAL_SIZE = 8;
+        static constexpr size_t MEMORY_PER_BUFFER_SIZE = 3840 * 2160 * 4 * 8; // 8 4K RGBA images
+        static constexpr uint32_t BAND_MIN_ROWS = 16;
+
+        enum class stage
+        {
+            INPUT,
+            CONVERT,
+            CROP,
+            SCALE,
+            GAIN,
+            ALGORITHM
+        };
+
+        struct node
+        {
+            stage type;
+            size_t parent;
+            core::imaging::pixel_format format;
+            imaging::pixel_converter::region rectangle; // crop rectangle, scale size
+            float gain;
+            utils::ref_count_ptr<core::imaging::image_algorithm_interface> algorithm;
+            bool built;
+            bool output;
+        };
+
+        // Builds the image of a node from the image of a built ancestor, by a fused pass over the stages between them or by
+        // an algorithm
+        struct job
+        {
+            size_t target;
+            size_t source;
+            std::vector<size_t> stages;
+            size_t level;
+            std::vector<imaging::pixel_converter> converters; // a converter per band
+
+            // The pass of the image being processed
+            core::imaging::image_params source_params;
+            core::imaging::image_params target_params;
+            imaging::pixel_converter::region region;
+            float gain;
+            uint32_t bands;
+            uint32_t band_rows;
+            utils::ref_count_ptr<core::buffer_interface> source_buffer;
+            utils::ref_count_ptr<core::buffer_interface> target_buffer;
+            utils::ref_count_ptr<utils::imaging::ref_count_image> image;
+        };
+
+        mutable std::mutex m_mutex;
+        uint32_t m_threads;
+        utils::ref_count_ptr<core::buffer_allocator> m_allocator;
+        utils::ref_count_object_pool<utils::imaging::ref_count_image> m_image_pool;
+
+        std::vector<node> m_nodes;
+        std::vector<size_t> m_outputs;
+
+        // The plan, built on the first image after stages were added
+        bool m_planned;
+        std::vector<job> m_jobs;
+        size_t m_levels;
+        std::vector<utils::ref_count_ptr<core::imaging::image_interface>> m_images;
+        std::vector<std::pair<size_t, uint32_t>> m_tasks; // job and band
+        std::vector<uint8_t> m_results;
+
+        bool add(size_t parent, const node& stage_node, size_t& index);
+        size_t split(const std::vector<size_t>& stages) const;
+        void plan();
+        bool prepare(job& current, uint32_t threads);
+        bool run(job& current, uint32_t band);
+        void release_images();
+
+    public:
+        image_pipeline_impl(uint32_t threads, core::buffer_allocator* allocator);
+
+        virtual bool add_convert(size_t parent, core::imaging::pixel_format format, size_t& node) override;
+        virtual bool add_crop(size_t parent, uint32_t x, uint32_t y, uint32_t width, uint32_t height, size_t& node) override;
+        virtual bool add_scale(size_t parent, uint32_t width, uint32_t height, size_t& node) override;
+        virtual bool add_gain(size_t parent, float gain, size_t& node) override;
+        virtual bool add_algorithm(size_t parent, core::imaging::image_algorithm_interface* algorithm, size_t& node) override;
+        virtual bool add_output(size_t node, size_t& output) override;
+        virtual size_t outputs() const override;
+        virtual bool process(core::imaging::image_interface* input, core::imaging::image_interface** outputs, size_t outputs_count) override;
+    };
+}
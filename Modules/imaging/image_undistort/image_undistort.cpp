@@ -1,20 +1,77 @@
 #include "image_undistort.h"
 #include <utils/ref_count_ptr.hpp>
 
+#include <algorithm>
 #include <cstddef>
-
-#ifdef OPENCV_VERSION_4
-    #include <opencv2/calib3d.hpp>
-    #include <opencv2/imgproc/types_c.h>
-#endif
+#include <stdexcept>
 
 static constexpr size_t POOLS_INITIAL_SIZE = 20;
 
+namespace
+{
+	// The distorted position of an undistorted one, the map of cv::initUndistortRectifyMap without rectification for the
+	// k1, k2, p1, p2 and k3 coefficients
+	imaging::pixel_remapper::mapping distortion(const float(&camera_matrix)[3][3], const float(&coefficients)[5])
+	{
+		const double m[3][3] = {
+			{ camera_matrix[0][0], camera_matrix[0][1], camera_matrix[0][2] },
+			{ camera_matrix[1][0], camera_matrix[1][1], camera_matrix[1][2] },
+			{ camera_matrix[2][0], camera_matrix[2][1], camera_matrix[2][2] } };
+
+		const double determinant =
+			m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+			m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+			m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+
+		if (determinant == 0.0)
+			throw std::invalid_argument("camera_matrix_chess");
+
+		// The inverse of the camera matrix, from pixels to normalized positions
+		const double inverse[3][3] = {
+			{ (m[1][1] * m[2][2] - m[1][2] * m[2][1]) / determinant, (m[0][2] * m[2][1] - m[0][1] * m[2][2]) / determinant,
+				(m[0][1] * m[1][2] - m[0][2] * m[1][1]) / determinant },
+			{ (m[1][2] * m[2][0] - m[1][0] * m[2][2]) / determinant, (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / determinant,
+				(m[0][2] * m[1][0] - m[0][0] * m[1][2]) / determinant },
+			{ (m[1][0] * m[2][1] - m[1][1] * m[2][0]) / determinant, (m[0][1] * m[2][0] - m[0][0] * m[2][1]) / determinant,
+				(m[0][0] * m[1][1] - m[0][1] * m[1][0]) / determinant } };
+
+		const double fx = m[0][0];
+		const double fy = m[1][1];
+		const double cx = m[0][2];
+		const double cy = m[1][2];
+		const double k1 = coefficients[0];
+		const double k2 = coefficients[1];
+		const double p1 = coefficients[2];
+		const double p2 = coefficients[3];
+		const double k3 = coefficients[4];
+
+		return [=](double x, double y, double& source_x, double& source_y)
+		{
+			double w = 1.0 / (inverse[2][0] * x + inverse[2][1] * y + inverse[2][2]);
+			double normalized_x = (inverse[0][0] * x + inverse[0][1] * y + inverse[0][2]) * w;
+			double normalized_y = (inverse[1][0] * x + inverse[1][1] * y + inverse[1][2]) * w;
+
+			double x2 = normalized_x * normalized_x;
+			double y2 = normalized_y * normalized_y;
+			double r2 = x2 + y2;
+			double xy2 = 2 * normalized_x * normalized_y;
+			double radial = 1 + ((k3 * r2 + k2) * r2 + k1) * r2;
+
+			source_x = fx * (normalized_x * radial + p1 * xy2 + p2 * (r2 + 2 * x2)) + cx;
+			source_y = fy * (normalized_y * radial + p1 * (r2 + 2 * y2) + p2 * xy2) + cy;
+		};
+	}
+}
+
 imaging::image_undistort_impl::image_undistort_impl(
 	uint32_t width,
 	uint32_t height,
 	float(&camera_matrix_chess)[3][3],
-	float(&distCoeffs_chess)[5]) :
+	float(&distCoeffs_chess)[5],
+	uint32_t threads,
+	core::buffer_allocator* allocator) :
+	m_remapper(width, height, distortion(camera_matrix_chess, distCoeffs_chess)),
+	m_threads(threads),
 	m_buffer_pool(
 		POOLS_INITIAL_SIZE,
 		utils::ref_count_object_pool<utils::ref_count_buffer>::growing_mode::doubling,
@@ -23,31 +80,72 @@ imaging::image_undistort_impl::image_undistort_impl(
 	m_image_pool(
 		POOLS_INITIAL_SIZE,
 		utils::ref_count_object_pool<utils::imaging::ref_count_image>::growing_mode::doubling,
-		true)
+		true),
+	m_allocator(allocator)
+{
+	if (threads == 0)
+		throw std::invalid_argument("threads");
+
+	utils::worker_pool::shared().reserve(threads - 1);
+}
+
+core::imaging::pixel_format imaging::image_undistort_impl::output_format(core::imaging::pixel_format format)
 {
-#ifndef __clang_analyzer__
-#ifdef USE_GPU
-#ifndef OPENCV_VERSION_2
-	// set below system variable in order to override OpenCL's default device
-	/*if (_putenv("OPENCV_OPENCL_DEVICE=:GPU:0") != 0)
+	// Formats with a remap kernel are undistorted as is, the others in RGBA
+	if (imaging::pixel_remapper::supports(format) || format == core::imaging::pixel_format::UNDEFINED_PIXEL_FORMAT)
+		return format;
+
+	return core::imaging::pixel_format::RGBA;
+}
+
+bool imaging::image_undistort_impl::undistort(
+	const core::imaging::image_params& input_image_params,
+	core::buffer_interface* source_buffer,
+	core::buffer_interface* target_buffer)
+{
+	if (input_image_params.width != m_remapper.width() || input_image_params.height != m_remapper.height())
+		return false;
+
+	const uint8_t* source = source_buffer->data();
+	size_t source_size = source_buffer->size();
+	core::imaging::pixel_format format = output_format(input_image_params.format);
+
+	utils::ref_count_ptr<utils::ref_count_buffer> converted_buffer;
+	if (format != input_image_params.format)
 	{
-		std::cerr << "Failed to set a desired OpenCL device" << std::endl;
-	}*/
+		if (m_buffer_pool.get_item(&converted_buffer) == false)
+			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
+
+		if (m_converter.convert(source, source_size, input_image_params, converted_buffer->data(), converted_buffer->size(),
+			format, input_image_params.width, input_image_params.height) == false)
+			return false;
 
-	cv::ocl::setUseOpenCL(true);
-#endif
-#endif
+		source = converted_buffer->data();
+		source_size = converted_buffer->size();
+	}
 
-	cv::Mat camera_matrix = cv::Mat(3, 3, CV_32FC1, camera_matrix_chess);
-	cv::Mat dist_coeffs = cv::Mat(1, 5, CV_32FC1, distCoeffs_chess);
+	// Bands of an even number of rows (the chroma rows of I420 and NV12 are shared by two rows), as image_converter
+	const uint32_t height = input_image_params.height;
+	uint32_t bands = std::max(1U, std::min(m_threads, height / BAND_MIN_ROWS));
+	if (bands == 1)
+		return m_remapper.remap(source, source_size, format, target_buffer->data(), target_buffer->size(), 0, height);
+
+	uint32_t band_rows = (((height + bands - 1) / bands) + 1) & ~1U;
+	std::vector<uint8_t>& remapped = m_remapped;
+	remapped.assign(bands, 0);
+	utils::worker_pool::shared().run(bands, [&](size_t band)
+	{
+		uint32_t first_row = static_cast<uint32_t>(band) * band_rows;
+		uint32_t last_row = std::min(height, first_row + band_rows);
+		remapped[band] = first_row >= last_row ||
+			m_remapper.remap(source, source_size, format, target_buffer->data(), target_buffer->size(), first_row, last_row);
+	});
 
-    cv::initUndistortRectifyMap(camera_matrix, dist_coeffs, cv::Mat(), camera_matrix, cv::Size(static_cast<int>(width), static_cast<int>(height)), CV_32FC1, m_map1, m_map2);
-#endif
+	return std::find(remapped.begin(), remapped.end(), 0) == remapped.end();
 }
 
 bool imaging::image_undistort_impl::apply(core::imaging::image_interface* input, core::imaging::image_interface** output)
 {
-#ifndef __clang_analyzer__
 	if (input == nullptr)
 		return false;
 
@@ -62,241 +160,93 @@ bool imaging::image_undistort_impl::apply(core::imaging::image_interface* input,
 	if (input->query_buffer(&source_buffer) == false)
 		return false;
 
-	core::imaging::pixel_format output_format = core::imaging::pixel_format::UNDEFINED_PIXEL_FORMAT;
-
-#ifdef USE_GPU
-	if (input_image_params.format == core::imaging::pixel_format::I420)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height + input_image_params.height / 2), static_cast<int>(input_image_params.width), CV_8UC1, source_buffer->data());
-		source.copyTo(m_gpu_convertion);
-        cv::cvtColor(m_gpu_convertion, m_gpu_source, CV_YUV2RGBA_I420);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::NV12)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height + input_image_params.height / 2), static_cast<int>(input_image_params.width), CV_8UC1, source_buffer->data());
-		source.copyTo(m_gpu_convertion);
-		cv::cvtColor(m_gpu_convertion, m_gpu_source, CV_YUV2RGBA_NV12);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::YUY2)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC2, source_buffer->data());
-		source.copyTo(m_gpu_convertion);
-		cv::cvtColor(m_gpu_convertion, m_gpu_source, CV_YUV2RGBA_YUY2);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::UYVY)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC2, source_buffer->data());
-		source.copyTo(m_gpu_convertion);
-		cv::cvtColor(m_gpu_convertion, m_gpu_source, CV_YUV2RGBA_Y422);
-		output_format = core::imaging::pixel_format::RGBA;
-	}	
-	else if (input_image_params.format == core::imaging::pixel_format::RGB)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC3, source_buffer->data());
-		source.copyTo(m_gpu_convertion);
-		cv::cvtColor(m_gpu_convertion, m_gpu_source, CV_RGB2RGBA);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::BGR)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC3, source_buffer->data());
-		source.copyTo(m_gpu_convertion);
-		cv::cvtColor(m_gpu_convertion, m_gpu_source, CV_BGR2BGRA);
-		output_format = core::imaging::pixel_format::BGRA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::GRAY8)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC1, source_buffer->data());
-		source.copyTo(m_gpu_convertion);
-		cv::cvtColor(m_gpu_convertion, m_gpu_source, CV_GRAY2RGBA);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::GRAY16_LE)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_16UC1, source_buffer->data());
-		source.copyTo(m_gpu_convertion_helper);
-		cv::convertScaleAbs(m_gpu_convertion_helper, m_gpu_convertion, 255.0 / 65535.0);
-		cv::cvtColor(m_gpu_convertion, m_gpu_source, CV_GRAY2RGBA);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, source_buffer->data());
-		source.copyTo(m_gpu_source);
-		output_format = input_image_params.format;
-	}
-	
-	cv::remap(m_gpu_source, m_gpu_target, m_map1, m_map2, cv::INTER_LINEAR);
-
-	utils::ref_count_ptr<utils::ref_count_buffer> undistorted_buffer;
-	if (m_buffer_pool.get_item(&undistorted_buffer) == false)
-		throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-    cv::Mat target(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, undistorted_buffer->data());
-	m_gpu_target.copyTo(target);
-
 	utils::ref_count_ptr<utils::imaging::ref_count_image> instance;
 	if (m_image_pool.get_item(&instance) == false)
 		throw std::runtime_error("Failed to allocate output image. Out of memory?");
 
-	instance->reset(core::imaging::image_params{ input_image_params.width,
-			input_image_params.height,
-			input_image_params.width * input_image_params.height * 4,
-			output_format }, undistorted_buffer);	
+	// A pooled image holds the buffer of its previous output until reused, the buffer is released before allocating
+	instance->reset(core::imaging::image_params{}, nullptr);
 
-	*output = instance;
-	(*output)->add_ref();
-	return true;
-#else
-	utils::ref_count_ptr<core::buffer_interface> converted_buffer;
-
-	if (input_image_params.format == core::imaging::pixel_format::I420)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height + input_image_params.height / 2), static_cast<int>(input_image_params.width), CV_8UC1, source_buffer->data());
-
-		utils::ref_count_ptr<utils::ref_count_buffer> buffer;
-		if (m_buffer_pool.get_item(&buffer) == false)
-			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-		converted_buffer = buffer;
-        cv::Mat cpu_source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
-
-		cv::cvtColor(source, cpu_source, CV_YUV2RGBA_I420);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::NV12)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height + input_image_params.height / 2), static_cast<int>(input_image_params.width), CV_8UC1, source_buffer->data());
-
-		utils::ref_count_ptr<utils::ref_count_buffer> buffer;
-		if (m_buffer_pool.get_item(&buffer) == false)
-			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-		converted_buffer = buffer;
-        cv::Mat cpu_source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
+	const core::imaging::pixel_format target_format = output_format(input_image_params.format);
+	size_t target_size = imaging::pixel_converter::image_size(target_format, input_image_params.width, input_image_params.height);
+	if (target_size == 0)
+		return false;
 
-		cv::cvtColor(source, cpu_source, CV_YUV2RGBA_NV12);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::YUY2)
+	utils::ref_count_ptr<core::buffer_interface> undistorted_buffer;
+	if (m_allocator != nullptr)
 	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC2, source_buffer->data());
-
-		utils::ref_count_ptr<utils::ref_count_buffer> buffer;
-		if (m_buffer_pool.get_item(&buffer) == false)
+		if (m_allocator->allocate(target_size, &undistorted_buffer) == false)
 			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-		converted_buffer = buffer;
-        cv::Mat cpu_source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
-
-		cv::cvtColor(source, cpu_source, CV_YUV2RGBA_YUY2);
-		output_format = core::imaging::pixel_format::RGBA;
 	}
-	else if (input_image_params.format == core::imaging::pixel_format::UYVY)
+	else
 	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC2, source_buffer->data());
-
 		utils::ref_count_ptr<utils::ref_count_buffer> buffer;
 		if (m_buffer_pool.get_item(&buffer) == false)
 			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-		converted_buffer = buffer;
-        cv::Mat cpu_source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
 
-		cv::cvtColor(source, cpu_source, CV_YUV2RGBA_YUY2);
-		output_format = core::imaging::pixel_format::RGBA;
+		undistorted_buffer = buffer;
 	}
-	else if (input_image_params.format == core::imaging::pixel_format::RGB)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC3, source_buffer->data());
 
-		utils::ref_count_ptr<utils::ref_count_buffer> buffer;
-		if (m_buffer_pool.get_item(&buffer) == false)
-			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-		converted_buffer = buffer;
-        cv::Mat cpu_source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
+	if (undistorted_buffer->size() < target_size)
+		return false;
 
-		cv::cvtColor(source, cpu_source, CV_RGB2RGBA);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::BGR)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC3, source_buffer->data());
+	if (undistort(input_image_params, source_buffer, undistorted_buffer) == false)
+		return false;
 
-		utils::ref_count_ptr<utils::ref_count_buffer> buffer;
-		if (m_buffer_pool.get_item(&buffer) == false)
-			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-		converted_buffer = buffer;
-        cv::Mat cpu_source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
+	instance->reset(core::imaging::image_params{ input_image_params.width,
+			input_image_params.height,
+			static_cast<uint32_t>(target_size),
+			target_format }, undistorted_buffer);
 
-		cv::cvtColor(source, cpu_source, CV_BGR2BGRA);
-		output_format = core::imaging::pixel_format::BGRA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::GRAY8)
-	{
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC1, source_buffer->data());
+	*output = instance;
+	(*output)->add_ref();
+	return true;
+}
 
-		utils::ref_count_ptr<utils::ref_count_buffer> buffer;
-		if (m_buffer_pool.get_item(&buffer) == false)
-			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-		converted_buffer = buffer;
-        cv::Mat cpu_source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
+bool imaging::image_undistort_impl::apply_into(core::imaging::image_interface* input, core::imaging::image_interface* output)
+{
+	if (input == nullptr)
+		return false;
 
-		cv::cvtColor(source, cpu_source, CV_GRAY2RGBA);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else if (input_image_params.format == core::imaging::pixel_format::GRAY16_LE)
-	{
-        cv::Mat temp(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_16UC1, source_buffer->data());
-		utils::ref_count_ptr<utils::ref_count_buffer> grayscale_buffer;
-		if (m_buffer_pool.get_item(&grayscale_buffer) == false)
-			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-        cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC1, grayscale_buffer->data());
-		cv::convertScaleAbs(temp, source, 255.0 / 65535.0);
+	if (output == nullptr)
+		return false;
 
-		utils::ref_count_ptr<utils::ref_count_buffer> buffer;
-		if (m_buffer_pool.get_item(&buffer) == false)
-			throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
-		converted_buffer = buffer;
-        cv::Mat cpu_source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
+	core::imaging::image_params input_image_params;
+	if (input->query_image_params(input_image_params) == false)
+		return false;
 
-		cv::cvtColor(source, cpu_source, CV_GRAY2RGBA);
-		output_format = core::imaging::pixel_format::RGBA;
-	}
-	else
-	{
-		converted_buffer = source_buffer;
-		output_format = input_image_params.format;
-	}
+	utils::ref_count_ptr<core::buffer_interface> source_buffer;
+	if (input->query_buffer(&source_buffer) == false)
+		return false;
 
-	utils::ref_count_ptr<utils::ref_count_buffer> undistorted_buffer;
-	if (m_buffer_pool.get_item(&undistorted_buffer) == false)
-	throw std::runtime_error("Failed to allocate buffer for image un-distortion. Out of memory?");
+	// The output image must be the one apply would have produced
+	core::imaging::image_params output_image_params;
+	if (output->query_image_params(output_image_params) == false)
+		return false;
 
-    cv::Mat target(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, undistorted_buffer->data());
-    cv::Mat source(static_cast<int>(input_image_params.height), static_cast<int>(input_image_params.width), CV_8UC4, converted_buffer->data());
-	cv::remap(source, target, m_map1, m_map2, cv::INTER_LINEAR);
+	if (output_image_params.format != output_format(input_image_params.format) ||
+		output_image_params.width != input_image_params.width ||
+		output_image_params.height != input_image_params.height)
+		return false;
 
-	utils::ref_count_ptr<utils::imaging::ref_count_image> instance;
-	if (m_image_pool.get_item(&instance) == false)
-	throw std::runtime_error("Failed to allocate output image. Out of memory?");
+	utils::ref_count_ptr<core::buffer_interface> target_buffer;
+	if (output->query_buffer(&target_buffer) == false)
+		return false;
 
-	instance->reset(core::imaging::image_params{ input_image_params.width,
-			input_image_params.height,
-			input_image_params.width * input_image_params.height * 4,
-			output_format }, undistorted_buffer);
+	size_t target_size = imaging::pixel_converter::image_size(output_image_params.format, input_image_params.width, input_image_params.height);
+	if (target_size == 0 || target_buffer->size() < target_size ||
+		target_buffer->data() == source_buffer->data())
+		return false;
 
-	*output = instance;
-	(*output)->add_ref();
-	return true;
-#endif
-#else
-	return false;
-#endif
+	return undistort(input_image_params, source_buffer, target_buffer);
 }
 
 bool imaging::image_undistort::create(
 	uint32_t width, uint32_t height,
 	float(&camera_matrix_chess)[3][3],
 	float(&distCoeffs_chess)[5],
+	uint32_t threads,
+	core::buffer_allocator* allocator,
 	core::imaging::image_algorithm_interface** algo)
 {
 	if (algo == nullptr)
@@ -305,7 +255,7 @@ bool imaging::image_undistort::create(
 	utils::ref_count_ptr<core::imaging::image_algorithm_interface> instance;
 	try
 	{
-		instance = utils::make_ref_count_ptr<imaging::image_undistort_impl>(width, height, camera_matrix_chess, distCoeffs_chess);
+		instance = utils::make_ref_count_ptr<imaging::image_undistort_impl>(width, height, camera_matrix_chess, distCoeffs_chess, threads, allocator);
 	}
 	catch (...)
 	{
@@ -319,3 +269,22 @@ bool imaging::image_undistort::create(
 	(*algo)->add_ref();
 	return true;
 }
+
+bool imaging::image_undistort::create(
+	uint32_t width, uint32_t height,
+	float(&camera_matrix_chess)[3][3],
+	float(&distCoeffs_chess)[5],
+	core::imaging::image_algorithm_interface** algo)
+{
+	return imaging::image_undistort::create(width, height, camera_matrix_chess, distCoeffs_chess, 1, nullptr, algo);
+}
+
+bool imaging::image_undistort::create(
+	uint32_t width, uint32_t height,
+	float(&camera_matrix_chess)[3][3],
+	float(&distCoeffs_chess)[5],
+	core::buffer_allocator* allocator,
+	core::imaging::image_algorithm_interface** algo)
+{
+	return imaging::image_undistort::create(width, height, camera_matrix_chess, distCoeffs_chess, 1, allocator, algo);
+}
@@ -4,76 +4,44 @@
 #include <utils/ref_count_object_pool.hpp>
 #include <utils/buffer_allocator.hpp>
 #include <utils/imaging.hpp>
+#include <utils/worker_pool.hpp>
 
-// opencv api
-#define CV_IGNORE_DEBUG_BUILD_GUARD
+#include "pixel_remapper.h"
+#include "../image_converter/pixel_converter.h"
 
-// USE GPU accelaration (OpenCL) on
-// OpenCV 3 and above
-#define USE_GPU
-
-#ifdef _WIN32
-#pragma warning( push )
-#pragma warning( disable : 4996)
-#include <opencv2/core/ocl.hpp>
-#include <opencv2/opencv.hpp>
-#pragma warning( pop )
-#else
-#ifndef __clang_analyzer__
-#include <opencv2/core/version.hpp>
-#include <opencv2/imgproc/imgproc.hpp>
-#if defined(CV_VERSION_EPOCH) && (CV_VERSION_EPOCH < 3)
-    #define OPENCV_VERSION_2
-#else
-#if (CV_VERSION_MAJOR >= 4)
-    #define OPENCV_VERSION_4
-#endif
-#endif
-
-#ifdef OPENCV_VERSION_2
-#ifdef USE_GPU
-namespace cv
-{
-    using UMat = cv::Mat;
-}
-#endif
-#else
-    #include <opencv2/core/ocl.hpp>
-#endif
-
-#endif
-#endif
+#include <vector>
 
 namespace imaging
 {
 	class image_undistort_impl : public utils::ref_count_base<imaging::image_undistort>
 	{
 	private:
-#ifndef __clang_analyzer__
-#ifdef USE_GPU
-		cv::UMat m_map1;
-		cv::UMat m_map2;
+		static constexpr uint32_t BAND_MIN_ROWS = 16;
 
-		cv::UMat m_gpu_source;
-		cv::UMat m_gpu_convertion;
-		cv::UMat m_gpu_convertion_helper;
-		cv::UMat m_gpu_target;
-#else
-		cv::Mat m_map1;
-		cv::Mat m_map2;	
-#endif
-#endif
+		imaging::pixel_remapper m_remapper;
+		imaging::pixel_converter m_converter; // formats without a remap kernel are undistorted in RGBA
+		uint32_t m_threads;
+		std::vector<uint8_t> m_remapped;
 
 		utils::ref_count_object_pool<utils::ref_count_buffer> m_buffer_pool;
 		utils::ref_count_object_pool<utils::imaging::ref_count_image> m_image_pool;
+		utils::ref_count_ptr<core::buffer_allocator> m_allocator;
+
+		static core::imaging::pixel_format output_format(core::imaging::pixel_format format);
+
+		bool undistort(const core::imaging::image_params& input_image_params, core::buffer_interface* source_buffer,
+			core::buffer_interface* target_buffer);
 
 	public:
 		image_undistort_impl(
 			uint32_t width, uint32_t height,
 			float(&camera_matrix_chess)[3][3],
-			float(&distCoeffs_chess)[5]);
+			float(&distCoeffs_chess)[5],
+			uint32_t threads = 1,
+			core::buffer_allocator* allocator = nullptr);
 		virtual ~image_undistort_impl() = default;
 
 		virtual bool apply(core::imaging::image_interface* input, core::imaging::image_interface** output) override;
+		virtual bool apply_into(core::imaging::image_interface* input, core::imaging::image_interface* output) override;
 	};
 }
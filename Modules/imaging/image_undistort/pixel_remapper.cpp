@@ -0,0 +1,293 @@
+#include "pixel_remapper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PIXEL_REMAPPER_SSE2
+#endif
+
+namespace
+{
+	using core::imaging::pixel_format;
+
+	// Weights in 7 bits fixed point, so that a horizontally interpolated level fits a signed 16 bits lane
+	constexpr uint32_t WEIGHT_BITS = 7;
+	constexpr uint32_t WEIGHT_ONE = 1 << WEIGHT_BITS;
+	constexpr uint32_t ROUNDING = 1 << (WEIGHT_BITS * 2 - 1);
+
+	// The position of target pixels mapped outside of the source
+	constexpr int16_t OUTSIDE = INT16_MIN;
+
+	constexpr uint8_t BLACK_LUMA = 16;
+	constexpr uint8_t BLACK_CHROMA = 128;
+
+	inline uint32_t chroma_size(uint32_t size)
+	{
+		return (size + 1) / 2;
+	}
+
+	inline uint32_t pair_weights(uint8_t weight)
+	{
+		return (static_cast<uint32_t>(weight) << 16) | (WEIGHT_ONE - weight);
+	}
+
+	// The bilinear interpolation of a channel, p00 and p01 on the first row, p10 and p11 on the second
+	inline uint8_t interpolate(uint32_t p00, uint32_t p01, uint32_t p10, uint32_t p11, uint32_t weight_x, uint32_t weight_y)
+	{
+		uint32_t top = p00 * (WEIGHT_ONE - weight_x) + p01 * weight_x;
+		uint32_t bottom = p10 * (WEIGHT_ONE - weight_x) + p11 * weight_x;
+		return static_cast<uint8_t>((top * (WEIGHT_ONE - weight_y) + bottom * weight_y + ROUNDING) >> (WEIGHT_BITS * 2));
+	}
+
+	template <uint32_t CHANNELS>
+	inline void interpolate_pixel(const uint8_t* first, const uint8_t* second, uint32_t weight_x, uint32_t weight_y, uint8_t* output)
+	{
+		for (uint32_t channel = 0; channel < CHANNELS; channel++)
+			output[channel] = interpolate(first[channel], first[channel + CHANNELS],
+				second[channel], second[channel + CHANNELS], weight_x, weight_y);
+	}
+
+#if defined(PIXEL_REMAPPER_SSE2)
+	// Two neighbor pixels in the low bytes, loads of RGB pixels read 2 bytes after them but at the end of a row where they
+	// may end the buffer
+	template <uint32_t CHANNELS>
+	inline __m128i load_pair(const uint8_t* pixels, bool last)
+	{
+		if (CHANNELS == 4 || (CHANNELS == 3 && last == false))
+			return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixels));
+
+		if (CHANNELS == 2)
+		{
+			uint32_t value = 0;
+			std::memcpy(&value, pixels, 4);
+			return _mm_cvtsi32_si128(static_cast<int>(value));
+		}
+
+		uint64_t value = 0;
+		std::memcpy(&value, pixels, CHANNELS * 2);
+		return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&value));
+	}
+
+	// The channels of two rows of pixel pairs weighted and summed: the left and right levels of a channel are interleaved in
+	// 16 bits lanes and multiplied-added by the horizontal weights, the two rows then by the vertical weights
+	inline __m128i interpolate(__m128i top, __m128i bottom, __m128i weights_x, __m128i weights_y)
+	{
+		__m128i horizontal = _mm_or_si128(_mm_madd_epi16(top, weights_x), _mm_slli_epi32(_mm_madd_epi16(bottom, weights_x), 16));
+		__m128i levels = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(horizontal, weights_y),
+			_mm_set1_epi32(static_cast<int>(ROUNDING))), WEIGHT_BITS * 2);
+		return _mm_packus_epi16(_mm_packs_epi32(levels, levels), levels);
+	}
+
+	template <uint32_t CHANNELS>
+	inline void remap_pixel_sse2(const uint8_t* first, const uint8_t* second, uint32_t weight_x, uint32_t weight_y, bool last,
+		uint8_t* output)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		__m128i top = load_pair<CHANNELS>(first, last);
+		__m128i bottom = load_pair<CHANNELS>(second, last);
+		top = _mm_unpacklo_epi8(_mm_unpacklo_epi8(top, _mm_srli_si128(top, CHANNELS)), zero);
+		bottom = _mm_unpacklo_epi8(_mm_unpacklo_epi8(bottom, _mm_srli_si128(bottom, CHANNELS)), zero);
+
+		uint32_t pixel = static_cast<uint32_t>(_mm_cvtsi128_si32(interpolate(top, bottom,
+			_mm_set1_epi32(static_cast<int>(pair_weights(static_cast<uint8_t>(weight_x)))),
+			_mm_set1_epi32(static_cast<int>(pair_weights(static_cast<uint8_t>(weight_y)))))));
+		std::memcpy(output, &pixel, CHANNELS);
+	}
+#endif
+}
+
+imaging::pixel_remapper::pixel_remapper(uint32_t width, uint32_t height, const mapping& source_position) :
+	m_width(width),
+	m_height(height)
+{
+	if (width < 2 || width > INT16_MAX)
+		throw std::invalid_argument("width");
+
+	if (height < 2 || height > INT16_MAX)
+		throw std::invalid_argument("height");
+
+	if (source_position == nullptr)
+		throw std::invalid_argument("source_position");
+
+	build(source_position, width, height, 1.0, m_luma);
+	build(source_position, chroma_size(width), chroma_size(height), 2.0, m_chroma);
+}
+
+void imaging::pixel_remapper::build(const mapping& source_position, uint32_t width, uint32_t height, double scale, std::vector<entry>& table)
+{
+	// A plane of a scale (chroma planes) samples the center of the scale x scale full size pixels it covers
+	const double offset = (scale - 1.0) / 2.0;
+	table.resize(static_cast<size_t>(width) * height);
+	entry* current = table.data();
+	for (uint32_t y = 0; y < height; y++)
+	{
+		for (uint32_t x = 0; x < width; x++, current++)
+		{
+			double source_x = 0;
+			double source_y = 0;
+			source_position(x * scale + offset, y * scale + offset, source_x, source_y);
+			source_x = (source_x - offset) / scale;
+			source_y = (source_y - offset) / scale;
+
+			// Positions within a pixel of the plane replicate its border
+			double clamped_x = std::min(std::max(source_x, 0.0), width - 1.0);
+			double clamped_y = std::min(std::max(source_y, 0.0), height - 1.0);
+			if (std::isfinite(source_x) == false || std::isfinite(source_y) == false ||
+				std::abs(source_x - clamped_x) >= 1.0 || std::abs(source_y - clamped_y) >= 1.0)
+			{
+				*current = entry{ OUTSIDE, OUTSIDE, 0, 0 };
+				continue;
+			}
+
+			// The left and top pixels of the interpolated 2x2 pixels are inside the plane, the weights up to one
+			long fixed_x = std::lround(clamped_x * WEIGHT_ONE);
+			long fixed_y = std::lround(clamped_y * WEIGHT_ONE);
+			long left = std::min(fixed_x >> WEIGHT_BITS, static_cast<long>(width) - 2);
+			long top = std::min(fixed_y >> WEIGHT_BITS, static_cast<long>(height) - 2);
+			*current = entry{ static_cast<int16_t>(left), static_cast<int16_t>(top),
+				static_cast<uint8_t>(fixed_x - left * WEIGHT_ONE), static_cast<uint8_t>(fixed_y - top * WEIGHT_ONE) };
+		}
+	}
+}
+
+template <uint32_t CHANNELS>
+void imaging::pixel_remapper::remap_row(const uint8_t* source, uint32_t width, const entry* entries, uint8_t border, uint8_t* output)
+{
+	const size_t stride = static_cast<size_t>(width) * CHANNELS;
+	for (uint32_t x = 0; x < width; x++)
+		remap_pixel<CHANNELS>(source, stride, entries[x], border, output + static_cast<size_t>(x) * CHANNELS);
+}
+
+template <uint32_t CHANNELS>
+void imaging::pixel_remapper::remap_pixel(const uint8_t* source, size_t stride, const entry& current, uint8_t border, uint8_t* output)
+{
+	if (current.x == OUTSIDE)
+	{
+		std::memset(output, border, CHANNELS);
+		return;
+	}
+
+	const uint8_t* first = source + static_cast<size_t>(current.y) * stride + static_cast<size_t>(current.x) * CHANNELS;
+#if defined(PIXEL_REMAPPER_SSE2)
+	if (CHANNELS > 1)
+	{
+		const bool last = static_cast<size_t>(current.x + 2) * CHANNELS == stride;
+		remap_pixel_sse2<CHANNELS>(first, first + stride, current.weight_x, current.weight_y, last, output);
+		return;
+	}
+#endif
+
+	interpolate_pixel<CHANNELS>(first, first + stride, current.weight_x, current.weight_y, output);
+}
+
+bool imaging::pixel_remapper::remap_plane(const uint8_t* source, uint8_t* target, uint32_t width, uint32_t height, uint32_t channels,
+	const entry* table, uint8_t border, uint32_t first_row, uint32_t last_row)
+{
+	const size_t stride = static_cast<size_t>(width) * channels;
+	for (uint32_t row = first_row; row < last_row && row < height; row++)
+	{
+		const entry* entries = table + static_cast<size_t>(row) * width;
+		uint8_t* output = target + row * stride;
+		switch (channels)
+		{
+		case 1:
+			remap_row<1>(source, width, entries, border, output);
+			break;
+		case 2:
+			remap_row<2>(source, width, entries, border, output);
+			break;
+		case 3:
+			remap_row<3>(source, width, entries, border, output);
+			break;
+		default:
+			remap_row<4>(source, width, entries, border, output);
+			break;
+		}
+	}
+
+	return true;
+}
+
+bool imaging::pixel_remapper::supports(core::imaging::pixel_format format)
+{
+	switch (format)
+	{
+	case pixel_format::RGB:
+	case pixel_format::BGR:
+	case pixel_format::RGBA:
+	case pixel_format::BGRA:
+	case pixel_format::GRAY8:
+	case pixel_format::I420:
+	case pixel_format::NV12:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool imaging::pixel_remapper::remap(const uint8_t* source, size_t source_size, core::imaging::pixel_format format,
+	uint8_t* target, size_t target_size, uint32_t first_row, uint32_t last_row) const
+{
+	if (source == nullptr || target == nullptr)
+		return false;
+
+	if (first_row >= last_row || last_row > m_height)
+		return false;
+
+	const size_t pixels = static_cast<size_t>(m_width) * m_height;
+	const size_t chroma_pixels = static_cast<size_t>(chroma_size(m_width)) * chroma_size(m_height);
+	size_t size = 0;
+	uint32_t channels = 0;
+	switch (format)
+	{
+	case pixel_format::RGB:
+	case pixel_format::BGR:
+		channels = 3;
+		break;
+	case pixel_format::RGBA:
+	case pixel_format::BGRA:
+		channels = 4;
+		break;
+	case pixel_format::GRAY8:
+		channels = 1;
+		break;
+	case pixel_format::I420:
+	case pixel_format::NV12:
+		if ((first_row & 1) != 0)
+			return false;
+
+		size = pixels + chroma_pixels * 2;
+		break;
+	default:
+		return false;
+	}
+
+	if (size == 0)
+		size = pixels * channels;
+
+	if (source_size < size || target_size < size)
+		return false;
+
+	if (channels != 0)
+		return remap_plane(source, target, m_width, m_height, channels, m_luma.data(), 0, first_row, last_row);
+
+	// The chroma rows of the band, a chroma row is shared by two rows
+	const uint32_t chroma_width = chroma_size(m_width);
+	const uint32_t chroma_height = chroma_size(m_height);
+	const uint32_t first_chroma_row = first_row / 2;
+	const uint32_t last_chroma_row = chroma_size(last_row);
+
+	remap_plane(source, target, m_width, m_height, 1, m_luma.data(), BLACK_LUMA, first_row, last_row);
+	if (format == pixel_format::NV12)
+		return remap_plane(source + pixels, target + pixels, chroma_width, chroma_height, 2, m_chroma.data(), BLACK_CHROMA,
+			first_chroma_row, last_chroma_row);
+
+	remap_plane(source + pixels, target + pixels, chroma_width, chroma_height, 1, m_chroma.data(), BLACK_CHROMA,
+		first_chroma_row, last_chroma_row);
+	return remap_plane(source + pixels + chroma_pixels, target + pixels + chroma_pixels, chroma_width, chroma_height, 1,
+		m_chroma.data(), BLACK_CHROMA, first_chroma_row, last_chroma_row);
+}
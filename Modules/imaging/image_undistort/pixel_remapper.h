@@ -0,0 +1,86 @@
+#pragma once
+#include <core/imaging.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace imaging
+{
+	/// Remaps images by a lookup table computed once (e.g. a lens undistortion): a target pixel is the bilinear interpolation
+	/// of the 2x2 source pixels around its source position.
+	/// The table holds a 16 bits integer position and 7 bits fractional weights (stored in a byte) per target pixel, in
+	/// the order the target is written, a second table of half the size maps I420 and NV12 chroma planes. Pixels of 2 to 4
+	/// channels are interpolated by an SSE2 kernel (all channels at once) and a scalar loop on other platforms, pixels of one
+	/// channel by the scalar loop, both compute the same values.
+	/// Source positions within a pixel of the image replicate its border, the pixels mapped further are black.
+	/// RGB, RGBA, BGR, BGRA, GRAY8, I420 and NV12 images are remapped in their own format, row bands of an image may be
+	/// remapped in parallel by the same remapper.
+	/// @date	19/10/2026
+	class pixel_remapper
+	{
+	public:
+		/// The source position of a target position (in pixels, the center of pixel (x, y) is at (x, y))
+		using mapping = std::function<void(double x, double y, double& source_x, double& source_y)>;
+
+	private:
+		struct entry
+		{
+			int16_t x;
+			int16_t y;
+			uint8_t weight_x;
+			uint8_t weight_y;
+		};
+
+		uint32_t m_width;
+		uint32_t m_height;
+		std::vector<entry> m_luma;
+		std::vector<entry> m_chroma;
+
+		static void build(const mapping& source_position, uint32_t width, uint32_t height, double scale, std::vector<entry>& table);
+		static bool remap_plane(const uint8_t* source, uint8_t* target, uint32_t width, uint32_t height, uint32_t channels,
+			const entry* table, uint8_t border, uint32_t first_row, uint32_t last_row);
+		template <uint32_t CHANNELS>
+		static void remap_row(const uint8_t* source, uint32_t width, const entry* entries, uint8_t border, uint8_t* output);
+		template <uint32_t CHANNELS>
+		static void remap_pixel(const uint8_t* source, size_t stride, const entry& current, uint8_t border, uint8_t* output);
+
+	public:
+		/// Computes the lookup tables of a mapping
+		/// @date	19/10/2026
+		/// @param	width		   	The width of the images, at least 2 and below 32768.
+		/// @param	height		   	The height of the images, at least 2 and below 32768.
+		/// @param	source_position	The mapping.
+		pixel_remapper(uint32_t width, uint32_t height, const mapping& source_position);
+
+		/// Checks if images of a format are remapped in their own format
+		/// @date	19/10/2026
+		/// @param	format	The pixel format.
+		/// @return	True for RGB, RGBA, BGR, BGRA, GRAY8, I420 and NV12.
+		static bool supports(core::imaging::pixel_format format);
+
+		/// Remaps a band of rows of an image
+		/// @date	19/10/2026
+		/// @param 			source	   	The source image, of the size of the tables.
+		/// @param 			source_size	The size of the source buffer.
+		/// @param 			format	   	The pixel format of the source and the target.
+		/// @param [out]	target	   	The target image.
+		/// @param 			target_size	The size of the target buffer.
+		/// @param 			first_row  	The first target row of the band, even when the format is I420 or NV12.
+		/// @param 			last_row   	The target row after the band.
+		/// @return	True if it succeeds, false if the format is not supported, a buffer is too small or the band is invalid.
+		bool remap(const uint8_t* source, size_t source_size, core::imaging::pixel_format format,
+			uint8_t* target, size_t target_size, uint32_t first_row, uint32_t last_row) const;
+
+		uint32_t width() const
+		{
+			return m_width;
+		}
+
+		uint32_t height() const
+		{
+			return m_height;
+		}
+	};
+}
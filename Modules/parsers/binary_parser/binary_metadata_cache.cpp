@@ -0,0 +1,820 @@
+#include "binary_metadata_cache.h"
+#include <parsers/binary_parser.h>
+#include <utils/parser.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+using namespace core::types;
+using namespace core::parsers;
+
+namespace
+{
+	constexpr uint64_t CACHE_MAGIC = 0x4548434143444D42ULL; // "BMDCACHE"
+	constexpr uint32_t CACHE_VERSION = 1;
+	constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+	constexpr uint32_t NO_INDEX = 0xFFFFFFFF;
+
+	// The sections follow the header in this order: enums, enum items, metadata, nodes, metadata entries,
+	// enum entries and the strings pool. Every record is a multiple of 8 bytes so the sections stay aligned.
+	struct cache_header
+	{
+		uint64_t magic;
+		uint32_t version;
+		uint32_t byte_order;
+		uint64_t source_hash;
+		uint64_t file_size;
+		uint32_t enums_count;
+		uint32_t items_count;
+		uint32_t metadata_count;
+		uint32_t nodes_count;
+		uint32_t metadata_entries_count;
+		uint32_t enum_entries_count;
+		uint64_t strings_size;
+	};
+
+	struct cache_enum
+	{
+		uint32_t name;
+		uint32_t first_item;
+		uint32_t items_count;
+		uint32_t reserved;
+	};
+
+	struct cache_item
+	{
+		int64_t val;
+		uint32_t name;
+		uint32_t reserved;
+	};
+
+	struct cache_metadata
+	{
+		uint32_t name;
+		uint32_t first_node;
+		uint32_t nodes_count;
+		uint32_t big_endian;
+		uint64_t size;
+	};
+
+	struct cache_node
+	{
+		uint32_t name;
+		uint32_t type;
+		uint64_t offset;
+		// The size of an element for arrays
+		uint64_t size;
+		uint64_t count;
+		uint32_t big_endian;
+		uint32_t num_of_bits;
+		uint32_t default_string;
+		// The enum of an ENUM node or of the elements of an array
+		uint32_t enum_index;
+		// The metadata of a COMPLEX node or of the elements of an array
+		uint32_t nested;
+		uint32_t element_type;
+		uint8_t options[sizeof(simple_options_data)];
+	};
+
+	// A store name and the index of its metadata or enum
+	struct cache_entry
+	{
+		uint32_t name;
+		uint32_t index;
+	};
+
+	static_assert(sizeof(cache_header) % 8 == 0 && sizeof(cache_enum) % 8 == 0 && sizeof(cache_item) % 8 == 0 &&
+		sizeof(cache_metadata) % 8 == 0 && sizeof(cache_node) % 8 == 0 && sizeof(cache_entry) % 8 == 0,
+		"Unaligned metadata cache records");
+
+	/// A read only mapping of a whole file
+	class mapped_file
+	{
+	private:
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+#ifdef _WIN32
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+#else
+		int m_fd = -1;
+#endif
+
+	public:
+		explicit mapped_file(const char* file_name)
+		{
+#ifdef _WIN32
+			m_file = ::CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			LARGE_INTEGER size;
+			if (m_file == INVALID_HANDLE_VALUE || ::GetFileSizeEx(m_file, &size) == FALSE || size.QuadPart == 0)
+				return;
+
+			m_mapping = ::CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mapping == nullptr)
+				return;
+
+			m_data = static_cast<const uint8_t*>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (m_data != nullptr)
+				m_size = static_cast<size_t>(size.QuadPart);
+#else
+			m_fd = ::open(file_name, O_RDONLY);
+			struct stat status;
+			if (m_fd < 0 || ::fstat(m_fd, &status) != 0 || status.st_size <= 0)
+				return;
+
+			void* data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+			if (data == MAP_FAILED)
+				return;
+
+			m_data = static_cast<const uint8_t*>(data);
+			m_size = static_cast<size_t>(status.st_size);
+#endif
+		}
+
+		~mapped_file()
+		{
+#ifdef _WIN32
+			if (m_data != nullptr)
+				::UnmapViewOfFile(m_data);
+			if (m_mapping != nullptr)
+				::CloseHandle(m_mapping);
+			if (m_file != INVALID_HANDLE_VALUE)
+				::CloseHandle(m_file);
+#else
+			if (m_data != nullptr)
+				::munmap(const_cast<uint8_t*>(m_data), m_size);
+			if (m_fd >= 0)
+				::close(m_fd);
+#endif
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		const uint8_t* data() const
+		{
+			return m_data;
+		}
+
+		size_t size() const
+		{
+			return m_size;
+		}
+	};
+
+	/// Flattens metadata and enums into the records of the cache
+	class cache_writer
+	{
+	private:
+		std::vector<cache_enum> m_enums;
+		std::vector<cache_item> m_items;
+		std::vector<cache_metadata> m_metadata;
+		std::vector<cache_node> m_nodes;
+		std::vector<cache_entry> m_metadata_entries;
+		std::vector<cache_entry> m_enum_entries;
+		std::vector<char> m_strings;
+		std::unordered_map<std::string, uint32_t> m_string_offsets;
+		std::unordered_map<const void*, uint32_t> m_metadata_indices;
+		std::unordered_map<const void*, uint32_t> m_enum_indices;
+
+		template <typename T>
+		static void append(std::vector<uint8_t>& image, const std::vector<T>& records)
+		{
+			if (records.empty())
+				return;
+
+			const uint8_t* data = reinterpret_cast<const uint8_t*>(records.data());
+			image.insert(image.end(), data, data + records.size() * sizeof(T));
+		}
+
+		uint32_t add_string(const char* str)
+		{
+			auto it = m_string_offsets.find(str);
+			if (it != m_string_offsets.end())
+				return it->second;
+
+			uint32_t offset = static_cast<uint32_t>(m_strings.size());
+			m_strings.insert(m_strings.end(), str, str + std::strlen(str) + 1);
+			m_string_offsets.emplace(str, offset);
+			return offset;
+		}
+
+		uint32_t add_enum(enum_data_interface* enum_data)
+		{
+			auto it = m_enum_indices.find(enum_data);
+			if (it != m_enum_indices.end())
+				return it->second;
+
+			cache_enum record;
+			std::memset(&record, 0, sizeof(record));
+			record.name = add_string(enum_data->name());
+			record.first_item = static_cast<uint32_t>(m_items.size());
+			record.items_count = static_cast<uint32_t>(enum_data->size());
+			for (size_t i = 0; i < enum_data->size(); i++)
+			{
+				enum_data_item item;
+				if (false == enum_data->item_by_index(i, item))
+					throw std::runtime_error("binary_metadata_cache: failed to query enum item");
+
+				cache_item item_record;
+				std::memset(&item_record, 0, sizeof(item_record));
+				item_record.val = item.value;
+				item_record.name = add_string(item.name);
+				m_items.push_back(item_record);
+			}
+
+			uint32_t index = static_cast<uint32_t>(m_enums.size());
+			m_enums.push_back(record);
+			m_enum_indices.emplace(enum_data, index);
+			return index;
+		}
+
+		uint32_t add_enum_of(const binary_node_interface* node)
+		{
+			utils::ref_count_ptr<enum_data_interface> enum_data;
+			if (false == node->query_enum(&enum_data) || enum_data == nullptr)
+				return NO_INDEX;
+
+			return add_enum(enum_data);
+		}
+
+		uint32_t add_nested(const binary_node_interface* node)
+		{
+			utils::ref_count_ptr<binary_metadata_interface> nested;
+			if (false == node->nested(&nested) || nested == nullptr)
+				throw std::runtime_error("binary_metadata_cache: complex node without metadata");
+
+			return add_metadata(nested);
+		}
+
+		cache_node node_record(const binary_metadata_interface* metadata, const binary_node_interface* node)
+		{
+			cache_node record;
+			std::memset(&record, 0, sizeof(record));
+			record.name = add_string(node->name());
+			record.type = static_cast<uint32_t>(node->type());
+			record.offset = node->offset();
+			record.size = node->size();
+			record.count = node->count();
+			record.big_endian = node->big_endian() ? 1 : 0;
+			record.default_string = NO_INDEX;
+			record.enum_index = NO_INDEX;
+			record.nested = NO_INDEX;
+			record.element_type = static_cast<uint32_t>(type_enum::UNKNOWN);
+			simple_options_data options = node->options();
+			std::memcpy(record.options, &options, sizeof(record.options));
+
+			switch (node->type())
+			{
+			case type_enum::STRING:
+				record.default_string = add_string(node->string_default());
+				break;
+			case type_enum::ENUM:
+				record.enum_index = add_enum_of(node);
+				break;
+			case type_enum::COMPLEX:
+				record.nested = add_nested(node);
+				break;
+			case type_enum::BITMAP:
+			{
+				// The bits are only exposed through the node's accessor
+				binary_accessor accessor;
+				if (false == metadata->compile_accessor(node->name(), accessor) || accessor.offset != node->offset())
+					throw std::runtime_error("binary_metadata_cache: failed to resolve bits node");
+
+				for (uint64_t mask = accessor.mask; mask != 0; mask &= mask - 1)
+					record.num_of_bits++;
+				break;
+			}
+			case type_enum::ARRAY:
+			{
+				// The array metadata holds a single node describing the element, it is recreated with the array
+				utils::ref_count_ptr<binary_metadata_interface> array_metadata;
+				utils::ref_count_ptr<binary_node_interface> element;
+				if (false == node->nested(&array_metadata) ||
+					false == array_metadata->query_node_by_index(0, &element))
+					throw std::runtime_error("binary_metadata_cache: array node without metadata");
+
+				record.element_type = static_cast<uint32_t>(element->type());
+				if (element->type() == type_enum::COMPLEX)
+					record.nested = add_nested(element);
+				else if (element->type() == type_enum::ENUM)
+					record.enum_index = add_enum_of(element);
+				break;
+			}
+			default:
+				break;
+			}
+
+			return record;
+		}
+
+	public:
+		/// Adds a metadata after the metadata nested in it
+		/// @return	The index of the metadata.
+		uint32_t add_metadata(const binary_metadata_interface* metadata)
+		{
+			auto it = m_metadata_indices.find(metadata);
+			if (it != m_metadata_indices.end())
+				return it->second;
+
+			std::vector<cache_node> nodes;
+			size_t count = metadata->node_count();
+			for (size_t i = 0; i < count; i++)
+			{
+				utils::ref_count_ptr<binary_node_interface> node;
+				if (false == metadata->query_node_by_index(i, &node))
+					throw std::runtime_error("binary_metadata_cache: failed to query node");
+
+				nodes.push_back(node_record(metadata, node));
+			}
+
+			cache_metadata record;
+			std::memset(&record, 0, sizeof(record));
+			record.name = add_string(metadata->namely());
+			record.first_node = static_cast<uint32_t>(m_nodes.size());
+			record.nodes_count = static_cast<uint32_t>(nodes.size());
+			record.big_endian = metadata->big_endian() ? 1 : 0;
+			record.size = metadata->size();
+			m_nodes.insert(m_nodes.end(), nodes.begin(), nodes.end());
+
+			uint32_t index = static_cast<uint32_t>(m_metadata.size());
+			m_metadata.push_back(record);
+			m_metadata_indices.emplace(metadata, index);
+			return index;
+		}
+
+		void add_entry(const std::string& name, const binary_metadata_interface* metadata)
+		{
+			cache_entry entry;
+			entry.index = add_metadata(metadata);
+			entry.name = add_string(name.c_str());
+			m_metadata_entries.push_back(entry);
+		}
+
+		void add_entry(const std::string& name, enum_data_interface* enum_data)
+		{
+			cache_entry entry;
+			entry.index = add_enum(enum_data);
+			entry.name = add_string(name.c_str());
+			m_enum_entries.push_back(entry);
+		}
+
+		std::vector<uint8_t> image(uint64_t source_hash)
+		{
+			// Pads the pool so the file size stays aligned
+			while (m_strings.size() % 8 != 0)
+				m_strings.push_back('\0');
+
+			cache_header header;
+			std::memset(&header, 0, sizeof(header));
+			header.magic = CACHE_MAGIC;
+			header.version = CACHE_VERSION;
+			header.byte_order = BYTE_ORDER_MARK;
+			header.source_hash = source_hash;
+			header.enums_count = static_cast<uint32_t>(m_enums.size());
+			header.items_count = static_cast<uint32_t>(m_items.size());
+			header.metadata_count = static_cast<uint32_t>(m_metadata.size());
+			header.nodes_count = static_cast<uint32_t>(m_nodes.size());
+			header.metadata_entries_count = static_cast<uint32_t>(m_metadata_entries.size());
+			header.enum_entries_count = static_cast<uint32_t>(m_enum_entries.size());
+			header.strings_size = m_strings.size();
+			header.file_size = sizeof(header) +
+				m_enums.size() * sizeof(cache_enum) +
+				m_items.size() * sizeof(cache_item) +
+				m_metadata.size() * sizeof(cache_metadata) +
+				m_nodes.size() * sizeof(cache_node) +
+				(m_metadata_entries.size() + m_enum_entries.size()) * sizeof(cache_entry) +
+				m_strings.size();
+
+			std::vector<uint8_t> image;
+			image.reserve(static_cast<size_t>(header.file_size));
+			const uint8_t* header_data = reinterpret_cast<const uint8_t*>(&header);
+			image.insert(image.end(), header_data, header_data + sizeof(header));
+			append(image, m_enums);
+			append(image, m_items);
+			append(image, m_metadata);
+			append(image, m_nodes);
+			append(image, m_metadata_entries);
+			append(image, m_enum_entries);
+			image.insert(image.end(), m_strings.begin(), m_strings.end());
+			return image;
+		}
+	};
+
+	/// The sections of a mapped cache, validated before anything is created from them
+	class cache_view
+	{
+	private:
+		const cache_header* m_header = nullptr;
+		const cache_enum* m_enums = nullptr;
+		const cache_item* m_items = nullptr;
+		const cache_metadata* m_metadata = nullptr;
+		const cache_node* m_nodes = nullptr;
+		const cache_entry* m_metadata_entries = nullptr;
+		const cache_entry* m_enum_entries = nullptr;
+		const char* m_strings = nullptr;
+
+		template <typename T>
+		static bool section(const uint8_t* data, uint64_t& offset, uint64_t count, uint64_t size, const T*& records)
+		{
+			uint64_t section_size = count * sizeof(T);
+			if (offset + section_size > size)
+				return false;
+
+			records = reinterpret_cast<const T*>(data + offset);
+			offset += section_size;
+			return true;
+		}
+
+		bool valid_string(uint32_t offset) const
+		{
+			return offset < m_header->strings_size;
+		}
+
+		bool valid_node(const cache_node& node) const
+		{
+			if (false == valid_string(node.name))
+				return false;
+			if (node.default_string != NO_INDEX && false == valid_string(node.default_string))
+				return false;
+			if (node.enum_index != NO_INDEX && node.enum_index >= m_header->enums_count)
+				return false;
+			if (node.nested != NO_INDEX && node.nested >= m_header->metadata_count)
+				return false;
+
+			return true;
+		}
+
+	public:
+		/// Validates the header and the cross references of the records
+		bool open(const uint8_t* data, size_t size, uint64_t source_hash)
+		{
+			if (data == nullptr || size < sizeof(cache_header))
+				return false;
+
+			m_header = reinterpret_cast<const cache_header*>(data);
+			if (m_header->magic != CACHE_MAGIC ||
+				m_header->version != CACHE_VERSION ||
+				m_header->byte_order != BYTE_ORDER_MARK ||
+				m_header->source_hash != source_hash ||
+				m_header->file_size != size)
+				return false;
+
+			uint64_t offset = sizeof(cache_header);
+			if (false == section(data, offset, m_header->enums_count, size, m_enums) ||
+				false == section(data, offset, m_header->items_count, size, m_items) ||
+				false == section(data, offset, m_header->metadata_count, size, m_metadata) ||
+				false == section(data, offset, m_header->nodes_count, size, m_nodes) ||
+				false == section(data, offset, m_header->metadata_entries_count, size, m_metadata_entries) ||
+				false == section(data, offset, m_header->enum_entries_count, size, m_enum_entries) ||
+				offset + m_header->strings_size != size)
+				return false;
+
+			m_strings = reinterpret_cast<const char*>(data + offset);
+			if (m_header->strings_size == 0 || m_strings[m_header->strings_size - 1] != '\0')
+				return false;
+
+			for (uint32_t i = 0; i < m_header->enums_count; i++)
+			{
+				const cache_enum& record = m_enums[i];
+				if (false == valid_string(record.name) ||
+					static_cast<uint64_t>(record.first_item) + record.items_count > m_header->items_count)
+					return false;
+			}
+
+			for (uint32_t i = 0; i < m_header->items_count; i++)
+			{
+				if (false == valid_string(m_items[i].name))
+					return false;
+			}
+
+			for (uint32_t i = 0; i < m_header->metadata_count; i++)
+			{
+				const cache_metadata& record = m_metadata[i];
+				if (false == valid_string(record.name) ||
+					static_cast<uint64_t>(record.first_node) + record.nodes_count > m_header->nodes_count)
+					return false;
+
+				// Nested metadata precede the metadata that refer to them
+				for (uint32_t j = 0; j < record.nodes_count; j++)
+				{
+					const cache_node& node = m_nodes[record.first_node + j];
+					if (false == valid_node(node) || (node.nested != NO_INDEX && node.nested >= i))
+						return false;
+				}
+			}
+
+			for (uint32_t i = 0; i < m_header->metadata_entries_count; i++)
+			{
+				if (false == valid_string(m_metadata_entries[i].name) || m_metadata_entries[i].index >= m_header->metadata_count)
+					return false;
+			}
+
+			for (uint32_t i = 0; i < m_header->enum_entries_count; i++)
+			{
+				if (false == valid_string(m_enum_entries[i].name) || m_enum_entries[i].index >= m_header->enums_count)
+					return false;
+			}
+
+			return true;
+		}
+
+		const cache_header& header() const
+		{
+			return *m_header;
+		}
+
+		const cache_enum& enum_at(size_t index) const
+		{
+			return m_enums[index];
+		}
+
+		const cache_item& item_at(size_t index) const
+		{
+			return m_items[index];
+		}
+
+		const cache_metadata& metadata_at(size_t index) const
+		{
+			return m_metadata[index];
+		}
+
+		const cache_node& node_at(size_t index) const
+		{
+			return m_nodes[index];
+		}
+
+		const cache_entry& metadata_entry_at(size_t index) const
+		{
+			return m_metadata_entries[index];
+		}
+
+		const cache_entry& enum_entry_at(size_t index) const
+		{
+			return m_enum_entries[index];
+		}
+
+		const char* string_at(uint32_t offset) const
+		{
+			return m_strings + offset;
+		}
+	};
+
+	/// Recreates a node through the builder calls which created it
+	bool replay_node(const cache_view& view, const cache_node& node, binary_metadata_builder_interface* builder,
+		const std::vector<utils::ref_count_ptr<binary_metadata_builder_interface>>& metadata,
+		const std::vector<utils::ref_count_ptr<enum_data_interface>>& enums)
+	{
+		const char* name = view.string_at(node.name);
+		size_t size = static_cast<size_t>(node.size);
+		simple_options_data options;
+		std::memcpy(&options, node.options, sizeof(options));
+		builder->set_big_endian(node.big_endian != 0);
+
+		switch (static_cast<type_enum>(node.type))
+		{
+		case type_enum::STRING:
+			return builder->put_string(name, size, node.default_string == NO_INDEX ? "" : view.string_at(node.default_string));
+		case type_enum::BITMAP:
+			return builder->put_bits(name, node.num_of_bits, size);
+		case type_enum::COMPLEX:
+			return node.nested != NO_INDEX && builder->nest_metadata(name, metadata[node.nested]);
+		case type_enum::ENUM:
+			if (node.enum_index != NO_INDEX)
+				return builder->put_enum(name, size, enums[node.enum_index], options);
+
+			return builder->put(name, size, type_enum::ENUM, options);
+		case type_enum::ARRAY:
+		{
+			type_enum element_type = static_cast<type_enum>(node.element_type);
+			size_t count = static_cast<size_t>(node.count);
+			if (element_type == type_enum::COMPLEX)
+				return node.nested != NO_INDEX && builder->array(name, size, element_type, count, options, metadata[node.nested]);
+			if (element_type == type_enum::ENUM && node.enum_index != NO_INDEX)
+				return builder->array(name, count, size, options, enums[node.enum_index]);
+
+			// The default of string elements is not exposed by the builder, string arrays are restored without it
+			return builder->array(name, size, element_type, count, options, nullptr);
+		}
+		default:
+			return builder->put(name, size, static_cast<type_enum>(node.type), options);
+		}
+	}
+
+	uint64_t mix(uint64_t hash, uint64_t word)
+	{
+		hash = ((hash << 5) | (hash >> 59)) ^ word;
+		return hash * 0x9E3779B97F4A7C15ULL;
+	}
+}
+
+bool parsers::binary_metadata_cache::save(const char* file_name, uint64_t source_hash, const named_metadata& metadata, const named_enums& enums)
+{
+	if (file_name == nullptr)
+		return false;
+
+	std::vector<uint8_t> image;
+	try
+	{
+		cache_writer writer;
+		for (const auto& entry : enums)
+			writer.add_entry(entry.first, entry.second);
+
+		for (const auto& entry : metadata)
+			writer.add_entry(entry.first, static_cast<const binary_metadata_interface*>(entry.second));
+
+		image = writer.image(source_hash);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	// Written aside and renamed, a reader never maps a partial file
+	std::string temp_name = std::string(file_name) + ".tmp";
+	{
+		std::ofstream file(temp_name, std::ios::binary | std::ios::trunc);
+		if (false == file.is_open())
+			return false;
+
+		file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+		if (false == file.good())
+		{
+			file.close();
+			std::remove(temp_name.c_str());
+			return false;
+		}
+	}
+
+#ifdef _WIN32
+	if (::MoveFileExA(temp_name.c_str(), file_name, MOVEFILE_REPLACE_EXISTING) == FALSE)
+#else
+	if (std::rename(temp_name.c_str(), file_name) != 0)
+#endif
+	{
+		std::remove(temp_name.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool parsers::binary_metadata_cache::load(const char* file_name, uint64_t source_hash, core::parsers::binary_metadata_store_interface* store)
+{
+	if (file_name == nullptr || store == nullptr)
+		return false;
+
+	mapped_file file(file_name);
+	cache_view view;
+	if (false == view.open(file.data(), file.size(), source_hash))
+		return false;
+
+	const cache_header& header = view.header();
+	try
+	{
+		// Enums of the store which already exist are shared by the loaded metadata
+		std::vector<utils::ref_count_ptr<enum_data_interface>> enums(header.enums_count);
+		std::vector<bool> stored_enums(header.enums_count, false);
+		for (uint32_t i = 0; i < header.enum_entries_count; i++)
+		{
+			const cache_entry& entry = view.enum_entry_at(i);
+			utils::ref_count_ptr<enum_data_interface> existing;
+			if (store->query_enum(view.string_at(entry.name), &existing))
+			{
+				enums[entry.index] = existing;
+				stored_enums[entry.index] = true;
+			}
+		}
+
+		for (uint32_t i = 0; i < header.enums_count; i++)
+		{
+			if (enums[i] != nullptr)
+				continue;
+
+			const cache_enum& record = view.enum_at(i);
+			if (false == parsers::enum_data::create(view.string_at(record.name), &enums[i]))
+				return false;
+
+			for (uint32_t j = 0; j < record.items_count; j++)
+			{
+				const cache_item& item = view.item_at(record.first_item + j);
+				if (false == enums[i]->add_item(view.string_at(item.name), item.val))
+					return false;
+			}
+		}
+
+		// The metadata are registered in the store only once all of them were restored
+		utils::ref_count_ptr<binary_parser_creator_interface> creator = utils::make_ref_count_ptr<utils::parsers::binary_parser_creator>();
+		std::vector<utils::ref_count_ptr<binary_metadata_builder_interface>> metadata(header.metadata_count);
+		for (uint32_t i = 0; i < header.metadata_count; i++)
+		{
+			const cache_metadata& record = view.metadata_at(i);
+			if (false == parsers::binary_metadata::create(record.big_endian != 0, store, creator, &metadata[i]))
+				return false;
+
+			for (uint32_t j = 0; j < record.nodes_count; j++)
+			{
+				const cache_node& node = view.node_at(record.first_node + j);
+				if (false == replay_node(view, node, metadata[i], metadata, enums))
+					return false;
+
+				// The layout is recomputed by the builder, it has to be the saved one
+				utils::ref_count_ptr<binary_node_interface> restored;
+				if (false == metadata[i]->query_node_by_index(j, &restored) || restored->offset() != node.offset)
+					return false;
+			}
+
+			metadata[i]->set_big_endian(record.big_endian != 0);
+			if (metadata[i]->size() != record.size)
+				return false;
+		}
+
+		for (uint32_t i = 0; i < header.enum_entries_count; i++)
+		{
+			const cache_entry& entry = view.enum_entry_at(i);
+			if (false == stored_enums[entry.index])
+				store->add_enum(view.string_at(entry.name), enums[entry.index]);
+		}
+
+		//the replayed metadata are complete, they are queried without locks
+		for (uint32_t i = 0; i < header.metadata_count; i++)
+		{
+			metadata[i]->namely(view.string_at(view.metadata_at(i).name));
+			metadata[i]->freeze();
+		}
+
+		for (uint32_t i = 0; i < header.metadata_entries_count; i++)
+		{
+			const cache_entry& entry = view.metadata_entry_at(i);
+			utils::ref_count_ptr<binary_metadata_interface> existing;
+			if (false == store->query_parser_metadata(view.string_at(entry.name), &existing))
+				store->add_parser_metadata(view.string_at(entry.name), metadata[entry.index]);
+		}
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool parsers::binary_metadata_cache::hash_files(const char* const* file_names, size_t count, uint64_t& hash)
+{
+	if (file_names == nullptr && count > 0)
+		return false;
+
+	static constexpr size_t CHUNK_SIZE = 64 * 1024;
+	std::vector<char> chunk(CHUNK_SIZE);
+	uint64_t result = 0xcbf29ce484222325ULL;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (file_names[i] == nullptr)
+			return false;
+
+		std::ifstream file(file_names[i], std::ios::binary);
+		if (false == file.is_open())
+			return false;
+
+		uint64_t length = 0;
+		while (file)
+		{
+			file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+			size_t read = static_cast<size_t>(file.gcount());
+			size_t words = read / sizeof(uint64_t);
+			for (size_t j = 0; j < words; j++)
+			{
+				uint64_t word;
+				std::memcpy(&word, chunk.data() + j * sizeof(uint64_t), sizeof(word));
+				result = mix(result, word);
+			}
+
+			for (size_t j = words * sizeof(uint64_t); j < read; j++)
+				result = mix(result, static_cast<uint8_t>(chunk[j]));
+
+			length += read;
+		}
+
+		if (file.bad())
+			return false;
+
+		// Separates the files, moving bytes between them changes the hash
+		result = mix(result, length);
+	}
+
+	hash = result ^ (result >> 31);
+	return true;
+}
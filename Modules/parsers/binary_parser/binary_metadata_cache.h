@@ -0,0 +1,47 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/ref_count_ptr.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace parsers
+{
+	/// The binary image of a metadata store - every metadata, node and enum of the store as flat fixed size records
+	/// which refer to each other by index and to their names by offset into a strings pool.
+	/// The image is mapped and read in place, the metadata are then replayed through their builders without
+	/// parsing any text. Nested metadata precede the metadata that refer to them, shared metadata are stored once.
+	/// @date	19/10/2026
+	class binary_metadata_cache
+	{
+	public:
+		using named_metadata = std::vector<std::pair<std::string, utils::ref_count_ptr<core::parsers::binary_metadata_interface>>>;
+		using named_enums = std::vector<std::pair<std::string, utils::ref_count_ptr<core::parsers::enum_data_interface>>>;
+
+		/// Saves the metadata and the enums of a store into a cache file
+		/// @date	19/10/2026
+		/// @param	file_name  	The name of the cache file.
+		/// @param	source_hash	The content hash of the sources of the store.
+		/// @param	metadata   	The metadata of the store by their names in the store.
+		/// @param	enums	   	The enums of the store by their names in the store.
+		/// @return	True if it succeeds, false if it fails.
+		static bool save(const char* file_name, uint64_t source_hash, const named_metadata& metadata, const named_enums& enums);
+
+		/// Loads a cache file into a store
+		/// @date	19/10/2026
+		/// @param 		   	file_name  	The name of the cache file.
+		/// @param 		   	source_hash	The content hash of the current sources.
+		/// @param [in]	store	   	The store.
+		/// @return	True if it succeeds, false if the file is missing, invalid or of other sources.
+		static bool load(const char* file_name, uint64_t source_hash, core::parsers::binary_metadata_store_interface* store);
+
+		/// Hashes the content of files
+		/// @date	19/10/2026
+		/// @param 			file_names	The names of the files.
+		/// @param 			count	  	Number of files.
+		/// @param [out]	hash	  	The content hash.
+		/// @return	True if it succeeds, false if a file cannot be read.
+		static bool hash_files(const char* const* file_names, size_t count, uint64_t& hash);
+	};
+}
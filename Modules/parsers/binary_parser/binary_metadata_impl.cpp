@@ -5,12 +5,20 @@
 #include <core/buffer_interface.h>
 #include <utils/buffer_allocator.hpp>
 #include <utils/types.hpp>
+#include <utils/endian.hpp>
 #include <parsers/binary_parser.h>
 #include "../nlohmann/fifo_json.hpp"
 #include <utils/parser.hpp>
 #include <utils/ref_count_object_pool.hpp>
 #include <utils/strings.hpp>
+#include "node_name_table.h"
+#include "frozen_metadata_tables.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
+#include <cctype>
+#include <cstdlib>
 #include <ostream>
 #include <sstream>
 #include <unordered_map>
@@ -25,7 +33,7 @@ namespace parsers
 	/// it holds a vector of nodes each describes the relevant node including its name, size, offset from start.
 	/// If it describe a complex data or and ARRAY it will also hold a metadata to that describe the struct of array
 	/// @date	23/09/2018
-	class binary_metadata_impl : public utils::ref_count_base<parsers::binary_metadata>
+	class binary_metadata_impl : public utils::ref_count_base<parsers::binary_metadata>, public frozen_metadata_tables
 	{
 	private:
 		/// A binary node - hold the description on a specific node of the data
@@ -161,21 +169,7 @@ namespace parsers
 				if (m_big_endian != utils::types::is_big_endian())
 				{
 					//if data stream is mismatched to the platform endian convert
-					uint8_t* data_change = (uint8_t*)data;
-					size_t convert_data_size;
-					if (data_size % 2 != 0)
-					{
-						convert_data_size = data_size - 1;
-					}
-					else
-					{
-						convert_data_size = data_size;
-					}
-
-					for (size_t i = 0; i < convert_data_size; i += 2)
-					{
-						utils::types::endian_swap(*((uint16_t*)&data_change[i]));
-					}
+					utils::types::endian_swap_words(data, data_size);
 				}
 
 				return true;
@@ -195,21 +189,7 @@ namespace parsers
 				if (m_big_endian != utils::types::is_big_endian())
 				{
 					//if data stream is mismatched to the platform endian convert
-					size_t convert_data_size;
-					uint8_t* data_change = (uint8_t*)data;
-					if (data_size % 2 != 0)
-					{
-						convert_data_size = data_size - 1;
-					}
-					else
-					{
-						convert_data_size = data_size;
-					}
-
-					for (size_t i = 0; i < convert_data_size; i += 2)
-					{
-						utils::types::endian_swap(*((uint16_t*)&data_change[i]));
-					}
+					utils::types::endian_swap_words(const_cast<void*>(data), data_size);
 				}
 
 				MEMCPY(buffer, buffer_size, data, data_size);
@@ -296,21 +276,7 @@ namespace parsers
 				if (m_big_endian != utils::types::is_big_endian())
 				{
 					//if data stream is mismatched to the platform endian convert
-					size_t convert_data_size;
-					uint8_t* data_change = (uint8_t*)data;
-					if (data_size % 2 != 0)
-					{
-						convert_data_size = data_size - 1;
-					}
-					else
-					{
-						convert_data_size = data_size;
-					}
-
-					for (size_t i = 0; i < convert_data_size; i += 2)
-					{
-						utils::types::endian_swap(*((uint16_t*)&data_change[i]));
-					}
+					utils::types::endian_swap_words(data, data_size);
 				}
 
 				return true;
@@ -334,21 +300,7 @@ namespace parsers
 				if (m_big_endian != utils::types::is_big_endian())
 				{
 					//if data stream is mismatched to the platform endian convert
-					size_t convert_data_size;
-					uint8_t* data_change = (uint8_t*)data;
-					if (data_size % 2 != 0)
-					{
-						convert_data_size = data_size - 1;
-					}
-					else
-					{
-						convert_data_size = data_size;
-					}
-
-					for (size_t i = 0; i < convert_data_size; i += 2)
-					{
-						utils::types::endian_swap(*((uint16_t*)&data_change[i]));
-					}
+					utils::types::endian_swap_words(const_cast<void*>(data), data_size);
 				}
 
 				uint64_t exist_data = 0;
@@ -402,6 +354,14 @@ namespace parsers
 		using parser_node_vector =
 			std::vector<utils::ref_count_ptr<binary_node_interface>>;
 		utils::thread_safe_object<parser_node_vector> m_parser_metadata;
+		// Once frozen the nodes are read from a read-only copy without locks.
+		// Mutators hold the freeze lock across their frozen check and the mutation, recursive as json_to_schema puts nodes.
+		std::atomic<bool> m_frozen;
+		std::recursive_mutex m_freeze_lock;
+		parser_node_vector m_frozen_nodes;
+		node_name_table m_frozen_names;
+		std::unique_ptr<utils::parsers::validation_table> m_frozen_validation;
+		std::unique_ptr<json_key_tables> m_frozen_json_keys;
 		utils::ref_count_ptr<binary_metadata_store_interface> m_store;
 		std::atomic<size_t> m_offset;
 		std::string m_name;
@@ -730,6 +690,7 @@ namespace parsers
 	public:
 		binary_metadata_impl(binary_metadata_store_interface* store, bool big_endian, binary_parser_creator_interface* parser_creator) :
 			m_big_endian(big_endian),
+			m_frozen(false),
 			m_store(store),
 			m_offset(0),
 			m_parser_creator(parser_creator)
@@ -761,6 +722,17 @@ namespace parsers
 		/// @return	True if it succeeds, false if it fails.
 		bool query_node(const char* name, binary_node_interface** node) const override
 		{
+			if (m_frozen.load(std::memory_order_acquire))
+			{
+				size_t index;
+				if (false == m_frozen_names.find(name, index))
+					return false;
+
+				*node = m_frozen_nodes[index];
+				(*node)->add_ref();
+				return true;
+			}
+
 			return m_parser_metadata.use<bool>([&](const parser_node_vector& parser_data)
 			{
 					for (size_t i = 0; i < parser_data.size(); i++)
@@ -784,6 +756,16 @@ namespace parsers
 		/// @return	True if it succeeds, false if it fails.
 		bool query_node_by_index(size_t index, binary_node_interface** node) const override
 		{
+			if (m_frozen.load(std::memory_order_acquire))
+			{
+				if (index >= m_frozen_nodes.size())
+					return false;
+
+				*node = m_frozen_nodes[index];
+				(*node)->add_ref();
+				return true;
+			}
+
             return m_parser_metadata.use<bool>([&](const parser_node_vector& parser_data)
 			{
 				if (index >= parser_data.size())
@@ -803,6 +785,9 @@ namespace parsers
 		/// @return	A size_t.
 		size_t node_count() const override
 		{
+			if (m_frozen.load(std::memory_order_acquire))
+				return m_frozen_nodes.size();
+
 			return m_parser_metadata.use<size_t>([&](const parser_node_vector& parser_data)
 			{
 				return parser_data.size();
@@ -846,9 +831,92 @@ namespace parsers
 			return false;
 		}
 
+		/// Compiles a field path into an accessor, resolving one path element per nesting level
+		/// @date	19/10/2026
+		/// @param 			path	 	The path of the field (e.g. "header.sensors[3].temp").
+		/// @param [out]	accessor	The compiled accessor.
+		/// @return	True if it succeeds, false if it fails.
+		bool compile_accessor(const char* path, binary_accessor& accessor) const override
+		{
+			if (path == nullptr)
+				return false;
+
+			const char* separator = path + std::strcspn(path, ".[");
+			std::string name(path, separator);
+			utils::ref_count_ptr<binary_node_interface> node;
+			if (false == query_node(name.c_str(), &node))
+				return false;
+
+			size_t offset = node->offset();
+			if (*separator == '[')
+			{
+				if (node->type() != type_enum::ARRAY)
+					return false;
+
+				if (std::isdigit(static_cast<unsigned char>(separator[1])) == 0)
+					return false;
+
+				char* end = nullptr;
+				size_t index = static_cast<size_t>(std::strtoull(separator + 1, &end, 10));
+				if (*end != ']' || index >= node->count())
+					return false;
+
+				//the array metadata holds a single node describing the element
+				utils::ref_count_ptr<binary_metadata_interface> array_metadata;
+				utils::ref_count_ptr<binary_node_interface> element;
+				if (false == node->nested(&array_metadata) ||
+					false == array_metadata->query_node_by_index(0, &element))
+					return false;
+
+				offset += index * element->size();
+				node = element;
+				separator = end + 1;
+			}
+
+			if (*separator == '.')
+			{
+				if (node->type() != type_enum::COMPLEX)
+					return false;
+
+				utils::ref_count_ptr<binary_metadata_interface> nested_metadata;
+				if (false == node->nested(&nested_metadata))
+					return false;
+
+				if (false == nested_metadata->compile_accessor(separator + 1, accessor))
+					return false;
+
+				accessor.offset += offset;
+				return true;
+			}
+
+			if (*separator != '\0')
+				return false;
+
+			//only fields which can be read as a whole
+			if (node->type() == type_enum::COMPLEX || node->type() == type_enum::ARRAY)
+				return false;
+
+			binary_accessor compiled;
+			compiled.offset = offset;
+			compiled.size = node->size();
+			compiled.type = node->type();
+			compiled.swap = (node->big_endian() != utils::types::is_big_endian());
+			if (compiled.type == type_enum::BITMAP)
+			{
+				const bit_binary_node* bit_node = static_cast<const bit_binary_node*>(static_cast<binary_node_interface*>(node));
+				compiled.mask = bit_node->mask();
+				compiled.bit_offset = static_cast<uint8_t>(bit_node->bit_offset());
+			}
+
+			accessor = compiled;
+			return true;
+		}
+
 		bool get_index_by_name(const char* name, size_t& index) const override
 		{
-			
+			if (m_frozen.load(std::memory_order_acquire))
+				return m_frozen_names.find(name, index);
+
 			return m_parser_metadata.use<bool>([&](const parser_node_vector& parser_data)
 			{
 				for (size_t i = 0; i < parser_data.size(); i++)
@@ -870,6 +938,83 @@ namespace parsers
 			return m_big_endian;
 		}
 
+		bool frozen() const override
+		{
+			return m_frozen.load(std::memory_order_acquire);
+		}
+
+		/// Freezes the metadata and its nested metadata, the nodes are copied into a flat read-only table
+		/// @date	19/10/2026
+		/// @return	True if it succeeds, false if it fails.
+		bool freeze() override
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return true;
+
+			parser_node_vector nodes = m_parser_metadata.use<parser_node_vector>([&](const parser_node_vector& parser_data)
+			{
+				return parser_data;
+			});
+
+			//nested metadata are complete once they are nested, the element metadata of arrays are owned by their nodes
+			for (const utils::ref_count_ptr<binary_node_interface>& node : nodes)
+			{
+				if (node->type() != type_enum::COMPLEX && node->type() != type_enum::ARRAY)
+					continue;
+
+				utils::ref_count_ptr<binary_metadata_interface> nested;
+				if (false == node->nested(&nested) || nested == nullptr || nested->frozen())
+					continue;
+
+				binary_metadata_builder_interface* builder =
+					dynamic_cast<binary_metadata_builder_interface*>(static_cast<binary_metadata_interface*>(nested));
+				if (builder == nullptr || false == builder->freeze())
+					return false;
+			}
+
+			m_frozen_nodes = std::move(nodes);
+			m_frozen_names.build(m_frozen_nodes);
+
+			//built once for every parser of the metadata, a metadata the tables do not support falls back to the slower paths
+			try
+			{
+				m_frozen_validation.reset(new utils::parsers::validation_table(this));
+			}
+			catch (...)
+			{
+				m_frozen_validation.reset();
+			}
+
+			try
+			{
+				m_frozen_json_keys.reset(new json_key_tables(this));
+			}
+			catch (...)
+			{
+				m_frozen_json_keys.reset();
+			}
+
+			m_frozen.store(true, std::memory_order_release);
+			return true;
+		}
+
+		const utils::parsers::validation_table* frozen_validation() const override
+		{
+			if (false == m_frozen.load(std::memory_order_acquire))
+				return nullptr;
+
+			return m_frozen_validation.get();
+		}
+
+		const json_key_tables* frozen_json_keys() const override
+		{
+			if (false == m_frozen.load(std::memory_order_acquire))
+				return nullptr;
+
+			return m_frozen_json_keys.get();
+		}
+
 		const char* to_json(bool compact) const override
 		{
 			int indent = -1;
@@ -890,6 +1035,9 @@ namespace parsers
 
 		bool from_json(const char *json_string) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			unordered_json json;
 			json = unordered_json::parse(json_string);
 
@@ -903,6 +1051,9 @@ namespace parsers
 		/// @param	name	The name.
 		bool namely(const char* name) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 			m_name = name;
@@ -953,6 +1104,10 @@ namespace parsers
 		/// @return	A reference to a binary_metadata_impl.
 		void set_big_endian(bool big_endian) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return;
+
 			m_big_endian = big_endian;
 		}
 
@@ -974,6 +1129,9 @@ namespace parsers
 		/// @return	A reference to a binary_metadata_impl.
 		bool put(const char* name, size_t size, type_enum type, const simple_options_data& options) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 
@@ -993,6 +1151,9 @@ namespace parsers
 
 		bool put_enum(const char* name, size_t size, enum_data_interface* enum_type, const simple_options_data& options) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 
@@ -1013,6 +1174,9 @@ namespace parsers
 
 		bool put_bits(const char* name, size_t num_of_bits, size_t data_size) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 			if (num_of_bits == 0)
@@ -1050,6 +1214,9 @@ namespace parsers
 			
 		bool put_string(const char* name,size_t max_size, const char* default_string) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 
@@ -1069,6 +1236,9 @@ namespace parsers
 
         bool nest_metadata(const char *name, binary_metadata_interface* nested_metadata) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 
@@ -1112,6 +1282,9 @@ namespace parsers
 		/// @return	A reference to a binary_metadata_impl.
 		bool array(const char *name, size_t size, type_enum type, size_t num_of_elements,simple_options_data options, binary_metadata_interface *nested_parser) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 			utils::ref_count_ptr<binary_node> node;
@@ -1146,6 +1319,9 @@ namespace parsers
 		//array of strings - need to be exported to the interface
 		bool array(const char *name, size_t size, type_enum type, size_t num_of_elements, const char* default_string) 
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 			utils::ref_count_ptr<binary_node> node;
@@ -1188,6 +1364,9 @@ namespace parsers
 		
 		bool array(const char *name, size_t num_of_elements,size_t size, simple_options_data options, enum_data_interface* enum_type) override
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_freeze_lock);
+			if (m_frozen.load(std::memory_order_acquire))
+				return false;
 			if (name == nullptr)
 				return false;
 			
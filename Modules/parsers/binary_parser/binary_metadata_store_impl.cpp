@@ -1,6 +1,8 @@
 #include <utils/thread_safe_object.hpp>
 #include <unordered_map>
+#include <algorithm>
 #include "binary_metadata_store_impl.h"
+#include "binary_metadata_cache.h"
 #include <parsers/binary_parser.h>
 /// get or create the binary store as a make it singletone
 /// @date	31/12/2018
@@ -61,6 +63,11 @@ bool parsers::binary_metadata_store::create(core::parsers::binary_metadata_store
 	return true;
 }
 
+bool parsers::binary_metadata_store::hash_files(const char* const* file_names, size_t count, uint64_t& hash)
+{
+	return parsers::binary_metadata_cache::hash_files(file_names, count, hash);
+}
+
 parsers::binary_metadata_store_impl::binary_metadata_store_impl()
 {
 
@@ -131,6 +138,32 @@ bool parsers::binary_metadata_store_impl::query_enum(const char* name, core::par
 	});
 }
 
+bool parsers::binary_metadata_store_impl::save_cache(const char* file_name, uint64_t source_hash)
+{
+	binary_metadata_cache::named_metadata metadata = m_parser_metadata.use<binary_metadata_cache::named_metadata>([&](const metadata_parser_map& parser_data)
+	{
+		return binary_metadata_cache::named_metadata(parser_data.begin(), parser_data.end());
+	});
+
+	binary_metadata_cache::named_enums enums = m_enums_metadata.use<binary_metadata_cache::named_enums>([&](const metadata_enum_map& enum_data)
+	{
+		return binary_metadata_cache::named_enums(enum_data.begin(), enum_data.end());
+	});
 
+	// Sorted, the same store is always saved into the same file
+	std::sort(metadata.begin(), metadata.end(), [](const binary_metadata_cache::named_metadata::value_type& a, const binary_metadata_cache::named_metadata::value_type& b)
+	{
+		return a.first < b.first;
+	});
+	std::sort(enums.begin(), enums.end(), [](const binary_metadata_cache::named_enums::value_type& a, const binary_metadata_cache::named_enums::value_type& b)
+	{
+		return a.first < b.first;
+	});
 
+	return binary_metadata_cache::save(file_name, source_hash, metadata, enums);
+}
 
+bool parsers::binary_metadata_store_impl::load_cache(const char* file_name, uint64_t source_hash)
+{
+	return binary_metadata_cache::load(file_name, source_hash, this);
+}
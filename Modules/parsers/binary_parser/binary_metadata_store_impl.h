@@ -25,5 +25,7 @@ namespace parsers
 		bool query_parser_metadata(const char* name, core::parsers::binary_metadata_interface **parser_metadata) override;
 		bool add_enum(const char* name, core::parsers::enum_data_interface* enum_instance) override;
 		bool query_enum(const char* name, core::parsers::enum_data_interface** enum_instance) override;
+		bool save_cache(const char* file_name, uint64_t source_hash) override;
+		bool load_cache(const char* file_name, uint64_t source_hash) override;
 	};
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <utils/parser.hpp>
 #include <utils/buffer_allocator.hpp>
+#include <utils/endian.hpp>
+#include <utils/binary_accessor.hpp>
 
 #include "../nlohmann/fifo_json.hpp"
 #include "binary_parser_impl.h"
@@ -617,6 +619,414 @@ bool parsers::binary_parser_impl::json(unordered_json& json,core::parsers::json_
 	return no_errors;
 }
 
+bool parsers::binary_parser_impl::enum_val_to_stream(int64_t val, const core::parsers::binary_node_interface* node, json_stream_writer& writer, core::parsers::json_details_level details_level) const
+{
+	utils::ref_count_ptr<core::parsers::enum_data_interface> enum_data;
+	core::parsers::enum_data_item enum_item;
+	bool full = (details_level == core::parsers::json_details_level::JSON_ENUM_FULL);
+	if (false == node->query_enum(&enum_data))
+	{
+		if (full)
+		{
+			writer.begin_object();
+			writer.key("name");
+			writer.string_value(ERROR_EXPRESION);
+			writer.end_object();
+		}
+		else
+			writer.string_value(ERROR_EXPRESION);
+
+		return false;
+	}
+
+	bool found = enum_data->item_by_val(val, enum_item);
+	if (full)
+	{
+		writer.begin_object();
+		writer.key("name");
+		writer.string_value(found ? enum_item.name : ENUM_VALUEOUTOFBOUNDS_EXPRESION);
+		writer.key("val");
+		writer.int_value(found ? enum_item.value : val);
+		writer.end_object();
+	}
+	else if (found && details_level == core::parsers::json_details_level::JSON_ENUM_LABLES)
+		writer.string_value(enum_item.name);
+	else if (found && details_level == core::parsers::json_details_level::JSON_ENUM_VALUES)
+		writer.int_value(enum_item.value);
+	else
+	{
+		writer.string_value(ENUM_VALUEOUTOFBOUNDS_EXPRESION);
+		return false;
+	}
+
+	return found;
+}
+
+bool parsers::binary_parser_impl::enum_node_to_stream(const core::parsers::binary_node_interface* node, size_t offset, json_stream_writer& writer, core::parsers::json_details_level details_level) const
+{
+	int64_t val = 0;
+	bool success = false;
+	switch (node->size())
+	{
+	case sizeof(int8_t):
+	{
+		int8_t internal_val;
+		success = read_from_buffer(&internal_val, sizeof(internal_val), offset, node->big_endian());
+		val = internal_val;
+		break;
+	}
+	case sizeof(int16_t):
+	{
+		int16_t internal_val;
+		success = read_from_buffer(&internal_val, sizeof(internal_val), offset, node->big_endian());
+		val = internal_val;
+		break;
+	}
+	case sizeof(int32_t):
+	{
+		int32_t internal_val;
+		success = read_from_buffer(&internal_val, sizeof(internal_val), offset, node->big_endian());
+		val = internal_val;
+		break;
+	}
+	case sizeof(int64_t):
+		success = read_from_buffer(&val, sizeof(val), offset, node->big_endian());
+		break;
+	default:
+		//larger than a value, no data at all
+		if (node->size() > sizeof(val))
+		{
+			writer.null_value();
+			return false;
+		}
+		break;
+	}
+
+	if (false == success)
+	{
+		if (details_level == core::parsers::json_details_level::JSON_ENUM_FULL)
+		{
+			writer.begin_object();
+			writer.key("name");
+			writer.string_value(ERROR_EXPRESION);
+			writer.end_object();
+		}
+		else
+			writer.string_value(ERROR_EXPRESION);
+
+		return false;
+	}
+
+	return enum_val_to_stream(val, node, writer, details_level);
+}
+
+bool parsers::binary_parser_impl::simple_to_stream(const core::parsers::binary_node_interface* node, size_t offset, json_stream_writer& writer) const
+{
+	uint8_t data[core::parsers::VAL_SIZE] = { 0 };
+	type_enum type = node->type();
+	if (node->size() > sizeof(data))
+	{
+		writer.string_value(ERROR_EXPRESION);
+		return false;
+	}
+
+	read_from_buffer(data, node->size(), offset, node->big_endian());
+	utils::parsers::simple_options options(node->options());
+	if (false == options.is_in_bounds(data, node->size(), type))
+	{
+		writer.string_value(OUTOFBOUND_EXPRESION);
+		return false;
+	}
+
+	switch (type)
+	{
+	case type_enum::INT8:
+	case type_enum::CHAR:
+		writer.int_value(static_cast<int8_t>(data[0]));
+		break;
+	case type_enum::UINT8:
+	case type_enum::BYTE:
+		writer.uint_value(data[0]);
+		break;
+	case type_enum::INT16:
+	case type_enum::SHORT:
+	{
+		int16_t val;
+		std::memcpy(&val, data, sizeof(val));
+		writer.int_value(val);
+		break;
+	}
+	case type_enum::UINT16:
+	case type_enum::USHORT:
+	{
+		uint16_t val;
+		std::memcpy(&val, data, sizeof(val));
+		writer.uint_value(val);
+		break;
+	}
+	case type_enum::BOOL:
+		writer.bool_value(data[0] != 0);
+		break;
+	case type_enum::INT32:
+	{
+		int32_t val;
+		std::memcpy(&val, data, sizeof(val));
+		writer.int_value(val);
+		break;
+	}
+	case type_enum::UINT32:
+	{
+		uint32_t val;
+		std::memcpy(&val, data, sizeof(val));
+		writer.uint_value(val);
+		break;
+	}
+	case type_enum::INT64:
+	{
+		int64_t val;
+		std::memcpy(&val, data, sizeof(val));
+		writer.int_value(val);
+		break;
+	}
+	case type_enum::UINT64:
+	{
+		uint64_t val;
+		std::memcpy(&val, data, sizeof(val));
+		writer.uint_value(val);
+		break;
+	}
+	case type_enum::FLOAT:
+	{
+		float val;
+		std::memcpy(&val, data, sizeof(val));
+		writer.double_value(val);
+		break;
+	}
+	case type_enum::DOUBLE:
+	{
+		double val;
+		std::memcpy(&val, data, sizeof(val));
+		writer.double_value(val);
+		break;
+	}
+	default:
+		writer.null_value();
+		return false;
+	}
+
+	return true;
+}
+
+bool parsers::binary_parser_impl::array_to_stream(const core::parsers::binary_node_interface* node, size_t offset, json_stream_writer& writer, core::parsers::json_details_level details_level) const
+{
+	utils::ref_count_ptr<core::parsers::binary_metadata_interface> internal_metadata;
+	utils::ref_count_ptr<core::parsers::binary_node_interface> child_node;
+	if (false == node->nested(&internal_metadata) ||
+		false == internal_metadata->query_node_by_index(size_t(0), &child_node))
+		throw std::runtime_error("query_node_by_index for array index 0 - does not exist");
+
+	size_t element_size = child_node->size();
+	size_t num_of_elements = node->count();
+	type_enum type = child_node->type();
+	bool no_errors = true;
+	if (type == type_enum::COMPLEX)
+	{
+		utils::ref_count_ptr<core::parsers::binary_metadata_interface> element_metadata;
+		if (false == child_node->nested(&element_metadata))
+			throw std::runtime_error("complex array element without metadata");
+
+		writer.begin_array();
+		for (size_t j = 0; j < num_of_elements; j++)
+		{
+			writer.element();
+			size_t position = writer.length();
+			writer.begin_object();
+			no_errors &= json_to_stream(element_metadata, offset + j * element_size, writer, details_level);
+			if (false == writer.end_object())
+			{
+				writer.rewind(position);
+				writer.null_value();
+			}
+		}
+
+		writer.end_array();
+		return no_errors;
+	}
+
+	utils::ref_count_ptr<core::parsers::enum_data_interface> enum_data;
+	if (type == type_enum::ENUM && false == child_node->query_enum(&enum_data))
+	{
+		writer.string_value(ERROR_EXPRESION);
+		return false;
+	}
+
+	if (type != type_enum::STRING && element_size > sizeof(uint64_t))
+	{
+		writer.string_value(ERROR_EXPRESION);
+		return false;
+	}
+
+	utils::parsers::simple_options options(child_node->options());
+	writer.begin_array();
+	for (size_t j = 0; j < num_of_elements; j++)
+	{
+		size_t element_offset = offset + j * element_size;
+		writer.element();
+		if (type == type_enum::STRING)
+		{
+			char str[BUFF_MAX_SIZE];
+			if (element_size > sizeof(str) ||
+				false == read_from_buffer(str, element_size, element_offset, child_node->big_endian()))
+			{
+				writer.string_value(ERROR_EXPRESION);
+				no_errors = false;
+			}
+			else
+				writer.string_value(str, strnlen(str, element_size));
+
+			continue;
+		}
+
+		uint64_t data = 0;
+		read_from_buffer(&data, element_size, element_offset, child_node->big_endian());
+		if (type == type_enum::ENUM)
+		{
+			no_errors &= enum_val_to_stream(static_cast<int64_t>(data), node, writer, details_level);
+		}
+		else if (false == options.is_in_bounds(reinterpret_cast<uint8_t*>(&data), utils::types::sizeof_type(type), type))
+		{
+			writer.error_value(OUTOFBOUND_EXPRESION, data);
+			no_errors = false;
+		}
+		else if (type == type_enum::DOUBLE)
+		{
+			double val;
+			std::memcpy(&val, &data, sizeof(val));
+			writer.double_value(val);
+		}
+		else if (type == type_enum::FLOAT)
+		{
+			float val;
+			std::memcpy(&val, &data, sizeof(val));
+			writer.double_value(val);
+		}
+		else
+			writer.uint_value(data);
+	}
+
+	writer.end_array();
+	return no_errors;
+}
+
+bool parsers::binary_parser_impl::json_to_stream(const core::parsers::binary_metadata_interface* metadata, size_t offset, json_stream_writer& writer, core::parsers::json_details_level details_level) const
+{
+	bool no_errors = true;
+	size_t count = metadata->node_count();
+	for (size_t i = 0; i < count; i++)
+	{
+		utils::ref_count_ptr<binary_node_interface> node;
+		if (false == metadata->query_node_by_index(i, &node))
+			continue;
+
+		size_t node_offset = offset + node->offset();
+		type_enum type = node->type();
+		if (utils::types::is_simple_type(type))
+		{
+			writer.key(node->name());
+			no_errors &= simple_to_stream(node, node_offset, writer);
+			continue;
+		}
+
+		switch (type)
+		{
+		case type_enum::BITMAP:
+		{
+			uint64_t bits = 0;
+			uint64_t data = 0;
+			if (node->size() > sizeof(bits) ||
+				false == m_buffer->safe_read(&bits, node->size(), node_offset) ||
+				false == node->read(&data, node->size(), &bits, node->size()))
+			{
+				no_errors = false;
+				break;
+			}
+
+			writer.key(node->name());
+			writer.uint_value(data);
+			break;
+		}
+		case type_enum::ENUM:
+			writer.key(node->name());
+			no_errors &= enum_node_to_stream(node, node_offset, writer, details_level);
+			break;
+		case type_enum::STRING:
+		{
+			char str[BUFF_MAX_SIZE];
+			writer.key(node->name());
+			if (node->size() > sizeof(str) ||
+				false == read_from_buffer(str, node->size(), node_offset, node->big_endian()))
+			{
+				writer.string_value(ERROR_EXPRESION);
+				no_errors = false;
+			}
+			else
+				writer.string_value(str, strnlen(str, node->size()));
+
+			break;
+		}
+		case type_enum::BUFFER:
+		{
+			uint8_t data[BUFF_MAX_SIZE];
+			writer.key(node->name());
+			if (node->size() > sizeof(data))
+			{
+				writer.error_value(TOO_BIG_EXPRESION, node->size());
+				no_errors = false;
+			}
+			else if (false == read_from_buffer(data, node->size(), node_offset, node->big_endian()))
+			{
+				writer.string_value(ERROR_EXPRESION);
+				no_errors = false;
+			}
+			else
+				writer.hex_value(data, node->size());
+
+			break;
+		}
+		case type_enum::ARRAY:
+			//an empty array has no value at all
+			if (node->count() == 0)
+				break;
+
+			writer.key(node->name());
+			no_errors &= array_to_stream(node, node_offset, writer, details_level);
+			break;
+		case type_enum::COMPLEX:
+		{
+			utils::ref_count_ptr<core::parsers::binary_metadata_interface> nested;
+			if (false == node->nested(&nested))
+				break;
+
+			writer.key(node->name());
+			size_t position = writer.length();
+			writer.begin_object();
+			no_errors &= json_to_stream(nested, node_offset, writer, details_level);
+			if (false == writer.end_object())
+			{
+				writer.rewind(position);
+				writer.string_value(INTERNAL_OBJ_FAILED_EXPRESION);
+				no_errors = false;
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	return no_errors;
+}
+
 bool parsers::binary_parser_impl::bitmap_from_json(const unordered_json & json, core::parsers::binary_node_interface * node, size_t& index)
 {
 	if (node->type() != type_enum::BITMAP)
@@ -945,6 +1355,404 @@ bool parsers::binary_parser_impl::from_json(const unordered_json& json)
 	return true;
 }
 
+bool parsers::binary_parser_impl::enum_from_stream(json_stream_reader& reader, const core::parsers::binary_node_interface* node, int64_t& val) const
+{
+	utils::ref_count_ptr<core::parsers::enum_data_interface> enum_data;
+	if (false == node->query_enum(&enum_data))
+		return false;
+
+	core::parsers::enum_data_item item;
+	char name[core::parsers::MAX_NAME];
+	size_t length;
+	json_number number;
+	switch (reader.peek())
+	{
+	case json_token::NUMBER:
+		if (false == reader.read_number(number) || number.kind == json_number::FLOAT)
+			return false;
+
+		val = number.get<int64_t>();
+		return enum_data->item_by_val(val, item);
+	case json_token::STRING:
+		if (false == reader.read_string(name, sizeof(name), length) ||
+			false == enum_data->item_by_name(name, item))
+			return false;
+
+		val = item.value;
+		return true;
+	case json_token::OBJECT:
+	{
+		//enum was stored as an object of name and value, the value is preferred
+		bool has_val = false;
+		bool has_name = false;
+		bool end = false;
+		if (false == reader.begin_object())
+			return false;
+
+		for (bool first = true; ; first = false)
+		{
+			char key[8];
+			size_t key_length;
+			if (false == reader.next_key(first, key, sizeof(key), key_length, end))
+				return false;
+			if (end)
+				break;
+
+			if (key_length == 3 && std::strcmp(key, "val") == 0)
+			{
+				if (reader.peek() != json_token::NUMBER || false == reader.read_number(number))
+					return false;
+
+				has_val = true;
+			}
+			else if (key_length == 4 && std::strcmp(key, "name") == 0)
+			{
+				if (false == reader.read_string(name, sizeof(name), length))
+					return false;
+
+				has_name = true;
+			}
+			else if (false == reader.skip_value())
+				return false;
+		}
+
+		val = 0;
+		if (has_val)
+		{
+			val = number.get<int64_t>();
+			return enum_data->item_by_val(val, item);
+		}
+
+		if (has_name)
+		{
+			if (false == enum_data->item_by_name(name, item))
+				return false;
+
+			val = item.value;
+		}
+
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+bool parsers::binary_parser_impl::array_from_stream(json_stream_reader& reader, const json_key_tables& keys, const json_key_tables::field& field, size_t offset)
+{
+	//no support for array of arrays
+	if (false == reader.begin_array())
+		return false;
+
+	const core::parsers::binary_node_interface* node = field.node;
+	const core::parsers::binary_node_interface* element = field.element;
+	size_t element_size = element->size();
+	type_enum type = element->type();
+	utils::parsers::simple_options options(node->options());
+	bool end = false;
+	for (size_t j = 0; ; j++)
+	{
+		if (false == reader.next_element(j == 0, end))
+			return false;
+		if (end)
+			return true;
+		if (j >= node->count())
+			return false;
+
+		size_t element_offset = offset + j * element_size;
+		if (type == type_enum::COMPLEX)
+		{
+			if (reader.peek() != json_token::OBJECT ||
+				false == object_from_stream(reader, keys, field.nested, element_offset))
+				return false;
+
+			continue;
+		}
+
+		if (type == type_enum::ENUM)
+		{
+			int64_t val = 0;
+			if (element_size > sizeof(val) ||
+				false == enum_from_stream(reader, element, val))
+				return false;
+
+			m_buffer->safe_write(&val, element_size, element_offset);
+			continue;
+		}
+
+		json_number number;
+		bool boolean = false;
+		json_token token = reader.peek();
+		if (token == json_token::BOOLEAN)
+		{
+			if (false == reader.read_bool(boolean))
+				return false;
+
+			number.unsigned_value = boolean ? 1 : 0;
+		}
+		else if (token != json_token::NUMBER || false == reader.read_number(number))
+			return false;
+
+		if (type == type_enum::DOUBLE)
+		{
+			double data = number.get<double>();
+			if (false == options.is_in_bounds(data))
+				return false;
+
+			m_buffer->safe_write(&data, (std::min)(element_size, sizeof(data)), element_offset);
+		}
+		else if (type == type_enum::FLOAT)
+		{
+			float data = number.get<float>();
+			if (false == options.is_in_bounds(data))
+				return false;
+
+			m_buffer->safe_write(&data, (std::min)(element_size, sizeof(data)), element_offset);
+		}
+		else
+		{
+			uint64_t data = number.get<uint64_t>();
+			m_buffer->safe_write(&data, (std::min)(element_size, sizeof(data)), element_offset);
+		}
+	}
+}
+
+template <typename T>
+static bool simple_from_stream(json_stream_reader& reader, core::safe_buffer_interface* buffer, size_t size, size_t offset)
+{
+	T data;
+	json_number number;
+	bool boolean;
+	switch (reader.peek())
+	{
+	case json_token::NUMBER:
+		if (false == reader.read_number(number))
+			return false;
+
+		data = number.get<T>();
+		break;
+	case json_token::BOOLEAN:
+		if (false == reader.read_bool(boolean))
+			return false;
+
+		data = static_cast<T>(boolean);
+		break;
+	default:
+		//not a value of a simple type - ignore the field
+		return reader.skip_value();
+	}
+
+	if (sizeof(T) > size)
+		return false;
+
+	return buffer->safe_write(&data, sizeof(T), offset);
+}
+
+// The strings are decoded in functions of their own to keep the large buffers off the frames of the nested objects recursion
+static bool string_from_stream(json_stream_reader& reader, core::safe_buffer_interface* buffer, size_t size, size_t offset)
+{
+	//write the string include the zero at the end
+	char str[BUFF_MAX_SIZE];
+	size_t length;
+	if (reader.peek() != json_token::STRING ||
+		false == reader.read_string(str, sizeof(str), length))
+		return false;
+
+	size_t string_size = std::strlen(str) + 1;
+	if (string_size > size)
+		return false;
+
+	return buffer->safe_write(str, string_size, offset);
+}
+
+static bool buffer_from_stream(json_stream_reader& reader, core::safe_buffer_interface* buffer, size_t size, size_t offset)
+{
+	char hex_str[BUFF_MAX_SIZE * 2 + 1];
+	uint8_t data[BUFF_MAX_SIZE];
+	size_t length;
+	size_t data_size = 0;
+	if (reader.peek() != json_token::STRING ||
+		false == reader.read_string(hex_str, sizeof(hex_str), length))
+		return false;
+
+	//an invalid hex string is ignored
+	if (size > sizeof(data) ||
+		false == hex_string2buf(hex_str, data, size, data_size))
+		return true;
+
+	return buffer->safe_write(data, data_size, offset);
+}
+
+bool parsers::binary_parser_impl::field_from_stream(json_stream_reader& reader, const json_key_tables& keys, const json_key_tables::field& field, size_t offset)
+{
+	const core::parsers::binary_node_interface* node = field.node;
+	switch (node->type())
+	{
+	case type_enum::INT8:
+	case type_enum::CHAR:
+		return simple_from_stream<int8_t>(reader, m_buffer, node->size(), offset);
+	case type_enum::UINT8:
+	case type_enum::BYTE:
+		return simple_from_stream<uint8_t>(reader, m_buffer, node->size(), offset);
+	case type_enum::INT16:
+	case type_enum::SHORT:
+		return simple_from_stream<int16_t>(reader, m_buffer, node->size(), offset);
+	case type_enum::UINT16:
+	case type_enum::USHORT:
+		return simple_from_stream<uint16_t>(reader, m_buffer, node->size(), offset);
+	case type_enum::BOOL:
+		return simple_from_stream<bool>(reader, m_buffer, node->size(), offset);
+	case type_enum::INT32:
+		return simple_from_stream<int32_t>(reader, m_buffer, node->size(), offset);
+	case type_enum::UINT32:
+		return simple_from_stream<uint32_t>(reader, m_buffer, node->size(), offset);
+	case type_enum::INT64:
+		return simple_from_stream<int64_t>(reader, m_buffer, node->size(), offset);
+	case type_enum::UINT64:
+		return simple_from_stream<uint64_t>(reader, m_buffer, node->size(), offset);
+	case type_enum::FLOAT:
+		return simple_from_stream<float>(reader, m_buffer, node->size(), offset);
+	case type_enum::DOUBLE:
+		return simple_from_stream<double>(reader, m_buffer, node->size(), offset);
+	case type_enum::ENUM:
+	{
+		int64_t val = 0;
+		if (node->size() > sizeof(val) ||
+			false == enum_from_stream(reader, node, val))
+			return false;
+
+		return m_buffer->safe_write(&val, node->size(), offset);
+	}
+	case type_enum::BITMAP:
+	{
+		json_number number;
+		bool boolean;
+		uint64_t data = 0;
+		json_token token = reader.peek();
+		if (token == json_token::NUMBER)
+		{
+			if (false == reader.read_number(number))
+				return false;
+
+			data = number.get<uint64_t>();
+		}
+		else if (token == json_token::BOOLEAN)
+		{
+			if (false == reader.read_bool(boolean))
+				return false;
+
+			data = boolean ? 1 : 0;
+		}
+		else
+			return reader.skip_value();
+
+		uint64_t bits = 0;
+		if (node->size() <= sizeof(bits) &&
+			m_buffer->safe_read(&bits, node->size(), offset) &&
+			node->write(&data, sizeof(data), &bits, node->size()))
+			m_buffer->safe_write(&bits, node->size(), offset);
+
+		return true;
+	}
+	case type_enum::STRING:
+		return string_from_stream(reader, m_buffer, node->size(), offset);
+	case type_enum::BUFFER:
+		return buffer_from_stream(reader, m_buffer, node->size(), offset);
+	case type_enum::ARRAY:
+		if (reader.peek() != json_token::ARRAY)
+			return false;
+
+		return array_from_stream(reader, keys, field, offset);
+	case type_enum::COMPLEX:
+		if (reader.peek() != json_token::OBJECT)
+			return false;
+
+		return object_from_stream(reader, keys, field.nested, offset);
+	default: //unsupported type
+		return false;
+	}
+}
+
+bool parsers::binary_parser_impl::validate_at(const core::parsers::binary_node_interface* node, size_t offset) const
+{
+	type_enum type = node->type();
+	if (utils::types::is_simple_type(type))
+	{
+		uint8_t data[core::parsers::VAL_SIZE] = { 0 };
+		if (node->size() > sizeof(data))
+			return false;
+
+		read_from_buffer(data, node->size(), offset, node->big_endian());
+		utils::parsers::simple_options options(node->options());
+		return options.is_in_bounds(data, node->size(), type);
+	}
+
+	if (type == type_enum::ENUM)
+	{
+		int64_t enum_val = 0;
+		if (node->size() > sizeof(enum_val))
+			return false;
+
+		read_from_buffer(&enum_val, node->size(), offset, node->big_endian());
+		enum_val = reinterpret_enum(node->size(), enum_val);
+		utils::ref_count_ptr<enum_data_interface> enum_data;
+		enum_data_item item;
+		return (node->query_enum(&enum_data) && enum_data->item_by_val(enum_val, item));
+	}
+
+	switch (type)
+	{
+	case type_enum::BITMAP:
+	case type_enum::STRING:
+	case type_enum::BUFFER:
+	case type_enum::ARRAY:
+	case type_enum::COMPLEX:
+		return true;
+	default: //unsupported type
+		return false;
+	}
+}
+
+bool parsers::binary_parser_impl::object_from_stream(json_stream_reader& reader, const json_key_tables& keys, size_t table, size_t offset)
+{
+	const json_key_tables::table& fields = keys.at(table);
+	if (false == reader.begin_object())
+		return false;
+
+	bool end = false;
+	for (bool first = true; ; first = false)
+	{
+		char key[core::parsers::MAX_NAME];
+		size_t key_length;
+		if (false == reader.next_key(first, key, sizeof(key), key_length, end))
+			return false;
+		if (end)
+			break;
+
+		//field does not exist - ignore the field
+		const json_key_tables::field* field = fields.find(key, key_length);
+		if (field == nullptr)
+		{
+			if (false == reader.skip_value())
+				return false;
+
+			continue;
+		}
+
+		if (false == field_from_stream(reader, keys, *field, offset + field->node->offset()))
+			return false;
+	}
+
+	//Check if the values are in range, including the fields which were not in the JSON
+	for (const json_key_tables::field& field : fields.fields)
+	{
+		if (false == validate_at(field.node, offset + field.node->offset()))
+			return false;
+	}
+
+	return true;
+}
+
 /// Queries a the parser metadata
 /// @date	20/11/2018
 /// @param [in,out]	parser_metadata	If non-null, the parser metadata.
@@ -1076,12 +1884,67 @@ const char* parsers::binary_parser_impl::check_and_get_json(core::parsers::json_
 	return m_json_str.c_str();
 }
 
+bool parsers::binary_parser_impl::write_json(char* json, size_t json_size, core::parsers::json_details_level details_level, bool compact, size_t& length, bool& no_errors) const
+{
+	json_stream_writer writer(json, json_size, compact);
+	writer.begin_object();
+	no_errors = json_to_stream(m_metadata, m_offset, writer, details_level);
+	if (false == writer.end_object())
+	{
+		//same as an empty document
+		writer.rewind(0);
+		writer.null_value();
+	}
+
+	length = writer.length();
+	return writer.finish();
+}
+
 bool parsers::binary_parser_impl::from_json(const char *json)
 {
 	unordered_json temp_json;
 	temp_json = unordered_json::parse(json);
 	return from_json(temp_json);
 }
+bool parsers::binary_parser_impl::from_json(const char* json, size_t json_size)
+{
+	if (json == nullptr)
+		return false;
+
+	json_stream_reader reader(json, json_size);
+	if (reader.peek() == json_token::ARRAY)
+	{
+		//values by the fields order are rare enough to go through the JSON document
+		return from_json(unordered_json::parse(json, json + strnlen(json, json_size)));
+	}
+
+	if (reader.peek() != json_token::OBJECT)
+		return false;
+
+	//the tables of a frozen metadata are built once by freeze(), a metadata which may still change gets its own
+	const frozen_metadata_tables* tables =
+		dynamic_cast<const frozen_metadata_tables*>(static_cast<const core::parsers::binary_metadata_interface*>(m_metadata));
+	const json_key_tables* keys = (tables != nullptr) ? tables->frozen_json_keys() : nullptr;
+	std::unique_ptr<json_key_tables> local_keys;
+	if (keys == nullptr)
+	{
+		try
+		{
+			local_keys.reset(new json_key_tables(m_metadata));
+		}
+		catch (...)
+		{
+			return false;
+		}
+
+		keys = local_keys.get();
+	}
+
+	if (false == object_from_stream(reader, *keys, 0, m_offset))
+		return false;
+
+	return reader.at_end();
+}
 /// Reads a simple data (primitive) from the buffer
 /// @date	03/10/2018
 /// @param 		   	index				   	Zero-based index of the.
@@ -1266,6 +2129,36 @@ bool parsers::binary_parser_impl::read_by_node(void* data, size_t number_of_byte
 	return read_from_buffer(data, number_of_bytes_to_read, offset,node->big_endian());
 }
 
+bool parsers::binary_parser_impl::read_compiled(const core::parsers::binary_accessor& accessor, void* data, size_t number_of_bytes_to_read) const
+{
+	if (data == nullptr)
+		return false;
+
+	if (number_of_bytes_to_read > accessor.size)
+		return false;
+
+	if (accessor.type == type_enum::BITMAP)
+	{
+		uint64_t bit_node_data = 0;
+		if (accessor.size > sizeof(bit_node_data) ||
+			false == m_buffer->safe_read(&bit_node_data, accessor.size, m_offset + accessor.offset))
+			return false;
+
+		//the bits block was read on its own, so it is at the start of the local copy
+		core::parsers::binary_accessor bits_accessor = accessor;
+		bits_accessor.offset = 0;
+		return utils::parsers::read_accessor(bits_accessor, &bit_node_data, sizeof(bit_node_data), data, number_of_bytes_to_read);
+	}
+
+	if (false == m_buffer->safe_read(data, number_of_bytes_to_read, m_offset + accessor.offset))
+		return false;
+
+	if (accessor.swap)
+		utils::types::endian_swap_words(data, number_of_bytes_to_read);
+
+	return true;
+}
+
 bool parsers::binary_parser_impl::read_from_buffer(void* data, size_t number_of_bytes_to_read,size_t offset,bool big_endian) const
 {
 	if (m_buffer->safe_read(data, number_of_bytes_to_read, offset))
@@ -1273,21 +2166,7 @@ bool parsers::binary_parser_impl::read_from_buffer(void* data, size_t number_of_
 		if (big_endian != utils::types::is_big_endian())
 		{
 			//if data stream is mismatched to the platform endian convert
-			size_t convert_data_size;
-			uint8_t* data_change = (uint8_t*)data;
-			if (number_of_bytes_to_read % 2 != 0)
-			{
-				convert_data_size = number_of_bytes_to_read - 1;
-			}
-			else
-			{
-				convert_data_size = number_of_bytes_to_read;
-			}
-
-			for (size_t i = 0; i < convert_data_size; i += 2)
-			{
-				endian_swap(*((uint16_t*)&data_change[i]));
-			}
+			endian_swap_words(data, number_of_bytes_to_read);
 		}
 
 		return true;
@@ -1738,6 +2617,23 @@ bool parsers::binary_parser_impl::write_at(size_t index, const void* data, size_
 /// @return	True if it succeeds, false if it fails.
 bool parsers::binary_parser_impl::validate() const 
 {
+	const utils::parsers::validation_table* table = query_validation_table();
+	if (table != nullptr)
+	{
+		//check a copy of the message in one pass over the table
+		uint8_t local[BUFF_MAX_SIZE];
+		std::vector<uint8_t> heap;
+		uint8_t* message = local;
+		if (table->size() > sizeof(local))
+		{
+			heap.resize(table->size());
+			message = heap.data();
+		}
+
+		return m_buffer->safe_read(message, table->size(), m_offset) &&
+			table->validate(message, table->size());
+	}
+
 	for (size_t i = 0; i < m_metadata->node_count(); i++)
 	{
 		utils::ref_count_ptr<core::parsers::binary_node_interface> node;
@@ -1750,6 +2646,16 @@ bool parsers::binary_parser_impl::validate() const
 	return true;
 }
 
+const utils::parsers::validation_table* parsers::binary_parser_impl::query_validation_table() const
+{
+	//a table of a metadata which may still change would go stale
+	const frozen_metadata_tables* tables = dynamic_cast<const frozen_metadata_tables*>(static_cast<const core::parsers::binary_metadata_interface*>(m_metadata));
+	if (tables == nullptr)
+		return nullptr;
+
+	return tables->frozen_validation();
+}
+
 /// Validates the data of the field of the given name
 /// @date	19/08/2019
 /// @param	name	The name.
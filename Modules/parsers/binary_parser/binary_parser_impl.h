@@ -2,7 +2,15 @@
 #include <parsers/binary_parser.h>
 #include <utils/thread_safe_object.hpp>
 #include <utils/types.hpp>
+#include <utils/binary_validation.hpp>
 #include <unordered_map>
+#include <memory>
+#include <mutex>
+
+#include "json_stream_writer.h"
+#include "json_stream_reader.h"
+#include "json_key_tables.h"
+#include "frozen_metadata_tables.h"
 
 namespace parsers
 {
@@ -21,6 +29,10 @@ namespace parsers
 		utils::thread_safe_object<parser_map> m_parsers;
 
 		bool parse_nested();
+		/// Gets the validation table the metadata built when it was frozen
+		/// @date	19/10/2026
+		/// @return	Null if the metadata is not frozen or has no table.
+		const utils::parsers::validation_table* query_validation_table() const;
 		bool is_big_endian() const;
 		bool build_nested_parser(core::parsers::binary_node_interface* node);
 		/// Writes data to the buffer.
@@ -43,6 +55,18 @@ namespace parsers
 		bool enum_val_from_json(const unordered_json& enum_json, const core::parsers::binary_node_interface* node, int64_t& val);
 		bool array_to_json(const core::parsers::binary_node_interface* node, unordered_json& json, size_t index, core::parsers::json_details_level details_level) const;
 		bool json(unordered_json& json, core::parsers::json_details_level details_level) const;
+		bool enum_val_to_stream(int64_t val, const core::parsers::binary_node_interface* node, json_stream_writer& writer, core::parsers::json_details_level details_level) const;
+		bool enum_node_to_stream(const core::parsers::binary_node_interface* node, size_t offset, json_stream_writer& writer, core::parsers::json_details_level details_level) const;
+		bool simple_to_stream(const core::parsers::binary_node_interface* node, size_t offset, json_stream_writer& writer) const;
+		bool array_to_stream(const core::parsers::binary_node_interface* node, size_t offset, json_stream_writer& writer, core::parsers::json_details_level details_level) const;
+		/// Streams the fields of a metadata as the members of the current JSON object
+		/// @date	19/10/2026
+		/// @param 		   	metadata	 	The metadata of the object.
+		/// @param 		   	offset		 	The offset of the object in the buffer.
+		/// @param [in,out]	writer		 	The writer.
+		/// @param 		   	details_level	The enums details level.
+		/// @return	True if no field is erroneous.
+		bool json_to_stream(const core::parsers::binary_metadata_interface* metadata, size_t offset, json_stream_writer& writer, core::parsers::json_details_level details_level) const;
 		void write_simple_default(const core::parsers::binary_node_interface* node);
 		void write_string_default(const core::parsers::binary_node_interface* node);
 		template <typename T>
@@ -84,6 +108,18 @@ namespace parsers
 		bool bitmap_from_json(const unordered_json& json, core::parsers::binary_node_interface* node, size_t& index);
 		bool array_from_json(const unordered_json& json, size_t i, utils::ref_count_ptr<core::parsers::binary_node_interface>& node);
 		bool from_json(const unordered_json& json);
+		bool enum_from_stream(json_stream_reader& reader, const core::parsers::binary_node_interface* node, int64_t& val) const;
+		bool array_from_stream(json_stream_reader& reader, const json_key_tables& keys, const json_key_tables::field& field, size_t offset);
+		bool field_from_stream(json_stream_reader& reader, const json_key_tables& keys, const json_key_tables::field& field, size_t offset);
+		bool validate_at(const core::parsers::binary_node_interface* node, size_t offset) const;
+		/// Reads a JSON object into the buffer, the members are matched to the fields by the key tables
+		/// @date	19/10/2026
+		/// @param [in,out]	reader	The reader, at the start of the object.
+		/// @param 		   	keys  	The key tables of the parsed metadata.
+		/// @param 		   	table 	The key table of the object's metadata.
+		/// @param 		   	offset	The offset of the object in the buffer.
+		/// @return	True if it succeeds, false if it fails.
+		bool object_from_stream(json_stream_reader& reader, const json_key_tables& keys, size_t table, size_t offset);
 
 		bool read_enum_by_node(int64_t& val, size_t size, const core::parsers::binary_node_interface* node, core::types::type_enum& type) const;
 	public:
@@ -135,8 +171,12 @@ namespace parsers
 
 		const char* check_and_get_json(core::parsers::json_details_level details_level, bool compact, bool& no_errors) override;
 
+		bool write_json(char* json, size_t json_size, core::parsers::json_details_level details_level, bool compact, size_t& length, bool& no_errors) const override;
+
 		bool from_json(const char *json) override;
 
+		bool from_json(const char* json, size_t json_size) override;
+
 		bool read_simple(size_t index, void* data, size_t number_of_bytes_to_read, core::types::type_enum& type) const override;
 
 		bool read_simple(const char* name, void* data, size_t number_of_bytes_to_read, core::types::type_enum& type) const override;
@@ -190,6 +230,15 @@ namespace parsers
 		bool read_from_buffer(void* data, size_t number_of_bytes_to_read, size_t offset, bool big_endian) const;
 
 		bool read_bits_by_node(void* data, size_t number_of_bytes_to_read, const core::parsers::binary_node_interface *node) const;
+
+		/// Reads a field through an accessor compiled by this parser's metadata - a single buffer read without lookup
+		/// @date	19/10/2026
+		/// @param 		   	accessor			   	The compiled accessor.
+		/// @param [out]	data				   	If non-null, the data read from the buffer.
+		/// @param 		   	number_of_bytes_to_read	Number of bytes to reads (size of the object).
+		/// @return	True if it succeeds, false if it fails.
+		bool read_compiled(const core::parsers::binary_accessor& accessor, void* data, size_t number_of_bytes_to_read) const override;
+
 		/// Reads a string from the parser
 		/// @date	10/10/2018
 		/// @exception	std::runtime_error	Raised when a runtime error condition
@@ -0,0 +1,26 @@
+#pragma once
+#include <utils/binary_validation.hpp>
+#include "json_key_tables.h"
+
+namespace parsers
+{
+	/// The tables a frozen metadata builds once when it is frozen, shared by every parser of the metadata.
+	/// Implemented by the metadata of this module, a parser reaches them by a dynamic_cast of its metadata.
+	/// @date	19/10/2026
+	class frozen_metadata_tables
+	{
+	public:
+		virtual ~frozen_metadata_tables() = default;
+
+		/// Gets the validation table of the metadata
+		/// @date	19/10/2026
+		/// @return	Null if the metadata is not frozen or the table could not be built (a field it can not check),
+		/// 		the parser then validates by walking the nodes.
+		virtual const utils::parsers::validation_table* frozen_validation() const = 0;
+
+		/// Gets the key tables from_json matches the members of a JSON object with
+		/// @date	19/10/2026
+		/// @return	Null if the metadata is not frozen or the tables could not be built.
+		virtual const json_key_tables* frozen_json_keys() const = 0;
+	};
+}
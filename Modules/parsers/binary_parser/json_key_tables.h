@@ -0,0 +1,171 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/ref_count_ptr.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace parsers
+{
+	/// Perfect hash tables of the field names of a metadata and of its nested metadata, built once so JSON keys
+	/// are matched to their nodes by a single hash and compare.
+	/// @date	19/10/2026
+	class json_key_tables
+	{
+	public:
+		struct field
+		{
+			utils::ref_count_ptr<core::parsers::binary_node_interface> node;
+			// The element of an array
+			utils::ref_count_ptr<core::parsers::binary_node_interface> element;
+			// The table of a complex node or of the elements of a complex array
+			size_t nested;
+			size_t name_length;
+		};
+
+		struct table
+		{
+			std::vector<field> fields;
+			// field index + 1, 0 for an empty slot
+			std::vector<uint32_t> slots;
+			uint64_t seed;
+			size_t mask;
+
+			/// Finds the field of a key
+			/// @return	Null if there is no such field.
+			const field* find(const char* key, size_t length) const
+			{
+				if (slots.empty())
+					return nullptr;
+
+				uint32_t slot = slots[static_cast<size_t>(hash(key, length, seed)) & mask];
+				if (slot == 0)
+					return nullptr;
+
+				const field& candidate = fields[slot - 1];
+				if (candidate.name_length != length || std::memcmp(candidate.node->name(), key, length) != 0)
+					return nullptr;
+
+				return &candidate;
+			}
+		};
+
+	private:
+		static constexpr uint32_t SEEDS_PER_SIZE = 64;
+
+		std::vector<table> m_tables;
+
+		static uint64_t hash(const char* key, size_t length, uint64_t seed)
+		{
+			uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+			for (size_t i = 0; i < length; i++)
+			{
+				h ^= static_cast<uint8_t>(key[i]);
+				h *= 0x100000001b3ULL;
+			}
+
+			return h ^ (h >> 29);
+		}
+
+		static void build_slots(table& current)
+		{
+			if (current.fields.empty())
+				return;
+
+			size_t size = 2;
+			while (size < current.fields.size() * 2)
+				size <<= 1;
+
+			// The first seed which maps every distinct name to its own slot, duplicated names keep the first field
+			for (;; size <<= 1)
+			{
+				for (uint64_t seed = 0; seed < SEEDS_PER_SIZE; seed++)
+				{
+					current.slots.assign(size, 0);
+					current.mask = size - 1;
+					current.seed = seed;
+					bool perfect = true;
+					for (size_t i = 0; i < current.fields.size() && perfect; i++)
+					{
+						const field& entry = current.fields[i];
+						uint32_t& slot = current.slots[static_cast<size_t>(hash(entry.node->name(), entry.name_length, seed)) & current.mask];
+						if (slot == 0)
+							slot = static_cast<uint32_t>(i + 1);
+						else if (current.find(entry.node->name(), entry.name_length) == nullptr)
+							perfect = false;
+					}
+
+					if (perfect)
+						return;
+				}
+			}
+		}
+
+		size_t build(const core::parsers::binary_metadata_interface* metadata)
+		{
+			size_t index = m_tables.size();
+			m_tables.emplace_back();
+
+			std::vector<field> fields;
+			size_t count = metadata->node_count();
+			for (size_t i = 0; i < count; i++)
+			{
+				field entry;
+				entry.nested = 0;
+				if (false == metadata->query_node_by_index(i, &entry.node))
+					throw std::runtime_error("json_key_tables: failed to query node");
+
+				entry.name_length = std::strlen(entry.node->name());
+				utils::ref_count_ptr<core::parsers::binary_metadata_interface> nested;
+				if (entry.node->type() == core::types::type_enum::COMPLEX)
+				{
+					if (false == entry.node->nested(&nested))
+						throw std::runtime_error("json_key_tables: complex node without metadata");
+
+					entry.nested = build(nested);
+				}
+				else if (entry.node->type() == core::types::type_enum::ARRAY)
+				{
+					if (false == entry.node->nested(&nested) ||
+						false == nested->query_node_by_index(0, &entry.element))
+						throw std::runtime_error("json_key_tables: array node without metadata");
+
+					utils::ref_count_ptr<core::parsers::binary_metadata_interface> element_metadata;
+					if (entry.element->type() == core::types::type_enum::COMPLEX)
+					{
+						if (false == entry.element->nested(&element_metadata))
+							throw std::runtime_error("json_key_tables: complex node without metadata");
+
+						entry.nested = build(element_metadata);
+					}
+				}
+
+				fields.push_back(entry);
+			}
+
+			// The nested tables were added in the meantime
+			table& current = m_tables[index];
+			current.fields = std::move(fields);
+			current.seed = 0;
+			current.mask = 0;
+			build_slots(current);
+			return index;
+		}
+
+	public:
+		/// Constructor - builds the tables of the metadata, the table of the metadata itself is the first
+		/// @date	19/10/2026
+		/// @exception	std::runtime_error	Thrown when the metadata is inconsistent.
+		/// @param	metadata	The metadata.
+		explicit json_key_tables(const core::parsers::binary_metadata_interface* metadata)
+		{
+			build(metadata);
+		}
+
+		const table& at(size_t index) const
+		{
+			return m_tables[index];
+		}
+	};
+}
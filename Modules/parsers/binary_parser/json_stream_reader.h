@@ -0,0 +1,506 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace parsers
+{
+	enum class json_token
+	{
+		OBJECT,
+		ARRAY,
+		STRING,
+		NUMBER,
+		BOOLEAN,
+		NULL_VALUE,
+		INVALID
+	};
+
+	/// A JSON number as the nlohmann lexer stores it - unsigned, negative integer or floating point
+	struct json_number
+	{
+		enum number_kind
+		{
+			UNSIGNED,
+			INTEGER,
+			FLOAT
+		};
+
+		number_kind kind = UNSIGNED;
+		uint64_t unsigned_value = 0;
+		int64_t integer_value = 0;
+		double float_value = 0;
+
+		template <typename T>
+		T get() const
+		{
+			switch (kind)
+			{
+			case INTEGER:
+				return static_cast<T>(integer_value);
+			case FLOAT:
+				return static_cast<T>(float_value);
+			default:
+				return static_cast<T>(unsigned_value);
+			}
+		}
+	};
+
+	/// Pulls the tokens of a JSON text one at a time, in place and without allocating.
+	/// Keys and strings are decoded into caller supplied buffers, values which are not needed are skipped.
+	/// Every method returns false on a syntax error, the position is then undefined.
+	/// @date	19/10/2026
+	class json_stream_reader
+	{
+	private:
+		static constexpr size_t MAX_SKIP_DEPTH = 256;
+
+		const char* m_position;
+		const char* m_end;
+
+		void skip_whitespace()
+		{
+			while (m_position < m_end &&
+				(*m_position == ' ' || *m_position == '\t' || *m_position == '\n' || *m_position == '\r'))
+				m_position++;
+		}
+
+		bool consume(char c)
+		{
+			skip_whitespace();
+			if (m_position == m_end || *m_position != c)
+				return false;
+
+			m_position++;
+			return true;
+		}
+
+		bool literal(const char* text, size_t length)
+		{
+			if (static_cast<size_t>(m_end - m_position) < length || std::memcmp(m_position, text, length) != 0)
+				return false;
+
+			m_position += length;
+			return true;
+		}
+
+		static int hex_digit(char c)
+		{
+			if (c >= '0' && c <= '9')
+				return c - '0';
+			if (c >= 'a' && c <= 'f')
+				return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F')
+				return c - 'A' + 10;
+
+			return -1;
+		}
+
+		bool read_hex4(uint32_t& code_unit)
+		{
+			if (m_end - m_position < 4)
+				return false;
+
+			code_unit = 0;
+			for (int i = 0; i < 4; i++)
+			{
+				int digit = hex_digit(*m_position++);
+				if (digit < 0)
+					return false;
+
+				code_unit = (code_unit << 4) | static_cast<uint32_t>(digit);
+			}
+
+			return true;
+		}
+
+		static size_t encode_utf8(uint32_t code_point, char* out)
+		{
+			if (code_point < 0x80)
+			{
+				out[0] = static_cast<char>(code_point);
+				return 1;
+			}
+			if (code_point < 0x800)
+			{
+				out[0] = static_cast<char>(0xC0 | (code_point >> 6));
+				out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+				return 2;
+			}
+			if (code_point < 0x10000)
+			{
+				out[0] = static_cast<char>(0xE0 | (code_point >> 12));
+				out[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+				out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+				return 3;
+			}
+
+			out[0] = static_cast<char>(0xF0 | (code_point >> 18));
+			out[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+			out[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+			out[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+			return 4;
+		}
+
+		// Decodes a string token, when str is null the string is only validated and skipped
+		bool string(char* str, size_t size, size_t& length, bool& truncated)
+		{
+			length = 0;
+			truncated = false;
+			if (false == consume('"'))
+				return false;
+
+			while (m_position < m_end)
+			{
+				char c = *m_position++;
+				if (c == '"')
+				{
+					if (str != nullptr && size > 0)
+						str[(length < size) ? length : size - 1] = '\0';
+
+					return true;
+				}
+
+				if (static_cast<unsigned char>(c) < 0x20)
+					return false;
+
+				char decoded[4];
+				size_t decoded_length = 1;
+				decoded[0] = c;
+				if (c == '\\')
+				{
+					if (m_position == m_end)
+						return false;
+
+					switch (*m_position++)
+					{
+					case '"': decoded[0] = '"'; break;
+					case '\\': decoded[0] = '\\'; break;
+					case '/': decoded[0] = '/'; break;
+					case 'b': decoded[0] = '\b'; break;
+					case 'f': decoded[0] = '\f'; break;
+					case 'n': decoded[0] = '\n'; break;
+					case 'r': decoded[0] = '\r'; break;
+					case 't': decoded[0] = '\t'; break;
+					case 'u':
+					{
+						uint32_t code_point;
+						if (false == read_hex4(code_point))
+							return false;
+
+						// A surrogate pair
+						if (code_point >= 0xD800 && code_point <= 0xDBFF)
+						{
+							uint32_t low;
+							if (false == literal("\\u", 2) || false == read_hex4(low) || low < 0xDC00 || low > 0xDFFF)
+								return false;
+
+							code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+						}
+						else if (code_point >= 0xDC00 && code_point <= 0xDFFF)
+							return false;
+
+						decoded_length = encode_utf8(code_point, decoded);
+						break;
+					}
+					default:
+						return false;
+					}
+				}
+
+				if (str != nullptr)
+				{
+					// Keeps a byte for the terminator
+					if (length + decoded_length >= size)
+						truncated = true;
+					else
+						std::memcpy(str + length, decoded, decoded_length);
+				}
+
+				length += decoded_length;
+			}
+
+			return false;
+		}
+
+		bool skip(size_t depth)
+		{
+			if (depth > MAX_SKIP_DEPTH)
+				return false;
+
+			switch (peek())
+			{
+			case json_token::OBJECT:
+			{
+				if (false == begin_object())
+					return false;
+
+				bool end = false;
+				for (bool first = true; ; first = false)
+				{
+					char key[1];
+					size_t key_length;
+					if (false == next_key(first, key, sizeof(key), key_length, end))
+						return false;
+					if (end)
+						return true;
+					if (false == skip(depth + 1))
+						return false;
+				}
+			}
+			case json_token::ARRAY:
+			{
+				if (false == begin_array())
+					return false;
+
+				bool end = false;
+				for (bool first = true; ; first = false)
+				{
+					if (false == next_element(first, end))
+						return false;
+					if (end)
+						return true;
+					if (false == skip(depth + 1))
+						return false;
+				}
+			}
+			case json_token::STRING:
+			{
+				size_t length;
+				bool truncated;
+				return string(nullptr, 0, length, truncated);
+			}
+			case json_token::NUMBER:
+			{
+				json_number number;
+				return read_number(number);
+			}
+			case json_token::BOOLEAN:
+			{
+				bool val;
+				return read_bool(val);
+			}
+			case json_token::NULL_VALUE:
+				return read_null();
+			default:
+				return false;
+			}
+		}
+
+	public:
+		/// Constructor
+		/// @date	19/10/2026
+		/// @param	json	The JSON text.
+		/// @param	size	The size of the text, reading stops at a null character as well.
+		json_stream_reader(const char* json, size_t size) :
+			m_position(json),
+			m_end(json + strnlen(json, size))
+		{
+		}
+
+		/// The kind of the next value
+		json_token peek()
+		{
+			skip_whitespace();
+			if (m_position == m_end)
+				return json_token::INVALID;
+
+			switch (*m_position)
+			{
+			case '{': return json_token::OBJECT;
+			case '[': return json_token::ARRAY;
+			case '"': return json_token::STRING;
+			case 't':
+			case 'f': return json_token::BOOLEAN;
+			case 'n': return json_token::NULL_VALUE;
+			default:
+				if (*m_position == '-' || (*m_position >= '0' && *m_position <= '9'))
+					return json_token::NUMBER;
+
+				return json_token::INVALID;
+			}
+		}
+
+		/// True when only whitespace is left
+		bool at_end()
+		{
+			skip_whitespace();
+			return (m_position == m_end);
+		}
+
+		bool begin_object()
+		{
+			return consume('{');
+		}
+
+		/// Reads the key of the next object member, or the end of the object
+		/// @date	19/10/2026
+		/// @param 			first	  	True for the first member of the object.
+		/// @param [out]	key		  	The decoded key, null terminated.
+		/// @param 			key_size  	Size of the key buffer.
+		/// @param [out]	key_length	The length of the key, larger than key_size when the key was truncated.
+		/// @param [out]	end		  	True if the object ended, there is no member.
+		/// @return	True if it succeeds, false on a syntax error.
+		bool next_key(bool first, char* key, size_t key_size, size_t& key_length, bool& end)
+		{
+			end = consume('}');
+			if (end)
+				return true;
+
+			if (false == first && false == consume(','))
+				return false;
+
+			bool truncated;
+			if (false == string(key, key_size, key_length, truncated))
+				return false;
+
+			if (truncated)
+				key_length = (std::numeric_limits<size_t>::max)();
+
+			return consume(':');
+		}
+
+		bool begin_array()
+		{
+			return consume('[');
+		}
+
+		/// Moves to the next array element, or the end of the array
+		/// @date	19/10/2026
+		/// @param 			first	True for the first element of the array.
+		/// @param [out]	end  	True if the array ended, there is no element.
+		/// @return	True if it succeeds, false on a syntax error.
+		bool next_element(bool first, bool& end)
+		{
+			end = consume(']');
+			if (end)
+				return true;
+
+			return (first || consume(','));
+		}
+
+		/// Reads a string value
+		/// @date	19/10/2026
+		/// @param [out]	str   	The decoded string, null terminated.
+		/// @param 			size  	Size of the string buffer.
+		/// @param [out]	length	The length of the string.
+		/// @return	True if it succeeds, false on a syntax error or when the string does not fit.
+		bool read_string(char* str, size_t size, size_t& length)
+		{
+			bool truncated;
+			return (string(str, size, length, truncated) && false == truncated);
+		}
+
+		bool read_number(json_number& number)
+		{
+			skip_whitespace();
+			const char* start = m_position;
+			bool negative = (m_position < m_end && *m_position == '-');
+			if (negative)
+				m_position++;
+
+			if (m_position == m_end || *m_position < '0' || *m_position > '9')
+				return false;
+
+			// No leading zeros
+			bool overflow = false;
+			uint64_t integer = 0;
+			if (*m_position == '0')
+				m_position++;
+			else
+			{
+				while (m_position < m_end && *m_position >= '0' && *m_position <= '9')
+				{
+					uint64_t digit = static_cast<uint64_t>(*m_position++ - '0');
+					if (integer > ((std::numeric_limits<uint64_t>::max)() - digit) / 10)
+						overflow = true;
+
+					integer = integer * 10 + digit;
+				}
+			}
+
+			bool is_float = false;
+			if (m_position < m_end && *m_position == '.')
+			{
+				is_float = true;
+				m_position++;
+				if (m_position == m_end || *m_position < '0' || *m_position > '9')
+					return false;
+
+				while (m_position < m_end && *m_position >= '0' && *m_position <= '9')
+					m_position++;
+			}
+
+			if (m_position < m_end && (*m_position == 'e' || *m_position == 'E'))
+			{
+				is_float = true;
+				m_position++;
+				if (m_position < m_end && (*m_position == '+' || *m_position == '-'))
+					m_position++;
+
+				if (m_position == m_end || *m_position < '0' || *m_position > '9')
+					return false;
+
+				while (m_position < m_end && *m_position >= '0' && *m_position <= '9')
+					m_position++;
+			}
+
+			if (negative && false == is_float && false == overflow &&
+				integer > static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()) + 1)
+				overflow = true;
+
+			if (is_float || overflow)
+			{
+				// The token is copied to be terminated for strtod
+				char token[64];
+				size_t length = static_cast<size_t>(m_position - start);
+				if (length >= sizeof(token))
+					return false;
+
+				std::memcpy(token, start, length);
+				token[length] = '\0';
+				number.kind = json_number::FLOAT;
+				number.float_value = std::strtod(token, nullptr);
+			}
+			else if (negative)
+			{
+				number.kind = json_number::INTEGER;
+				number.integer_value = static_cast<int64_t>(0 - integer);
+			}
+			else
+			{
+				number.kind = json_number::UNSIGNED;
+				number.unsigned_value = integer;
+			}
+
+			return true;
+		}
+
+		bool read_bool(bool& val)
+		{
+			skip_whitespace();
+			if (literal("true", 4))
+			{
+				val = true;
+				return true;
+			}
+
+			val = false;
+			return literal("false", 5);
+		}
+
+		bool read_null()
+		{
+			skip_whitespace();
+			return literal("null", 4);
+		}
+
+		/// Skips the next value, including nested objects and arrays
+		bool skip_value()
+		{
+			return skip(0);
+		}
+	};
+}
@@ -0,0 +1,306 @@
+#pragma once
+#include "../nlohmann/json.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace parsers
+{
+	/// Writes JSON text directly into a caller supplied buffer, without building a document and without allocating.
+	/// The layout matches the nlohmann dump of the same values - compact, or pretty with an indentation of 4 spaces.
+	/// Writing past the end of the buffer is not an error, the writer keeps counting so length() is the required size.
+	/// @date	19/10/2026
+	class json_stream_writer
+	{
+	private:
+		static constexpr size_t MAX_DEPTH = 128;
+		static constexpr size_t INDENT = 4;
+
+		char* m_buffer;
+		size_t m_capacity;
+		size_t m_length;
+		bool m_compact;
+		bool m_overflow;
+		size_t m_depth;
+		bool m_has_members[MAX_DEPTH];
+
+		void put(char c)
+		{
+			if (m_length < m_capacity)
+				m_buffer[m_length] = c;
+
+			m_length++;
+		}
+
+		void put(const char* str, size_t length)
+		{
+			if (m_length < m_capacity)
+			{
+				size_t available = m_capacity - m_length;
+				std::memcpy(m_buffer + m_length, str, (length < available) ? length : available);
+			}
+
+			m_length += length;
+		}
+
+		void new_line()
+		{
+			put('\n');
+			for (size_t i = 0; i < m_depth * INDENT; i++)
+				put(' ');
+		}
+
+		// Separator before an object member or an array element
+		void next_member()
+		{
+			if (m_depth == 0)
+				return;
+
+			if (m_has_members[m_depth - 1])
+				put(',');
+
+			m_has_members[m_depth - 1] = true;
+			if (false == m_compact)
+				new_line();
+		}
+
+		void begin(char c)
+		{
+			put(c);
+			if (m_depth == MAX_DEPTH)
+			{
+				m_overflow = true;
+				return;
+			}
+
+			m_has_members[m_depth++] = false;
+		}
+
+		bool end(char c)
+		{
+			if (m_overflow || m_depth == 0)
+			{
+				m_overflow = true;
+				put(c);
+				return false;
+			}
+
+			bool has_members = m_has_members[--m_depth];
+			if (has_members && false == m_compact)
+				new_line();
+
+			put(c);
+			return has_members;
+		}
+
+		void quoted(const char* str, size_t length)
+		{
+			static const char hex[] = "0123456789abcdef";
+			put('"');
+			size_t start = 0;
+			for (size_t i = 0; i < length; i++)
+			{
+				uint8_t c = static_cast<uint8_t>(str[i]);
+				if (c >= 0x20 && c != '"' && c != '\\')
+					continue;
+
+				put(str + start, i - start);
+				start = i + 1;
+				put('\\');
+				switch (c)
+				{
+				case '\b': put('b'); break;
+				case '\t': put('t'); break;
+				case '\n': put('n'); break;
+				case '\f': put('f'); break;
+				case '\r': put('r'); break;
+				case '"': put('"'); break;
+				case '\\': put('\\'); break;
+				default:
+					put("u00", 3);
+					put(hex[c >> 4]);
+					put(hex[c & 0xF]);
+					break;
+				}
+			}
+
+			put(str + start, length - start);
+			put('"');
+		}
+
+	public:
+		/// Constructor
+		/// @date	19/10/2026
+		/// @param [out]	buffer  	The output buffer, may be null when only measuring.
+		/// @param 			capacity	The size of the buffer.
+		/// @param 			compact 	True for compact JSON, false for indented JSON.
+		json_stream_writer(char* buffer, size_t capacity, bool compact) :
+			m_buffer(buffer),
+			m_capacity(buffer == nullptr ? 0 : capacity),
+			m_length(0),
+			m_compact(compact),
+			m_overflow(false),
+			m_depth(0)
+		{
+		}
+
+		/// The length of the JSON written so far, including the part that did not fit
+		size_t length() const
+		{
+			return m_length;
+		}
+
+		/// Drops everything written after the given length, used to replace a value that was already written
+		/// @date	19/10/2026
+		/// @param	length	The length to roll back to, must be at the same depth.
+		void rewind(size_t length)
+		{
+			if (length < m_length)
+				m_length = length;
+		}
+
+		/// Terminates the JSON with a null character
+		/// @date	19/10/2026
+		/// @return	True if the JSON and its terminator fit in the buffer.
+		bool finish()
+		{
+			if (m_length < m_capacity)
+			{
+				m_buffer[m_length] = '\0';
+				return (false == m_overflow && m_depth == 0);
+			}
+
+			return false;
+		}
+
+		void begin_object()
+		{
+			begin('{');
+		}
+
+		/// Closes the current object
+		/// @return	True if the object has members.
+		bool end_object()
+		{
+			return end('}');
+		}
+
+		void begin_array()
+		{
+			begin('[');
+		}
+
+		/// Closes the current array
+		/// @return	True if the array has elements.
+		bool end_array()
+		{
+			return end(']');
+		}
+
+		/// Writes the key of the next object member
+		void key(const char* name)
+		{
+			next_member();
+			quoted(name, std::strlen(name));
+			if (m_compact)
+				put(':');
+			else
+				put(": ", 2);
+		}
+
+		/// Starts the next array element - values written inside an array have to be preceded by a call
+		void element()
+		{
+			next_member();
+		}
+
+		void null_value()
+		{
+			put("null", 4);
+		}
+
+		void bool_value(bool val)
+		{
+			if (val)
+				put("true", 4);
+			else
+				put("false", 5);
+		}
+
+		void uint_value(uint64_t val)
+		{
+			char digits[20];
+			size_t count = 0;
+			do
+			{
+				digits[count++] = static_cast<char>('0' + val % 10);
+				val /= 10;
+			} while (val != 0);
+
+			while (count > 0)
+				put(digits[--count]);
+		}
+
+		void int_value(int64_t val)
+		{
+			if (val < 0)
+			{
+				put('-');
+				uint_value(0 - static_cast<uint64_t>(val));
+			}
+			else
+				uint_value(static_cast<uint64_t>(val));
+		}
+
+		/// Writes a floating point value, the shortest representation that round trips (NaN and infinity as null)
+		void double_value(double val)
+		{
+			if (false == std::isfinite(val))
+			{
+				null_value();
+				return;
+			}
+
+			char digits[64];
+			char* end = nlohmann::detail::to_chars(digits, digits + sizeof(digits), val);
+			put(digits, static_cast<size_t>(end - digits));
+		}
+
+		void string_value(const char* str, size_t length)
+		{
+			quoted(str, length);
+		}
+
+		void string_value(const char* str)
+		{
+			quoted(str, std::strlen(str));
+		}
+
+		/// Writes a buffer as a string of upper case hexadecimal digits
+		void hex_value(const uint8_t* data, size_t size)
+		{
+			static const char hex[] = "0123456789ABCDEF";
+			put('"');
+			for (size_t i = 0; i < size; i++)
+			{
+				put(hex[data[i] >> 4]);
+				put(hex[data[i] & 0xF]);
+			}
+
+			put('"');
+		}
+
+		/// Writes an error expression followed by a number in parentheses, as in "<<<ERROR...>>>(15)"
+		void error_value(const char* expression, uint64_t val)
+		{
+			put('"');
+			put(expression, std::strlen(expression));
+			put('(');
+			uint_value(val);
+			put(')');
+			put('"');
+		}
+	};
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <core/parser.h>
+#include <utils/ref_count_ptr.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace parsers
+{
+	/// A perfect hash table of the node names of a frozen metadata, a name is matched to its node index by a single
+	/// hash and compare.
+	/// @date	19/10/2026
+	class node_name_table
+	{
+	private:
+		static constexpr uint32_t SEEDS_PER_SIZE = 64;
+
+		struct entry
+		{
+			const char* name;
+			size_t length;
+		};
+
+		std::vector<entry> m_names;
+		// node index + 1, 0 for an empty slot
+		std::vector<uint32_t> m_slots;
+		uint64_t m_seed;
+		size_t m_mask;
+
+		static uint64_t hash(const char* name, size_t length, uint64_t seed)
+		{
+			uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+			for (size_t i = 0; i < length; i++)
+			{
+				h ^= static_cast<uint8_t>(name[i]);
+				h *= 0x100000001b3ULL;
+			}
+
+			return h ^ (h >> 29);
+		}
+
+		bool find(const char* name, size_t length, size_t& index) const
+		{
+			if (m_slots.empty())
+				return false;
+
+			uint32_t slot = m_slots[static_cast<size_t>(hash(name, length, m_seed)) & m_mask];
+			if (slot == 0)
+				return false;
+
+			const entry& candidate = m_names[slot - 1];
+			if (candidate.length != length || std::memcmp(candidate.name, name, length) != 0)
+				return false;
+
+			index = slot - 1;
+			return true;
+		}
+
+	public:
+		node_name_table() :
+			m_seed(0),
+			m_mask(0)
+		{
+		}
+
+		/// Builds the table of the nodes, the names must outlive the table
+		/// @date	19/10/2026
+		/// @param	nodes	The nodes of the metadata.
+		void build(const std::vector<utils::ref_count_ptr<core::parsers::binary_node_interface>>& nodes)
+		{
+			m_names.clear();
+			m_slots.clear();
+			m_seed = 0;
+			m_mask = 0;
+			for (const utils::ref_count_ptr<core::parsers::binary_node_interface>& node : nodes)
+				m_names.push_back({ node->name(), std::strlen(node->name()) });
+
+			if (m_names.empty())
+				return;
+
+			size_t size = 2;
+			while (size < m_names.size() * 2)
+				size <<= 1;
+
+			// The first seed which maps every distinct name to its own slot, a duplicated name keeps its first node
+			for (;; size <<= 1)
+			{
+				for (uint64_t seed = 0; seed < SEEDS_PER_SIZE; seed++)
+				{
+					m_slots.assign(size, 0);
+					m_mask = size - 1;
+					m_seed = seed;
+					bool perfect = true;
+					for (size_t i = 0; i < m_names.size() && perfect; i++)
+					{
+						uint32_t& slot = m_slots[static_cast<size_t>(hash(m_names[i].name, m_names[i].length, seed)) & m_mask];
+						size_t existing;
+						if (slot == 0)
+							slot = static_cast<uint32_t>(i + 1);
+						else if (false == find(m_names[i].name, m_names[i].length, existing))
+							perfect = false;
+					}
+
+					if (perfect)
+						return;
+				}
+			}
+		}
+
+		/// Finds the index of a node by its name
+		/// @date	19/10/2026
+		/// @param 		   	name 	The name of the node.
+		/// @param [out]	index	The index of the node.
+		/// @return	False if there is no such node.
+		bool find(const char* name, size_t& index) const
+		{
+			if (name == nullptr)
+				return false;
+
+			return find(name, std::strlen(name), index);
+		}
+	};
+}
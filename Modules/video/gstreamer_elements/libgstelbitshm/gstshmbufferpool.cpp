@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <core/video.h>
+#include <utils/video_statistics.hpp>
 
 #include <mutex>
 #include <vector>
@@ -305,7 +306,11 @@ public:
 				display_params.timestamp = static_cast<uint64_t>(reinterpret_cast<ATimeMeta*>(meta)->absoluteTime);
 		}
 		
-		bool retval = pool_item->publish(m_image_params, display_params, m_video_params);
+		core::video::video_params video_params = m_video_params;
+		std::memset(video_params.timestamps, 0, sizeof(video_params.timestamps));
+		utils::video::stamp(video_params, core::video::video_hop::PUBLISH_HOP);
+
+		bool retval = pool_item->publish(m_image_params, display_params, video_params);
 		if (retval == false)
 		{
 			const char* message = "Pool is being abused! Remapping...\n";
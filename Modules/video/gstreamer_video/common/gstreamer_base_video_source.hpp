@@ -102,6 +102,9 @@ namespace video
 			m_display_params({}),
 			m_video_params({})
 		{
+			// The sample was just pulled from the appsink
+			utils::video::stamp(m_video_params, core::video::video_hop::CAPTURE_HOP);
+
 			GstCaps* caps = gst_sample_get_caps(m_sample.get());
 			/*gchar* str = gst_caps_to_string(caps);
 			printf("Frame Caps: %s\n", str);*/
@@ -0,0 +1,313 @@
+#include "shared_memory_frame_allocator.h"
+
+#include <utils/video.hpp>
+
+#ifdef USE_LZ4
+#include <compression/lz4_compression_interface.h>
+#endif
+
+#include <cstring>
+
+video::publishers::shared_memory_frame_allocator_impl::frame_buffer::frame_buffer(
+	shared_memory_frame_allocator_impl* allocator,
+	shared_memory::shm_sharable_buffer_interface* pool_buffer,
+	uint32_t alignment_offset,
+	size_t size) :
+	utils::relative_buffer_base<utils::ref_count_base<core::buffer_interface>>(pool_buffer, HEADER_SIZE + alignment_offset, size),
+	m_allocator(allocator),
+	m_pool_buffer(pool_buffer),
+	m_alignment_offset(alignment_offset),
+	m_published(false)
+{
+}
+
+video::publishers::shared_memory_frame_allocator_impl::frame_buffer::~frame_buffer()
+{
+	// The pool buffer is unlocked by its own destructor when it was not published
+	m_allocator->remove_frame(this);
+}
+
+video::publishers::shared_memory_frame_allocator_impl::shared_memory_frame_allocator_impl(
+	const char* video_name,
+	uint32_t buffer_size,
+	uint32_t buffer_pool_size,
+	bool lock_free) :
+	m_buffer_size(buffer_size),
+	m_buffer_pool_size(buffer_pool_size),
+	m_next_index(0),
+	m_lock_free(lock_free),
+	m_backpressure_timeout(0),
+	m_statistics(utils::make_ref_count_ptr<utils::video::video_statistics_collector>())
+{
+	if (video_name == nullptr)
+		throw std::invalid_argument("video_name");
+
+	shared_memory::shm_pool_params stream_params[] =
+	{
+		shared_memory::shm_pool_params{ VIDEO_CHANNEL_ID, buffer_pool_size, buffer_size,
+			lock_free ? shared_memory::publication_mode::LOCK_FREE : shared_memory::publication_mode::LOCKED },
+	};
+
+	m_session = utils::make_ref_count_ptr<shared_memory::shm_session>(video_name, stream_params, static_cast<uint32_t>(1));
+}
+
+bool video::publishers::shared_memory_frame_allocator_impl::query_pool_buffer_unsafe(shared_memory::shm_sharable_buffer_interface** pool_buffer)
+{
+	// A published pool buffer is unlocked while its frame may still be alive in this process, such buffers are skipped
+	// before they are locked: locking a buffer withdraws its publication from the subscribers which did not get it yet
+	for (uint32_t i = 0; i < m_buffer_pool_size; i++)
+	{
+		uint32_t index = ((m_next_index + i) % m_buffer_pool_size);
+
+		utils::ref_count_ptr<shared_memory::shm_sharable_buffer_interface> instance;
+		if (m_session->query_buffer_unlocked(VIDEO_CHANNEL_ID, index, &instance) != shared_memory::error_codes::SHM_NO_ERROR)
+			return false;
+
+		if (m_reserved.find(instance->data()) != m_reserved.end() ||
+			instance->lock_unique() == false)
+			continue;
+
+		m_next_index = ((index + 1) % m_buffer_pool_size);
+
+		*pool_buffer = instance;
+		(*pool_buffer)->add_ref();
+		return true;
+	}
+
+	return false;
+}
+
+bool video::publishers::shared_memory_frame_allocator_impl::query_pool_buffer(std::unique_lock<std::mutex>& locker, shared_memory::shm_sharable_buffer_interface** pool_buffer)
+{
+	if (query_pool_buffer_unsafe(pool_buffer) == true)
+		return true;
+
+	uint32_t timeout = m_backpressure_timeout;
+	if (timeout == 0)
+		return false;
+
+	// Waiting for LOSSLESS readers without the lock, the frames of this process can release their buffers meanwhile
+	locker.unlock();
+	shared_memory::error_codes error = m_session->wait_for_release(VIDEO_CHANNEL_ID, timeout, [&]()
+	{
+		std::lock_guard<std::mutex> acquire_locker(m_mutex);
+		return query_pool_buffer_unsafe(pool_buffer);
+	});
+
+	locker.lock();
+	return (error == shared_memory::error_codes::SHM_NO_ERROR);
+}
+
+void video::publishers::shared_memory_frame_allocator_impl::remove_frame(frame_buffer* buffer)
+{
+	std::lock_guard<std::mutex> locker(m_mutex);
+	m_frames.erase(buffer->data());
+	m_reserved.erase(buffer->m_pool_buffer->data());
+}
+
+size_t video::publishers::shared_memory_frame_allocator_impl::max_buffer_size() const
+{
+	if (m_buffer_size < HEADER_SIZE + DATA_ALIGNMENT)
+		return 0;
+
+	return m_buffer_size - HEADER_SIZE - DATA_ALIGNMENT;
+}
+
+bool video::publishers::shared_memory_frame_allocator_impl::allocate(size_t buffer_size, core::buffer_interface** buffer)
+{
+	if (buffer == nullptr)
+		return false;
+
+	std::unique_lock<std::mutex> locker(m_mutex);
+
+	utils::ref_count_ptr<shared_memory::shm_sharable_buffer_interface> pool_buffer;
+	if (query_pool_buffer(locker, &pool_buffer) == false)
+		return false;
+
+	uintptr_t unaligned = reinterpret_cast<uintptr_t>(pool_buffer->data() + HEADER_SIZE);
+	uint32_t alignment_offset = static_cast<uint32_t>((DATA_ALIGNMENT - (unaligned % DATA_ALIGNMENT)) % DATA_ALIGNMENT);
+	if (HEADER_SIZE + alignment_offset + buffer_size > pool_buffer->size())
+		return false;
+
+	utils::ref_count_ptr<frame_buffer> instance;
+	try
+	{
+		instance = utils::make_ref_count_ptr<frame_buffer>(this, pool_buffer, alignment_offset, buffer_size);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	m_frames[instance->data()] = instance;
+	m_reserved.insert(pool_buffer->data());
+
+	*buffer = instance;
+	(*buffer)->add_ref();
+	return true;
+}
+
+bool video::publishers::shared_memory_frame_allocator_impl::enable_backpressure(uint32_t timeout_ms)
+{
+	// Only the readers of a LOCK_FREE pool hold the writer back
+	if (m_lock_free == false)
+		return false;
+
+	m_backpressure_timeout = timeout_ms;
+	return true;
+}
+
+bool video::publishers::shared_memory_frame_allocator_impl::enable_compression(bool per_tile, uint32_t keyframe_interval, uint32_t acceleration)
+{
+#ifdef USE_LZ4
+	utils::ref_count_ptr<core::compression_interface> compression;
+	if (compression::lz4_compression_interface::create(acceleration, &compression) == false)
+		return false;
+
+	utils::ref_count_ptr<utils::video::frame_codec> codec;
+	try
+	{
+		codec = utils::make_ref_count_ptr<utils::video::frame_codec>(compression,
+			per_tile ? utils::video::frame_codec::chunking::PER_TILE : utils::video::frame_codec::chunking::PER_PLANE,
+			keyframe_interval);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> locker(m_mutex);
+	m_codec = codec;
+	return true;
+#else
+	(void)per_tile;
+	(void)keyframe_interval;
+	(void)acceleration;
+	return false;
+#endif
+}
+
+bool video::publishers::shared_memory_frame_allocator_impl::publish(core::video::frame_interface* frame)
+{
+	if (frame == nullptr)
+		return false;
+
+	utils::ref_count_ptr<core::buffer_interface> data_buffer;
+	if (frame->query_buffer(&data_buffer) == false)
+		return false;
+
+	core::imaging::image_params image_params;
+	core::video::display_params display_params;
+	core::video::video_params video_params;
+	if (frame->query_image_params(image_params) == false || image_params.size == 0 ||
+		frame->query_display_params(display_params) == false ||
+		frame->query_video_params(video_params) == false)
+		return false;
+
+	utils::ref_count_ptr<shared_memory::shm_sharable_buffer_interface> pool_buffer;
+	utils::ref_count_ptr<utils::video::frame_codec> codec;
+	bool copy = false;
+	{
+		std::unique_lock<std::mutex> locker(m_mutex);
+		codec = m_codec;
+
+		// Zero copy: the frame data already is in a pool buffer locked for writing, only the parameters are written
+		auto it = m_frames.find(data_buffer->data());
+		if (codec == nullptr && it != m_frames.end() && it->second->m_published == false && image_params.size <= data_buffer->size())
+		{
+			utils::video::stamp(video_params, core::video::video_hop::PUBLISH_HOP);
+
+			frame_buffer* target = it->second;
+			uint8_t* pos = target->m_pool_buffer->data();
+			std::memcpy(pos, &image_params, sizeof(core::imaging::image_params));
+			pos += sizeof(core::imaging::image_params);
+			std::memcpy(pos, &display_params, sizeof(core::video::display_params));
+			pos += sizeof(core::video::display_params);
+			std::memcpy(pos, &video_params, sizeof(core::video::video_params));
+			pos += sizeof(core::video::video_params);
+			std::memcpy(pos, &target->m_alignment_offset, sizeof(uint32_t));
+
+			target->m_published = true;
+			pool_buffer = target->m_pool_buffer;
+		}
+		else
+		{
+			if (query_pool_buffer(locker, &pool_buffer) == false)
+			{
+				m_statistics->add_dropped();
+				return false;
+			}
+
+			copy = true;
+		}
+	}
+
+	if (copy == true)
+	{
+		utils::video::frame_binary_serializer serializer(frame, 0, codec);
+		if (serializer.serialize(pool_buffer) == false)
+		{
+			m_statistics->add_dropped();
+			return false;
+		}
+
+		// Stamped once the data is copied, the copy is part of the latency to publishing
+		utils::video::stamp(video_params, core::video::video_hop::PUBLISH_HOP);
+		std::memcpy(pool_buffer->data() + sizeof(core::imaging::image_params) + sizeof(core::video::display_params),
+			&video_params, sizeof(core::video::video_params));
+
+		m_statistics->add_copied(image_params.size);
+	}
+
+	if (m_session->publish(pool_buffer) != shared_memory::error_codes::SHM_NO_ERROR)
+	{
+		m_statistics->add_dropped();
+		return false;
+	}
+
+	m_statistics->add_frame(video_params.timestamps[core::video::video_hop::PUBLISH_HOP]);
+	m_statistics->add_latency(video_params, core::video::video_hop::PUBLISH_HOP, true, video_params.timestamps[core::video::video_hop::PUBLISH_HOP]);
+	return true;
+}
+
+void video::publishers::shared_memory_frame_allocator_impl::query_statistics(core::video::video_statistics& statistics) const
+{
+	m_statistics->query(statistics);
+}
+
+bool video::publishers::shared_memory_frame_allocator::create(
+	const char* video_name,
+	uint32_t buffer_size,
+	uint32_t buffer_pool_size,
+	bool lock_free,
+	shared_memory_frame_allocator** allocator)
+{
+	if (video_name == nullptr)
+		return false;
+
+	if (allocator == nullptr)
+		return false;
+
+	if (buffer_size == 0)
+		return false;
+
+	if (buffer_pool_size == 0)
+		return false;
+
+	utils::ref_count_ptr<shared_memory_frame_allocator> instance;
+	try
+	{
+		instance = utils::make_ref_count_ptr<shared_memory_frame_allocator_impl>(video_name, buffer_size, buffer_pool_size, lock_free);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	if (instance == nullptr)
+		return false;
+
+	*allocator = instance;
+	(*allocator)->add_ref();
+	return true;
+}
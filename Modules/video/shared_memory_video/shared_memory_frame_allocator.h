@@ -0,0 +1,91 @@
+#pragma once
+#include <video/publishers/shared_memory_frame_allocator.h>
+#include <core/video.h>
+#include <utils/ref_count_base.hpp>
+#include <utils/ref_count_ptr.hpp>
+#include <utils/buffer_allocator.hpp>
+#include <utils/frame_codec.hpp>
+#include <utils/video_statistics.hpp>
+
+#include <shared_memory_streaming.hpp>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace video
+{
+	namespace publishers
+	{
+		static constexpr uint32_t VIDEO_CHANNEL_ID = 0;
+		static constexpr uint32_t VIDEO_CHANNEL_POOL_SIZE = 20;
+		static constexpr uint32_t VIDEO_CHANNEL_BUFFER_SIZE = 10485760; // 10 MBs
+
+		class shared_memory_frame_allocator_impl :
+			public utils::ref_count_base<video::publishers::shared_memory_frame_allocator>
+		{
+		private:
+			// The frame parameters and the data alignment offset, as written by utils::video::frame_binary_serializer
+			static constexpr size_t HEADER_SIZE = sizeof(core::imaging::image_params) +
+				sizeof(core::video::display_params) +
+				sizeof(core::video::video_params) +
+				sizeof(uint32_t);
+
+			static constexpr size_t DATA_ALIGNMENT = 64;
+
+			// The data of a frame inside a pool buffer, the pool buffer stays locked for writing until it is published
+			class frame_buffer :
+				public utils::relative_buffer_base<utils::ref_count_base<core::buffer_interface>>
+			{
+			private:
+				utils::ref_count_ptr<shared_memory_frame_allocator_impl> m_allocator;
+				utils::ref_count_ptr<shared_memory::shm_sharable_buffer_interface> m_pool_buffer;
+				uint32_t m_alignment_offset;
+				bool m_published;
+
+				friend class shared_memory_frame_allocator_impl;
+
+			public:
+				frame_buffer(shared_memory_frame_allocator_impl* allocator,
+					shared_memory::shm_sharable_buffer_interface* pool_buffer,
+					uint32_t alignment_offset,
+					size_t size);
+
+				virtual ~frame_buffer();
+			};
+
+			utils::ref_count_ptr<shared_memory::shm_session> m_session;
+			uint32_t m_buffer_size;
+			uint32_t m_buffer_pool_size;
+			uint32_t m_next_index;
+			bool m_lock_free;
+			std::atomic<uint32_t> m_backpressure_timeout; // Milliseconds, 0 when the publisher does not wait for its readers
+
+			std::mutex m_mutex;
+			std::map<const uint8_t*, frame_buffer*> m_frames; // The alive frame buffers by data pointer
+			std::set<const uint8_t*> m_reserved; // Their pool buffers
+			utils::ref_count_ptr<utils::video::frame_codec> m_codec;
+			utils::ref_count_ptr<utils::video::video_statistics_collector> m_statistics;
+
+			bool query_pool_buffer_unsafe(shared_memory::shm_sharable_buffer_interface** pool_buffer);
+			bool query_pool_buffer(std::unique_lock<std::mutex>& locker, shared_memory::shm_sharable_buffer_interface** pool_buffer);
+			void remove_frame(frame_buffer* buffer);
+
+		public:
+			shared_memory_frame_allocator_impl(const char* video_name, uint32_t buffer_size, uint32_t buffer_pool_size, bool lock_free);
+			virtual ~shared_memory_frame_allocator_impl() = default;
+
+			virtual size_t max_buffer_size() const override;
+			virtual bool allocate(size_t buffer_size, core::buffer_interface** buffer) override;
+			virtual bool enable_compression(bool per_tile, uint32_t keyframe_interval, uint32_t acceleration) override;
+			virtual bool enable_backpressure(uint32_t timeout_ms) override;
+
+			// Publishes a frame: a frame whose buffer was allocated here is handed off, any other (or compressed) frame is copied
+			bool publish(core::video::frame_interface* frame);
+
+			// The frames published, dropped and copied, with their latency from capture to publishing
+			void query_statistics(core::video::video_statistics& statistics) const;
+		};
+	}
+}
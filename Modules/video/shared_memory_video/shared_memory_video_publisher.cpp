@@ -6,6 +6,17 @@ bool video::publishers::shared_memory_video_publisher::create(
 	uint32_t buffer_size,
 	uint32_t buffer_pool_size,
 	core::video::video_publisher_interface** publisher)
+{
+	return create(video_name, source, buffer_size, buffer_pool_size, false, publisher);
+}
+
+bool video::publishers::shared_memory_video_publisher::create(
+	const char* video_name,
+	core::video::video_source_interface* source,
+	uint32_t buffer_size,
+	uint32_t buffer_pool_size,
+	bool lock_free,
+	core::video::video_publisher_interface** publisher)
 {
 	if (source == nullptr)
 		return false;
@@ -22,7 +33,7 @@ bool video::publishers::shared_memory_video_publisher::create(
 	utils::ref_count_ptr<core::video::video_publisher_interface> instance;
 	try
 	{
-		instance = utils::make_ref_count_ptr<shared_memory_video_publisher_impl>(video_name, source, buffer_size, buffer_pool_size);
+		instance = utils::make_ref_count_ptr<shared_memory_video_publisher_impl>(video_name, source, buffer_size, buffer_pool_size, lock_free);
 	}
 	catch (...)
 	{
@@ -51,6 +62,17 @@ bool video::publishers::shared_memory_video_publisher::create(
 	uint32_t buffer_size,
 	uint32_t buffer_pool_size,
 	core::video::video_publisher_interface** publisher)
+{
+	return create(video_name, source_factory, buffer_size, buffer_pool_size, false, publisher);
+}
+
+bool video::publishers::shared_memory_video_publisher::create(
+	const char* video_name,
+	const core::video::video_source_factory_interface* source_factory,
+	uint32_t buffer_size,
+	uint32_t buffer_pool_size,
+	bool lock_free,
+	core::video::video_publisher_interface** publisher)
 {
 	if (source_factory == nullptr)
 		return false;
@@ -68,7 +90,7 @@ bool video::publishers::shared_memory_video_publisher::create(
 	if (source_factory->create(&source) == false)
 		return false;
 
-	return video::publishers::shared_memory_video_publisher::create(video_name, source, buffer_size, buffer_pool_size, publisher);
+	return video::publishers::shared_memory_video_publisher::create(video_name, source, buffer_size, buffer_pool_size, lock_free, publisher);
 }
 
 bool video::publishers::shared_memory_video_publisher::create(
@@ -78,3 +100,35 @@ bool video::publishers::shared_memory_video_publisher::create(
 {
 	return create(video_name, source_factory, VIDEO_CHANNEL_BUFFER_SIZE, VIDEO_CHANNEL_POOL_SIZE, publisher);
 }
+
+bool video::publishers::shared_memory_video_publisher::create(
+	video::publishers::shared_memory_frame_allocator* allocator,
+	core::video::video_source_interface* source,
+	core::video::video_publisher_interface** publisher)
+{
+	if (allocator == nullptr)
+		return false;
+
+	if (source == nullptr)
+		return false;
+
+	if (publisher == nullptr)
+		return false;
+
+	utils::ref_count_ptr<core::video::video_publisher_interface> instance;
+	try
+	{
+		instance = utils::make_ref_count_ptr<shared_memory_video_publisher_impl>(static_cast<shared_memory_frame_allocator_impl*>(allocator), source);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	if (instance == nullptr)
+		return false;
+
+	*publisher = instance;
+	(*publisher)->add_ref();
+	return true;
+}
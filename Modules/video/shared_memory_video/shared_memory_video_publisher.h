@@ -7,22 +7,19 @@
 #include <utils/scope_guard.hpp>
 #include <utils/video.hpp>
 
-#include <shared_memory_streaming.hpp>
+#include "shared_memory_frame_allocator.h"
 #include <string>
 
 namespace video
 {
 	namespace publishers
 	{
-		static constexpr uint32_t VIDEO_CHANNEL_ID = 0;
-		static constexpr uint32_t VIDEO_CHANNEL_POOL_SIZE = 20;
-		static constexpr uint32_t VIDEO_CHANNEL_BUFFER_SIZE = 10485760; // 10 MBs
-
 		class shared_memory_video_publisher_impl : 
-			public utils::ref_count_base<utils::video::video_controller_base<video::publishers::shared_memory_video_publisher>>
+			public utils::ref_count_base<utils::video::video_controller_base<video::publishers::shared_memory_video_publisher>>,
+			public core::video::video_statistics_interface
 		{
 		private:	
-			utils::ref_count_ptr<shared_memory::shm_session> m_session;
+			utils::ref_count_ptr<shared_memory_frame_allocator_impl> m_allocator;
 			utils::ref_count_ptr<core::video::video_source_interface> m_source;
 			utils::ref_count_ptr<core::video::frame_callback> m_frame_callback;
 			utils::ref_count_ptr<core::video::video_error_callback> m_error_callback;
@@ -30,24 +27,29 @@ namespace video
 		protected:
 			virtual void on_frame(core::video::frame_interface* frame)
 			{
-				utils::ref_count_ptr<shared_memory::shm_sharable_buffer_interface> buffer;
-				if (m_session->query_buffer_unique(VIDEO_CHANNEL_ID, &buffer) != shared_memory::error_codes::SHM_NO_ERROR)
-					return;			
-
-				utils::video::frame_binary_serializer serializer(frame, 0);
-				if (serializer.serialize(buffer) == false)
-					return;				
-
-				m_session->publish(buffer);
+				// Frames allocated by m_allocator are handed off, others are copied
+				m_allocator->publish(frame);
 			}		
 
 		public:
 			shared_memory_video_publisher_impl(const char* video_name, 
 				core::video::video_source_interface* source,
 				uint32_t buffer_size,
-				uint32_t buffer_pool_size) :
+				uint32_t buffer_pool_size,
+				bool lock_free = false) :
+				shared_memory_video_publisher_impl(
+					utils::make_ref_count_ptr<shared_memory_frame_allocator_impl>(video_name, buffer_size, buffer_pool_size, lock_free), source)
+			{
+			}
+
+			shared_memory_video_publisher_impl(shared_memory_frame_allocator_impl* allocator,
+				core::video::video_source_interface* source) :
+				m_allocator(allocator),
 				m_source(source)
 			{
+				if (allocator == nullptr)
+					throw std::invalid_argument("allocator");
+
 				if (source == nullptr)
 					throw std::invalid_argument("source");				
 
@@ -66,14 +68,6 @@ namespace video
 
 				if (m_source->add_error_callback(m_error_callback) == false)
 					throw std::runtime_error("Failed to set error callback to source");
-
-
-				shared_memory::shm_pool_params stream_params[] = 
-				{ 
-					shared_memory::shm_pool_params{ VIDEO_CHANNEL_ID, buffer_pool_size, buffer_size},
-				};
-
-                m_session = utils::make_ref_count_ptr<shared_memory::shm_session>(video_name, stream_params, static_cast<uint32_t>(1));
 			}
 
 			~shared_memory_video_publisher_impl()
@@ -102,6 +96,12 @@ namespace video
 			{
 				m_source->pause();
 			}
+
+			virtual bool query_statistics(core::video::video_statistics& statistics) const override
+			{
+				m_allocator->query_statistics(statistics);
+				return true;
+			}
 		};
 	}
 }
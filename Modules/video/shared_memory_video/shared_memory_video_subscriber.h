@@ -7,6 +7,11 @@
 #include "shared_memory_streaming.hpp"
 #include <thread>
 #include <atomic>
+#include <memory>
+
+#ifdef USE_LZ4
+#include <compression/lz4_compression_interface.h>
+#endif
 
 namespace video
 {
@@ -22,6 +27,7 @@ namespace video
 			{
 			private:
 				utils::ref_count_ptr<core::buffer_interface> m_buffer;
+				uint64_t m_received;
 
 				core::imaging::image_params& direct_image_params() const
 				{
@@ -29,8 +35,9 @@ namespace video
 				}
 
 			public:
-				shared_memory_zero_copy_frame(core::buffer_interface* buffer) :
-					m_buffer(buffer)
+				shared_memory_zero_copy_frame(core::buffer_interface* buffer, uint64_t received) :
+					m_buffer(buffer),
+					m_received(received)
 				{
 				}
 
@@ -58,6 +65,7 @@ namespace video
                         return false;
 
                     std::memcpy(&video_params, m_buffer->data() + sizeof(core::imaging::image_params) + sizeof(core::video::display_params), sizeof(core::video::video_params));
+                    utils::video::stamp(video_params, core::video::video_hop::RECEIVE_HOP, m_received);
                     return true;
                 }
 
@@ -94,9 +102,61 @@ namespace video
 				}
 			};
 
+			// A decoded frame, with the parameters of the compressed one stamped when it was received
+			class shared_memory_decoded_frame : public utils::video::frame_base<core::video::frame_interface>
+			{
+			public:
+				shared_memory_decoded_frame(
+					const core::imaging::image_params& image_params,
+					const core::video::display_params& display_params,
+					const core::video::video_params& video_params,
+					core::buffer_interface* buffer) :
+					frame_base(image_params, display_params, video_params, buffer)
+				{
+				}
+			};
+
 			std::mutex m_mutex;
 			std::atomic<core::video::video_state> m_state;
 			utils::ref_count_ptr<shared_memory::shm_session_player> m_player;
+			std::unique_ptr<utils::video::frame_binary_serializer> m_decoder; // Compressed frames, decoded by the player thread
+
+			static bool is_compressed(core::buffer_interface* buffer)
+			{
+				static constexpr size_t OFFSET_POSITION = sizeof(core::imaging::image_params) + sizeof(core::video::display_params) +
+					sizeof(core::video::video_params);
+
+				uint32_t offset;
+				std::memcpy(&offset, buffer->data() + OFFSET_POSITION, sizeof(uint32_t));
+				return ((offset & utils::video::frame_binary_serializer::COMPRESSED) != 0);
+			}
+
+			bool decode(core::buffer_interface* buffer, uint64_t received, core::video::frame_interface** frame)
+			{
+				utils::ref_count_ptr<core::video::frame_interface> decoded;
+				if (m_decoder->deserialize(buffer) == false || m_decoder->query_frame(&decoded) == false)
+					return false;
+
+				core::imaging::image_params image_params;
+				core::video::display_params display_params;
+				core::video::video_params video_params;
+				utils::ref_count_ptr<core::buffer_interface> data;
+				if (decoded->query_image_params(image_params) == false ||
+					decoded->query_display_params(display_params) == false ||
+					decoded->query_video_params(video_params) == false ||
+					decoded->query_buffer(&data) == false)
+					return false;
+
+				statistics()->add_copied(image_params.size);
+				utils::video::stamp(video_params, core::video::video_hop::RECEIVE_HOP, received);
+
+				utils::ref_count_ptr<core::video::frame_interface> instance =
+					utils::make_ref_count_ptr<shared_memory_decoded_frame>(image_params, display_params, video_params, data);
+
+				*frame = instance;
+				(*frame)->add_ref();
+				return true;
+			}
 
 		public:
 			shared_memory_video_subscriber(const char* video_name) :
@@ -105,6 +165,15 @@ namespace video
 				utils::ref_count_ptr<shared_memory::shm_session> session =
 					utils::make_ref_count_ptr<shared_memory::shm_session>(video_name);
 
+				// Publishers compress with LZ4, without it compressed frames are dropped
+				utils::ref_count_ptr<utils::video::frame_codec> codec;
+#ifdef USE_LZ4
+				utils::ref_count_ptr<core::compression_interface> compression;
+				if (compression::lz4_compression_interface::create(1, &compression) == true)
+					codec = utils::make_ref_count_ptr<utils::video::frame_codec>(compression);
+#endif
+				m_decoder.reset(new utils::video::frame_binary_serializer(static_cast<core::buffer_allocator*>(nullptr), 0, codec));
+
 				m_player = utils::make_ref_count_ptr<shared_memory::shm_session_player>(session, VIDEO_CHANNEL_ID);
 
 				m_player->OnBuffer += [this](uint32_t stream_index, core::buffer_interface* buffer)
@@ -115,7 +184,23 @@ namespace video
 					if (state() != core::video::video_state::PLAYING)
 						return;
 
-					utils::ref_count_ptr<core::video::frame_interface> frame = utils::make_ref_count_ptr<shared_memory_zero_copy_frame>(buffer);
+					uint64_t received = utils::video::monotonic_now();
+
+					utils::ref_count_ptr<core::video::frame_interface> frame;
+					if (is_compressed(buffer) == false)
+					{
+						frame = utils::make_ref_count_ptr<shared_memory_zero_copy_frame>(buffer, received);
+					}
+					else if (decode(buffer, received, &frame) == false)
+					{
+						statistics()->add_dropped();
+						return;
+					}
+
+					core::video::video_params video_params;
+					if (frame->query_video_params(video_params) == true)
+						statistics()->add_latency(video_params, core::video::video_hop::RECEIVE_HOP, false, received);
+
 					raise_frame(frame);
 				};
 			}
@@ -125,6 +210,18 @@ namespace video
 				stop();
 			}
 
+			virtual bool query_statistics(core::video::video_statistics& statistics) const override
+			{
+				utils::video::video_source_base<video::sources::shared_memory_video_source>::query_statistics(statistics);
+
+				// The frames the reader skipped (LOCK_FREE pools only)
+				shared_memory::reader_statistics reader;
+				if (m_player->query_statistics(reader) == true)
+					statistics.dropped += reader.dropped;
+
+				return true;
+			}
+
 			virtual core::video::video_state state() override
 			{
 				return m_state;
@@ -152,6 +249,12 @@ namespace video
 				if (m_state != core::video::video_state::STOPPED)
 				{
 					m_state = core::video::video_state::STOPPED;
+
+					// The reader is detached by the player, its drops are kept
+					shared_memory::reader_statistics reader;
+					if (m_player->query_statistics(reader) == true)
+						statistics()->add_dropped(reader.dropped);
+
 					m_player->stop();
 				}
 			}
@@ -16,6 +16,15 @@
 #include <string>
 #include <functional>
 #include <thread>
+#include <chrono>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#endif
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -60,7 +69,11 @@ namespace shared_memory
 	// {AA315FB1-B710-47D4-B082-F831EB463261}
 	static constexpr core::guid SESSION_SEGMENT_IDENTIFIER = { 0xaa315fb1, 0xb710, 0x47d4,{ 0xb0, 0x82, 0xf8, 0x31, 0xeb, 0x46, 0x32, 0x61 } };
 
+	// {5E2D8A61-93C4-4F0B-A7E2-3B91D06C4F18}
+	static constexpr core::guid FRAME_RING_SEGMENT_IDENTIFIER = { 0x5e2d8a61, 0x93c4, 0x4f0b,{ 0xa7, 0xe2, 0x3b, 0x91, 0xd0, 0x6c, 0x4f, 0x18 } };
+
 	static constexpr uint32_t MAX_SHARABLE_POOLS_PER_SESSION = 5;
+	static constexpr size_t CACHE_LINE_SIZE = 64;
 
 	class guid_generator
 	{
@@ -89,6 +102,12 @@ namespace shared_memory
 		WRITER
 	};
 
+	enum publication_mode
+	{
+		LOCKED,		// An interprocess mutex and condition per pool, a sharable mutex per buffer
+		LOCK_FREE	// A shm_frame_ring: atomic slots and futex wakeups, the writer never waits for readers
+	};
+
 	enum error_codes
 	{
 		SHM_NO_ERROR,
@@ -102,6 +121,26 @@ namespace shared_memory
 		SHM_DATA_CORRUPTION
 	};
 
+	enum reader_policy
+	{
+		LATEST_ONLY,	// The latest publication, the ones published since the previous read are dropped
+		BOUNDED_LAG,	// Every publication in order while at most 'max_lag' behind the latest one, then skips ahead
+		LOSSLESS		// Every publication in order, the writer does not reuse a buffer the reader did not get yet
+	};
+
+	// The statistics of a reader attached to a LOCK_FREE pool
+	struct reader_statistics
+	{
+		uint32_t reader;
+		reader_policy policy;
+		uint32_t max_lag;
+		uint32_t lag;			// Publications behind the latest one when it got its last buffer
+		uint64_t delivered;
+		uint64_t dropped;
+		uint64_t hold_time;		// Total microseconds its buffers were held
+		uint64_t max_hold_time;	// Microseconds
+	};
+
 	class shm_buffer_interface :
 		public core::buffer_interface
 	{
@@ -132,6 +171,467 @@ namespace shared_memory
 
 	};
 
+	// Waits while a word shared between processes holds 'expected', up to 'timeout' milliseconds (forever if not positive).
+	// May return early, callers check their condition again.
+	inline void wait_on_address(std::atomic<uint32_t>& word, uint32_t expected, int64_t timeout)
+	{
+#ifdef __linux__
+		// Not a private futex: the word is shared between processes
+		timespec duration;
+		duration.tv_sec = static_cast<time_t>(timeout / 1000);
+		duration.tv_nsec = static_cast<long>(timeout % 1000) * 1000000L;
+		::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, (timeout > 0) ? &duration : nullptr, nullptr, 0);
+#else
+		(void)timeout;
+		if (word.load() == expected)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+	}
+
+	inline void wake_address(std::atomic<uint32_t>& word)
+	{
+#ifdef __linux__
+		::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+		(void)word;
+#endif
+	}
+
+	/// The publication state of a LOCK_FREE pool, constructed in the shared memory segment in front of its slots.
+	/// The writer pins a free slot (no readers), fills it and publishes it by storing its sequence number and index in
+	/// a single 64 bits word, readers pin a slot by incrementing its reader count and check it still holds the frame
+	/// they were told about. The writer skips the slots pinned by readers instead of waiting for them and readers sleep
+	/// on a futex which the writer wakes only when someone is waiting, so no side ever blocks the other.
+	/// Readers may also attach a cursor and a reader_policy: the recent publications are kept by sequence number so a
+	/// reader can get them in order, and the writer skips the slots holding a publication a LOSSLESS reader did not get
+	/// yet (a reader which did not read for TIMEOUT_BEFORE_REMAPPING is considered gone). All the waiting readers are
+	/// woken by the same futex broadcast, the writer may wait on a second futex for a reader to release a slot.
+	class shm_frame_ring
+	{
+	public:
+		static constexpr uint32_t MAX_READERS = 16;
+
+	private:
+		static constexpr uint32_t WRITING = 0x80000000;
+
+		enum reader_state : uint32_t
+		{
+			FREE,
+			ATTACHING,
+			ATTACHED
+		};
+
+		struct slot
+		{
+			std::atomic<uint32_t> state;	// WRITING or the number of readers
+			std::atomic<uint32_t> sequence;	// The sequence number of the frame it holds, 0 while it is written
+			uint8_t padding[CACHE_LINE_SIZE - (2 * sizeof(uint32_t))];
+		};
+
+		// Written by its reader only, except the state
+		struct reader
+		{
+			std::atomic<uint32_t> state;
+			std::atomic<uint32_t> policy;
+			std::atomic<uint32_t> max_lag;
+			std::atomic<uint32_t> cursor;		// The sequence number of the last publication it got or dropped
+			std::atomic<uint32_t> lag;
+			uint32_t reserved;
+			std::atomic<uint64_t> heartbeat;	// The steady clock milliseconds of its last read
+			std::atomic<uint64_t> delivered;
+			std::atomic<uint64_t> dropped;
+			std::atomic<uint64_t> hold_time;
+			std::atomic<uint64_t> max_hold_time;
+		};
+
+		static_assert(sizeof(reader) == CACHE_LINE_SIZE, "A reader of the frame ring should fill a cache line");
+
+		// The latest publication, its sequence number in the 32 upper bits and its slot index in the lower ones
+		std::atomic<uint64_t> m_latest;
+		uint32_t m_history;	// The number of publications kept by sequence number
+		uint8_t m_padding0[CACHE_LINE_SIZE - sizeof(uint64_t) - sizeof(uint32_t)];
+		std::atomic<uint32_t> m_wake_sequence;
+		std::atomic<uint32_t> m_waiters;
+		uint8_t m_padding1[CACHE_LINE_SIZE - (2 * sizeof(uint32_t))];
+		std::atomic<uint32_t> m_release_sequence;
+		std::atomic<uint32_t> m_writer_waiting;
+		std::atomic<uint32_t> m_lossless_readers;
+		uint8_t m_padding2[CACHE_LINE_SIZE - (3 * sizeof(uint32_t))];
+		reader m_readers[MAX_READERS];
+
+		static size_t history_size(uint32_t history)
+		{
+			return ((history * sizeof(uint64_t) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+		}
+
+		// The publications by sequence number, in the same format as m_latest
+		std::atomic<uint64_t>& get_publication(uint32_t sequence)
+		{
+			return static_cast<std::atomic<uint64_t>*>(static_cast<void*>(this + 1))[sequence % m_history];
+		}
+
+		slot& get_slot(uint32_t index)
+		{
+			return static_cast<slot*>(static_cast<void*>(reinterpret_cast<uint8_t*>(this + 1) + history_size(m_history)))[index];
+		}
+
+		static uint64_t now()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		// Checks whether a publication was not read yet by a LOSSLESS reader
+		bool is_pending(uint32_t sequence)
+		{
+			if (m_lossless_readers.load() == 0)
+				return false;
+
+			uint64_t current_time = now();
+			for (reader& current : m_readers)
+			{
+				if (current.state.load(std::memory_order_acquire) != reader_state::ATTACHED ||
+					current.policy.load(std::memory_order_relaxed) != reader_policy::LOSSLESS ||
+					current_time - current.heartbeat.load(std::memory_order_relaxed) > static_cast<uint64_t>(TIMEOUT_BEFORE_REMAPPING))
+					continue;
+
+				if (static_cast<int32_t>(sequence - current.cursor.load(std::memory_order_acquire)) > 0)
+					return true;
+			}
+
+			return false;
+		}
+
+		// Registers as waiting on a futex word, waits while 'condition' holds and unregisters
+		static void wait_for_word(std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiters, int64_t timeout, const std::function<bool()>& condition)
+		{
+			waiters.fetch_add(1);
+			uint32_t value = word.load();
+			if (condition() == true)
+				wait_on_address(word, value, timeout);
+
+			waiters.fetch_sub(1);
+		}
+
+	public:
+		shm_frame_ring(uint32_t pool_size) :
+			m_latest(0),
+			m_history(2 * pool_size),
+			m_wake_sequence(0),
+			m_waiters(0),
+			m_release_sequence(0),
+			m_writer_waiting(0),
+			m_lossless_readers(0)
+		{
+			for (reader& current : m_readers)
+			{
+				current.state.store(reader_state::FREE);
+				current.delivered.store(0);
+				current.dropped.store(0);
+			}
+
+			for (uint32_t i = 0; i < m_history; i++)
+				new (&get_publication(i)) std::atomic<uint64_t>(0);
+
+			for (uint32_t i = 0; i < pool_size; i++)
+			{
+				slot* current = new (&get_slot(i)) slot();
+				current->state.store(0);
+				current->sequence.store(0);
+			}
+		}
+
+		static size_t size(uint32_t pool_size)
+		{
+			return sizeof(shm_frame_ring) + history_size(2 * pool_size) + (pool_size * sizeof(slot));
+		}
+
+		uint32_t sequence() const
+		{
+			return static_cast<uint32_t>(m_latest.load(std::memory_order_acquire) >> 32);
+		}
+
+		bool lock_write(uint32_t index)
+		{
+			slot& current = get_slot(index);
+			uint32_t state = 0;
+			if (current.state.compare_exchange_strong(state, WRITING, std::memory_order_acquire) == false)
+				return false;
+
+			uint32_t held = current.sequence.load(std::memory_order_relaxed);
+			if (held != 0 && is_pending(held) == true)
+			{
+				current.state.store(0, std::memory_order_release);
+				return false;
+			}
+
+			current.sequence.store(0, std::memory_order_relaxed);
+			return true;
+		}
+
+		void unlock_write(uint32_t index)
+		{
+			get_slot(index).state.store(0, std::memory_order_release);
+		}
+
+		// Pins a published slot, holding the frame 'sequence' unless it is 0
+		bool lock_read(uint32_t index, uint32_t sequence)
+		{
+			slot& current = get_slot(index);
+			uint32_t state = current.state.load(std::memory_order_relaxed);
+			do
+			{
+				if ((state & WRITING) != 0)
+					return false;
+			} while (current.state.compare_exchange_weak(state, state + 1, std::memory_order_acquire) == false);
+
+			uint32_t pinned = current.sequence.load(std::memory_order_relaxed);
+			if (pinned == 0 || (sequence != 0 && pinned != sequence))
+			{
+				current.state.fetch_sub(1, std::memory_order_release);
+				return false;
+			}
+
+			return true;
+		}
+
+		void unlock_read(uint32_t index)
+		{
+			get_slot(index).state.fetch_sub(1, std::memory_order_release);
+
+			m_release_sequence.fetch_add(1);
+			if (m_writer_waiting.load() != 0)
+				wake_address(m_release_sequence);
+		}
+
+		// Publishes a slot pinned by lock_write and unpins it
+		void publish(uint32_t index)
+		{
+			// A single writer, the sequence number skips 0 when it wraps
+			uint32_t next = sequence() + 1;
+			if (next == 0)
+				next = 1;
+
+			slot& current = get_slot(index);
+			current.sequence.store(next, std::memory_order_relaxed);
+			current.state.store(0, std::memory_order_release);
+
+			uint64_t publication = ((static_cast<uint64_t>(next) << 32) | index);
+			get_publication(next).store(publication, std::memory_order_release);
+			m_latest.store(publication);
+
+			// One broadcast for all the waiting readers
+			m_wake_sequence.fetch_add(1);
+			if (m_waiters.load() != 0)
+				wake_address(m_wake_sequence);
+		}
+
+		// Waits up to 'timeout' milliseconds (forever if not positive) for a publication newer than 'last_sequence'
+		error_codes wait(int64_t timeout, uint32_t& last_sequence, uint32_t& index)
+		{
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+			while (true)
+			{
+				uint64_t latest = m_latest.load();
+				uint32_t sequence = static_cast<uint32_t>(latest >> 32);
+				if (sequence != 0 && sequence != last_sequence)
+				{
+					last_sequence = sequence;
+					index = static_cast<uint32_t>(latest);
+					return error_codes::SHM_NO_ERROR;
+				}
+
+				int64_t remaining = 0;
+				if (timeout > 0)
+				{
+					remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+					if (remaining <= 0)
+						return error_codes::SHM_TIMEOUT;
+				}
+
+				// The writer wakes the word only while someone is registered as waiting
+				wait_for_word(m_wake_sequence, m_waiters, remaining, [&]()
+				{
+					return (m_latest.load() == latest);
+				});
+			}
+		}
+
+		// The writer: waits up to 'timeout' milliseconds for a reader to release a slot since 'release_sequence()' returned 'observed'
+		void wait_for_release(uint32_t observed, int64_t timeout)
+		{
+			wait_for_word(m_release_sequence, m_writer_waiting, timeout, [&]()
+			{
+				return (m_release_sequence.load() == observed);
+			});
+		}
+
+		uint32_t release_sequence() const
+		{
+			return m_release_sequence.load();
+		}
+
+		// Attaches a reader, its cursor starts at the latest publication.
+		// The readers of a process which exits without detaching them stay attached until the writer maps the pool again.
+		bool attach(reader_policy policy, uint32_t max_lag, uint32_t& reader_index)
+		{
+			for (uint32_t i = 0; i < MAX_READERS; i++)
+			{
+				reader& current = m_readers[i];
+				uint32_t state = reader_state::FREE;
+				if (current.state.compare_exchange_strong(state, reader_state::ATTACHING) == false)
+					continue;
+
+				current.policy.store(policy);
+				current.max_lag.store(max_lag);
+				current.cursor.store(sequence());
+				current.lag.store(0);
+				current.heartbeat.store(now());
+				current.delivered.store(0);
+				current.dropped.store(0);
+				current.hold_time.store(0);
+				current.max_hold_time.store(0);
+
+				if (policy == reader_policy::LOSSLESS)
+					m_lossless_readers.fetch_add(1);
+
+				current.state.store(reader_state::ATTACHED, std::memory_order_release);
+				reader_index = i;
+				return true;
+			}
+
+			return false;
+		}
+
+		void detach(uint32_t reader_index)
+		{
+			if (reader_index >= MAX_READERS)
+				return;
+
+			reader& current = m_readers[reader_index];
+			uint32_t state = reader_state::ATTACHED;
+			if (current.state.compare_exchange_strong(state, reader_state::FREE) == false)
+				return;
+
+			if (current.policy.load() == reader_policy::LOSSLESS)
+			{
+				// The slots it held back may be reused
+				m_lossless_readers.fetch_sub(1);
+				m_release_sequence.fetch_add(1);
+				if (m_writer_waiting.load() != 0)
+					wake_address(m_release_sequence);
+			}
+		}
+
+		// Pins the next publication of an attached reader according to its policy, waiting up to 'timeout' milliseconds
+		// (forever if not positive) for it. Publications reused by the writer before they were pinned are dropped.
+		error_codes read(uint32_t reader_index, int64_t timeout, uint32_t& index)
+		{
+			if (reader_index >= MAX_READERS)
+				return error_codes::SHM_INVALID_ARGUMENT;
+
+			reader& current = m_readers[reader_index];
+			if (current.state.load(std::memory_order_acquire) != reader_state::ATTACHED)
+				return error_codes::SHM_PERMISSION_DENIED;
+
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+			while (true)
+			{
+				current.heartbeat.store(now(), std::memory_order_relaxed);
+
+				uint32_t latest = sequence();
+				uint32_t cursor = current.cursor.load(std::memory_order_relaxed);
+				if (latest != 0 && static_cast<int32_t>(latest - cursor) > 0)
+				{
+					uint32_t target = cursor + 1;
+					if (current.policy.load(std::memory_order_relaxed) == reader_policy::LATEST_ONLY)
+						target = latest;
+					else if (current.policy.load(std::memory_order_relaxed) == reader_policy::BOUNDED_LAG &&
+						latest - cursor > current.max_lag.load(std::memory_order_relaxed) + 1)
+						target = latest - current.max_lag.load(std::memory_order_relaxed);
+
+					if (target == 0)
+						target = 1;
+
+					uint64_t publication = get_publication(target).load(std::memory_order_acquire);
+					bool pinned = false;
+					if (static_cast<uint32_t>(publication >> 32) == target)
+					{
+						pinned = lock_read(static_cast<uint32_t>(publication), target);
+
+						// The writer checks the LOSSLESS readers with the slot locked, it is unlocked again unless it is reused
+						if (pinned == false && get_slot(static_cast<uint32_t>(publication)).sequence.load(std::memory_order_relaxed) == target)
+						{
+							std::this_thread::yield();
+							continue;
+						}
+					}
+
+					uint32_t skipped = (pinned == true) ? (target - cursor - 1) : (target - cursor);
+					if (skipped != 0)
+						current.dropped.fetch_add(skipped, std::memory_order_relaxed);
+
+					current.cursor.store(target, std::memory_order_release);
+					if (pinned == false)
+						continue;
+
+					current.lag.store(latest - target, std::memory_order_relaxed);
+					current.delivered.fetch_add(1, std::memory_order_relaxed);
+					index = static_cast<uint32_t>(publication);
+					return error_codes::SHM_NO_ERROR;
+				}
+
+				int64_t remaining = 0;
+				if (timeout > 0)
+				{
+					remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+					if (remaining <= 0)
+						return error_codes::SHM_TIMEOUT;
+				}
+
+				wait_for_word(m_wake_sequence, m_waiters, remaining, [&]()
+				{
+					return (sequence() == latest);
+				});
+			}
+		}
+
+		// Unpins a slot pinned by read
+		void release(uint32_t reader_index, uint32_t index, uint64_t hold_time)
+		{
+			unlock_read(index);
+
+			if (reader_index >= MAX_READERS)
+				return;
+
+			reader& current = m_readers[reader_index];
+			current.hold_time.fetch_add(hold_time, std::memory_order_relaxed);
+			if (hold_time > current.max_hold_time.load(std::memory_order_relaxed))
+				current.max_hold_time.store(hold_time, std::memory_order_relaxed);
+		}
+
+		bool query_statistics(uint32_t reader_index, reader_statistics& statistics)
+		{
+			if (reader_index >= MAX_READERS)
+				return false;
+
+			reader& current = m_readers[reader_index];
+			if (current.state.load(std::memory_order_acquire) != reader_state::ATTACHED)
+				return false;
+
+			statistics.reader = reader_index;
+			statistics.policy = static_cast<reader_policy>(current.policy.load(std::memory_order_relaxed));
+			statistics.max_lag = current.max_lag.load(std::memory_order_relaxed);
+			statistics.lag = current.lag.load(std::memory_order_relaxed);
+			statistics.delivered = current.delivered.load(std::memory_order_relaxed);
+			statistics.dropped = current.dropped.load(std::memory_order_relaxed);
+			statistics.hold_time = current.hold_time.load(std::memory_order_relaxed);
+			statistics.max_hold_time = current.max_hold_time.load(std::memory_order_relaxed);
+			return true;
+		}
+	};
+
+	static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "The frame ring requires lock-free atomics");
+
 	class shm_buffer :
 		public utils::ref_count_base<shared_memory::shm_buffer_interface>
 	{
@@ -469,8 +969,16 @@ namespace shared_memory
 			utils::ref_count_ptr<core::buffer_interface> m_relative_buffer;
 			uint32_t m_index;
 			shared_memory::access_mode m_access_mode;
+			uint32_t m_reader; // The frame ring reader it was read by, if any
+			std::chrono::steady_clock::time_point m_pinned;
 			std::mutex m_mutex;
 
+			bool unlock_read_unsafe(shm_sharable_bufferpool* pool)
+			{
+				uint64_t hold_time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_pinned).count());
+				return pool->unlock_read(m_index, m_reader, hold_time);
+			}
+
 			bool unlock_unsafe()
 			{
 				if (m_access_mode == shared_memory::access_mode::NONE)
@@ -480,14 +988,16 @@ namespace shared_memory
 				if (query_source_buffer((core::buffer_interface**)(&pool)) == false)
 					return false;
 
-				shm_shared_buffer_mutex* shared_mutex = pool->get_buffer_mutex(m_index);
-				if (shared_mutex == nullptr)
-					return false;
-
 				if (m_access_mode == shared_memory::access_mode::WRITER)
-					shared_mutex->unlock_write();
+				{
+					if (pool->unlock_write(m_index) == false)
+						return false;
+				}
 				else if (m_access_mode == shared_memory::access_mode::READER)
-					shared_mutex->unlock_read();
+				{
+					if (unlock_read_unsafe(pool) == false)
+						return false;
+				}
 
 				m_access_mode = shared_memory::access_mode::NONE;
 				return true;
@@ -499,14 +1009,10 @@ namespace shared_memory
 				if (query_source_buffer((core::buffer_interface**)(&pool)) == false)
 					return false;
 
-				shm_shared_buffer_mutex* shared_mutex = pool->get_buffer_mutex(m_index);
-				if (shared_mutex == nullptr)
-					return false;
-
                 if (m_access_mode == shared_memory::access_mode::READER)
 					return false;
 
-				if (shared_mutex->lock_write() == false)
+				if (pool->lock_write(m_index) == false)
 					return false;
 
 				m_access_mode = shared_memory::access_mode::WRITER;
@@ -519,14 +1025,12 @@ namespace shared_memory
 				if (query_source_buffer((core::buffer_interface**)(&pool)) == false)
 					return false;
 
-				shm_shared_buffer_mutex* shared_mutex = pool->get_buffer_mutex(m_index);
-				if (shared_mutex == nullptr)
+				if (m_access_mode != shared_memory::access_mode::WRITER)
 					return false;
 
-				if (m_access_mode != shared_memory::access_mode::WRITER)
+				if (pool->unlock_write(m_index) == false)
 					return false;
 
-				shared_mutex->unlock_write();
 				m_access_mode = shared_memory::access_mode::NONE;
 				return true;
 			}
@@ -537,10 +1041,6 @@ namespace shared_memory
 				if (query_source_buffer((core::buffer_interface**)(&pool)) == false)
 					return false;
 
-				shm_shared_buffer_mutex* shared_mutex = pool->get_buffer_mutex(m_index);
-				if (shared_mutex == nullptr)
-					return false;
-
 				if (m_access_mode == shared_memory::access_mode::READER)
 				{
 					return true;
@@ -555,10 +1055,12 @@ namespace shared_memory
 					return false;
 				}
 
-				if (shared_mutex->lock_read() == false)
+				if (pool->lock_read(m_index) == false)
 					return false;
 
 				m_access_mode = shared_memory::access_mode::READER;
+				m_reader = UNDEFINED_INDEX;
+				m_pinned = std::chrono::steady_clock::now();
 				return true;
 			}
 
@@ -568,14 +1070,12 @@ namespace shared_memory
 				if (query_source_buffer((core::buffer_interface**)(&pool)) == false)
 					return false;
 
-				shm_shared_buffer_mutex* shared_mutex = pool->get_buffer_mutex(m_index);
-				if (shared_mutex == nullptr)
+				if (m_access_mode != shared_memory::access_mode::READER)
 					return false;
 
-				if (m_access_mode != shared_memory::access_mode::READER)
+				if (unlock_read_unsafe(pool) == false)
 					return false;
 
-				shared_mutex->unlock_read();
 				m_access_mode = shared_memory::access_mode::NONE;
 				return true;
 			}
@@ -589,21 +1089,21 @@ namespace shared_memory
 				if (query_source_buffer((core::buffer_interface**)(&pool)) == false)
 					return error_codes::SHM_POOL_DOES_NOT_EXIST;
 
-				shm_bufferpool_wait_handler* wait_handler = pool->get_wait_handler();
-				if (wait_handler == nullptr)
-					return error_codes::SHM_DATA_CORRUPTION;
-
-				if (unlock_unsafe() == false)
-					return error_codes::SHM_LOCK_SHARED_FAILED;
+				// Publishing releases the buffer, even when notifying the readers fails
+				error_codes retval = pool->publish_buffer(m_index);
+				if (retval != error_codes::SHM_INVALID_ARGUMENT)
+					m_access_mode = shared_memory::access_mode::NONE;
 
-				return wait_handler->set(m_index);
+				return retval;
 			}
 
 		public:
-			shm_sharable_buffer(shm_sharable_bufferpool* bufferpool, uint32_t index, shared_memory::access_mode access_mode) :
+			shm_sharable_buffer(shm_sharable_bufferpool* bufferpool, uint32_t index, shared_memory::access_mode access_mode, uint32_t reader = UNDEFINED_INDEX) :
 				utils::relative_buffer_base<utils::ref_count_base<shared_memory::shm_sharable_buffer_interface>>(bufferpool, bufferpool->get_buffer_offset(index), bufferpool->buffer_size()),
 				m_index(index),
-				m_access_mode(access_mode)
+				m_access_mode(access_mode),
+				m_reader(reader),
+				m_pinned(std::chrono::steady_clock::now())
 			{
 			}
 
@@ -659,6 +1159,21 @@ namespace shared_memory
 		uint32_t m_pool_size;
 		uint32_t m_buffer_size;
 		uint32_t m_next_unique_query;
+		publication_mode m_publication;
+		uint32_t m_last_sequence; // Readers of a LOCK_FREE pool: the latest publication they were given
+
+		static constexpr size_t HEADER_SIZE = sizeof(core::guid) + sizeof(uint32_t) + sizeof(uint32_t);
+
+		// The frame ring of a LOCK_FREE pool starts on the cache line after the header
+		static constexpr size_t FRAME_RING_OFFSET = ((HEADER_SIZE + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+
+		static size_t control_size(publication_mode publication, uint32_t pool_size)
+		{
+			if (publication == publication_mode::LOCK_FREE)
+				return FRAME_RING_OFFSET + shm_frame_ring::size(pool_size);
+
+			return HEADER_SIZE + sizeof(shm_bufferpool_wait_handler) + (pool_size * sizeof(shm_shared_buffer_mutex));
+		}
 
 		core::guid get_segment_identifier()
 		{
@@ -681,11 +1196,26 @@ namespace shared_memory
 			return retval;
 		}
 
+		void read_header()
+		{
+			m_publication = (get_segment_identifier() == FRAME_RING_SEGMENT_IDENTIFIER) ? publication_mode::LOCK_FREE : publication_mode::LOCKED;
+			m_pool_size = get_pool_size();
+			m_buffer_size = get_buffer_size();
+
+			// Waiting for the next publication, as readers of LOCKED pools do
+			if (m_publication == publication_mode::LOCK_FREE)
+				m_last_sequence = get_frame_ring()->sequence();
+		}
+
 		bool destroy()
 		{
 			if (mode() != access_mode::WRITER)
 				return false;
 
+			// The frame ring is trivially destructible
+			if (m_publication == publication_mode::LOCK_FREE)
+				return true;
+
 			for (uint32_t i = 0; i < pool_size(); i++)
 			{
 				shm_shared_buffer_mutex* handler = get_buffer_mutex(i);
@@ -715,7 +1245,11 @@ namespace shared_memory
 				return false;
 
 			uint8_t* base_addr = this->data();
-			std::memcpy(base_addr, &BUFFER_POOL_SEGMENT_IDENTIFIER, sizeof(core::guid));
+			if (m_publication == publication_mode::LOCK_FREE)
+				std::memcpy(base_addr, &FRAME_RING_SEGMENT_IDENTIFIER, sizeof(core::guid));
+			else
+				std::memcpy(base_addr, &BUFFER_POOL_SEGMENT_IDENTIFIER, sizeof(core::guid));
+
 			base_addr += sizeof(core::guid);
 
 			std::memcpy(base_addr, &m_pool_size, sizeof(uint32_t));
@@ -724,6 +1258,12 @@ namespace shared_memory
 			std::memcpy(base_addr, &m_buffer_size, sizeof(uint32_t));
 			base_addr += sizeof(uint32_t);
 
+			if (m_publication == publication_mode::LOCK_FREE)
+			{
+				new (this->data() + FRAME_RING_OFFSET) shm_frame_ring(m_pool_size);
+				return true;
+			}
+
 			new (base_addr) shm_bufferpool_wait_handler(UNDEFINED_INDEX);
 			base_addr += sizeof(shm_bufferpool_wait_handler);
 
@@ -748,8 +1288,7 @@ namespace shared_memory
 			}
 			else // if (mode() == shared_memory::access_mode::READER)
 			{
-				m_pool_size = get_pool_size();
-				m_buffer_size = get_buffer_size();
+				read_header();
 			}
 
             return true;
@@ -757,7 +1296,7 @@ namespace shared_memory
 
 		shm_bufferpool_wait_handler* get_wait_handler()
 		{
-			return static_cast<shm_bufferpool_wait_handler*>(static_cast<void*>(this->data() + sizeof(core::guid) + sizeof(uint32_t) + sizeof(uint32_t)));
+			return static_cast<shm_bufferpool_wait_handler*>(static_cast<void*>(this->data() + HEADER_SIZE));
 		}
 
 		shm_shared_buffer_mutex* get_buffer_mutex(uint32_t index)
@@ -765,10 +1304,86 @@ namespace shared_memory
 			if (index >= m_pool_size)
 				return nullptr;
 
-			return static_cast<shm_shared_buffer_mutex*>(static_cast<void*>(this->data() + sizeof(core::guid) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(shm_bufferpool_wait_handler) + (index * sizeof(shm_shared_buffer_mutex))));
+			return static_cast<shm_shared_buffer_mutex*>(static_cast<void*>(this->data() + HEADER_SIZE + sizeof(shm_bufferpool_wait_handler) + (index * sizeof(shm_shared_buffer_mutex))));
+		}
+
+		shm_frame_ring* get_frame_ring()
+		{
+			return static_cast<shm_frame_ring*>(static_cast<void*>(this->data() + FRAME_RING_OFFSET));
+		}
+
+		bool lock_write(uint32_t index)
+		{
+			if (index >= m_pool_size)
+				return false;
+
+			if (m_publication == publication_mode::LOCK_FREE)
+				return get_frame_ring()->lock_write(index);
+
+			return get_buffer_mutex(index)->lock_write();
+		}
+
+		bool unlock_write(uint32_t index)
+		{
+			if (index >= m_pool_size)
+				return false;
+
+			if (m_publication == publication_mode::LOCK_FREE)
+				get_frame_ring()->unlock_write(index);
+			else
+				get_buffer_mutex(index)->unlock_write();
+
+			return true;
+		}
+
+		// 'sequence' is the publication expected in a slot of a LOCK_FREE pool, 0 for any
+		bool lock_read(uint32_t index, uint32_t sequence = 0)
+		{
+			if (index >= m_pool_size)
+				return false;
+
+			if (m_publication == publication_mode::LOCK_FREE)
+				return get_frame_ring()->lock_read(index, sequence);
+
+			return get_buffer_mutex(index)->lock_read();
 		}
 
-		bool query_sharable_buffer(uint32_t index, shared_memory::access_mode access_mode, shm_sharable_buffer_interface** buffer)
+		// 'reader' is the frame ring reader which pinned a slot of a LOCK_FREE pool for 'hold_time' microseconds, if any
+		bool unlock_read(uint32_t index, uint32_t reader = UNDEFINED_INDEX, uint64_t hold_time = 0)
+		{
+			if (index >= m_pool_size)
+				return false;
+
+			if (m_publication == publication_mode::LOCK_FREE)
+				get_frame_ring()->release(reader, index, hold_time);
+			else
+				get_buffer_mutex(index)->unlock_read();
+
+			return true;
+		}
+
+		// Releases a buffer locked for writing and notifies the readers
+		error_codes publish_buffer(uint32_t index)
+		{
+			if (index >= m_pool_size)
+				return error_codes::SHM_INVALID_ARGUMENT;
+
+			if (m_publication == publication_mode::LOCK_FREE)
+			{
+				get_frame_ring()->publish(index);
+				return error_codes::SHM_NO_ERROR;
+			}
+
+			get_buffer_mutex(index)->unlock_write();
+
+			shm_bufferpool_wait_handler* wait_handler = get_wait_handler();
+			if (wait_handler == nullptr)
+				return error_codes::SHM_DATA_CORRUPTION;
+
+			return wait_handler->set(index);
+		}
+
+		bool query_sharable_buffer(uint32_t index, shared_memory::access_mode access_mode, shm_sharable_buffer_interface** buffer, uint32_t reader = UNDEFINED_INDEX)
 		{
 			if (buffer == nullptr)
 				return false;
@@ -779,7 +1394,7 @@ namespace shared_memory
 			utils::ref_count_ptr<shm_sharable_buffer_interface> instance;
 			try
 			{
-				instance = utils::make_ref_count_ptr<shm_sharable_buffer>(this, index, access_mode);
+				instance = utils::make_ref_count_ptr<shm_sharable_buffer>(this, index, access_mode, reader);
 			}
 			catch (...)
 			{
@@ -796,12 +1411,13 @@ namespace shared_memory
 
 	public:
 		// C'tor for writers
-		shm_sharable_bufferpool(const char* name, uint32_t pool_size, uint32_t buffer_size) :
-			shm_buffer(name,
-				sizeof(core::guid) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(shm_bufferpool_wait_handler) + (pool_size * sizeof(shm_shared_buffer_mutex)) + (pool_size * buffer_size)),
+		shm_sharable_bufferpool(const char* name, uint32_t pool_size, uint32_t buffer_size, publication_mode publication = publication_mode::LOCKED) :
+			shm_buffer(name, control_size(publication, pool_size) + (pool_size * buffer_size)),
 			m_pool_size(pool_size),
 			m_buffer_size(buffer_size),
-			m_next_unique_query(0)
+			m_next_unique_query(0),
+			m_publication(publication),
+			m_last_sequence(0)
 		{
 			if (is_mapped() == false)
 				throw std::runtime_error("Allocation failed");
@@ -813,13 +1429,15 @@ namespace shared_memory
 		shm_sharable_bufferpool(const char* name) :
 			shm_buffer(name),
 			m_pool_size(0),
-			m_buffer_size(0)
+			m_buffer_size(0),
+			m_next_unique_query(0),
+			m_publication(publication_mode::LOCKED),
+			m_last_sequence(0)
 		{
 			if (is_mapped() == false)
 				return;
 
-			m_pool_size = get_pool_size();
-			m_buffer_size = get_buffer_size();
+			read_header();
 		}
 
 		virtual ~shm_sharable_bufferpool() = default;
@@ -834,9 +1452,14 @@ namespace shared_memory
 			return m_buffer_size;
 		}
 
+		publication_mode publication()
+		{
+			return m_publication;
+		}
+
 		size_t get_buffer_offset(uint32_t index)
 		{
-			return sizeof(core::guid) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(shm_bufferpool_wait_handler) + (pool_size() * sizeof(shm_shared_buffer_mutex)) + (index * buffer_size());
+			return control_size(m_publication, pool_size()) + (index * buffer_size());
 		}
 
 		bool query_buffer_unlocked(uint32_t index, shm_sharable_buffer_interface** buffer)
@@ -847,15 +1470,14 @@ namespace shared_memory
 			if (is_mapped() == false)
 				return false;
 
-			shm_shared_buffer_mutex* shared_mutex = get_buffer_mutex(index);
-			if (shared_mutex == nullptr ||
+			if (index >= m_pool_size ||
 				query_sharable_buffer(index, shared_memory::access_mode::NONE, buffer) == false)
 				return false;
 
 			return true;
 		}
 
-		bool query_buffer_shared(uint32_t index, shm_sharable_buffer_interface** buffer)
+		bool query_buffer_shared(uint32_t index, shm_sharable_buffer_interface** buffer, uint32_t sequence = 0)
 		{
 			if (buffer == nullptr)
 				return false;
@@ -863,12 +1485,15 @@ namespace shared_memory
 			if (is_mapped() == false)
 				return false;
 
-			shm_shared_buffer_mutex* shared_mutex = get_buffer_mutex(index);
-			if (shared_mutex == nullptr ||
-				shared_mutex->lock_read() == false ||
-				query_sharable_buffer(index, shared_memory::access_mode::READER, buffer) == false)
+			if (lock_read(index, sequence) == false)
 				return false;
 
+			if (query_sharable_buffer(index, shared_memory::access_mode::READER, buffer) == false)
+			{
+				unlock_read(index);
+				return false;
+			}
+
 			return true;
 		}
 
@@ -880,15 +1505,19 @@ namespace shared_memory
 			if (is_mapped() == false)
 				return false;
 
+			// Buffers held by readers are skipped, the writer never waits for them
 			for (uint32_t i = 0; i < m_pool_size; i++)
 			{
 				uint32_t index = ((m_next_unique_query + i) % m_pool_size);
-				shm_shared_buffer_mutex* shared_mutex = get_buffer_mutex(index);
-				if (shared_mutex == nullptr ||
-					shared_mutex->lock_write() == false ||
-					query_sharable_buffer(index, shared_memory::access_mode::WRITER, buffer) == false)
+				if (lock_write(index) == false)
 					continue;
 
+				if (query_sharable_buffer(index, shared_memory::access_mode::WRITER, buffer) == false)
+				{
+					unlock_write(index);
+					continue;
+				}
+
 				m_next_unique_query = ((index + 1) % m_pool_size);
 				return true;
 			}
@@ -904,6 +1533,21 @@ namespace shared_memory
 			if (is_mapped() == false)
 				return error_codes::SHM_NOT_MAPPED;
 
+			if (m_publication == publication_mode::LOCK_FREE)
+			{
+				// A slot reused by the writer before it was pinned holds a newer frame (or will soon), waiting for it
+				while (true)
+				{
+					uint32_t index;
+					error_codes error = get_frame_ring()->wait(timeout, m_last_sequence, index);
+					if (error != error_codes::SHM_NO_ERROR)
+						return error;
+
+					if (query_buffer_shared(index, buffer, m_last_sequence) == true)
+						return error_codes::SHM_NO_ERROR;
+				}
+			}
+
 			shm_bufferpool_wait_handler* wait_handle = get_wait_handler();
 			if (wait_handle == nullptr)
 				return error_codes::SHM_DATA_CORRUPTION;
@@ -918,6 +1562,165 @@ namespace shared_memory
 
 			return error_codes::SHM_NO_ERROR;
 		}
+
+		// Waits up to 'timeout' milliseconds for a buffer held back by the readers of a LOCK_FREE pool
+		error_codes wait_for_buffer_unique(int64_t timeout, shm_sharable_buffer_interface** buffer)
+		{
+			if (buffer == nullptr)
+				return error_codes::SHM_INVALID_ARGUMENT;
+
+			return wait_for_release(timeout, [&]()
+			{
+				return query_buffer_unique(buffer);
+			});
+		}
+
+		// Retries 'acquire' for up to 'timeout' milliseconds, each time a reader of a LOCK_FREE pool releases a buffer
+		template <typename ACQUIRE>
+		error_codes wait_for_release(int64_t timeout, ACQUIRE acquire)
+		{
+			if (is_mapped() == false)
+				return error_codes::SHM_NOT_MAPPED;
+
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+			while (true)
+			{
+				uint32_t observed = (m_publication == publication_mode::LOCK_FREE) ? get_frame_ring()->release_sequence() : 0;
+				if (acquire() == true)
+					return error_codes::SHM_NO_ERROR;
+
+				int64_t remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+				if (m_publication != publication_mode::LOCK_FREE || remaining <= 0)
+					return error_codes::SHM_LOCK_UNIQUE_FAILED;
+
+				get_frame_ring()->wait_for_release(observed, remaining);
+			}
+		}
+
+		// Readers of a LOCK_FREE pool: attaches a cursor with a policy, up to shm_frame_ring::MAX_READERS per pool
+		error_codes attach_reader(reader_policy policy, uint32_t max_lag, uint32_t& reader)
+		{
+			if (is_mapped() == false)
+				return error_codes::SHM_NOT_MAPPED;
+
+			if (m_publication != publication_mode::LOCK_FREE)
+				return error_codes::SHM_PERMISSION_DENIED;
+
+			if (get_frame_ring()->attach(policy, max_lag, reader) == false)
+				return error_codes::SHM_LOCK_SHARED_FAILED;
+
+			return error_codes::SHM_NO_ERROR;
+		}
+
+		void detach_reader(uint32_t reader)
+		{
+			if (is_mapped() == false || m_publication != publication_mode::LOCK_FREE)
+				return;
+
+			get_frame_ring()->detach(reader);
+		}
+
+		// Waits up to 'timeout' milliseconds for the next buffer of an attached reader, held until the buffer is released
+		error_codes read_buffer(uint32_t reader, int64_t timeout, shm_sharable_buffer_interface** buffer)
+		{
+			if (buffer == nullptr)
+				return error_codes::SHM_INVALID_ARGUMENT;
+
+			if (is_mapped() == false)
+				return error_codes::SHM_NOT_MAPPED;
+
+			if (m_publication != publication_mode::LOCK_FREE)
+				return error_codes::SHM_PERMISSION_DENIED;
+
+			uint32_t index;
+			error_codes error = get_frame_ring()->read(reader, timeout, index);
+			if (error != error_codes::SHM_NO_ERROR)
+				return error;
+
+			if (query_sharable_buffer(index, shared_memory::access_mode::READER, buffer, reader) == false)
+			{
+				get_frame_ring()->release(reader, index, 0);
+				return error_codes::SHM_LOCK_SHARED_FAILED;
+			}
+
+			return error_codes::SHM_NO_ERROR;
+		}
+
+		bool query_reader_statistics(uint32_t reader, reader_statistics& statistics)
+		{
+			if (is_mapped() == false || m_publication != publication_mode::LOCK_FREE)
+				return false;
+
+			return get_frame_ring()->query_statistics(reader, statistics);
+		}
+
+		// The statistics of all the readers attached to the pool, by any process
+		bool query_readers(std::vector<reader_statistics>& readers)
+		{
+			readers.clear();
+			if (is_mapped() == false || m_publication != publication_mode::LOCK_FREE)
+				return false;
+
+			for (uint32_t i = 0; i < shm_frame_ring::MAX_READERS; i++)
+			{
+				reader_statistics statistics;
+				if (get_frame_ring()->query_statistics(i, statistics) == true)
+					readers.emplace_back(statistics);
+			}
+
+			return true;
+		}
+	};
+
+	/// A reader attached to a LOCK_FREE pool with a cursor and a policy, detached when released.
+	/// It keeps the pool it was attached to mapped: after the writer maps the pool again, its reads time out and a new
+	/// reader should be attached through a remapped session.
+	class shm_pool_reader :
+		public utils::ref_count_base<core::ref_count_interface>
+	{
+	private:
+		utils::ref_count_ptr<shm_sharable_bufferpool> m_pool;
+		uint32_t m_reader;
+
+	public:
+		// Takes over a reader attached by shm_sharable_bufferpool::attach_reader
+		shm_pool_reader(shm_sharable_bufferpool* pool, uint32_t reader) :
+			m_pool(pool),
+			m_reader(reader)
+		{
+			if (pool == nullptr)
+				throw std::invalid_argument("pool");
+		}
+
+		virtual ~shm_pool_reader()
+		{
+			m_pool->detach_reader(m_reader);
+		}
+
+		uint32_t reader() const
+		{
+			return m_reader;
+		}
+
+		error_codes read(int64_t timeout, core::buffer_interface** buffer)
+		{
+			if (buffer == nullptr)
+				return error_codes::SHM_INVALID_ARGUMENT;
+
+			utils::ref_count_ptr<shm_sharable_buffer_interface> instance;
+			error_codes error = m_pool->read_buffer(m_reader, timeout, &instance);
+			if (error != error_codes::SHM_NO_ERROR)
+				return error;
+
+			*buffer = instance;
+			(*buffer)->add_ref();
+			return error_codes::SHM_NO_ERROR;
+		}
+
+		bool query_statistics(reader_statistics& statistics)
+		{
+			return m_pool->query_reader_statistics(m_reader, statistics);
+		}
 	};
 
 	struct shm_pool_params
@@ -925,6 +1728,7 @@ namespace shared_memory
 		uint32_t index;
 		uint32_t pool_size;
 		uint32_t buffer_size;
+		publication_mode publication; // LOCKED when omitted from the initializer
 	};
 
 	class shm_session :
@@ -1179,7 +1983,7 @@ namespace shared_memory
 				stream << id;
 
 				utils::ref_count_ptr<shm_sharable_bufferpool> pool =
-					utils::make_ref_count_ptr<shm_sharable_bufferpool>(stream.str().c_str(), curr_pool_params.pool_size, curr_pool_params.buffer_size);
+					utils::make_ref_count_ptr<shm_sharable_bufferpool>(stream.str().c_str(), curr_pool_params.pool_size, curr_pool_params.buffer_size, curr_pool_params.publication);
 
 				m_pools[curr_pool_params.index] = pool;
 				retval = true;
@@ -1214,7 +2018,7 @@ namespace shared_memory
 					stream << id;
 
 					utils::ref_count_ptr<shm_sharable_bufferpool> pool =
-						utils::make_ref_count_ptr<shm_sharable_bufferpool>(stream.str().c_str(), curr_pool_params.pool_size, curr_pool_params.buffer_size);
+						utils::make_ref_count_ptr<shm_sharable_bufferpool>(stream.str().c_str(), curr_pool_params.pool_size, curr_pool_params.buffer_size, curr_pool_params.publication);
 
 					m_pools[curr_pool_params.index] = pool;
 				}
@@ -1283,6 +2087,36 @@ namespace shared_memory
 			return error_codes::SHM_NO_ERROR;
 		}
 
+		// The backpressure of LOSSLESS readers: waits up to 'timeout' milliseconds for them to release a buffer
+		error_codes wait_for_buffer_unique(uint32_t pool_index, int64_t timeout, shm_sharable_buffer_interface** buffer)
+		{
+			if (buffer == nullptr)
+				return error_codes::SHM_INVALID_ARGUMENT;
+
+			if (m_mode != shared_memory::access_mode::WRITER)
+				return error_codes::SHM_PERMISSION_DENIED;
+
+			utils::ref_count_ptr<shm_sharable_bufferpool> pool;
+			if (query_pool(pool_index, &pool) == false)
+				return error_codes::SHM_POOL_DOES_NOT_EXIST;
+
+			return pool->wait_for_buffer_unique(timeout, buffer);
+		}
+
+		// The same backpressure for writers which pick their buffers themselves: retries 'acquire' as the readers release buffers
+		template <typename ACQUIRE>
+		error_codes wait_for_release(uint32_t pool_index, int64_t timeout, ACQUIRE acquire)
+		{
+			if (m_mode != shared_memory::access_mode::WRITER)
+				return error_codes::SHM_PERMISSION_DENIED;
+
+			utils::ref_count_ptr<shm_sharable_bufferpool> pool;
+			if (query_pool(pool_index, &pool) == false)
+				return error_codes::SHM_POOL_DOES_NOT_EXIST;
+
+			return pool->wait_for_release(timeout, acquire);
+		}
+
 		error_codes query_buffer_shared(uint32_t pool_index, uint32_t buffer_index, core::buffer_interface** buffer)
 		{
 			if (buffer == nullptr)
@@ -1320,6 +2154,48 @@ namespace shared_memory
 			return error_codes::SHM_NO_ERROR;
 		}
 
+		error_codes attach_reader(uint32_t pool_index, reader_policy policy, uint32_t max_lag, shm_pool_reader** reader)
+		{
+			if (reader == nullptr)
+				return error_codes::SHM_INVALID_ARGUMENT;
+
+			utils::ref_count_ptr<shm_sharable_bufferpool> pool;
+			if (query_pool(pool_index, &pool) == false)
+				return error_codes::SHM_POOL_DOES_NOT_EXIST;
+
+			uint32_t attached;
+			error_codes error = pool->attach_reader(policy, max_lag, attached);
+			if (error != error_codes::SHM_NO_ERROR)
+				return error;
+
+			utils::ref_count_ptr<shm_pool_reader> instance;
+			try
+			{
+				instance = utils::make_ref_count_ptr<shm_pool_reader>(pool, attached);
+			}
+			catch (...)
+			{
+				pool->detach_reader(attached);
+				return error_codes::SHM_LOCK_SHARED_FAILED;
+			}
+
+			*reader = instance;
+			(*reader)->add_ref();
+			return error_codes::SHM_NO_ERROR;
+		}
+
+		error_codes query_readers(uint32_t pool_index, std::vector<reader_statistics>& readers)
+		{
+			utils::ref_count_ptr<shm_sharable_bufferpool> pool;
+			if (query_pool(pool_index, &pool) == false)
+				return error_codes::SHM_POOL_DOES_NOT_EXIST;
+
+			if (pool->query_readers(readers) == false)
+				return error_codes::SHM_PERMISSION_DENIED;
+
+			return error_codes::SHM_NO_ERROR;
+		}
+
 		error_codes publish(shm_sharable_buffer_interface* buffer)
 		{
 			if (buffer == nullptr)
@@ -1339,17 +2215,43 @@ namespace shared_memory
 	private:
 		utils::ref_count_ptr<shm_session> m_session;
 		uint32_t m_pool_index;
+		reader_policy m_policy;
+		uint32_t m_max_lag;
 
 		std::mutex m_mutex;
 		std::atomic<bool> m_running;
 		std::thread m_listening_thread;
 
+		std::mutex m_reader_mutex;
+		utils::ref_count_ptr<shm_pool_reader> m_reader; // LOCK_FREE pools only
+
+		error_codes wait_for_buffer(int64_t timeout, core::buffer_interface** buffer)
+		{
+			utils::ref_count_ptr<shm_pool_reader> reader;
+			{
+				std::lock_guard<std::mutex> locker(m_reader_mutex);
+				if (m_reader == nullptr)
+					m_session->attach_reader(m_pool_index, m_policy, m_max_lag, &m_reader);
+
+				reader = m_reader;
+			}
+
+			// The pools without a frame ring have no reader cursor, their latest buffer is waited for
+			if (reader == nullptr)
+				return m_session->wait_for_buffer_share(m_pool_index, timeout, buffer);
+
+			return reader->read(timeout, buffer);
+		}
+
 	public:
 		utils::signal<shm_session_player, uint32_t, core::buffer_interface*> OnBuffer;
 
-		shm_session_player(shared_memory::shm_session* session, uint32_t pool_index) :
+		// The buffers of a LOCK_FREE pool are read with 'policy', 'max_lag' applies to BOUNDED_LAG
+		shm_session_player(shared_memory::shm_session* session, uint32_t pool_index, reader_policy policy = reader_policy::LATEST_ONLY, uint32_t max_lag = 0) :
 			m_session(session),
 			m_pool_index(pool_index),
+			m_policy(policy),
+			m_max_lag(max_lag),
 			m_running(false)
 
 		{
@@ -1376,7 +2278,7 @@ namespace shared_memory
 					error_codes error = error_codes::SHM_TIMEOUT;
 					for (int64_t i = 0; i < ITERATIONS; i++)
 					{
-						error = m_session->wait_for_buffer_share(m_pool_index, MAX_BLOCKING_TIME_MS, &buffer);
+						error = wait_for_buffer(MAX_BLOCKING_TIME_MS, &buffer);
 						if (m_running == false ||
 							error == error_codes::SHM_NO_ERROR ||
 							error != error_codes::SHM_TIMEOUT)
@@ -1402,6 +2304,11 @@ namespace shared_memory
 						if (m_running == false)
 							break;
 
+						{
+							std::lock_guard<std::mutex> locker(m_reader_mutex);
+							m_reader.release();
+						}
+
 						m_session->remap();
 						continue;
 					}
@@ -1421,6 +2328,19 @@ namespace shared_memory
 				if (m_listening_thread.joinable())
 					m_listening_thread.join();
 			}
+
+			std::lock_guard<std::mutex> reader_locker(m_reader_mutex);
+			m_reader.release();
+		}
+
+		// The statistics of the player's reader, while reading a LOCK_FREE pool
+		bool query_statistics(reader_statistics& statistics)
+		{
+			std::lock_guard<std::mutex> locker(m_reader_mutex);
+			if (m_reader == nullptr)
+				return false;
+
+			return m_reader->query_statistics(statistics);
 		}
 	};
 }
@@ -0,0 +1,170 @@
+// AccessorBenchmark.cpp : Compares the per field read cost of the name based lookups against compiled accessors.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+#include "benchmark.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace Parsers;
+
+static constexpr size_t ITERATIONS = 1000000;
+static constexpr size_t SENSORS_COUNT = 8;
+static constexpr size_t VALUES_COUNT = 16;
+static constexpr size_t SENSOR_INDEX = 3;
+static constexpr size_t VALUE_INDEX = 5;
+static constexpr size_t SAMPLES_COUNT = 1024;
+
+template <typename FUNC>
+double measure(const char* title, FUNC read)
+{
+	double ns_per_read = samples::measure_reads_ns(ITERATIONS, read);
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n%-45s %10.1f ns/read", title, ns_per_read);
+	return ns_per_read;
+}
+
+int main()
+{
+	BinaryMetaDataBuilder sensor = BinaryMetaDataBuilder::Create(true);
+	sensor.Simple<uint16_t>("id").
+		Simple<float>("temp").
+		Bits<uint8_t>("valid", 1).
+		Bits<uint8_t>("mode", 3);
+
+	BinaryMetaDataBuilder header = BinaryMetaDataBuilder::Create(true);
+	header.Simple<uint32_t>("seq").
+		Array("sensors", SENSORS_COUNT, sensor);
+
+	BinaryMetaDataBuilder message = BinaryMetaDataBuilder::Create(true);
+	message.Complex("header", header).
+		Simple<int32_t>("counter").
+		Array<int32_t>("values", VALUES_COUNT).
+		Array<float>("samples", SAMPLES_COUNT);
+
+	// Random big endian message
+	std::vector<uint8_t> data(message.Size());
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> distribution(0, 255);
+	for (uint8_t& byte : data)
+		byte = static_cast<uint8_t>(distribution(generator));
+
+	BinaryParser parser = message.CreateParser();
+	parser.Parse(data.data(), data.size());
+	core::parsers::binary_parser_interface* core_parser = static_cast<core::parsers::binary_parser_interface*>(parser);
+
+	BinaryAccessor counter = message.CompileAccessor("counter");
+	BinaryAccessor temp = message.CompileAccessor("header.sensors[3].temp");
+	BinaryAccessor mode = message.CompileAccessor("header.sensors[3].mode");
+	BinaryAccessor value = message.CompileAccessor("values[5]");
+
+	// The compiled accessors read the same values as the name based lookups
+	BinaryParser sensor_parser = parser.ReadComplex("header").ReadComplexArrayAt("sensors", SENSOR_INDEX);
+	core::types::type_enum type;
+	int32_t array_value = 0;
+	core_parser->read_at("values", &array_value, sizeof(array_value), type, VALUE_INDEX);
+	bool same =
+		parser.Read<int32_t>("counter") == parser.Read<int32_t>(counter) &&
+		parser.Read<int32_t>("counter") == utils::parsers::read_accessor<int32_t>(counter, data.data()) &&
+		array_value == utils::parsers::read_accessor<int32_t>(value, data.data()) &&
+		sensor_parser.Read<float>("temp") == parser.Read<float>(temp) &&
+		sensor_parser.Read<float>("temp") == utils::parsers::read_accessor<float>(temp, data.data()) &&
+		sensor_parser.Read<uint8_t>("mode") == parser.Read<uint8_t>(mode) &&
+		sensor_parser.Read<uint8_t>("mode") == utils::parsers::read_accessor<uint8_t>(mode, data.data());
+
+	// A normalized copy of the message is read by plain loads
+	EndianPlan plan(message);
+	std::vector<uint8_t> normalized(data.size());
+	plan.normalize(data.data(), normalized.data(), data.size());
+	BinaryAccessor native_temp = EndianPlan::normalized(temp);
+	BinaryAccessor native_mode = EndianPlan::normalized(mode);
+	BinaryAccessor native_value = EndianPlan::normalized(value);
+	same = same &&
+		utils::parsers::read_accessor<float>(native_temp, normalized.data()) == parser.Read<float>(temp) &&
+		utils::parsers::read_accessor<uint8_t>(native_mode, normalized.data()) == parser.Read<uint8_t>(mode) &&
+		utils::parsers::read_accessor<int32_t>(native_value, normalized.data()) == array_value;
+
+	Core::Console::ColorPrint(same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\ncompiled accessors %s the name based reads\n", same ? "match" : "DO NOT match");
+
+	measure("top level field, read_simple by name", [&]()
+	{
+		int32_t val = 0;
+		core_parser->read_simple("counter", &val, sizeof(val), type);
+		return val;
+	});
+
+	measure("top level field, read_compiled", [&]()
+	{
+		int32_t val = 0;
+		core_parser->read_compiled(counter, &val, sizeof(val));
+		return val;
+	});
+
+	measure("top level field, raw buffer accessor", [&]()
+	{
+		return utils::parsers::read_accessor<int32_t>(counter, data.data());
+	});
+
+	measure("array element, read_at by name", [&]()
+	{
+		int32_t val = 0;
+		core_parser->read_at("values", &val, sizeof(val), type, VALUE_INDEX);
+		return val;
+	});
+
+	measure("array element, raw buffer accessor", [&]()
+	{
+		return utils::parsers::read_accessor<int32_t>(value, data.data());
+	});
+
+	measure("nested field, read_complex/read_complex_at/read", [&]()
+	{
+		utils::ref_count_ptr<core::parsers::binary_parser_interface> header_parser;
+		utils::ref_count_ptr<core::parsers::binary_parser_interface> element_parser;
+		float val = 0;
+		if (core_parser->read_complex("header", &header_parser) &&
+			header_parser->read_complex_at("sensors", &element_parser, SENSOR_INDEX))
+			element_parser->read_simple("temp", &val, sizeof(val), type);
+		return val;
+	});
+
+	measure("nested field, read_compiled", [&]()
+	{
+		float val = 0;
+		core_parser->read_compiled(temp, &val, sizeof(val));
+		return val;
+	});
+
+	measure("nested field, raw buffer accessor", [&]()
+	{
+		return utils::parsers::read_accessor<float>(temp, data.data());
+	});
+
+	measure("nested bits, raw buffer accessor", [&]()
+	{
+		return utils::parsers::read_accessor<uint8_t>(mode, data.data());
+	});
+
+	measure("normalize whole message", [&]()
+	{
+		plan.normalize(data.data(), normalized.data(), data.size());
+		return normalized[0];
+	});
+
+	measure("samples array, read_at by name (per element)", [&]()
+	{
+		float val = 0;
+		core_parser->read_at("samples", &val, sizeof(val), type, SAMPLES_COUNT / 2);
+		return val;
+	});
+
+	measure("nested field, normalized buffer accessor", [&]()
+	{
+		return utils::parsers::read_accessor<float>(native_temp, normalized.data());
+	});
+
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n%u bytes message, %u regions to convert\n",
+		static_cast<unsigned>(data.size()), static_cast<unsigned>(plan.regions().size()));
+	return same ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// BatchParsing.cpp : Extracts fields of a capture of homogeneous records into columns with a BatchReader and compares it
+// with parsing the records one by one.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+#include "benchmark.hpp"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace Parsers;
+
+static constexpr size_t RECORDS_COUNT = 100000;
+static constexpr size_t ITERATIONS = 20;
+// Every record of the capture is preceded by a capture header
+static constexpr size_t CAPTURE_HEADER_SIZE = 8;
+
+template <typename FUNC>
+double measure(const char* title, size_t bytes, FUNC read)
+{
+	double ns_per_pass = samples::measure_reads_ns(ITERATIONS, read);
+	double ns_per_record = ns_per_pass / RECORDS_COUNT;
+	double gb_per_second = static_cast<double>(bytes) / ns_per_pass;
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n%-45s %8.2f ns/record %8.2f GB/s", title, ns_per_record, gb_per_second);
+	return ns_per_record;
+}
+
+int main()
+{
+	BinaryMetaDataBuilder header = BinaryMetaDataBuilder::Create(true);
+	header.Simple<uint32_t>("seq").
+		Simple<double>("time");
+
+	BinaryMetaDataBuilder record = BinaryMetaDataBuilder::Create(true);
+	record.Complex("header", header).
+		Simple<uint16_t>("id").
+		Simple<float>("gain").
+		Bits<uint8_t>("valid", 1).
+		Bits<uint8_t>("mode", 3).
+		Simple<int64_t>("counter").
+		Array<int16_t>("samples", 4);
+
+	// Random big endian capture
+	size_t stride = CAPTURE_HEADER_SIZE + record.Size();
+	std::vector<uint8_t> capture(stride * RECORDS_COUNT);
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> distribution(0, 255);
+	for (uint8_t& byte : capture)
+		byte = static_cast<uint8_t>(distribution(generator));
+
+	const uint8_t* records = capture.data() + CAPTURE_HEADER_SIZE;
+	size_t records_size = capture.size() - CAPTURE_HEADER_SIZE;
+
+	BatchReader reader(record);
+	reader.add("header.seq");
+	reader.add("header.time");
+	reader.add("id");
+	reader.add("gain");
+	reader.add("mode");
+	reader.add("counter");
+	reader.add("samples[2]");
+
+	std::vector<uint32_t> seq(RECORDS_COUNT);
+	std::vector<double> time(RECORDS_COUNT);
+	std::vector<uint16_t> id(RECORDS_COUNT);
+	std::vector<float> gain(RECORDS_COUNT);
+	std::vector<uint8_t> mode(RECORDS_COUNT);
+	std::vector<int64_t> counter(RECORDS_COUNT);
+	std::vector<int16_t> sample(RECORDS_COUNT);
+	void* const columns[] = { seq.data(), time.data(), id.data(), gain.data(), mode.data(), counter.data(), sample.data() };
+
+	// The columns hold the values the parser reads from every record
+	bool same = reader.read(records, records_size, stride, RECORDS_COUNT, columns);
+	BinaryParser parser = record.CreateParser();
+	BinaryAccessor accessors[] = {
+		record.CompileAccessor("header.seq"), record.CompileAccessor("header.time"), record.CompileAccessor("id"),
+		record.CompileAccessor("gain"), record.CompileAccessor("mode"), record.CompileAccessor("counter"),
+		record.CompileAccessor("samples[2]") };
+
+	for (size_t i = 0; i < RECORDS_COUNT && same; i++)
+	{
+		parser.Parse(records + i * stride, record.Size());
+		uint32_t parsed_seq = parser.Read<uint32_t>(accessors[0]);
+		double parsed_time = parser.Read<double>(accessors[1]);
+		float parsed_gain = parser.Read<float>(accessors[3]);
+		int64_t parsed_counter = parser.Read<int64_t>(accessors[5]);
+		same = parsed_seq == seq[i] &&
+			std::memcmp(&parsed_time, &time[i], sizeof(double)) == 0 &&
+			parser.Read<uint16_t>(accessors[2]) == id[i] &&
+			std::memcmp(&parsed_gain, &gain[i], sizeof(float)) == 0 &&
+			parser.Read<uint8_t>(accessors[4]) == mode[i] &&
+			parsed_counter == counter[i] &&
+			parser.Read<int16_t>(accessors[6]) == sample[i];
+	}
+
+	// A buffer shorter than the batch is rejected
+	same = same && false == reader.read(records, records_size - 1, stride, RECORDS_COUNT, columns);
+
+	Core::Console::ColorPrint(same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\nbatch columns %s the parsed records\n", same ? "match" : "DO NOT match");
+
+	measure("parse every record, compiled accessors", capture.size(), [&]()
+	{
+		double sum = 0;
+		for (size_t i = 0; i < RECORDS_COUNT; i++)
+		{
+			parser.Parse(records + i * stride, record.Size());
+			sum += parser.Read<float>(accessors[3]) + parser.Read<uint8_t>(accessors[4]) + static_cast<double>(parser.Read<int64_t>(accessors[5]));
+		}
+
+		return sum;
+	});
+
+	measure("raw buffer accessors per record", capture.size(), [&]()
+	{
+		double sum = 0;
+		for (size_t i = 0; i < RECORDS_COUNT; i++)
+		{
+			const uint8_t* current = records + i * stride;
+			sum += utils::parsers::read_accessor<float>(accessors[3], current) +
+				utils::parsers::read_accessor<uint8_t>(accessors[4], current) +
+				static_cast<double>(utils::parsers::read_accessor<int64_t>(accessors[5], current));
+		}
+
+		return sum;
+	});
+
+	measure("batch reader, 3 columns", capture.size(), [&]()
+	{
+		reader.read_column(3, records, records_size, stride, RECORDS_COUNT, gain.data());
+		reader.read_column(4, records, records_size, stride, RECORDS_COUNT, mode.data());
+		reader.read_column(5, records, records_size, stride, RECORDS_COUNT, counter.data());
+		return gain[RECORDS_COUNT / 2] + mode[RECORDS_COUNT / 2] + static_cast<double>(counter[RECORDS_COUNT / 2]);
+	});
+
+	measure("batch reader, all 7 columns", capture.size(), [&]()
+	{
+		reader.read(records, records_size, stride, RECORDS_COUNT, columns);
+		return gain[RECORDS_COUNT / 2];
+	});
+
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n%u records of %u bytes, stride %u\n",
+		static_cast<unsigned>(RECORDS_COUNT), static_cast<unsigned>(record.Size()), static_cast<unsigned>(stride));
+	return same ? 0 : 1;
+}
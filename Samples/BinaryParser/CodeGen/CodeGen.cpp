@@ -0,0 +1,609 @@
+// CodeGen.cpp : Generates packed C++ structs from binary parser metadata - JSON schema files (BinaryMetaData::ToJson)
+// or data set XML files (Database::Schema). The structs have constexpr offsets, endian aware accessors and bits helpers,
+// and validate themselves against the runtime metadata (see utils/binary_struct.hpp and cmake_includes/binary_parser_codegen.cmake).
+//
+// Usage: BinaryParserCodeGen --output <header> [--namespace <namespace>] [--xml] <metadata files...>
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using MetadataPtr = utils::ref_count_ptr<core::parsers::binary_metadata_interface>;
+using NodePtr = utils::ref_count_ptr<core::parsers::binary_node_interface>;
+
+static std::string Identifier(const std::string& name)
+{
+	static const std::set<std::string> reserved = {
+		"alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "class", "const", "constexpr",
+		"continue", "decltype", "default", "delete", "do", "double", "else", "enum", "explicit", "export", "extern", "false",
+		"float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not",
+		"nullptr", "operator", "or", "private", "protected", "public", "register", "return", "short", "signed", "sizeof",
+		"static", "struct", "switch", "template", "this", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+		"unsigned", "using", "virtual", "void", "volatile", "while", "xor",
+		// The members every generated struct declares
+		"offsets", "counts", "SIZE", "schema_name", "validate_schema" };
+
+	std::string identifier;
+	for (char c : name)
+		identifier += (std::isalnum(static_cast<unsigned char>(c)) != 0) ? c : '_';
+
+	if (identifier.empty() || std::isdigit(static_cast<unsigned char>(identifier[0])) != 0)
+		identifier = "_" + identifier;
+
+	if (reserved.count(identifier) > 0)
+		identifier += "_";
+
+	return identifier;
+}
+
+// The C++ type of a simple or enum value, null when the size does not match a C++ type
+static const char* ValueType(core::types::type_enum type, size_t size)
+{
+	switch (type)
+	{
+	case core::types::type_enum::BOOL:
+		return size == sizeof(bool) ? "bool" : nullptr;
+	case core::types::type_enum::UINT8:
+	case core::types::type_enum::BYTE:
+		return size == 1 ? "uint8_t" : nullptr;
+	case core::types::type_enum::INT8:
+	case core::types::type_enum::CHAR:
+		return size == 1 ? "int8_t" : nullptr;
+	case core::types::type_enum::UINT16:
+	case core::types::type_enum::USHORT:
+		return size == 2 ? "uint16_t" : nullptr;
+	case core::types::type_enum::INT16:
+	case core::types::type_enum::SHORT:
+		return size == 2 ? "int16_t" : nullptr;
+	case core::types::type_enum::UINT32:
+		return size == 4 ? "uint32_t" : nullptr;
+	case core::types::type_enum::INT32:
+		return size == 4 ? "int32_t" : nullptr;
+	case core::types::type_enum::UINT64:
+		return size == 8 ? "uint64_t" : nullptr;
+	case core::types::type_enum::INT64:
+		return size == 8 ? "int64_t" : nullptr;
+	case core::types::type_enum::FLOAT:
+		return size == sizeof(float) ? "float" : nullptr;
+	case core::types::type_enum::DOUBLE:
+		return size == sizeof(double) ? "double" : nullptr;
+	case core::types::type_enum::ENUM:
+		switch (size)
+		{
+		case 1: return "int8_t";
+		case 2: return "int16_t";
+		case 4: return "int32_t";
+		case 8: return "int64_t";
+		default: return nullptr;
+		}
+	default:
+		return nullptr;
+	}
+}
+
+static const char* BitsType(size_t size)
+{
+	switch (size)
+	{
+	case 1: return "uint8_t";
+	case 2: return "uint16_t";
+	case 4: return "uint32_t";
+	default: return "uint64_t";
+	}
+}
+
+static const char* TypeEnumName(core::types::type_enum type)
+{
+	switch (type)
+	{
+	case core::types::type_enum::UNKNOWN: return "UNKNOWN";
+	case core::types::type_enum::BYTE: return "BYTE";
+	case core::types::type_enum::SHORT: return "SHORT";
+	case core::types::type_enum::INT32: return "INT32";
+	case core::types::type_enum::FLOAT: return "FLOAT";
+	case core::types::type_enum::COMPLEX: return "COMPLEX";
+	case core::types::type_enum::EMPTY_TYPE: return "EMPTY_TYPE";
+	case core::types::type_enum::BOOL: return "BOOL";
+	case core::types::type_enum::DOUBLE: return "DOUBLE";
+	case core::types::type_enum::STRING: return "STRING";
+	case core::types::type_enum::BUFFER: return "BUFFER";
+	case core::types::type_enum::POINTER: return "POINTER";
+	case core::types::type_enum::BITMAP: return "BITMAP";
+	case core::types::type_enum::UINT8: return "UINT8";
+	case core::types::type_enum::UINT16: return "UINT16";
+	case core::types::type_enum::UINT32: return "UINT32";
+	case core::types::type_enum::UINT64: return "UINT64";
+	case core::types::type_enum::INT8: return "INT8";
+	case core::types::type_enum::INT16: return "INT16";
+	case core::types::type_enum::CHAR: return "CHAR";
+	case core::types::type_enum::USHORT: return "USHORT";
+	case core::types::type_enum::INT64: return "INT64";
+	case core::types::type_enum::ENUM: return "ENUM";
+	case core::types::type_enum::ARRAY: return "ARRAY";
+	default: throw std::runtime_error("Unsupported node type");
+	}
+}
+
+/// Emits the structs of metadata, nested metadata first. Metadata with the same name and layout share a struct.
+class StructGenerator
+{
+private:
+	std::ostringstream m_structs;
+	std::map<const void*, std::string> m_generated;
+	std::map<const void*, std::string> m_schema_names; // Names given by the sources, metadata loaded from JSON have none
+	std::map<std::string, std::string> m_layouts;
+	std::vector<std::string> m_roots;
+
+	struct Field
+	{
+		NodePtr node;
+		NodePtr element; //arrays
+		std::string id;
+		std::string nested; //the struct of a complex node or of complex elements
+		core::parsers::binary_accessor accessor; //simple, enum, bits, string and buffer nodes or elements
+	};
+
+	std::string UniqueName(const core::parsers::binary_metadata_interface* metadata, const std::string& fallback)
+	{
+		std::string schema_name = SchemaName(metadata);
+		std::string base = Identifier(schema_name.empty() ? fallback : schema_name);
+		std::string layout = metadata->to_json(true);
+		std::string name = base;
+		for (size_t i = 2; ; i++)
+		{
+			auto it = m_layouts.find(name);
+			if (it == m_layouts.end())
+			{
+				m_layouts.emplace(name, layout);
+				return name;
+			}
+
+			if (it->second == layout)
+				return name;
+
+			name = base + "_" + std::to_string(i);
+		}
+	}
+
+	static std::string Swap(const core::parsers::binary_node_interface* node)
+	{
+		return node->big_endian() ? "utils::parsers::field_swap(true)" : "utils::parsers::field_swap(false)";
+	}
+
+	static MetadataPtr Nested(const core::parsers::binary_node_interface* node)
+	{
+		MetadataPtr nested;
+		if (false == node->nested(&nested) || nested == nullptr)
+			throw std::runtime_error(std::string("Missing nested metadata of ") + node->name());
+
+		return nested;
+	}
+
+	void EmitMember(std::ostream& out, const Field& field, size_t& offset, const std::map<size_t, size_t>& bit_blocks)
+	{
+		const core::parsers::binary_node_interface* node = field.node;
+		if (node->type() == core::types::type_enum::BITMAP && node->offset() < offset)
+			return; //in the block of a previous field
+
+		if (node->offset() > offset)
+		{
+			out << "\t\tuint8_t m_padding_" << offset << "[" << node->offset() - offset << "];\n";
+			offset = node->offset();
+		}
+		else if (node->offset() < offset)
+			throw std::runtime_error(std::string("Overlapping field ") + node->name());
+
+		size_t size = node->size();
+		switch (node->type())
+		{
+		case core::types::type_enum::BITMAP:
+			size = bit_blocks.at(node->offset());
+			out << "\t\tuint8_t m_bits_" << node->offset() << "[" << size << "];\n";
+			break;
+		case core::types::type_enum::COMPLEX:
+			out << "\t\t" << field.nested << " m_" << field.id << ";\n";
+			break;
+		case core::types::type_enum::STRING:
+			out << "\t\tchar m_" << field.id << "[" << size << "];\n";
+			break;
+		case core::types::type_enum::ARRAY:
+		{
+			const core::parsers::binary_node_interface* element = field.element;
+			const char* type = ValueType(element->type(), element->size());
+			if (element->type() == core::types::type_enum::COMPLEX)
+				out << "\t\t" << field.nested << " m_" << field.id << "[" << node->count() << "];\n";
+			else if (element->type() == core::types::type_enum::STRING)
+				out << "\t\tchar m_" << field.id << "[" << node->count() << "][" << element->size() << "];\n";
+			else if (type != nullptr)
+				out << "\t\t" << type << " m_" << field.id << "[" << node->count() << "];\n";
+			else
+				out << "\t\tuint8_t m_" << field.id << "[" << node->count() << "][" << element->size() << "];\n";
+
+			size = element->size() * node->count();
+			break;
+		}
+		default:
+		{
+			const char* type = ValueType(node->type(), size);
+			if (type != nullptr)
+				out << "\t\t" << type << " m_" << field.id << ";\n";
+			else
+				out << "\t\tuint8_t m_" << field.id << "[" << size << "];\n";
+			break;
+		}
+		}
+
+		offset += size;
+	}
+
+	void EmitAccessors(std::ostream& out, const Field& field)
+	{
+		const core::parsers::binary_node_interface* node = field.node;
+		const std::string& id = field.id;
+		out << "\n\t\t/// " << node->name() << "\n";
+		switch (node->type())
+		{
+		case core::types::type_enum::BITMAP:
+		{
+			const char* type = BitsType(node->size());
+			std::ostringstream args;
+			args << "m_bits_" << node->offset() << ", " << node->size() << ", 0x" << std::hex << field.accessor.mask << std::dec << "ULL, "
+				<< static_cast<unsigned>(field.accessor.bit_offset) << ", " << Swap(node);
+			out << "\t\t" << type << " " << id << "() const { return utils::parsers::load_bits<" << type << ">(" << args.str() << "); }\n";
+			out << "\t\tvoid " << id << "(" << type << " val) { utils::parsers::store_bits<" << type << ">(" << args.str() << ", val); }\n";
+			break;
+		}
+		case core::types::type_enum::COMPLEX:
+			out << "\t\tconst " << field.nested << "& " << id << "() const { return m_" << id << "; }\n";
+			out << "\t\t" << field.nested << "& " << id << "() { return m_" << id << "; }\n";
+			break;
+		case core::types::type_enum::STRING:
+			out << "\t\tstd::string " << id << "() const { return utils::parsers::load_string(m_" << id << ", sizeof(m_" << id << "), " << Swap(node) << "); }\n";
+			out << "\t\tvoid " << id << "(const char* val) { utils::parsers::store_string(m_" << id << ", sizeof(m_" << id << "), " << Swap(node) << ", val); }\n";
+			break;
+		case core::types::type_enum::ARRAY:
+		{
+			const core::parsers::binary_node_interface* element = field.element;
+			const char* type = ValueType(element->type(), element->size());
+			std::string item = "m_" + id + "[index]";
+			if (element->type() == core::types::type_enum::COMPLEX)
+			{
+				out << "\t\tconst " << field.nested << "& " << id << "(size_t index) const { return " << item << "; }\n";
+				out << "\t\t" << field.nested << "& " << id << "(size_t index) { return " << item << "; }\n";
+			}
+			else if (element->type() == core::types::type_enum::STRING)
+			{
+				out << "\t\tstd::string " << id << "(size_t index) const { return utils::parsers::load_string(" << item << ", sizeof(" << item << "), " << Swap(element) << "); }\n";
+				out << "\t\tvoid " << id << "(size_t index, const char* val) { utils::parsers::store_string(" << item << ", sizeof(" << item << "), " << Swap(element) << ", val); }\n";
+			}
+			else if (type != nullptr)
+			{
+				out << "\t\t" << type << " " << id << "(size_t index) const { return utils::parsers::load_field<" << type << ">(&" << item << ", " << Swap(element) << "); }\n";
+				out << "\t\tvoid " << id << "(size_t index, " << type << " val) { utils::parsers::store_field<" << type << ">(&" << item << ", val, " << Swap(element) << "); }\n";
+			}
+			else
+			{
+				out << "\t\tstd::vector<uint8_t> " << id << "(size_t index) const { return utils::parsers::load_buffer(" << item << ", sizeof(" << item << "), " << Swap(element) << "); }\n";
+				out << "\t\tvoid " << id << "(size_t index, const std::vector<uint8_t>& val) { utils::parsers::store_buffer(" << item << ", sizeof(" << item << "), " << Swap(element) << ", val); }\n";
+			}
+			break;
+		}
+		default:
+		{
+			const char* type = ValueType(node->type(), node->size());
+			if (type != nullptr)
+			{
+				out << "\t\t" << type << " " << id << "() const { return utils::parsers::load_field<" << type << ">(&m_" << id << ", " << Swap(node) << "); }\n";
+				out << "\t\tvoid " << id << "(" << type << " val) { utils::parsers::store_field<" << type << ">(&m_" << id << ", val, " << Swap(node) << "); }\n";
+			}
+			else
+			{
+				out << "\t\tstd::vector<uint8_t> " << id << "() const { return utils::parsers::load_buffer(m_" << id << ", sizeof(m_" << id << "), " << Swap(node) << "); }\n";
+				out << "\t\tvoid " << id << "(const std::vector<uint8_t>& val) { utils::parsers::store_buffer(m_" << id << ", sizeof(m_" << id << "), " << Swap(node) << ", val); }\n";
+			}
+			break;
+		}
+		}
+	}
+
+	void EmitField(std::ostream& out, const Field& field)
+	{
+		const core::parsers::binary_node_interface* node = field.node;
+		const core::parsers::binary_node_interface* leaf = (field.element != nullptr) ? field.element : field.node;
+		bool nested = (leaf->type() == core::types::type_enum::COMPLEX);
+		out << "\t\t\t\t{ \"" << node->name() << "\", core::types::type_enum::" << TypeEnumName(node->type())
+			<< ", " << node->offset() << ", " << node->size() << ", " << node->count()
+			<< ", core::types::type_enum::" << TypeEnumName(field.element != nullptr ? field.element->type() : core::types::type_enum::UNKNOWN)
+			<< ", " << (nested ? "false" : Swap(leaf))
+			<< ", 0x" << std::hex << field.accessor.mask << std::dec << "ULL, " << static_cast<unsigned>(field.accessor.bit_offset)
+			<< ", " << (nested ? "&" + field.nested + "::validate_schema" : std::string("nullptr")) << " },\n";
+	}
+
+	std::string SchemaName(const core::parsers::binary_metadata_interface* metadata) const
+	{
+		auto it = m_schema_names.find(metadata);
+		return (it != m_schema_names.end()) ? it->second : std::string(metadata->namely());
+	}
+
+public:
+	/// Names a metadata and its nested metadata after the schema_name of their JSON schema (BinaryMetaData::ToJson)
+	void NameSchemas(const core::parsers::binary_metadata_interface* metadata, const nlohmann::json& schema)
+	{
+		if (schema.count("schema_name") != 0 && schema.at("schema_name").is_string())
+			m_schema_names[metadata] = schema.at("schema_name").get<std::string>();
+
+		if (schema.count("data") == 0)
+			return;
+
+		for (const nlohmann::json& entry : schema.at("data"))
+		{
+			NodePtr node;
+			if (entry.count("data") == 0 || entry.count("name") == 0 ||
+				false == metadata->query_node(entry.at("name").get<std::string>().c_str(), &node))
+				continue;
+
+			// The schema of an array of complex elements is the one of its element
+			MetadataPtr nested = Nested(node);
+			if (node->type() == core::types::type_enum::ARRAY)
+			{
+				NodePtr element;
+				if (false == nested->query_node_by_index(0, &element))
+					continue;
+
+				nested = Nested(element);
+			}
+
+			NameSchemas(nested, entry.at("data"));
+		}
+	}
+
+	/// Generates the struct of a metadata and of its nested metadata
+	/// @return	The name of the struct.
+	std::string Generate(const core::parsers::binary_metadata_interface* metadata, const std::string& fallback, bool root)
+	{
+		auto generated = m_generated.find(metadata);
+		if (generated != m_generated.end())
+			return generated->second;
+
+		std::string name = UniqueName(metadata, fallback);
+		bool emitted = false;
+		for (const auto& entry : m_generated)
+			emitted = emitted || entry.second == name;
+
+		m_generated.emplace(metadata, name);
+		if (root && std::find(m_roots.begin(), m_roots.end(), name) == m_roots.end())
+			m_roots.push_back(name);
+
+		// A struct of the same layout was already emitted
+		if (emitted)
+			return name;
+
+		std::vector<Field> fields;
+		std::map<size_t, size_t> bit_blocks;
+		std::set<std::string> ids;
+		for (size_t i = 0; i < metadata->node_count(); i++)
+		{
+			Field field;
+			if (false == metadata->query_node_by_index(i, &field.node))
+				throw std::runtime_error("Failed to query node");
+
+			field.id = Identifier(field.node->name());
+			if (false == ids.insert(field.id).second)
+				throw std::runtime_error(name + ": duplicated field " + field.id);
+
+			const core::parsers::binary_node_interface* leaf = field.node;
+			std::string path = field.node->name();
+			if (field.node->type() == core::types::type_enum::ARRAY)
+			{
+				MetadataPtr array_metadata = Nested(field.node);
+				if (false == array_metadata->query_node_by_index(0, &field.element))
+					throw std::runtime_error(name + ": array without element " + field.id);
+
+				leaf = field.element;
+				path += "[0]";
+			}
+
+			if (leaf->type() == core::types::type_enum::COMPLEX)
+				field.nested = Generate(Nested(leaf), name + "_" + field.id, false);
+			else if (false == metadata->compile_accessor(path.c_str(), field.accessor))
+				throw std::runtime_error(name + ": failed to resolve " + path);
+
+			if (field.node->type() == core::types::type_enum::BITMAP)
+			{
+				size_t& block = bit_blocks[field.node->offset()];
+				block = (std::max)(block, field.node->size());
+			}
+
+			fields.push_back(field);
+		}
+
+		bool has_arrays = false;
+		std::ostringstream out;
+		out << "\t/// " << (SchemaName(metadata).empty() ? name : SchemaName(metadata)) << "\n";
+		out << "\tstruct " << name << "\n\t{\n";
+		out << "\t\tstatic constexpr size_t SIZE = " << metadata->size() << ";\n\n";
+		out << "\t\tstruct offsets\n\t\t{\n";
+		for (const Field& field : fields)
+		{
+			out << "\t\t\tstatic constexpr size_t " << field.id << " = " << field.node->offset() << ";\n";
+			has_arrays = has_arrays || field.node->type() == core::types::type_enum::ARRAY;
+		}
+		out << "\t\t};\n\n";
+
+		if (has_arrays)
+		{
+			out << "\t\tstruct counts\n\t\t{\n";
+			for (const Field& field : fields)
+			{
+				if (field.node->type() == core::types::type_enum::ARRAY)
+					out << "\t\t\tstatic constexpr size_t " << field.id << " = " << field.node->count() << ";\n";
+			}
+			out << "\t\t};\n\n";
+		}
+
+		size_t offset = 0;
+		for (const Field& field : fields)
+			EmitMember(out, field, offset, bit_blocks);
+
+		if (offset < metadata->size())
+			out << "\t\tuint8_t m_padding_" << offset << "[" << metadata->size() - offset << "];\n";
+
+		for (const Field& field : fields)
+			EmitAccessors(out, field);
+
+		out << "\n\t\tstatic const char* schema_name() { return \"" << SchemaName(metadata) << "\"; }\n";
+		out << "\n\t\t/// Validates the struct against the runtime metadata it was generated from\n";
+		out << "\t\tstatic bool validate_schema(const core::parsers::binary_metadata_interface* metadata)\n\t\t{\n";
+		if (fields.empty())
+			out << "\t\t\treturn utils::parsers::validate_generated(metadata, SIZE, nullptr, 0);\n";
+		else
+		{
+			out << "\t\t\tstatic const utils::parsers::generated_field fields[] =\n\t\t\t{\n";
+			for (const Field& field : fields)
+				EmitField(out, field);
+			out << "\t\t\t};\n\n";
+			out << "\t\t\treturn utils::parsers::validate_generated(metadata, SIZE, fields, sizeof(fields) / sizeof(fields[0]));\n";
+		}
+		out << "\t\t}\n";
+		out << "\t};\n\n";
+		out << "\tstatic_assert(sizeof(" << name << ") == " << name << "::SIZE, \"Unexpected size of " << name << "\");\n";
+		for (const Field& field : fields)
+		{
+			if (field.node->type() != core::types::type_enum::BITMAP)
+				out << "\tstatic_assert(offsetof(" << name << ", m_" << field.id << ") == " << name << "::offsets::" << field.id
+					<< ", \"Unexpected offset of " << name << "::" << field.id << "\");\n";
+		}
+		out << "\n";
+
+		m_structs << out.str();
+		return name;
+	}
+
+	void Write(std::ostream& out, const std::string& name_space, const std::vector<std::string>& sources) const
+	{
+		out << "// Generated by BinaryParserCodeGen from";
+		for (const std::string& source : sources)
+			out << " " << source.substr(source.find_last_of("/\\") + 1);
+		out << " - do not edit\n";
+		out << "#pragma once\n#include <utils/binary_struct.hpp>\n\n#include <cstddef>\n#include <cstdint>\n#include <string>\n#include <vector>\n\n";
+		out << "namespace " << name_space << "\n{\n";
+		out << "#pragma pack(push, 1)\n";
+		out << m_structs.str();
+		out << "#pragma pack(pop)\n\n";
+		out << "\t/// Validates the generated structs against the metadata registered by their names in a store\n";
+		out << "\t/// @return	True if every struct has its metadata in the store and matches it.\n";
+		out << "\tinline bool validate_schemas(core::parsers::binary_metadata_store_interface* store)\n\t{\n";
+		out << "\t\tif (store == nullptr)\n\t\t\treturn false;\n\n";
+		for (const std::string& root : m_roots)
+		{
+			out << "\t\t{\n\t\t\tutils::ref_count_ptr<core::parsers::binary_metadata_interface> metadata;\n";
+			out << "\t\t\tif (false == store->query_parser_metadata(" << root << "::schema_name(), &metadata) ||\n";
+			out << "\t\t\t\tfalse == " << root << "::validate_schema(metadata))\n\t\t\t\treturn false;\n\t\t}\n\n";
+		}
+		out << "\t\treturn true;\n\t}\n}\n";
+	}
+};
+
+static std::string ReadFile(const std::string& file_name)
+{
+	std::ifstream file(file_name, std::ios::binary);
+	if (false == file.is_open())
+		throw std::runtime_error("Failed to open " + file_name);
+
+	std::stringstream text;
+	text << file.rdbuf();
+	return text.str();
+}
+
+static void GenerateFromXml(StructGenerator& generator, const std::string& file_name)
+{
+	Database::DataSet dataset = Database::MemoryDatabase::Create("CodeGen");
+	if (false == Database::Schema::Load(dataset, file_name, false, false))
+		throw std::runtime_error("Failed to load the data set " + file_name);
+
+	for (Database::Table table : dataset)
+	{
+		for (Database::Row row : table)
+		{
+			Parsers::BinaryMetaData metadata = row.ParserMetadata();
+			if (false == metadata.Empty() && metadata.Namely()[0] != '\0')
+				generator.Generate(static_cast<core::parsers::binary_metadata_interface*>(metadata), metadata.Namely(), true);
+		}
+	}
+}
+
+static void GenerateFromJson(StructGenerator& generator, const std::string& file_name)
+{
+	std::string json = ReadFile(file_name);
+	Parsers::BinaryMetaDataBuilder metadata = Parsers::BinaryMetaDataBuilder::Create(json.c_str());
+	generator.NameSchemas(static_cast<core::parsers::binary_metadata_interface*>(metadata), nlohmann::json::parse(json));
+
+	std::string fallback = file_name.substr(file_name.find_last_of("/\\") + 1);
+	fallback = fallback.substr(0, fallback.find('.'));
+	generator.Generate(static_cast<core::parsers::binary_metadata_interface*>(metadata), fallback, true);
+}
+
+int main(int argc, char* argv[])
+{
+	std::string output;
+	std::string name_space = "generated";
+	bool xml = false;
+	std::vector<std::string> sources;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--output" && i + 1 < argc)
+			output = argv[++i];
+		else if (arg == "--namespace" && i + 1 < argc)
+			name_space = argv[++i];
+		else if (arg == "--xml")
+			xml = true;
+		else
+			sources.push_back(arg);
+	}
+
+	if (output.empty() || sources.empty())
+	{
+		std::cerr << "Usage: " << argv[0] << " --output <header> [--namespace <namespace>] [--xml] <metadata files...>\n";
+		return 2;
+	}
+
+	try
+	{
+		StructGenerator generator;
+		for (const std::string& source : sources)
+		{
+			if (xml)
+				GenerateFromXml(generator, source);
+			else
+				GenerateFromJson(generator, source);
+		}
+
+		std::ostringstream header;
+		generator.Write(header, name_space, sources);
+
+		std::ofstream file(output, std::ios::binary | std::ios::trunc);
+		file << header.str();
+		if (false == file.good())
+			throw std::runtime_error("Failed to write " + output);
+	}
+	catch (std::exception& e)
+	{
+		std::cerr << "BinaryParserCodeGen: " << e.what() << "\n";
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,41 @@
+// benchmark.hpp : Timing helpers shared by the binary parser samples.
+//
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+namespace samples
+{
+	// Prevents the compiler from dropping the measured reads
+	static volatile double g_sink = 0;
+
+	/// Runs a call the given number of times
+	/// @date	19/10/2026
+	/// @param	iterations	The number of calls.
+	/// @param	call	  	The measured call.
+	/// @return	The average duration of a call, in nanoseconds.
+	template <typename FUNC>
+	double measure_ns(size_t iterations, FUNC call)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; i++)
+			call();
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+	}
+
+	/// Runs a read the given number of times, its results are summed into g_sink so it is not optimized away
+	/// @date	19/10/2026
+	/// @param	iterations	The number of reads.
+	/// @param	read	  	The measured read.
+	/// @return	The average duration of a read, in nanoseconds.
+	template <typename FUNC>
+	double measure_reads_ns(size_t iterations, FUNC read)
+	{
+		return measure_ns(iterations, [&]()
+		{
+			g_sink = g_sink + read();
+		});
+	}
+}
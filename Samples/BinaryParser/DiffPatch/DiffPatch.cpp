@@ -0,0 +1,91 @@
+// DiffPatch.cpp : Replicates a row by patches of its changed fields with a BinaryDiff, checks the replica matches the row
+// and compares the size of the patches with sending the whole row.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace Parsers;
+
+static constexpr size_t UPDATES_COUNT = 100000;
+static constexpr size_t TARGETS_COUNT = 32;
+
+int main()
+{
+	BinaryMetaDataBuilder target = BinaryMetaDataBuilder::Create();
+	target.Simple<uint32_t>("id").
+		Simple<double>("range").
+		Simple<double>("azimuth").
+		Simple<float>("speed").
+		Bits<uint8_t>("tracked", 1).
+		Bits<uint8_t>("kind", 4).
+		Array<int16_t>("history", 4).
+		String("label", 16);
+
+	BinaryMetaDataBuilder row = BinaryMetaDataBuilder::Create();
+	row.Simple<uint64_t>("time").
+		Simple<uint32_t>("sequence").
+		Array("targets", TARGETS_COUNT, target).
+		Buffer("raw", 256);
+
+	BinaryDiff diff(row);
+	size_t size = row.Size();
+	std::vector<uint8_t> current(size, 0);
+	std::vector<uint8_t> previous(current);
+	std::vector<uint8_t> replica(current);
+	std::vector<uint8_t> patch(diff.max_patch_size());
+
+	// Every update moves the time and a few targets, now and then the raw buffer
+	std::mt19937 generator(3);
+	std::uniform_int_distribution<size_t> targets(0, TARGETS_COUNT - 1);
+	std::uniform_int_distribution<size_t> bytes(0, size - 1);
+	BinaryAccessor time = row.CompileAccessor("time");
+	size_t target_size = target.Size();
+	size_t targets_offset = row.QueryNode("targets").Offset();
+
+	bool same = true;
+	size_t patches_size = 0;
+	double diff_seconds = 0;
+	for (size_t i = 0; i < UPDATES_COUNT && same; i++)
+	{
+		previous = current;
+		uint64_t now = i;
+		std::memcpy(current.data() + time.offset, &now, sizeof(now));
+		for (size_t moved = 0; moved < 3; moved++)
+		{
+			uint8_t* moving = current.data() + targets_offset + targets(generator) * target_size;
+			moving[8] = static_cast<uint8_t>(generator());
+			moving[16] = static_cast<uint8_t>(generator());
+		}
+
+		if (i % 100 == 0)
+			current[bytes(generator)] = static_cast<uint8_t>(generator());
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		size_t patch_size = diff.diff(previous.data(), current.data(), size, patch.data(), patch.size());
+		diff_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		patches_size += patch_size;
+		same = patch_size != 0 &&
+			diff.apply(patch.data(), patch_size, replica.data(), size) &&
+			replica == current;
+	}
+
+	// A patch of a row is rejected by a row of another size and a truncated patch is rejected
+	size_t patch_size = diff.diff(previous.data(), current.data(), size, patch.data(), patch.size());
+	same = same &&
+		false == diff.apply(patch.data(), patch_size, replica.data(), size - 1) &&
+		false == diff.apply(patch.data(), patch_size - 1, replica.data(), size);
+
+	Core::Console::ColorPrint(false, true, same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\nreplica %s the row after %u patches\n", same ? "matches" : "DOES NOT match", static_cast<unsigned>(UPDATES_COUNT));
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\nrow of %u bytes, %u fields: average patch %.1f bytes, diff %.1f ns\n", static_cast<unsigned>(size),
+		static_cast<unsigned>(diff.fields().size()), static_cast<double>(patches_size) / UPDATES_COUNT,
+		diff_seconds * 1e9 / UPDATES_COUNT);
+	return same ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// FrozenMetadata.cpp : Compares node queries of a metadata from several threads before and after it is frozen,
+// and checks a frozen metadata rejects changes.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Parsers;
+
+static constexpr size_t FIELDS_COUNT = 64;
+static constexpr size_t ITERATIONS = 200000;
+static constexpr size_t THREADS_COUNT = 4;
+
+static std::string field_name(size_t index)
+{
+	return "field_" + std::to_string(index);
+}
+
+// Queries every field by name and by index from every thread
+static double measure(const char* title, core::parsers::binary_metadata_interface* metadata, const std::vector<std::string>& names)
+{
+	std::atomic<size_t> found(0);
+
+	// The threads run side by side, an iteration lasts the whole run divided by the iterations of a thread
+	double ns_per_query = samples::measure_ns(1, [&]()
+	{
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < THREADS_COUNT; t++)
+		{
+			threads.emplace_back([&, t]()
+			{
+				size_t local = 0;
+				for (size_t i = 0; i < ITERATIONS; i++)
+				{
+					size_t field = (i + t) % names.size();
+					utils::ref_count_ptr<core::parsers::binary_node_interface> by_name;
+					utils::ref_count_ptr<core::parsers::binary_node_interface> by_index;
+					if (metadata->query_node(names[field].c_str(), &by_name) &&
+						metadata->query_node_by_index(field, &by_index) &&
+						metadata->node_count() == names.size())
+						local += (by_name == by_index) ? 1 : 0;
+				}
+
+				found += local;
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+	}) / ITERATIONS;
+
+	Core::Console::ColorPrint(found == THREADS_COUNT * ITERATIONS ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+		"\n%-45s %10.1f ns/iteration (%u threads)", title, ns_per_query, static_cast<unsigned>(THREADS_COUNT));
+	return ns_per_query;
+}
+
+int main()
+{
+	BinaryMetaDataBuilder point = BinaryMetaDataBuilder::Create(true);
+	point.Simple<int32_t>("x").
+		Simple<int32_t>("y");
+
+	std::vector<std::string> names;
+	BinaryMetaDataBuilder message = BinaryMetaDataBuilder::Create(true);
+	for (size_t i = 0; i < FIELDS_COUNT; i++)
+	{
+		names.push_back(field_name(i));
+		if (i % 8 == 0)
+			message.Array(names.back().c_str(), 4, point);
+		else
+			message.Simple<uint32_t>(names.back().c_str());
+	}
+
+	core::parsers::binary_metadata_interface* core_metadata = static_cast<core::parsers::binary_metadata_interface*>(message);
+	measure("query nodes, building metadata", core_metadata, names);
+	std::string json = message.ToJson(true);
+
+	message.Freeze();
+	measure("query nodes, frozen metadata", core_metadata, names);
+
+	// A frozen metadata and its nested metadata keep their layout and reject changes
+	core::parsers::binary_metadata_builder_interface* builder = static_cast<core::parsers::binary_metadata_builder_interface*>(message);
+	size_t size = message.Size();
+	bool valid =
+		message.Frozen() &&
+		point.Frozen() &&
+		false == builder->put("late", sizeof(uint32_t), core::types::type_enum::UINT32, SimpleOptions()) &&
+		false == builder->namely("renamed") &&
+		false == static_cast<core::parsers::binary_metadata_builder_interface*>(point)->put("z", sizeof(int32_t), core::types::type_enum::INT32, SimpleOptions()) &&
+		message.Size() == size &&
+		message.NodeCount() == FIELDS_COUNT &&
+		json == message.ToJson(true);
+
+	// The queries of a frozen metadata are those of the built metadata
+	size_t index = 0;
+	valid = valid &&
+		core_metadata->get_index_by_name(field_name(17).c_str(), index) && index == 17 &&
+		false == core_metadata->get_index_by_name("missing", index) &&
+		message.CompileAccessor("field_8[2].y").offset == message.QueryNode("field_8").Offset() + 2 * point.Size() + sizeof(int32_t);
+
+	Core::Console::ColorPrint(valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nfrozen metadata %s\n", valid ? "is read-only and consistent" : "IS NOT read-only or consistent");
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// GeneratedStructs.cpp : Reads messages through the packed structs BinaryParserCodeGen generates from messages.json
+// and compares them with the dynamic parser of the same metadata.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <generated/messages.hpp>
+#include "benchmark.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Parsers;
+
+static constexpr size_t MESSAGES_COUNT = 1024;
+static constexpr size_t ITERATIONS = 200;
+
+template <typename T>
+static bool same(const T& lhs, const T& rhs)
+{
+	return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+template <typename FUNC>
+static double measure(const char* title, FUNC read)
+{
+	double ns_per_message = samples::measure_reads_ns(ITERATIONS, read) / MESSAGES_COUNT;
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n%-45s %10.1f ns/message", title, ns_per_message);
+	return ns_per_message;
+}
+
+// Compares every field of a message read through the generated struct with the dynamic parser
+static bool compare(const messages::Telemetry& message, BinaryParser& parser, BinaryMetaData& metadata)
+{
+	if (false == parser.Parse(&message, sizeof(message)))
+		return false;
+
+	// A full size string has no terminator, the dynamic string is bounded by the field
+	std::vector<uint8_t> name = parser.Read("name");
+	const char* name_chars = reinterpret_cast<const char*>(name.data());
+
+	bool equal =
+		same(message.header().seq(), parser.Read<uint32_t>(metadata.CompileAccessor("header.seq"))) &&
+		same(message.header().time(), parser.Read<double>(metadata.CompileAccessor("header.time"))) &&
+		same(message.id(), parser.Read<uint16_t>("id")) &&
+		same(message.gain(), parser.Read<float>("gain")) &&
+		same(message.state(), parser.Read<int8_t>("state")) &&
+		same(message.valid(), parser.Read<uint8_t>(metadata.CompileAccessor("valid"))) &&
+		same(message.mode(), parser.Read<uint8_t>(metadata.CompileAccessor("mode"))) &&
+		same(message.level(), parser.Read<uint8_t>(metadata.CompileAccessor("level"))) &&
+		message.name() == std::string(name_chars, strnlen(name_chars, name.size())) &&
+		message.raw() == parser.Read("raw") &&
+		same(message.stamp(), parser.Read<int64_t>("stamp"));
+
+	for (size_t i = 0; i < messages::Telemetry::counts::values && equal; i++)
+	{
+		std::string path = "values[" + std::to_string(i) + "]";
+		equal = same(message.values(i), parser.Read<uint16_t>(metadata.CompileAccessor(path.c_str())));
+	}
+
+	for (size_t i = 0; i < messages::Telemetry::counts::points && equal; i++)
+	{
+		std::string path = "points[" + std::to_string(i) + "]";
+		equal = same(message.points(i).x(), parser.Read<int16_t>(metadata.CompileAccessor((path + ".x").c_str()))) &&
+			same(message.points(i).y(), parser.Read<int16_t>(metadata.CompileAccessor((path + ".y").c_str())));
+	}
+
+	return equal;
+}
+
+int main()
+{
+	std::ifstream file(MESSAGES_SCHEMA);
+	std::stringstream json;
+	json << file.rdbuf();
+
+	BinaryMetadataStore store = BinaryMetadataStore::Create();
+	BinaryMetaDataBuilder metadata = BinaryMetaDataBuilder::Create(json.str().c_str(), store);
+	store.SetMetadata(messages::Telemetry::schema_name(), metadata);
+
+	// The generated structs match the runtime metadata, a changed metadata is detected
+	bool valid = messages::validate_schemas(static_cast<core::parsers::binary_metadata_store_interface*>(store)) &&
+		metadata.ValidateStruct<messages::Telemetry>();
+
+	BinaryMetaDataBuilder changed = BinaryMetaDataBuilder::Create(true);
+	changed.Simple<uint32_t>("seq").
+		Simple<float>("time");
+
+	valid = valid && false == changed.ValidateStruct<messages::Header>();
+	Core::Console::ColorPrint(valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\ngenerated structs %s the runtime metadata\n", valid ? "match" : "DO NOT match");
+
+	// Random messages read through both paths
+	std::vector<messages::Telemetry> telemetry(MESSAGES_COUNT);
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> distribution(0, 255);
+	for (messages::Telemetry& message : telemetry)
+	{
+		uint8_t* bytes = reinterpret_cast<uint8_t*>(&message);
+		for (size_t i = 0; i < sizeof(message); i++)
+			bytes[i] = static_cast<uint8_t>(distribution(generator));
+	}
+
+	BinaryParser parser = metadata.CreateParser();
+	bool equal = true;
+	for (size_t i = 0; i < MESSAGES_COUNT && equal; i++)
+		equal = compare(telemetry[i], parser, metadata);
+
+	// Values written through the setters are read back by the dynamic parser
+	messages::Telemetry message = {};
+	message.header().seq(7);
+	message.header().time(1.5);
+	message.id(0x1234);
+	message.gain(2.5f);
+	message.state(2);
+	message.valid(1);
+	message.mode(5);
+	message.level(9);
+	message.name("telemetry");
+	message.raw({ 1, 2, 3 });
+	message.values(2, 0xBEEF);
+	message.points(1).x(-3);
+	message.stamp(-1234567890123LL);
+	equal = equal && compare(message, parser, metadata) &&
+		message.mode() == 5 && message.level() == 9 && message.valid() == 1 &&
+		message.name() == "telemetry" && message.raw()[2] == 3 && message.points(1).x() == -3;
+
+	Core::Console::ColorPrint(equal ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\ngenerated accessors %s the dynamic parser\n", equal ? "match" : "DO NOT match");
+
+	BinaryAccessor gain = metadata.CompileAccessor("gain");
+	BinaryAccessor mode = metadata.CompileAccessor("mode");
+	BinaryAccessor y = metadata.CompileAccessor("points[2].y");
+	measure("dynamic parser, compiled accessors", [&]()
+	{
+		double sum = 0;
+		for (const messages::Telemetry& message : telemetry)
+		{
+			parser.Parse(&message, sizeof(message));
+			sum += parser.Read<float>(gain) + parser.Read<uint8_t>(mode) + parser.Read<int16_t>(y);
+		}
+
+		return sum;
+	});
+
+	measure("generated structs", [&]()
+	{
+		double sum = 0;
+		for (const messages::Telemetry& message : telemetry)
+			sum += message.gain() + message.mode() + message.points(2).y();
+
+		return sum;
+	});
+
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n");
+	return valid && equal ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+// JsonBenchmark.cpp : Compares the JSON document serialization and ingestion of a 1,000 fields message against the streaming
+// writer and reader.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+#include "benchmark.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Parsers;
+
+static constexpr size_t ITERATIONS = 500;
+static constexpr size_t CHANNELS_COUNT = 96;
+static constexpr size_t JSON_BUFFER_SIZE = 1024 * 1024;
+
+static std::vector<uint8_t> buffer_of(core::parsers::binary_parser_interface* parser)
+{
+	utils::ref_count_ptr<core::safe_buffer_interface> buffer;
+	std::vector<uint8_t> data(parser->buffer_size());
+	if (parser->query_buffer(&buffer))
+		buffer->safe_read(data.data(), data.size(), 0);
+
+	return data;
+}
+
+template <typename FUNC>
+double measure(const char* title, FUNC serialize)
+{
+	size_t length = 0;
+	double us_per_json = samples::measure_ns(ITERATIONS, [&]()
+	{
+		length += serialize();
+	}) / 1000.0;
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n%-45s %10.1f us/json (%u bytes)", title, us_per_json,
+		static_cast<unsigned>(length / ITERATIONS));
+	return us_per_json;
+}
+
+static std::string channel_name(size_t index)
+{
+	char name[16];
+	std::snprintf(name, sizeof(name), "ch_%02u", static_cast<unsigned>(index));
+	return name;
+}
+
+// 1,000 fields - 96 channels of 10 fields, 4 simple fields and 4 arrays of 40 values
+static BinaryMetaDataBuilder create_message(bool big_endian, EnumData& states)
+{
+	SimpleOptions gain_options;
+	gain_options.maxval<float>(1000.0f);
+
+	BinaryMetaDataBuilder channel = BinaryMetaDataBuilder::Create(big_endian);
+	channel.Simple<uint16_t>("id").
+		Simple<float>("gain", gain_options).
+		Simple<double>("offset").
+		Simple<int8_t>("level").
+		Enum("state", sizeof(int8_t), states).
+		Bits<uint8_t>("valid", 1).
+		Bits<uint8_t>("mode", 3).
+		String("name", 12).
+		Buffer("raw", 4).
+		Simple<bool>("enabled");
+
+	BinaryMetaDataBuilder point = BinaryMetaDataBuilder::Create(big_endian);
+	point.Simple<int32_t>("x").
+		Simple<int32_t>("y");
+
+	BinaryMetaDataBuilder message = BinaryMetaDataBuilder::Create(big_endian);
+	message.Simple<uint32_t>("seq").
+		Simple<double>("time").
+		Simple<int64_t>("counter").
+		Simple<uint64_t>("total");
+
+	for (size_t i = 0; i < CHANNELS_COUNT; i++)
+		message.Complex(channel_name(i).c_str(), channel);
+
+	message.Array<float>("history", 8).
+		Array("codes", 4, sizeof(int8_t), SimpleOptions(), states).
+		Array("points", 4, point).
+		Array<uint16_t>("spare", 16);
+
+	return message;
+}
+
+int main()
+{
+	// Every other value is a label, the rest are out of the enum bounds
+	EnumData states = EnumDataFactory::Create("state");
+	for (int64_t val = -128; val < 128; val += 2)
+		states.AddNewItem(val, ("STATE_" + std::to_string(val + 128)).c_str());
+
+	BinaryMetaDataBuilder message = create_message(true, states);
+	std::vector<std::string> channel_names;
+	for (size_t i = 0; i < CHANNELS_COUNT; i++)
+		channel_names.push_back(channel_name(i));
+
+	// Random big endian message with printable channel names (the JSON document rejects invalid UTF-8)
+	std::vector<uint8_t> data(message.Size());
+	std::mt19937 generator(7);
+	std::uniform_int_distribution<int> distribution(0, 255);
+	for (uint8_t& byte : data)
+		byte = static_cast<uint8_t>(distribution(generator));
+
+	BinaryParser parser = message.CreateParser();
+	parser.Parse(data.data(), data.size());
+	for (size_t i = 0; i < CHANNELS_COUNT; i++)
+	{
+		BinaryParser channel_parser = parser.ReadComplex(channel_names[i].c_str());
+		std::string name = (i % 3 == 0) ? "tab\t\"" + std::to_string(i) + "\"" : "channel " + std::to_string(i);
+		// Big endian strings are converted in 16 bits words, the terminator has to end a word
+		if (name.size() % 2 == 0)
+			name += ' ';
+
+		channel_parser.Write("name", name.c_str());
+	}
+
+	core::parsers::binary_parser_interface* core_parser = static_cast<core::parsers::binary_parser_interface*>(parser);
+
+	// The streamed JSON is the same text as the document's in every mode
+	std::vector<char> json(JSON_BUFFER_SIZE);
+	bool same = true;
+	const JsonDetailsLevel levels[] = { JsonDetailsLevel::JSON_ENUM_VALUES, JsonDetailsLevel::JSON_ENUM_LABLES, JsonDetailsLevel::JSON_ENUM_FULL };
+	for (JsonDetailsLevel level : levels)
+	{
+		for (bool compact : { true, false })
+		{
+			bool dom_no_errors = true;
+			bool stream_no_errors = true;
+			size_t length = 0;
+			std::string dom_json = core_parser->check_and_get_json(level, compact, dom_no_errors);
+			bool fits = core_parser->write_json(json.data(), json.size(), level, compact, length, stream_no_errors);
+			same = same && fits &&
+				dom_no_errors == stream_no_errors &&
+				length == dom_json.size() &&
+				dom_json == json.data();
+		}
+	}
+
+	// A buffer too small reports the required length
+	size_t required = 0;
+	bool no_errors = true;
+	same = same &&
+		false == core_parser->write_json(json.data(), 16, JsonDetailsLevel::JSON_ENUM_VALUES, true, required, no_errors) &&
+		required == parser.WriteJson(json.data(), json.size());
+
+	Core::Console::ColorPrint(same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\nstreamed JSON %s the JSON document\n", same ? "matches" : "DOES NOT match");
+
+	for (bool compact : { true, false })
+	{
+		measure(compact ? "compact, JSON document" : "indented, JSON document", [&]()
+		{
+			bool dom_no_errors = true;
+			return std::strlen(core_parser->check_and_get_json(JsonDetailsLevel::JSON_ENUM_FULL, compact, dom_no_errors));
+		});
+
+		measure(compact ? "compact, streaming writer" : "indented, streaming writer", [&]()
+		{
+			bool stream_no_errors = true;
+			size_t length = 0;
+			core_parser->write_json(json.data(), json.size(), JsonDetailsLevel::JSON_ENUM_FULL, compact, length, stream_no_errors);
+			return length;
+		});
+	}
+
+	// Ingestion requires valid enums
+	for (size_t i = 0; i < CHANNELS_COUNT; i++)
+		parser.ReadComplex(channel_names[i].c_str()).Write<int8_t>("state", static_cast<int8_t>(2 * i));
+
+	for (size_t i = 0; i < 4; i++)
+		parser.WriteArrayAt<int8_t>("codes", i, static_cast<int8_t>(2 * i));
+
+	// The streaming reader writes the same buffer as the JSON document in every mode.
+	// Into a platform endian message - the JSON document validates the values it wrote with the stream endian conversion.
+	BinaryMetaDataBuilder native_message = create_message(utils::types::is_big_endian(), states);
+	bool same_ingest = true;
+	for (JsonDetailsLevel level : levels)
+	{
+		std::string input = core_parser->check_and_get_json(level, false, no_errors);
+		BinaryParser dom_parser = native_message.CreateParser();
+		BinaryParser stream_parser = native_message.CreateParser();
+		bool dom_success = dom_parser.FromJson(input.c_str());
+		bool stream_success = stream_parser.FromJson(input.c_str(), input.size());
+		same_ingest = same_ingest && dom_success && stream_success &&
+			buffer_of(static_cast<core::parsers::binary_parser_interface*>(dom_parser)) ==
+			buffer_of(static_cast<core::parsers::binary_parser_interface*>(stream_parser));
+	}
+
+	// Unknown members are skipped, an invalid text fails without throwing
+	BinaryParser control = native_message.CreateParser();
+	const char unknown[] = "{\"unknown\": {\"a\": [1, {\"b\": \"\\u00e9\"}], \"c\": null}, \"seq\": 7}";
+	const char truncated[] = "{\"seq\": 8, \"time\":";
+	same_ingest = same_ingest &&
+		control.FromJson(unknown, sizeof(unknown)) && control.Read<uint32_t>("seq") == 7 &&
+		false == control.FromJson(truncated, sizeof(truncated));
+
+	Core::Console::ColorPrint(same_ingest ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nstreamed JSON ingestion %s the JSON document\n", same_ingest ? "matches" : "DOES NOT match");
+
+	std::string input = core_parser->check_and_get_json(JsonDetailsLevel::JSON_ENUM_LABLES, true, no_errors);
+	BinaryParser target = native_message.CreateParser();
+	core::parsers::binary_parser_interface* core_target = static_cast<core::parsers::binary_parser_interface*>(target);
+	measure("from_json, JSON document", [&]()
+	{
+		return core_target->from_json(input.c_str()) ? input.size() : 0;
+	});
+
+	measure("from_json, streaming reader", [&]()
+	{
+		return core_target->from_json(input.c_str(), input.size()) ? input.size() : 0;
+	});
+
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n%u bytes message\n", static_cast<unsigned>(data.size()));
+	return (same && same_ingest) ? 0 : 1;
+}
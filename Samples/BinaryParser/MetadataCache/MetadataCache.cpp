@@ -0,0 +1,138 @@
+// MetadataCache.cpp : Compares building the metadata of a 3,000 structs schema from its JSON text against loading
+// the binary cache of the store.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+#include "benchmark.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Parsers;
+
+static constexpr size_t STRUCTS_COUNT = 3000;
+static constexpr size_t CHAIN_LENGTH = 10;
+static const char* SOURCES_FILE = "metadata_cache_schema.json";
+static const char* CACHE_FILE = "metadata_cache_schema.bin";
+
+static std::string struct_name(size_t index)
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "Struct_%04u", static_cast<unsigned>(index));
+	return name;
+}
+
+template <typename FUNC>
+double measure(const char* title, FUNC load)
+{
+	bool success = false;
+	double ms = samples::measure_ns(1, [&]()
+	{
+		success = load();
+	}) / 1e6;
+	Core::Console::ColorPrint(success ? Core::Console::Colors::WHITE : Core::Console::Colors::RED, "\n%-45s %10.1f ms", title, ms);
+	return ms;
+}
+
+int main()
+{
+	EnumData states = EnumDataFactory::Create("state");
+	for (int64_t val = 0; val < 16; val++)
+		states.AddNewItem(val, ("STATE_" + std::to_string(val)).c_str());
+
+	// Every struct shares the header and the point metadata and extends the previous struct of its chain
+	BinaryMetadataStore store = BinaryMetadataStore::Create();
+	store.SetEnum("state", states);
+
+	BinaryMetaDataBuilder header = BinaryMetaDataBuilder::Create(store, true);
+	header.Simple<uint32_t>("seq").
+		Simple<double>("time").
+		Namely("Header");
+
+	BinaryMetaDataBuilder point = BinaryMetaDataBuilder::Create(store);
+	point.Simple<int32_t>("x").
+		Simple<int32_t>("y").
+		Namely("Point");
+
+	SimpleOptions gain_options;
+	gain_options.maxval<float>(1000.0f);
+	std::vector<BinaryMetaDataBuilder> structs;
+	for (size_t i = 0; i < STRUCTS_COUNT; i++)
+	{
+		BinaryMetaDataBuilder metadata = BinaryMetaDataBuilder::Create(store, i % 2 == 0);
+		metadata.Complex("header", header).
+			Simple<uint16_t>("id").
+			Simple<float>("gain", gain_options).
+			Enum("state", sizeof(uint8_t), states).
+			Bits<uint8_t>("valid", 1).
+			Bits<uint8_t>("mode", 3).
+			String("name", 16, "none").
+			Buffer("raw", 6).
+			Array<uint16_t>("values", 8).
+			Array("codes", 4, sizeof(uint8_t), SimpleOptions(), states).
+			Array("points", 2, point);
+
+		if (i % CHAIN_LENGTH != 0)
+			metadata.Complex("base", structs.back());
+
+		metadata.Namely(struct_name(i).c_str());
+		structs.push_back(metadata);
+	}
+
+	// The sources of the schema - the JSON text of every struct
+	std::vector<std::string> sources;
+	{
+		std::ofstream file(SOURCES_FILE, std::ios::trunc);
+		for (BinaryMetaDataBuilder& metadata : structs)
+		{
+			sources.push_back(metadata.ToJson(true));
+			file << sources.back() << "\n";
+		}
+	}
+
+	uint64_t source_hash = BinaryMetadataStore::HashFiles({ SOURCES_FILE });
+	bool same = store.SaveCache(CACHE_FILE, source_hash);
+
+	measure("build from the JSON text", [&]()
+	{
+		BinaryMetadataStore json_store = BinaryMetadataStore::Create();
+		json_store.SetEnum("state", states);
+		for (const std::string& source : sources)
+			BinaryMetaDataBuilder::Create(source.c_str(), json_store);
+
+		return true;
+	});
+
+	BinaryMetadataStore cached_store = BinaryMetadataStore::Create();
+	measure("load the binary cache", [&]()
+	{
+		return cached_store.LoadCache(CACHE_FILE, source_hash);
+	});
+
+	// The loaded metadata describe the same layouts, the enum is restored into the store
+	for (size_t i = 0; i < STRUCTS_COUNT && same; i++)
+	{
+		BinaryMetaData loaded = cached_store.Metadata(struct_name(i).c_str());
+		same = false == loaded.Empty() &&
+			std::string(loaded.ToJson(false)) == structs[i].ToJson(false);
+	}
+
+	same = same &&
+		false == cached_store.Enum("state").Empty() &&
+		false == cached_store.Metadata("Point").Empty();
+
+	// A cache of other sources is not loaded and leaves the store unchanged
+	BinaryMetadataStore stale_store = BinaryMetadataStore::Create();
+	same = same &&
+		false == stale_store.LoadCache(CACHE_FILE, source_hash + 1) &&
+		stale_store.Metadata(struct_name(0).c_str()).Empty();
+
+	Core::Console::ColorPrint(same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nloaded metadata %s the built metadata\n", same ? "match" : "DO NOT match");
+
+	std::remove(SOURCES_FILE);
+	std::remove(CACHE_FILE);
+	return same ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+// ValidationBenchmark.cpp : Validates messages with the parser's node walk and with a ValidationTable, checks both agree
+// on which messages are valid and compares their speed.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+#include "benchmark.hpp"
+
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Parsers;
+
+static constexpr size_t MESSAGES_COUNT = 1000;
+static constexpr size_t ITERATIONS = 50;
+
+static BinaryMetaDataBuilder create_metadata(EnumData& mode)
+{
+	BinaryMetaDataBuilder point = BinaryMetaDataBuilder::Create();
+	point.Simple<int32_t>("x", SimpleOptions::create<int32_t>(-1000, 1000, 0)).
+		Simple<int32_t>("y", SimpleOptions::create<int32_t>(-1000, 1000, 0));
+
+	BinaryMetaDataBuilder message = BinaryMetaDataBuilder::Create();
+	message.Simple<uint32_t>("seq").
+		Simple<uint8_t>("level", SimpleOptions::create<uint8_t>(0, 200, 0)).
+		Simple<bool>("enabled").
+		Enum("mode", sizeof(int16_t), mode).
+		Simple<double>("temperature", SimpleOptions::create<double>(-40.0, 125.0, 20.0)).
+		Simple<int64_t>("counter", SimpleOptions::create<int64_t>(0, 1000000000000LL, 0)).
+		Array<float>("gains", 8, SimpleOptions::create<float>(0.0f, 10.0f, 1.0f)).
+		Array("points", 4, point);
+
+	return message;
+}
+
+// A field wider than its type is read by the parser as its type, the table can not check it: the frozen metadata has no
+// table and its parsers must still reject what the node walk rejects
+static bool check_unsupported_field()
+{
+	BinaryMetaDataBuilder building = BinaryMetaDataBuilder::Create();
+	BinaryMetaDataBuilder frozen = BinaryMetaDataBuilder::Create();
+	building.Simple("wide", sizeof(int64_t), TypeEnum::INT32, SimpleOptions::create<int32_t>(0, 100, 0));
+	frozen.Simple("wide", sizeof(int64_t), TypeEnum::INT32, SimpleOptions::create<int32_t>(0, 100, 0));
+	frozen.Freeze();
+
+	bool rejected = false;
+	try
+	{
+		ValidationTable table(frozen);
+	}
+	catch (const std::runtime_error&)
+	{
+		rejected = true;
+	}
+
+	BinaryParser walking_parser = building.CreateParser();
+	BinaryParser table_parser = frozen.CreateParser();
+	bool same = rejected;
+	const int64_t values[] = { 50, 1000 };
+	for (int64_t value : values)
+	{
+		walking_parser.Parse(&value, sizeof(value));
+		table_parser.Parse(&value, sizeof(value));
+		same = same && walking_parser.Validate() == (value == 50) && table_parser.Validate() == walking_parser.Validate();
+	}
+
+	Core::Console::ColorPrint(same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\nfield wider than its type %s", same ? "validated by the node walk" : "NOT validated as by the node walk");
+	return same;
+}
+
+template <typename FUNC>
+double measure(const char* title, FUNC validate)
+{
+	size_t valid = 0;
+	double ns_per_message = samples::measure_ns(ITERATIONS, [&]()
+	{
+		valid += validate();
+	}) / MESSAGES_COUNT;
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n%-45s %10.1f ns/message (%u valid)", title, ns_per_message,
+		static_cast<unsigned>(valid / ITERATIONS));
+	return ns_per_message;
+}
+
+int main()
+{
+	EnumData mode = EnumDataFactory::Create("validation_mode");
+	mode.AddNewItem(0, "IDLE").
+		AddNewItem(1, "RUN").
+		AddNewItem(5, "TEST");
+
+	// The same layout twice, the parsers of the frozen one validate by its table
+	BinaryMetaDataBuilder building = create_metadata(mode);
+	BinaryMetaDataBuilder frozen = create_metadata(mode);
+	frozen.Freeze();
+	BinaryParser walking_parser = building.CreateParser();
+	BinaryParser table_parser = frozen.CreateParser();
+
+	const char* json =
+		"{\"seq\":1,\"level\":100,\"enabled\":true,\"mode\":5,\"temperature\":36.6,\"counter\":42,"
+		"\"gains\":[1,2,3,4,5,6,7,8],"
+		"\"points\":[{\"x\":1,\"y\":2},{\"x\":-3,\"y\":4},{\"x\":5,\"y\":-6},{\"x\":7,\"y\":8}]}";
+	if (false == walking_parser.FromJson(json, std::strlen(json)))
+		return 1;
+
+	// Valid messages, a quarter of them with a random byte overwritten
+	Buffers::Buffer valid_message = walking_parser.Buffer();
+	size_t size = frozen.Size();
+	std::vector<uint8_t> messages(size * MESSAGES_COUNT);
+	std::mt19937 generator(7);
+	std::uniform_int_distribution<size_t> offsets(0, size - 1);
+	std::uniform_int_distribution<int> bytes(0, 255);
+	for (size_t i = 0; i < MESSAGES_COUNT; i++)
+	{
+		uint8_t* message = messages.data() + i * size;
+		std::memcpy(message, valid_message.Data(), size);
+		if (i % 4 == 0)
+			message[offsets(generator)] = static_cast<uint8_t>(bytes(generator));
+	}
+
+	ValidationTable table(frozen);
+	std::vector<uint64_t> violations(table.mask_words());
+	bool same = true;
+	size_t invalid = 0;
+	for (size_t i = 0; i < MESSAGES_COUNT && same; i++)
+	{
+		const uint8_t* message = messages.data() + i * size;
+		walking_parser.Parse(message, size);
+		table_parser.Parse(message, size);
+		bool valid = walking_parser.Validate();
+		same = table.check(message, size, violations.data()) &&
+			table_parser.Validate() == valid &&
+			table.validate(message, size) == valid;
+
+		size_t violating = 0;
+		for (size_t field = 0; field < table.fields().size(); field++)
+			violating += (violations[field / 64] >> (field % 64)) & 1;
+
+		same = same && (violating == 0) == valid;
+		if (violating != 0 && invalid++ == 0)
+		{
+			for (size_t field = 0; field < table.fields().size(); field++)
+			{
+				if ((violations[field / 64] >> (field % 64)) & 1)
+					Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\nmessage %u: '%s' is invalid", static_cast<unsigned>(i), table.path(field).c_str());
+			}
+		}
+	}
+
+	// A buffer shorter than the message is not valid
+	same = same && false == table.validate(messages.data(), size - 1);
+	same = check_unsupported_field() && same;
+
+	Core::Console::ColorPrint(same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\nvalidation table %s the parser (%u of %u messages invalid, %u checked fields)\n", same ? "agrees with" : "DOES NOT agree with",
+		static_cast<unsigned>(invalid), static_cast<unsigned>(MESSAGES_COUNT), static_cast<unsigned>(table.fields().size()));
+
+	measure("parser validate, node walk", [&]()
+	{
+		size_t valid = 0;
+		for (size_t i = 0; i < MESSAGES_COUNT; i++)
+		{
+			walking_parser.Parse(messages.data() + i * size, size);
+			valid += walking_parser.Validate() ? 1 : 0;
+		}
+
+		return valid;
+	});
+
+	measure("parser validate, frozen metadata", [&]()
+	{
+		size_t valid = 0;
+		for (size_t i = 0; i < MESSAGES_COUNT; i++)
+		{
+			table_parser.Parse(messages.data() + i * size, size);
+			valid += table_parser.Validate() ? 1 : 0;
+		}
+
+		return valid;
+	});
+
+	measure("validation table on the raw messages", [&]()
+	{
+		size_t valid = 0;
+		for (size_t i = 0; i < MESSAGES_COUNT; i++)
+			valid += table.validate(messages.data() + i * size, size) ? 1 : 0;
+
+		return valid;
+	});
+
+	Core::Console::ColorPrint(Core::Console::Colors::WHITE, "\n");
+	return same ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+// CanBatching.cpp : Sends CAN frames of two IDs on a virtual CAN interface while a second adapter, filtering one of them in the kernel,
+// drains its receive queue in batches. Checks that only the filtered ID arrives, in order and complete, with increasing kernel receive timestamps.
+// Requires a vcan interface (the channel name defaults to vcan0):
+//		sudo modprobe vcan && sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+//
+#include <Core.hpp>
+#include <communication/ports/can_port.h>
+#include <utils/ref_count_ptr.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+static constexpr uint32_t COUNT = 10000;
+static constexpr int ACCEPTED_ID = 0x100;
+static constexpr int FILTERED_OUT_ID = 0x200;
+static constexpr size_t BATCH_SIZE = 64;
+static constexpr std::chrono::seconds TIMEOUT(5);
+
+static bool create_adapter(const char* channel_name, utils::ref_count_ptr<core::communication::client_channel_interface>& channel, communication::ports::can_port_adapter** adapter)
+{
+	if (communication::ports::can_port_adapter::create(communication::ports::socket_can, communication::ports::MODE_CAN_MTU, channel_name, 500000, false, &channel) == false)
+		return false;
+
+	*adapter = dynamic_cast<communication::ports::can_port_adapter*>(static_cast<core::communication::client_channel_interface*>(channel));
+	return (*adapter != nullptr);
+}
+
+int main(int argc, const char* argv[])
+{
+	const char* channel_name = (argc > 1) ? argv[1] : "vcan0";
+
+	utils::ref_count_ptr<core::communication::client_channel_interface> receiver_channel;
+	utils::ref_count_ptr<core::communication::client_channel_interface> sender_channel;
+	communication::ports::can_port_adapter* receiver = nullptr;
+	communication::ports::can_port_adapter* sender = nullptr;
+	if (create_adapter(channel_name, receiver_channel, &receiver) == false || create_adapter(channel_name, sender_channel, &sender) == false)
+	{
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::RED, "\nfailed to create the CAN adapters\n");
+		return 1;
+	}
+
+	// Frames of other IDs never reach the receiver's socket
+	communication::ports::can_id_filter filter = { ACCEPTED_ID, 0x7FF };
+	if (receiver->set_filters(&filter, 1) == false)
+	{
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::RED, "\nfailed to set the receive filter\n");
+		return 1;
+	}
+
+	if (receiver->connect() == false || sender->connect() == false)
+	{
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::YELLOW, "\n%s is not available, nothing to check\n", channel_name);
+		return 0;
+	}
+
+	std::atomic<uint32_t> received(0);
+	uint32_t batches = 0;
+	uint32_t unexpected = 0;
+	uint32_t out_of_order = 0;
+	uint32_t untimed = 0;
+	uint64_t first_timestamp = 0;
+	uint64_t last_timestamp = 0;
+	core::communication::communication_error error = core::communication::communication_error::NO_ERRORS;
+
+	std::thread reader([&]()
+	{
+		communication::ports::can_timestamped_msg batch[BATCH_SIZE];
+		size_t count;
+		while ((count = receiver->recieve_batch(batch, BATCH_SIZE, &error)) != 0)
+		{
+			batches++;
+			for (size_t i = 0; i < count; i++)
+			{
+				uint32_t sequence;
+				std::memcpy(&sequence, batch[i].msg.data, sizeof(sequence));
+				if (batch[i].msg.id != ACCEPTED_ID)
+					unexpected++;
+				else if (sequence != received * 2)
+					out_of_order++;
+
+				if (batch[i].timestamp_ns == 0 || batch[i].timestamp_ns < last_timestamp)
+					untimed++;
+
+				if (first_timestamp == 0)
+					first_timestamp = batch[i].timestamp_ns;
+
+				last_timestamp = batch[i].timestamp_ns;
+				received++;
+			}
+		}
+	});
+
+	for (uint32_t sequence = 0; sequence < COUNT; sequence++)
+	{
+		communication::ports::can_msg msg = {};
+		msg.id = (sequence % 2 == 0) ? ACCEPTED_ID : FILTERED_OUT_ID;
+		std::memcpy(msg.data, &sequence, sizeof(sequence));
+		while (sender->send(&msg, sizeof(msg)) == 0)
+			std::this_thread::sleep_for(std::chrono::microseconds(100)); // The interface's queue is full
+
+		// Bursts let the receiving thread find several frames per recvmmsg call
+		if (sequence % 256 == 255)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + TIMEOUT;
+	while (received < COUNT / 2 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	uint64_t dropped = receiver->dropped_messages();
+	receiver->disconnect();
+	sender->disconnect();
+	reader.join();
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\nreceived %u of %u frames in %u batches (%.1f frames per batch), %llu dropped, %u out of order, %u of other IDs, %u without increasing timestamps"
+		"\nreceive timestamps span %.3f ms, the adapter stopped with error %d",
+		static_cast<uint32_t>(received), COUNT / 2, batches, (batches != 0) ? static_cast<double>(received) / batches : 0.0,
+		static_cast<unsigned long long>(dropped), out_of_order, unexpected, untimed,
+		static_cast<double>(last_timestamp - first_timestamp) / 1e6, static_cast<int>(error));
+
+	bool valid = received == COUNT / 2 && dropped == 0 && out_of_order == 0 && unexpected == 0 && untimed == 0;
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthe CAN adapter %s\n", valid ? "passed" : "FAILED");
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+// ChannelLoopback.cpp : Sends messages over loopback UDP through a CommClientChannel which coalesces them, a plain socket
+// receives the frames and checks that they are flushed on the size threshold, on the frame budget, on the deadline and
+// explicitly, with the messages intact and in order, also when a large message is sent on its own after small ones.
+// Then a subscriber holding the first message exhausts the pool of a pooled receive channel, and checks that the
+// drop oldest, drop newest and block policies deliver, drop and count the following messages as documented.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+#include <Utils.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr uint16_t FRAMES_RECEIVER_PORT = 25011;
+static constexpr uint16_t COALESCER_PORT = 25012;
+static constexpr uint16_t POOLED_RECEIVER_PORT = 25013;
+static constexpr uint16_t POOLED_SENDER_PORT = 25014;
+static constexpr size_t MESSAGE_SIZE = 16;
+static constexpr size_t POOL_SIZE = 4;
+static constexpr uint32_t POOLED_COUNT = 32;
+static constexpr std::chrono::seconds TIMEOUT(5);
+
+using namespace Communication;
+using namespace Communication::Ports;
+
+// A message is its sequence number and its size followed by the low byte of the sequence number
+static void fill_message(uint32_t sequence, uint8_t* message, size_t size)
+{
+	uint32_t header[] = { sequence, static_cast<uint32_t>(size) };
+	std::memcpy(message, header, sizeof(header));
+	std::memset(message + sizeof(header), static_cast<uint8_t>(sequence), size - sizeof(header));
+}
+
+// Receives the coalesced frames on a plain socket, so the frame boundaries are seen as they were sent
+class frame_receiver
+{
+private:
+	int m_socket;
+	uint32_t m_expected;
+
+public:
+	frame_receiver() :
+		m_socket(::socket(AF_INET, SOCK_DGRAM, 0)),
+		m_expected(0)
+	{
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_port = htons(FRAMES_RECEIVER_PORT);
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		if (m_socket >= 0 && ::bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			::close(m_socket);
+			m_socket = -1;
+		}
+	}
+
+	~frame_receiver()
+	{
+		if (m_socket >= 0)
+			::close(m_socket);
+	}
+
+	bool valid() const
+	{
+		return m_socket >= 0;
+	}
+
+	// Receives a frame, checks that it holds whole messages in sequence
+	// @return	The size of the frame, 0 if none arrived in time or it was corrupted.
+	size_t receive(std::chrono::milliseconds timeout)
+	{
+		timeval time = { static_cast<time_t>(timeout.count() / 1000), static_cast<suseconds_t>((timeout.count() % 1000) * 1000) };
+		::setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &time, sizeof(time));
+
+		uint8_t frame[2048];
+		ssize_t size = ::recv(m_socket, frame, sizeof(frame), 0);
+		if (size <= 0)
+			return 0;
+
+		for (size_t offset = 0; offset < static_cast<size_t>(size);)
+		{
+			uint32_t header[2];
+			if (static_cast<size_t>(size) - offset < sizeof(header))
+				return 0;
+
+			std::memcpy(header, frame + offset, sizeof(header));
+			if (header[1] < sizeof(header) || header[1] > static_cast<size_t>(size) - offset)
+				return 0;
+
+			uint8_t expected[sizeof(frame)];
+			fill_message(m_expected++, expected, header[1]);
+			if (std::memcmp(frame + offset, expected, header[1]) != 0)
+				return 0;
+
+			offset += header[1];
+		}
+
+		return static_cast<size_t>(size);
+	}
+};
+
+static bool report(const char* test, bool passed)
+{
+	Core::Console::ColorPrint(false, true, passed ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n%-48s %s", test, passed ? "passed" : "FAILED");
+	return passed;
+}
+
+static bool send_messages(CommClientChannel& channel, uint32_t& sequence, size_t count, size_t size = MESSAGE_SIZE)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		uint8_t message[1024];
+		fill_message(sequence++, message, size);
+		if (channel.Send(message, size) == false)
+			return false;
+	}
+
+	return true;
+}
+
+static bool coalescing()
+{
+	frame_receiver receiver;
+	ClientChannel port = UdpPort::Create("127.0.0.1", FRAMES_RECEIVER_PORT, "127.0.0.1", COALESCER_PORT);
+	CommClientChannel channel(port, 2048);
+	if (receiver.valid() == false || channel.Connect() == false)
+		return report("coalescing, loopback sockets", false);
+
+	uint32_t sequence = 0;
+	bool valid = true;
+
+	// A frame is sent as soon as it reaches the threshold, long before the deadline
+	valid &= channel.EnableSendCoalescing(1024, 16 * MESSAGE_SIZE, 1000000) && send_messages(channel, sequence, 64);
+	bool size_flushed = true;
+	for (int i = 0; i < 4; i++)
+		size_flushed &= (receiver.receive(std::chrono::milliseconds(500)) == 16 * MESSAGE_SIZE);
+
+	valid &= report("coalescing, flushed on the size threshold", size_flushed);
+
+	// A message which does not fit into the frame budget sends the pending frame, the rest waits for flush
+	channel.DisableSendCoalescing();
+	valid &= channel.EnableSendCoalescing(6 * MESSAGE_SIZE + MESSAGE_SIZE / 2, 0, 1000000) && send_messages(channel, sequence, 7);
+	bool budget_flushed = (receiver.receive(std::chrono::milliseconds(500)) == 6 * MESSAGE_SIZE);
+	bool explicitly_flushed = (receiver.receive(std::chrono::milliseconds(100)) == 0) && channel.Flush() &&
+		(receiver.receive(std::chrono::milliseconds(500)) == MESSAGE_SIZE);
+
+	valid &= report("coalescing, flushed on the frame budget", budget_flushed);
+	valid &= report("coalescing, flushed explicitly", explicitly_flushed);
+
+	// A frame below the threshold is sent once the deadline of its first message expired
+	channel.DisableSendCoalescing();
+	const std::chrono::milliseconds deadline(50);
+	valid &= channel.EnableSendCoalescing(1024, 0, std::chrono::duration_cast<std::chrono::microseconds>(deadline).count());
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	valid &= send_messages(channel, sequence, 5);
+	bool deadline_flushed = (receiver.receive(std::chrono::milliseconds(1000)) == 5 * MESSAGE_SIZE) &&
+		std::chrono::steady_clock::now() - start >= deadline;
+
+	valid &= report("coalescing, flushed on the deadline", deadline_flushed);
+
+	// A message of the threshold or larger is sent on its own, after the pending messages, though it fits the budget
+	channel.DisableSendCoalescing();
+	valid &= channel.EnableSendCoalescing(1024, 8 * MESSAGE_SIZE, 1000000) &&
+		send_messages(channel, sequence, 2) && send_messages(channel, sequence, 1, 12 * MESSAGE_SIZE) &&
+		send_messages(channel, sequence, 1) && channel.Flush();
+	bool mixed_in_order = (receiver.receive(std::chrono::milliseconds(500)) == 2 * MESSAGE_SIZE) &&
+		(receiver.receive(std::chrono::milliseconds(500)) == 12 * MESSAGE_SIZE) &&
+		(receiver.receive(std::chrono::milliseconds(500)) == MESSAGE_SIZE);
+
+	valid &= report("coalescing, mixed sizes in order", mixed_in_order);
+
+	channel.Disconnect();
+	return valid;
+}
+
+// The subscriber holds the first message until every message was read, the pool's other buffers fill up meanwhile
+static bool pooled_receive(const char* test, ReceiveOverflowPolicy policy)
+{
+	ClientChannel receiver = UdpPort::Create("127.0.0.1", POOLED_SENDER_PORT, "127.0.0.1", POOLED_RECEIVER_PORT);
+	ClientChannel sender = UdpPort::Create("127.0.0.1", POOLED_RECEIVER_PORT, "127.0.0.1", POOLED_SENDER_PORT);
+	CommClientChannel channel(receiver, sizeof(uint32_t));
+
+	std::mutex delivered_mutex;
+	std::vector<uint32_t> delivered;
+	std::atomic<bool> holding(false);
+	std::atomic<bool> released(false);
+	channel.OnData() += [&](const DataReader& reader)
+	{
+		uint32_t sequence;
+		std::memcpy(&sequence, reader.Buffer(), sizeof(sequence));
+		{
+			std::lock_guard<std::mutex> locker(delivered_mutex);
+			delivered.push_back(sequence);
+		}
+
+		if (sequence != 0)
+			return;
+
+		holding = true;
+		while (released == false)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	};
+
+	if (channel.EnablePooledReceive(POOL_SIZE, policy) == false || channel.Connect() == false || sender.Connect() == false)
+		return report(test, false);
+
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + TIMEOUT;
+	for (uint32_t sequence = 0; sequence < POOLED_COUNT; sequence++)
+	{
+		sender.Send(&sequence, sizeof(sequence));
+		while (sequence == 0 && holding == false && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// Lets the receiving thread read, drop or block on every message before releasing the pool
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	released = true;
+
+	// Without drops every message is delivered, otherwise the first message and a full pool's worth
+	const size_t expected_count = (policy == ReceiveOverflowPolicy::block) ? POOLED_COUNT : POOL_SIZE;
+	ReceiveStatistics statistics = channel.QueryReceiveStatistics();
+	while (statistics.frames_dispatched < expected_count && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		statistics = channel.QueryReceiveStatistics();
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	statistics = channel.QueryReceiveStatistics();
+	channel.Disconnect();
+	sender.Disconnect();
+
+	std::vector<uint32_t> expected;
+	for (uint32_t sequence = 0; sequence < POOLED_COUNT; sequence++)
+	{
+		bool kept = (policy == ReceiveOverflowPolicy::block) ||
+			(policy == ReceiveOverflowPolicy::drop_newest && sequence < POOL_SIZE) ||
+			(policy == ReceiveOverflowPolicy::drop_oldest && (sequence == 0 || sequence >= POOLED_COUNT - (POOL_SIZE - 1)));
+		if (kept)
+			expected.push_back(sequence);
+	}
+
+	const uint64_t dropped = POOLED_COUNT - expected.size();
+	bool valid = (delivered == expected) &&
+		statistics.frames_received == POOLED_COUNT &&
+		statistics.frames_dispatched == expected.size() &&
+		statistics.dropped_oldest == ((policy == ReceiveOverflowPolicy::drop_oldest) ? dropped : 0) &&
+		statistics.dropped_newest == ((policy == ReceiveOverflowPolicy::drop_newest) ? dropped : 0) &&
+		(statistics.blocked != 0) == (policy == ReceiveOverflowPolicy::block);
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n%s: %u received, %u dispatched, %u dropped oldest, %u dropped newest, %u blocked", test,
+		static_cast<unsigned>(statistics.frames_received), static_cast<unsigned>(statistics.frames_dispatched),
+		static_cast<unsigned>(statistics.dropped_oldest), static_cast<unsigned>(statistics.dropped_newest),
+		static_cast<unsigned>(statistics.blocked));
+
+	return report(test, valid);
+}
+
+int main()
+{
+	bool valid = true;
+	valid &= coalescing();
+	valid &= pooled_receive("pooled receive, drop oldest", ReceiveOverflowPolicy::drop_oldest);
+	valid &= pooled_receive("pooled receive, drop newest", ReceiveOverflowPolicy::drop_newest);
+	valid &= pooled_receive("pooled receive, block", ReceiveOverflowPolicy::block);
+
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthe comm client channel %s\n", valid ? "passed" : "FAILED");
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+// IoUringLoopback.cpp : Receives sequence numbers over loopback UDP and TCP through the io_uring backend, both read by the
+// channel's receiving thread and delivered directly from the io_uring completion thread (EnableDirectReceive).
+// Checks that every number arrives, in order, and that the end of a TCP stream and a reset TCP connection are reported once.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+#include <Utils.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t COUNT = 20000;
+static constexpr uint16_t UDP_RECEIVER_PORT = 25001;
+static constexpr uint16_t UDP_SENDER_PORT = 25002;
+static constexpr uint16_t TCP_SERVER_PORT = 25003;
+static constexpr std::chrono::seconds TIMEOUT(5);
+
+using namespace Communication;
+using namespace Communication::Ports;
+
+// Checks the sequence numbers raised by a channel, a TCP stream may split them across frames
+class sequence_checker
+{
+private:
+	uint8_t m_partial[sizeof(uint32_t)];
+	size_t m_partial_size;
+	uint32_t m_expected;
+
+public:
+	std::atomic<uint32_t> received;
+	std::atomic<uint32_t> out_of_order;
+	std::atomic<uint32_t> closed;
+	std::atomic<CommError> error;
+
+	sequence_checker() :
+		m_partial_size(0),
+		m_expected(0),
+		received(0),
+		out_of_order(0),
+		closed(0),
+		error(CommError::NO_ERRORS)
+	{
+	}
+
+	void subscribe(CommClientChannel& channel)
+	{
+		channel.OnData() += [this](const DataReader& reader)
+		{
+			const uint8_t* data = static_cast<const uint8_t*>(reader.Buffer());
+			for (size_t i = 0; i < reader.Size(); i++)
+			{
+				m_partial[m_partial_size++] = data[i];
+				if (m_partial_size < sizeof(uint32_t))
+					continue;
+
+				uint32_t sequence;
+				std::memcpy(&sequence, m_partial, sizeof(sequence));
+				m_partial_size = 0;
+
+				if (sequence != m_expected)
+					out_of_order++;
+
+				m_expected = sequence + 1;
+				received++;
+			}
+		};
+
+		// The error of the receive which ended the connection is raised right before the status
+		channel.OnCommError() += [this](const CommError& comm_error)
+		{
+			error = comm_error;
+		};
+
+		channel.OnCommStatus() += [this](const CommStatus& status)
+		{
+			if (status == CommStatus::DISCONNECTED)
+				closed++;
+		};
+	}
+
+	bool wait(uint32_t count, uint32_t closures) const
+	{
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + TIMEOUT;
+		while ((received < count || closed < closures) && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		return (received == count && closed == closures);
+	}
+};
+
+static bool report(const char* test, bool passed)
+{
+	Core::Console::ColorPrint(false, true, passed ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n%-48s %s", test, passed ? "passed" : "FAILED");
+	return passed;
+}
+
+static bool udp_loopback(bool direct)
+{
+	ClientChannel receiver = UdpPort::Create("127.0.0.1", UDP_SENDER_PORT, "127.0.0.1", UDP_RECEIVER_PORT, false, 4 * 1024 * 1024, 0, IOBackend::io_uring);
+	ClientChannel sender = UdpPort::Create("127.0.0.1", UDP_RECEIVER_PORT, "127.0.0.1", UDP_SENDER_PORT);
+
+	CommClientChannel channel(receiver, sizeof(uint32_t));
+	sequence_checker checker;
+	checker.subscribe(channel);
+
+	if ((direct == true && channel.EnableDirectReceive() == false) || channel.Connect() == false || sender.Connect() == false)
+		return false;
+
+	for (uint32_t sequence = 0; sequence < COUNT; sequence++)
+	{
+		sender.Send(&sequence, sizeof(sequence));
+
+		// Datagrams beyond the socket's receive buffer would be dropped
+		if (sequence % 32 == 31)
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+
+	bool retval = checker.wait(COUNT, 0) && checker.out_of_order == 0;
+	channel.Disconnect();
+	sender.Disconnect();
+
+	// The local disconnection ends the receive once, without an error
+	return retval && checker.closed == 1 && checker.error == CommError::NO_ERRORS;
+}
+
+// Streams the sequence numbers to the first client in chunks which split them, then closes or resets the connection
+static bool tcp_loopback(bool direct, bool reset)
+{
+	int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+	int reuse = 1;
+	::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(TCP_SERVER_PORT);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 1) != 0)
+	{
+		::close(listener);
+		return false;
+	}
+
+	std::thread server([listener, reset]()
+	{
+		int client = ::accept(listener, nullptr, nullptr);
+		if (client < 0)
+			return;
+
+		std::vector<uint32_t> sequences(COUNT);
+		for (uint32_t sequence = 0; sequence < COUNT; sequence++)
+			sequences[sequence] = sequence;
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(sequences.data());
+		size_t size = sequences.size() * sizeof(uint32_t);
+		for (size_t offset = 0; offset < size;)
+		{
+			ssize_t sent = ::send(client, data + offset, (std::min)(size - offset, static_cast<size_t>(1001)), MSG_NOSIGNAL);
+			if (sent <= 0)
+				break;
+
+			offset += static_cast<size_t>(sent);
+		}
+
+		if (reset == true)
+		{
+			// Let the data reach the client before aborting the connection
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+			linger abort = { 1, 0 };
+			::setsockopt(client, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+		}
+
+		::close(client);
+	});
+
+	ClientChannel port = TcpPort::Create("127.0.0.1", TCP_SERVER_PORT, "127.0.0.1", 0, false, IOBackend::io_uring);
+	CommClientChannel channel(port, sizeof(uint32_t));
+	sequence_checker checker;
+	checker.subscribe(channel);
+
+	bool retval = (direct == false || channel.EnableDirectReceive() == true) && channel.Connect() == true;
+	if (retval == false)
+		::shutdown(listener, SHUT_RDWR);
+
+	server.join();
+	::close(listener);
+
+	// The end of the stream, or the reset, is reported once after the last sequence number
+	retval = retval && checker.wait(COUNT, 1) && checker.out_of_order == 0 &&
+		checker.error == (reset ? CommError::UNKNOWN_ERROR : CommError::NO_ERRORS);
+
+	channel.Disconnect();
+	return retval && checker.closed == 1;
+}
+
+int main(int argc, const char* argv[])
+{
+	if (communication::ports::io_uring_backend::supported() == false)
+	{
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::YELLOW, "\nio_uring is not supported, nothing to check\n");
+		return 0;
+	}
+
+	bool valid = true;
+	valid &= report("UDP, receiving thread", udp_loopback(false));
+	valid &= report("UDP, direct receive", udp_loopback(true));
+	valid &= report("TCP end of stream, receiving thread", tcp_loopback(false, false));
+	valid &= report("TCP end of stream, direct receive", tcp_loopback(true, false));
+	valid &= report("TCP connection reset, receiving thread", tcp_loopback(false, true));
+	valid &= report("TCP connection reset, direct receive", tcp_loopback(true, true));
+
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthe io_uring backend %s\n", valid ? "passed" : "FAILED");
+	return valid ? 0 : 1;
+}
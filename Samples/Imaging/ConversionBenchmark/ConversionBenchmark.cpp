@@ -0,0 +1,151 @@
+// ConversionBenchmark.cpp : Measures the megapixels per second of 4K conversions and resizes per format pair with
+// ImageConverterAlgorithm at 1, 2, 4 and 8 threads, and checks every thread count produces the same image.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <utils/imaging.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t WIDTH = 3840;
+static constexpr uint32_t HEIGHT = 2160;
+static constexpr size_t ITERATIONS = 5;
+static const uint32_t THREADS[] = { 1, 2, 4, 8 };
+
+struct format
+{
+	const char* name;
+	Imaging::PixelFormat format;
+};
+
+struct conversion
+{
+	format source;
+	format target;
+	uint32_t width;
+	uint32_t height;
+};
+
+static const format RGB = { "RGB", Imaging::PixelFormat::RGB };
+static const format RGBA = { "RGBA", Imaging::PixelFormat::RGBA };
+static const format BGR = { "BGR", Imaging::PixelFormat::BGR };
+static const format BGRA = { "BGRA", Imaging::PixelFormat::BGRA };
+static const format I420 = { "I420", Imaging::PixelFormat::I420 };
+static const format NV12 = { "NV12", Imaging::PixelFormat::NV12 };
+static const format YUY2 = { "YUY2", Imaging::PixelFormat::YUY2 };
+static const format GRAY8 = { "GRAY8", Imaging::PixelFormat::GRAY8 };
+static const format GRAY16_LE = { "GRAY16_LE", Imaging::PixelFormat::GRAY16_LE };
+
+// A gradient frame of the given format
+static Imaging::Image create_frame(Imaging::PixelFormat pixel_format)
+{
+	utils::ref_count_ptr<utils::imaging::ref_count_image> image = utils::make_ref_count_ptr<utils::imaging::ref_count_image>(
+		core::imaging::image_params{ WIDTH, HEIGHT, WIDTH * HEIGHT * 3, Imaging::PixelFormat::RGB });
+
+	Imaging::Image frame(image);
+	uint8_t* pixel = frame.Buffer();
+	for (uint32_t y = 0; y < HEIGHT; y++)
+	{
+		for (uint32_t x = 0; x < WIDTH; x++, pixel += 3)
+		{
+			pixel[0] = static_cast<uint8_t>(x * 255 / WIDTH);
+			pixel[1] = static_cast<uint8_t>(y * 255 / HEIGHT);
+			pixel[2] = static_cast<uint8_t>((x + y) & 0xFF);
+		}
+	}
+
+	return Imaging::ImageConverterAlgorithm::Create(pixel_format).Apply(frame);
+}
+
+static size_t image_size(const Imaging::Image& image)
+{
+	size_t pixels = static_cast<size_t>(image.Width()) * image.Height();
+	switch (image.Format())
+	{
+	case Imaging::PixelFormat::RGB:
+	case Imaging::PixelFormat::BGR:
+		return pixels * 3;
+	case Imaging::PixelFormat::RGBA:
+	case Imaging::PixelFormat::BGRA:
+		return pixels * 4;
+	case Imaging::PixelFormat::I420:
+	case Imaging::PixelFormat::NV12:
+		return pixels * 3 / 2;
+	case Imaging::PixelFormat::GRAY8:
+		return pixels;
+	default:
+		return pixels * 2;
+	}
+}
+
+int main()
+{
+	const conversion conversions[] = {
+		{ I420, RGB, 0, 0 },
+		{ I420, RGBA, 0, 0 },
+		{ I420, BGR, 0, 0 },
+		{ I420, GRAY8, 0, 0 },
+		{ NV12, RGB, 0, 0 },
+		{ NV12, BGRA, 0, 0 },
+		{ NV12, I420, 0, 0 },
+		{ YUY2, RGB, 0, 0 },
+		{ YUY2, I420, 0, 0 },
+		{ RGB, I420, 0, 0 },
+		{ RGB, BGRA, 0, 0 },
+		{ BGRA, NV12, 0, 0 },
+		{ BGRA, GRAY8, 0, 0 },
+		{ GRAY16_LE, RGB, 0, 0 },
+		{ I420, RGBA, 1920, 1080 },
+		{ NV12, BGR, 1280, 720 },
+		{ RGB, RGB, 1920, 1080 }
+	};
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE, "\n%-36s", "megapixels per second, threads:");
+	for (uint32_t threads : THREADS)
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE, "%9u", static_cast<unsigned>(threads));
+
+	bool same = true;
+	for (const conversion& current : conversions)
+	{
+		Imaging::Image frame = create_frame(current.source.format);
+		char title[64];
+		if (current.width == 0)
+			std::snprintf(title, sizeof(title), "%s -> %s", current.source.name, current.target.name);
+		else
+			std::snprintf(title, sizeof(title), "%s -> %s %ux%u", current.source.name, current.target.name,
+				static_cast<unsigned>(current.width), static_cast<unsigned>(current.height));
+
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE, "\n%-36s", title);
+		std::vector<uint8_t> reference;
+		for (uint32_t threads : THREADS)
+		{
+			Imaging::ImageAlgorithm converter = Imaging::ImageConverterAlgorithm::Create(current.target.format, current.width, current.height, threads);
+			Imaging::Image output = converter.Apply(frame);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < ITERATIONS; i++)
+				output = converter.Apply(frame);
+
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+			// The image of the first thread count is the reference of the others
+			if (threads == THREADS[0])
+				reference.assign(output.Buffer(), output.Buffer() + image_size(output));
+
+			bool valid = reference.size() == image_size(output) && std::memcmp(reference.data(), output.Buffer(), reference.size()) == 0;
+			same = same && valid;
+
+			Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+				"%9.1f", static_cast<double>(WIDTH) * HEIGHT / 1e6 / seconds);
+		}
+	}
+
+	Core::Console::ColorPrint(false, true, same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthreaded conversions %s the single threaded ones (%u hardware threads)\n", same ? "match" : "DO NOT match",
+		std::thread::hardware_concurrency());
+	return same ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+// ImagePipeline.cpp : Feeds NV12 frames to an ImagePipeline of a full resolution RGB branch with a gain, a cropped BGRA
+// thumbnail, a GRAY8 branch, a crop of a scaled image and the scaled image itself, checks every output against the same stages applied one by one
+// with ImageConverterAlgorithm and measures the pipeline against the chain of converters.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <utils/imaging.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static constexpr uint32_t WIDTH = 1920;
+static constexpr uint32_t HEIGHT = 1080;
+static constexpr uint32_t THREADS = 4;
+static constexpr size_t ITERATIONS = 20;
+
+static Imaging::Image create_image(uint32_t width, uint32_t height, Imaging::PixelFormat format, uint32_t size)
+{
+	return Imaging::Image(utils::make_ref_count_ptr<utils::imaging::ref_count_image>(
+		core::imaging::image_params{ width, height, size, format }));
+}
+
+// A gradient NV12 frame
+static Imaging::Image create_frame()
+{
+	Imaging::Image frame = create_image(WIDTH, HEIGHT, Imaging::PixelFormat::RGB, WIDTH * HEIGHT * 3);
+	uint8_t* pixel = frame.Buffer();
+	for (uint32_t y = 0; y < HEIGHT; y++)
+	{
+		for (uint32_t x = 0; x < WIDTH; x++, pixel += 3)
+		{
+			pixel[0] = static_cast<uint8_t>(x * 255 / WIDTH);
+			pixel[1] = static_cast<uint8_t>(y * 255 / HEIGHT);
+			pixel[2] = static_cast<uint8_t>((x + y) & 0xFF);
+		}
+	}
+
+	return Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::NV12).Apply(frame);
+}
+
+// The rectangle of an RGBA image
+static Imaging::Image crop(const Imaging::Image& image, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	Imaging::Image cropped = create_image(width, height, Imaging::PixelFormat::RGBA, width * height * 4);
+	for (uint32_t row = 0; row < height; row++)
+		std::memcpy(cropped.Buffer() + static_cast<size_t>(row) * width * 4,
+			image.Buffer() + (static_cast<size_t>(y + row) * image.Width() + x) * 4, static_cast<size_t>(width) * 4);
+
+	return cropped;
+}
+
+// The gain of the RGB levels of an RGBA image, rounded as the pipeline does
+static void gain(Imaging::Image& image, float value)
+{
+	const uint32_t fixed = static_cast<uint32_t>(std::lround(value * 256));
+	uint8_t* pixel = image.Buffer();
+	for (size_t i = 0; i < static_cast<size_t>(image.Width()) * image.Height(); i++, pixel += 4)
+		for (size_t channel = 0; channel < 3; channel++)
+			pixel[channel] = static_cast<uint8_t>(std::min<uint32_t>(((static_cast<uint32_t>(pixel[channel]) << 8 | 0x80) * fixed) >> 16, 255));
+}
+
+static bool same(const Imaging::Image& image, const Imaging::Image& reference, size_t size)
+{
+	return image.Width() == reference.Width() && image.Height() == reference.Height() &&
+		image.Format() == reference.Format() && std::memcmp(image.Buffer(), reference.Buffer(), size) == 0;
+}
+
+int main()
+{
+	Imaging::Image frame = create_frame();
+
+	Imaging::ImagePipeline pipeline = Imaging::ImageProcessingPipeline::Create(THREADS);
+
+	// Full resolution RGB with a gain, a single pass over the frame
+	size_t full = pipeline.AddOutput(pipeline.AddGain(
+		pipeline.AddConvert(Imaging::ImagePipeline::INPUT_NODE, Imaging::PixelFormat::RGB), 1.5f));
+
+	// A BGRA thumbnail of the center, a single pass reading the rectangle only
+	size_t thumbnail = pipeline.AddOutput(pipeline.AddConvert(pipeline.AddGain(pipeline.AddScale(
+		pipeline.AddCrop(Imaging::ImagePipeline::INPUT_NODE, 321, 181, 1280, 720), 320, 180), 0.75f), Imaging::PixelFormat::BGRA));
+
+	// GRAY8, the luma plane of the frame
+	size_t gray = pipeline.AddOutput(pipeline.AddConvert(Imaging::ImagePipeline::INPUT_NODE, Imaging::PixelFormat::GRAY8));
+
+	// A crop of a scaled image, two passes: the scaled NV12 image is built and cropped
+	size_t scaled_node = pipeline.AddScale(Imaging::ImagePipeline::INPUT_NODE, 640, 360);
+	size_t corner = pipeline.AddOutput(pipeline.AddConvert(pipeline.AddCrop(scaled_node, 160, 90, 320, 180), Imaging::PixelFormat::RGB));
+
+	// A convert which changes nothing shares the scaled image, which is not an output itself
+	size_t scaled_copy = pipeline.AddOutput(pipeline.AddConvert(scaled_node, Imaging::PixelFormat::NV12));
+
+	std::vector<Imaging::Image> outputs;
+	if (pipeline.Process(frame, outputs) == false)
+	{
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::RED, "\nthe pipeline failed\n");
+		return 1;
+	}
+
+	// The same stages, one by one
+	Imaging::Image rgba = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA).Apply(frame);
+	Imaging::Image full_rgba = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA).Apply(frame);
+	gain(full_rgba, 1.5f);
+
+	Imaging::Image thumbnail_rgba = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA, 320, 180).Apply(
+		crop(rgba, 321, 181, 1280, 720));
+	gain(thumbnail_rgba, 0.75f);
+
+	Imaging::Image scaled = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::NV12, 640, 360).Apply(frame);
+	Imaging::Image corner_rgba = crop(Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA).Apply(scaled), 160, 90, 320, 180);
+
+	const struct
+	{
+		const char* name;
+		size_t output;
+		Imaging::Image reference;
+		size_t size;
+	} checks[] = {
+		{ "full resolution RGB, gain 1.5", full,
+			Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGB).Apply(full_rgba), WIDTH * HEIGHT * 3 },
+		{ "cropped BGRA thumbnail, gain 0.75", thumbnail,
+			Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::BGRA).Apply(thumbnail_rgba), 320 * 180 * 4 },
+		{ "GRAY8", gray,
+			Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::GRAY8).Apply(frame), WIDTH * HEIGHT },
+		{ "crop of a scaled image, RGB", corner,
+			Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGB).Apply(corner_rgba), 320 * 180 * 3 },
+		{ "scaled NV12, shared with the crop", scaled_copy, scaled, 640 * 360 * 3 / 2 }
+	};
+
+	bool valid = true;
+	for (const auto& check : checks)
+	{
+		bool matches = same(outputs[check.output], check.reference, check.size);
+		valid = valid && matches;
+		Core::Console::ColorPrint(false, true, matches ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+			"\n%-36s %ux%u %s", check.name, static_cast<unsigned>(outputs[check.output].Width()),
+			static_cast<unsigned>(outputs[check.output].Height()), matches ? "matches" : "DOES NOT match");
+	}
+
+	// The pipeline against the converters each branch needs without fusion
+	Imaging::ImageAlgorithm to_rgba = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA, 0, 0, THREADS);
+	Imaging::ImageAlgorithm to_rgb = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGB, 0, 0, THREADS);
+	Imaging::ImageAlgorithm to_thumbnail = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::BGRA, 320, 180, THREADS);
+	Imaging::ImageAlgorithm to_gray = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::GRAY8, 0, 0, THREADS);
+	Imaging::ImageAlgorithm to_scaled = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::NV12, 640, 360, THREADS);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < ITERATIONS; i++)
+		pipeline.Process(frame, outputs);
+
+	double fused = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+	start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < ITERATIONS; i++)
+	{
+		Imaging::Image decoded = to_rgba.Apply(frame);
+		gain(decoded, 1.5f);
+		to_rgb.Apply(decoded);
+		to_thumbnail.Apply(crop(decoded, 321, 181, 1280, 720));
+		to_gray.Apply(frame);
+		to_rgb.Apply(crop(to_rgba.Apply(to_scaled.Apply(frame)), 160, 90, 320, 180));
+	}
+
+	double chained = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n\nper frame, %u threads: pipeline %.2f ms, chained converters %.2f ms\n", static_cast<unsigned>(THREADS), fused, chained);
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\npipeline outputs %s the chained stages\n", valid ? "match" : "DO NOT match");
+	return valid ? 0 : 1;
+}
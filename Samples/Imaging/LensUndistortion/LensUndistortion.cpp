@@ -0,0 +1,134 @@
+// LensUndistortion.cpp : Measures the milliseconds per 1080p frame of ImageUndistortAlgorithm per pixel format at 1, 2, 4
+// and 8 threads, checks every thread count produces the same image and that a camera without distortion leaves the frames
+// unchanged.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <utils/imaging.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t WIDTH = 1920;
+static constexpr uint32_t HEIGHT = 1080;
+static constexpr size_t ITERATIONS = 10;
+static const uint32_t THREADS[] = { 1, 2, 4, 8 };
+
+struct format
+{
+	const char* name;
+	Imaging::PixelFormat format;
+};
+
+static const format FORMATS[] = {
+	{ "RGB", Imaging::PixelFormat::RGB },
+	{ "RGBA", Imaging::PixelFormat::RGBA },
+	{ "BGRA", Imaging::PixelFormat::BGRA },
+	{ "GRAY8", Imaging::PixelFormat::GRAY8 },
+	{ "I420", Imaging::PixelFormat::I420 },
+	{ "NV12", Imaging::PixelFormat::NV12 },
+	{ "YUY2 (undistorted in RGBA)", Imaging::PixelFormat::YUY2 }
+};
+
+// A checkerboard frame of the given format, its straight lines show the distortion
+static Imaging::Image create_frame(Imaging::PixelFormat pixel_format)
+{
+	utils::ref_count_ptr<utils::imaging::ref_count_image> image = utils::make_ref_count_ptr<utils::imaging::ref_count_image>(
+		core::imaging::image_params{ WIDTH, HEIGHT, WIDTH * HEIGHT * 3, Imaging::PixelFormat::RGB });
+
+	Imaging::Image frame(image);
+	uint8_t* pixel = frame.Buffer();
+	for (uint32_t y = 0; y < HEIGHT; y++)
+	{
+		for (uint32_t x = 0; x < WIDTH; x++, pixel += 3)
+		{
+			bool white = ((x / 60) + (y / 60)) % 2 == 0;
+			pixel[0] = static_cast<uint8_t>(white ? 230 : x * 255 / WIDTH);
+			pixel[1] = static_cast<uint8_t>(white ? 230 : y * 255 / HEIGHT);
+			pixel[2] = static_cast<uint8_t>(white ? 230 : 40);
+		}
+	}
+
+	return Imaging::ImageConverterAlgorithm::Create(pixel_format).Apply(frame);
+}
+
+static size_t image_size(const Imaging::Image& image)
+{
+	size_t pixels = static_cast<size_t>(image.Width()) * image.Height();
+	switch (image.Format())
+	{
+	case Imaging::PixelFormat::RGB:
+	case Imaging::PixelFormat::BGR:
+		return pixels * 3;
+	case Imaging::PixelFormat::RGBA:
+	case Imaging::PixelFormat::BGRA:
+		return pixels * 4;
+	case Imaging::PixelFormat::I420:
+	case Imaging::PixelFormat::NV12:
+		return pixels * 3 / 2;
+	case Imaging::PixelFormat::GRAY8:
+		return pixels;
+	default:
+		return pixels * 2;
+	}
+}
+
+int main()
+{
+	float camera_matrix[3][3] = {
+		{ 1400.0f, 0.0f, WIDTH / 2.0f },
+		{ 0.0f, 1400.0f, HEIGHT / 2.0f },
+		{ 0.0f, 0.0f, 1.0f } };
+	float distortion[5] = { -0.32f, 0.12f, 0.001f, -0.0005f, -0.02f };
+	float no_distortion[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE, "\n%-36s", "milliseconds per frame, threads:");
+	for (uint32_t threads : THREADS)
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE, "%9u", static_cast<unsigned>(threads));
+
+	bool same = true;
+	bool unchanged = true;
+	for (const format& current : FORMATS)
+	{
+		Imaging::Image frame = create_frame(current.format);
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE, "\n%-36s", current.name);
+
+		std::vector<uint8_t> reference;
+		for (uint32_t threads : THREADS)
+		{
+			Imaging::ImageAlgorithm undistort = Imaging::ImageUndistortAlgorithm::Create(WIDTH, HEIGHT, camera_matrix, distortion, threads);
+			Imaging::Image output = undistort.Apply(frame);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < ITERATIONS; i++)
+				output = undistort.Apply(frame);
+
+			double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+			// The image of the first thread count is the reference of the others
+			if (threads == THREADS[0])
+				reference.assign(output.Buffer(), output.Buffer() + image_size(output));
+
+			bool valid = reference.size() == image_size(output) && std::memcmp(reference.data(), output.Buffer(), reference.size()) == 0;
+			same = same && valid;
+
+			Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+				"%9.2f", milliseconds);
+		}
+
+		// Without distortion every pixel maps to itself
+		Imaging::Image output = Imaging::ImageUndistortAlgorithm::Create(WIDTH, HEIGHT, camera_matrix, no_distortion).Apply(frame);
+		if (output.Format() == frame.Format())
+			unchanged = unchanged && std::memcmp(output.Buffer(), frame.Buffer(), image_size(frame)) == 0;
+	}
+
+	Core::Console::ColorPrint(false, true, same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthreaded undistortions %s the single threaded ones (%u hardware threads)", same ? "match" : "DO NOT match",
+		std::thread::hardware_concurrency());
+	Core::Console::ColorPrint(false, true, unchanged ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\nframes without distortion are %s\n", unchanged ? "unchanged" : "CHANGED");
+	return same && unchanged ? 0 : 1;
+}
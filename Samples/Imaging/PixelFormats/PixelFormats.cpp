@@ -0,0 +1,152 @@
+// PixelFormats.cpp : Converts a frame of color bars with ImageConverterAlgorithm into every pixel format, with and without
+// resizing, checks the colors of the bars survive the conversions and measures the time of each conversion.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <utils/imaging.hpp>
+
+#include <chrono>
+#include <cstdlib>
+
+static constexpr uint32_t WIDTH = 1920;
+static constexpr uint32_t HEIGHT = 1080;
+static constexpr size_t ITERATIONS = 20;
+static constexpr int TOLERANCE = 6;
+
+struct bar
+{
+	const char* name;
+	uint8_t rgb[3];
+	uint8_t yuv[3]; // BT.601 limited range
+};
+
+static const bar BARS[] = {
+	{ "white", { 255, 255, 255 }, { 235, 128, 128 } },
+	{ "red", { 255, 0, 0 }, { 81, 90, 240 } },
+	{ "blue", { 0, 0, 255 }, { 41, 240, 110 } },
+	{ "black", { 0, 0, 0 }, { 16, 128, 128 } }
+};
+
+static constexpr uint32_t BARS_COUNT = sizeof(BARS) / sizeof(BARS[0]);
+
+static Imaging::Image create_bars()
+{
+	const uint32_t chroma_width = WIDTH / 2;
+	const uint32_t chroma_height = HEIGHT / 2;
+	utils::ref_count_ptr<utils::imaging::ref_count_image> image = utils::make_ref_count_ptr<utils::imaging::ref_count_image>(
+		core::imaging::image_params{ WIDTH, HEIGHT, WIDTH * HEIGHT + chroma_width * chroma_height * 2, Imaging::PixelFormat::I420 });
+
+	Imaging::Image frame(image);
+	uint8_t* luma = frame.Buffer();
+	uint8_t* u = luma + WIDTH * HEIGHT;
+	uint8_t* v = u + chroma_width * chroma_height;
+	for (uint32_t y = 0; y < HEIGHT; y++)
+	{
+		for (uint32_t x = 0; x < WIDTH; x++)
+			luma[y * WIDTH + x] = BARS[x * BARS_COUNT / WIDTH].yuv[0];
+	}
+
+	for (uint32_t y = 0; y < chroma_height; y++)
+	{
+		for (uint32_t x = 0; x < chroma_width; x++)
+		{
+			u[y * chroma_width + x] = BARS[x * BARS_COUNT / chroma_width].yuv[1];
+			v[y * chroma_width + x] = BARS[x * BARS_COUNT / chroma_width].yuv[2];
+		}
+	}
+
+	return frame;
+}
+
+// The middle of every bar of an RGBA image holds the color of the bar (its gray level for gray formats)
+static bool check_bars(const Imaging::Image& rgba, bool gray)
+{
+	for (uint32_t i = 0; i < BARS_COUNT; i++)
+	{
+		const bar& expected = BARS[i];
+		uint32_t x = (2 * i + 1) * rgba.Width() / (2 * BARS_COUNT);
+		const uint8_t* pixel = rgba.Buffer() + (rgba.Height() / 2 * rgba.Width() + x) * 4;
+		for (size_t channel = 0; channel < 3; channel++)
+		{
+			int level = gray ?
+				(77 * expected.rgb[0] + 150 * expected.rgb[1] + 29 * expected.rgb[2] + 128) >> 8 :
+				expected.rgb[channel];
+
+			if (std::abs(pixel[channel] - level) > TOLERANCE)
+			{
+				Core::Console::ColorPrint(false, true, Core::Console::Colors::RED, "\n%s bar: channel %u is %u instead of %d",
+					expected.name, static_cast<unsigned>(channel), static_cast<unsigned>(pixel[channel]), level);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static double measure(Imaging::ImageAlgorithm& converter, const Imaging::Image& input, Imaging::Image& output)
+{
+	// The first conversion fills the pools of the converter
+	output = converter.Apply(input);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < ITERATIONS; i++)
+		output = converter.Apply(input);
+
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+}
+
+int main()
+{
+	struct format
+	{
+		const char* name;
+		Imaging::PixelFormat format;
+	};
+
+	const format formats[] = {
+		{ "RGB", Imaging::PixelFormat::RGB },
+		{ "RGBA", Imaging::PixelFormat::RGBA },
+		{ "BGR", Imaging::PixelFormat::BGR },
+		{ "BGRA", Imaging::PixelFormat::BGRA },
+		{ "I420", Imaging::PixelFormat::I420 },
+		{ "NV12", Imaging::PixelFormat::NV12 },
+		{ "YUY2", Imaging::PixelFormat::YUY2 },
+		{ "UYVY", Imaging::PixelFormat::UYVY },
+		{ "GRAY8", Imaging::PixelFormat::GRAY8 },
+		{ "GRAY16_LE", Imaging::PixelFormat::GRAY16_LE }
+	};
+
+	Imaging::Image frame = create_bars();
+	Imaging::ImageAlgorithm to_rgba = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA);
+	bool same = true;
+	for (const format& target : formats)
+	{
+		// I420 into the format, then the format back into RGBA
+		Imaging::ImageAlgorithm converter = Imaging::ImageConverterAlgorithm::Create(target.format);
+		Imaging::Image converted;
+		double to_format = measure(converter, frame, converted);
+		Imaging::Image rgba;
+		double from_format = measure(to_rgba, converted, rgba);
+		bool gray = target.format == Imaging::PixelFormat::GRAY8 || target.format == Imaging::PixelFormat::GRAY16_LE;
+		bool valid = converted.Format() == target.format && check_bars(rgba, gray);
+		same = same && valid;
+		Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+			"\nI420 -> %-10s %6.2f ms, %-10s -> RGBA %6.2f ms%s", target.name, to_format, target.name, from_format,
+			valid ? "" : " WRONG COLORS");
+	}
+
+	// Conversion and resize in a single pass
+	Imaging::ImageAlgorithm resizing = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA, 1280, 720);
+	Imaging::Image resized;
+	double resize = measure(resizing, frame, resized);
+	bool valid = resized.Width() == 1280 && resized.Height() == 720 && check_bars(resized, false);
+	same = same && valid;
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+		"\nI420 %ux%u -> RGBA 1280x720 %6.2f ms%s", static_cast<unsigned>(WIDTH), static_cast<unsigned>(HEIGHT), resize,
+		valid ? "" : " WRONG COLORS");
+
+	Core::Console::ColorPrint(false, true, same ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\ncolor bars %s every conversion\n", same ? "survive" : "DO NOT survive");
+	return same ? 0 : 1;
+}
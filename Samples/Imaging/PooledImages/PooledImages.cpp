@@ -0,0 +1,172 @@
+// PooledImages.cpp : Converts a 60 fps stream of frames with ImageConverterAlgorithm, keeping a few converted frames in
+// flight, and counts the large allocations made once the stream reached its steady state: with the converter's own pool,
+// with a PooledBufferAllocator and with ApplyInto filling the frames of the stream in place.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <utils/imaging.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include <vector>
+
+static constexpr uint32_t WIDTH = 1920;
+static constexpr uint32_t HEIGHT = 1080;
+static constexpr uint32_t TARGET_WIDTH = 1280;
+static constexpr uint32_t TARGET_HEIGHT = 720;
+static constexpr size_t FRAMES_IN_FLIGHT = 3;
+static constexpr size_t WARM_UP_FRAMES = 60;
+static constexpr size_t FRAMES = 600; // 10 seconds at 60 fps
+static constexpr size_t LARGE_ALLOCATION = 64 * 1024;
+
+static std::atomic<size_t> g_large_allocations(0);
+static std::atomic<size_t> g_large_bytes(0);
+
+void* operator new(size_t size)
+{
+	if (size >= LARGE_ALLOCATION)
+	{
+		g_large_allocations++;
+		g_large_bytes += size;
+	}
+
+	void* pointer = std::malloc(size == 0 ? 1 : size);
+	if (pointer == nullptr)
+		throw std::bad_alloc();
+
+	return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+struct allocations
+{
+	size_t count;
+	size_t bytes;
+};
+
+static allocations query_allocations()
+{
+	return allocations{ g_large_allocations.load(), g_large_bytes.load() };
+}
+
+static Imaging::Image create_frame()
+{
+	utils::ref_count_ptr<utils::imaging::ref_count_image> image = utils::make_ref_count_ptr<utils::imaging::ref_count_image>(
+		core::imaging::image_params{ WIDTH, HEIGHT, WIDTH * HEIGHT * 3 / 2, Imaging::PixelFormat::I420 });
+
+	Imaging::Image frame(image);
+	uint8_t* pixel = frame.Buffer();
+	for (size_t i = 0; i < static_cast<size_t>(WIDTH) * HEIGHT * 3 / 2; i++)
+		pixel[i] = static_cast<uint8_t>(i * 7);
+
+	return frame;
+}
+
+static void print(const char* title, const allocations& warm_up, const allocations& steady)
+{
+	Core::Console::ColorPrint(false, true, steady.count == 0 ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+		"\n%-28s %8.1f MB while warming up, %6u large allocations (%.1f MB) in %u frames", title,
+		static_cast<double>(warm_up.bytes) / (1024 * 1024), static_cast<unsigned>(steady.count),
+		static_cast<double>(steady.bytes) / (1024 * 1024), static_cast<unsigned>(FRAMES));
+}
+
+// Converts the stream with Apply, a converted frame is released once FRAMES_IN_FLIGHT newer frames were converted
+static bool stream(const char* title, Imaging::ImageAlgorithm converter, const Imaging::Image& frame)
+{
+	std::deque<Imaging::Image> in_flight;
+	allocations start = query_allocations();
+	allocations warm_up = {};
+	for (size_t i = 0; i < WARM_UP_FRAMES + FRAMES; i++)
+	{
+		if (i == WARM_UP_FRAMES)
+		{
+			allocations now = query_allocations();
+			warm_up = allocations{ now.count - start.count, now.bytes - start.bytes };
+			start = now;
+		}
+
+		in_flight.push_back(converter.Apply(frame));
+		if (in_flight.back().Empty() == true)
+			return false;
+
+		if (in_flight.size() > FRAMES_IN_FLIGHT)
+			in_flight.pop_front();
+	}
+
+	allocations now = query_allocations();
+	allocations steady = { now.count - start.count, now.bytes - start.bytes };
+	print(title, warm_up, steady);
+	return steady.count == 0;
+}
+
+// Converts the stream with ApplyInto, into FRAMES_IN_FLIGHT frames used in turn
+static bool stream_into(const char* title, Imaging::ImageAlgorithm converter, const Imaging::Image& frame)
+{
+	allocations start = query_allocations();
+	std::vector<Imaging::Image> frames;
+	for (size_t i = 0; i < FRAMES_IN_FLIGHT; i++)
+	{
+		utils::ref_count_ptr<core::imaging::image_interface> image = utils::make_ref_count_ptr<utils::imaging::ref_count_image>(
+			core::imaging::image_params{ TARGET_WIDTH, TARGET_HEIGHT, TARGET_WIDTH * TARGET_HEIGHT * 4, Imaging::PixelFormat::RGBA });
+		frames.emplace_back(image);
+	}
+
+	allocations warm_up = {};
+	for (size_t i = 0; i < WARM_UP_FRAMES + FRAMES; i++)
+	{
+		if (i == WARM_UP_FRAMES)
+		{
+			allocations now = query_allocations();
+			warm_up = allocations{ now.count - start.count, now.bytes - start.bytes };
+			start = now;
+		}
+
+		if (converter.ApplyInto(frame, frames[i % FRAMES_IN_FLIGHT]) == false)
+			return false;
+	}
+
+	allocations now = query_allocations();
+	allocations steady = { now.count - start.count, now.bytes - start.bytes };
+	print(title, warm_up, steady);
+	return steady.count == 0;
+}
+
+int main()
+{
+	Imaging::Image frame = create_frame();
+	bool valid = true;
+
+	valid = stream("converter pool:",
+		Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA, TARGET_WIDTH, TARGET_HEIGHT, 2), frame) && valid;
+
+	// Room for the frames in flight and the one being converted
+	Buffers::BufferAllocator allocator = Buffers::PooledBufferAllocator::Create(
+		static_cast<size_t>(TARGET_WIDTH) * TARGET_HEIGHT * 4 * (FRAMES_IN_FLIGHT + 1));
+	valid = stream("pooled buffer allocator:",
+		Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA, TARGET_WIDTH, TARGET_HEIGHT, 2, allocator), frame) && valid;
+
+	valid = stream_into("apply into frames:",
+		Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA, TARGET_WIDTH, TARGET_HEIGHT, 2), frame) && valid;
+
+	// A frame of other parameters than the converted ones is refused
+	utils::ref_count_ptr<core::imaging::image_interface> image = utils::make_ref_count_ptr<utils::imaging::ref_count_image>(
+		core::imaging::image_params{ WIDTH, HEIGHT, WIDTH * HEIGHT * 4, Imaging::PixelFormat::RGBA });
+	Imaging::Image wrong_size(image);
+	valid = Imaging::ImageConverterAlgorithm::Create(Imaging::PixelFormat::RGBA, TARGET_WIDTH, TARGET_HEIGHT).ApplyInto(frame, wrong_size) == false && valid;
+
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nsteady state conversions %s\n", valid ? "do not allocate" : "ALLOCATE");
+	return valid ? 0 : 1;
+}
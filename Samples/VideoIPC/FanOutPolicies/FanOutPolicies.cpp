@@ -0,0 +1,280 @@
+// FanOutPolicies.cpp : Publishes numbered frames through a LOCK_FREE shared memory session to a fast subscriber and to slow
+// subscribers reading with each reader policy, waits for the LOSSLESS subscriber when the pool is full (backpressure)
+// and compares the frames every subscriber received with the statistics of its reader.
+// Then publishes frames through a SharedMemoryVideoPublisher to a slow LOSSLESS subscriber, with and without the
+// backpressure of its frame allocator (EnableBackpressure): the publisher waits for it instead of dropping frames.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <utils/video.hpp>
+
+#include <shared_memory_streaming.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t POOL_SIZE = 8;
+static constexpr uint32_t BUFFER_SIZE = 4096;
+static constexpr uint64_t FRAMES = 300;
+static constexpr std::chrono::microseconds FRAME_INTERVAL(1000);
+static constexpr uint32_t MAX_LAG = 2;
+static constexpr uint32_t BACKPRESSURE_TIMEOUT_MS = 1000;
+
+struct subscriber
+{
+	const char* name;
+	shared_memory::reader_policy policy;
+	uint32_t max_lag;
+	std::chrono::microseconds hold;
+
+	// What it received, written by its player thread
+	uint64_t received;
+	uint64_t missed;	// Including the frames published before the first one received
+	uint64_t last;
+	bool ordered;
+	uint32_t max_lag_seen;
+	shared_memory::reader_statistics statistics;
+};
+
+static int64_t now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class frame : public utils::video::frame_base<core::video::frame_interface>
+{
+public:
+	frame(uint64_t frame_id, core::buffer_interface* buffer) :
+		frame_base(core::imaging::image_params{ BUFFER_SIZE / 4, 1, BUFFER_SIZE / 4, core::imaging::pixel_format::GRAY8 },
+			core::video::display_params{ 0, frame_id, 0, 0, frame_id }, core::video::video_params{}, buffer)
+	{
+	}
+};
+
+// A source raising the frames it is given, synchronously: raise returns once the publisher is done with the frame
+class manual_source : public utils::ref_count_base<utils::video::video_source_base<core::video::video_source_interface>>
+{
+private:
+	std::atomic<core::video::video_state> m_state;
+
+public:
+	manual_source() :
+		m_state(core::video::video_state::STOPPED)
+	{
+	}
+
+	void raise(core::video::frame_interface* current)
+	{
+		raise_frame(current, false);
+	}
+
+	virtual core::video::video_state state() override
+	{
+		return m_state;
+	}
+
+	virtual void start() override
+	{
+		m_state = core::video::video_state::PLAYING;
+	}
+
+	virtual void stop() override
+	{
+		m_state = core::video::video_state::STOPPED;
+	}
+
+	virtual void pause() override
+	{
+		m_state = core::video::video_state::PAUSED;
+	}
+};
+
+// Publishes FRAMES frames to a slow LOSSLESS subscriber through the pool of a frame allocator, returns whether the
+// publisher dropped frames (without backpressure) or waited for the subscriber to get every one of them (with it)
+static bool publisher_backpressure(bool backpressure)
+{
+	const char* name = "fan_out_backpressure";
+	Video::FrameAllocator allocator = Video::Publishers::SharedMemoryFrameAllocator::Create(name, BUFFER_SIZE, POOL_SIZE, true);
+	if (backpressure == true && allocator.EnableBackpressure(BACKPRESSURE_TIMEOUT_MS) == false)
+		return false;
+
+	utils::ref_count_ptr<manual_source> source = utils::make_ref_count_ptr<manual_source>();
+	Video::VideoPublisher publisher = Video::Publishers::SharedMemoryVideoPublisher::Create(allocator, Video::VideoSource(source));
+	publisher.Start();
+
+	// The frame ID follows the image parameters in a published buffer
+	uint64_t received = 0;
+	uint64_t last = 0;
+	bool ordered = true;
+	utils::ref_count_ptr<shared_memory::shm_session> reader = utils::make_ref_count_ptr<shared_memory::shm_session>(name);
+	utils::ref_count_ptr<shared_memory::shm_session_player> player =
+		utils::make_ref_count_ptr<shared_memory::shm_session_player>(reader, 0, shared_memory::reader_policy::LOSSLESS, 0);
+	player->OnBuffer += [&](uint32_t, core::buffer_interface* buffer)
+	{
+		core::video::display_params display_params;
+		std::memcpy(&display_params, buffer->data() + sizeof(core::imaging::image_params), sizeof(display_params));
+		ordered = ordered && (display_params.frame_id > last);
+		last = display_params.frame_id;
+		received++;
+
+		std::this_thread::sleep_for(std::chrono::microseconds(3000));
+	};
+
+	player->start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+	Buffers::BufferAllocator heap = Buffers::PooledBufferAllocator::Create(static_cast<size_t>(BUFFER_SIZE) * POOL_SIZE);
+	int64_t start = now();
+	for (uint64_t i = 1; i <= FRAMES; i++)
+	{
+		std::this_thread::sleep_for(FRAME_INTERVAL);
+
+		Buffers::Buffer buffer = heap.Allocate(BUFFER_SIZE / 4);
+		source->raise(utils::make_ref_count_ptr<frame>(i, static_cast<core::buffer_interface*>(buffer)));
+	}
+
+	int64_t elapsed = now() - start;
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+	player->stop();
+
+	Video::VideoStatistics statistics = {};
+	publisher.QueryStatistics(statistics);
+	publisher.Stop();
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n%-17s %9llu published %9llu dropped, lossless subscriber received %llu %s, publishing took %.1f ms",
+		backpressure ? "backpressure" : "no backpressure",
+		static_cast<unsigned long long>(statistics.frames), static_cast<unsigned long long>(statistics.dropped),
+		static_cast<unsigned long long>(received), ordered ? "in order" : "OUT OF ORDER", static_cast<double>(elapsed) / 1000.0);
+
+	if (backpressure == true)
+		return statistics.frames == FRAMES && statistics.dropped == 0 && received == FRAMES && ordered == true;
+
+	return statistics.dropped != 0 && statistics.frames + statistics.dropped == FRAMES && received == statistics.frames && ordered == true;
+}
+
+int main()
+{
+	const char* name = "fan_out_policies";
+	shared_memory::shm_pool_params params{ 0, POOL_SIZE, BUFFER_SIZE, shared_memory::publication_mode::LOCK_FREE };
+	utils::ref_count_ptr<shared_memory::shm_session> session =
+		utils::make_ref_count_ptr<shared_memory::shm_session>(name, &params, static_cast<uint32_t>(1));
+
+	subscriber subscribers[] = {
+		{ "fast latest-only", shared_memory::reader_policy::LATEST_ONLY, 0, std::chrono::microseconds(0), 0, 0, 0, true, 0, {} },
+		{ "slow latest-only", shared_memory::reader_policy::LATEST_ONLY, 0, std::chrono::microseconds(4000), 0, 0, 0, true, 0, {} },
+		{ "slow bounded lag", shared_memory::reader_policy::BOUNDED_LAG, MAX_LAG, std::chrono::microseconds(3000), 0, 0, 0, true, 0, {} },
+		{ "slow lossless", shared_memory::reader_policy::LOSSLESS, 0, std::chrono::microseconds(3000), 0, 0, 0, true, 0, {} }
+	};
+
+	// A session per subscriber, as in separate processes
+	std::vector<utils::ref_count_ptr<shared_memory::shm_session_player>> players;
+	for (subscriber& current : subscribers)
+	{
+		utils::ref_count_ptr<shared_memory::shm_session> reader = utils::make_ref_count_ptr<shared_memory::shm_session>(name);
+		utils::ref_count_ptr<shared_memory::shm_session_player> player =
+			utils::make_ref_count_ptr<shared_memory::shm_session_player>(reader, 0, current.policy, current.max_lag);
+
+		shared_memory::shm_session_player* instance = player;
+		player->OnBuffer += [&current, instance](uint32_t, core::buffer_interface* buffer)
+		{
+			uint64_t number;
+			std::memcpy(&number, buffer->data(), sizeof(uint64_t));
+			current.ordered = current.ordered && (number > current.last);
+			current.missed += number - current.last - 1;
+
+			current.last = number;
+			current.received++;
+
+			shared_memory::reader_statistics statistics;
+			if (instance->query_statistics(statistics) == true)
+				current.max_lag_seen = std::max(current.max_lag_seen, statistics.lag);
+
+			if (current.hold.count() != 0)
+				std::this_thread::sleep_for(current.hold);
+		};
+
+		player->start();
+		players.emplace_back(player);
+	}
+
+	// Letting the subscribers attach their readers
+	std::vector<shared_memory::reader_statistics> readers;
+	for (uint32_t i = 0; i < 100 && readers.size() < players.size(); i++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		session->query_readers(0, readers);
+	}
+
+	int64_t blocked = 0;
+	uint64_t dropped = 0;
+	for (uint64_t i = 1; i <= FRAMES; i++)
+	{
+		std::this_thread::sleep_for(FRAME_INTERVAL);
+
+		int64_t start = now();
+		utils::ref_count_ptr<shared_memory::shm_sharable_buffer_interface> buffer;
+		if (session->wait_for_buffer_unique(0, shared_memory::TIMEOUT_BEFORE_REMAPPING, &buffer) != shared_memory::error_codes::SHM_NO_ERROR)
+		{
+			dropped++;
+			continue;
+		}
+
+		blocked += now() - start;
+		std::memcpy(buffer->data(), &i, sizeof(uint64_t));
+		session->publish(buffer);
+	}
+
+	// Letting the slow subscribers drain, then collecting the statistics of their readers
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+	for (size_t i = 0; i < players.size(); i++)
+	{
+		players[i]->query_statistics(subscribers[i].statistics);
+		players[i]->stop();
+	}
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n%-17s %9s %9s %9s %8s %8s %14s %14s", "subscriber", "received", "delivered", "dropped", "ordered", "max lag",
+		"hold mean (us)", "hold max (us)");
+
+	bool valid = (dropped == 0);
+	for (subscriber& current : subscribers)
+	{
+		const shared_memory::reader_statistics& statistics = current.statistics;
+
+		// The frames a subscriber did not receive are the drops of its reader, the policies hold
+		bool consistent = (statistics.delivered == current.received && statistics.dropped == current.missed);
+		consistent = consistent && current.ordered && current.last == FRAMES;
+		if (current.policy == shared_memory::reader_policy::BOUNDED_LAG)
+			consistent = consistent && current.max_lag_seen <= current.max_lag;
+		else if (current.policy == shared_memory::reader_policy::LOSSLESS)
+			consistent = consistent && current.received == FRAMES && statistics.dropped == 0;
+
+		valid = valid && consistent;
+		Core::Console::ColorPrint(false, true, consistent ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+			"\n%-17s %9llu %9llu %9llu %8s %8u %14.1f %14.1f", current.name,
+			static_cast<unsigned long long>(current.received), static_cast<unsigned long long>(statistics.delivered),
+			static_cast<unsigned long long>(statistics.dropped), current.ordered ? "yes" : "NO", current.max_lag_seen,
+			(statistics.delivered != 0) ? static_cast<double>(statistics.hold_time) / static_cast<double>(statistics.delivered) : 0.0,
+			static_cast<double>(statistics.max_hold_time));
+	}
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n\npublisher: %llu frames, %llu dropped, %.1f ms waiting for the lossless subscriber",
+		static_cast<unsigned long long>(FRAMES), static_cast<unsigned long long>(dropped), static_cast<double>(blocked) / 1000.0);
+
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthe subscribers %s their reader policies\n", valid ? "followed" : "DID NOT follow");
+
+	bool waited = publisher_backpressure(false);
+	waited = publisher_backpressure(true) && waited;
+	Core::Console::ColorPrint(false, true, waited ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthe publisher %s for the lossless subscriber only with backpressure\n", waited ? "waited" : "DID NOT wait");
+	return (valid && waited) ? 0 : 1;
+}
@@ -0,0 +1,304 @@
+// FrameCompression.cpp : Compresses test source patterns (color bars, a ball moving over color bars and snow) in RGBA and
+// I420 with a utils::video::frame_codec over LZ4 per plane, per tile and per plane with deltas, measures the ratio and the
+// encode and decode MB/s and checks every frame decodes back. Then publishes compressed frames through shared memory and
+// checks a subscriber decodes them.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <compression/lz4_compression_interface.h>
+#include <utils/video.hpp>
+#include <utils/frame_codec.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t WIDTH = 1280;
+static constexpr uint32_t HEIGHT = 720;
+static constexpr uint32_t FRAMES = 60;
+static constexpr uint32_t KEYFRAME_INTERVAL = 30;
+
+enum class pattern
+{
+	BARS,
+	BALL,
+	SNOW
+};
+
+static const uint8_t BARS_RGB[][3] = {
+	{ 192, 192, 192 }, { 192, 192, 0 }, { 0, 192, 192 }, { 0, 192, 0 }, { 192, 0, 192 }, { 192, 0, 0 }, { 0, 0, 192 }
+};
+
+static core::imaging::image_params params_of(core::imaging::pixel_format format)
+{
+	uint32_t size = (format == core::imaging::pixel_format::RGBA) ? WIDTH * HEIGHT * 4 : (WIDTH * HEIGHT * 3) / 2;
+	return core::imaging::image_params{ WIDTH, HEIGHT, size, format };
+}
+
+// Frame 'index' of a pattern, as videotestsrc draws them
+static void draw(pattern current, core::imaging::pixel_format format, uint32_t index, std::mt19937& random, uint8_t* data)
+{
+	uint32_t ball_x = (index * 16) % (WIDTH - 64);
+	uint32_t ball_y = (index * 9) % (HEIGHT - 64);
+	for (uint32_t y = 0; y < HEIGHT; y++)
+	{
+		for (uint32_t x = 0; x < WIDTH; x++)
+		{
+			const uint8_t* bar = BARS_RGB[(x * 7) / WIDTH];
+			uint8_t rgb[3] = { bar[0], bar[1], bar[2] };
+			if (current == pattern::SNOW)
+			{
+				uint8_t value = static_cast<uint8_t>(random());
+				rgb[0] = rgb[1] = rgb[2] = value;
+			}
+			else if (current == pattern::BALL && x - ball_x < 64 && y - ball_y < 64)
+			{
+				rgb[0] = rgb[1] = rgb[2] = 255;
+			}
+
+			if (format == core::imaging::pixel_format::RGBA)
+			{
+				uint8_t* pixel = data + ((static_cast<size_t>(y) * WIDTH + x) * 4);
+				pixel[0] = rgb[0];
+				pixel[1] = rgb[1];
+				pixel[2] = rgb[2];
+				pixel[3] = 255;
+				continue;
+			}
+
+			// I420, BT.601
+			data[static_cast<size_t>(y) * WIDTH + x] = static_cast<uint8_t>(16 + ((66 * rgb[0] + 129 * rgb[1] + 25 * rgb[2]) >> 8));
+			if ((x % 2) == 0 && (y % 2) == 0)
+			{
+				size_t chroma = (static_cast<size_t>(y / 2) * (WIDTH / 2)) + (x / 2);
+				data[WIDTH * HEIGHT + chroma] = static_cast<uint8_t>(128 + ((-38 * rgb[0] - 74 * rgb[1] + 112 * rgb[2]) >> 8));
+				data[WIDTH * HEIGHT + (WIDTH * HEIGHT) / 4 + chroma] = static_cast<uint8_t>(128 + ((112 * rgb[0] - 94 * rgb[1] - 18 * rgb[2]) >> 8));
+			}
+		}
+	}
+}
+
+struct configuration
+{
+	const char* name;
+	utils::video::frame_codec::chunking chunks;
+	uint32_t keyframe_interval;
+};
+
+struct results
+{
+	double ratio;
+	double encode_mbps;
+	double decode_mbps;
+	bool intact;
+};
+
+static results measure(pattern current, core::imaging::pixel_format format, const configuration& config, core::compression_interface* compression)
+{
+	core::imaging::image_params params = params_of(format);
+	utils::ref_count_ptr<utils::video::frame_codec> encoder = utils::make_ref_count_ptr<utils::video::frame_codec>(compression, config.chunks, config.keyframe_interval);
+	utils::ref_count_ptr<utils::video::frame_codec> decoder = utils::make_ref_count_ptr<utils::video::frame_codec>(compression, config.chunks, config.keyframe_interval);
+
+	std::mt19937 random(1);
+	std::vector<std::vector<uint8_t>> frames(FRAMES, std::vector<uint8_t>(params.size));
+	for (uint32_t i = 0; i < FRAMES; i++)
+		draw(current, format, i, random, frames[i].data());
+
+	std::vector<std::vector<uint8_t>> encoded(FRAMES, std::vector<uint8_t>(encoder->max_encoded_size(params)));
+	std::vector<size_t> sizes(FRAMES);
+	std::vector<uint8_t> decoded(params.size);
+
+	results retval{ 0, 0, 0, true };
+	size_t total = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < FRAMES; i++)
+	{
+		retval.intact = encoder->encode(params, frames[i].data(), encoded[i].data(), encoded[i].size(), sizes[i]) && retval.intact;
+		total += sizes[i];
+	}
+
+	double encoding = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double decoding = 0;
+	for (uint32_t i = 0; i < FRAMES; i++)
+	{
+		start = std::chrono::steady_clock::now();
+		bool decoded_frame = decoder->decode(params, encoded[i].data(), sizes[i], decoded.data());
+		decoding += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		retval.intact = retval.intact && decoded_frame && std::memcmp(decoded.data(), frames[i].data(), params.size) == 0;
+	}
+
+	double megabytes = static_cast<double>(params.size) * FRAMES / (1024.0 * 1024.0);
+	retval.ratio = static_cast<double>(params.size) * FRAMES / static_cast<double>(total);
+	retval.encode_mbps = megabytes / encoding;
+	retval.decode_mbps = megabytes / decoding;
+	return retval;
+}
+
+class frame : public utils::video::frame_base<core::video::frame_interface>
+{
+public:
+	frame(const core::imaging::image_params& image_params, uint64_t frame_id, core::buffer_interface* buffer) :
+		frame_base(image_params, core::video::display_params{ 0, frame_id, 0, 0, frame_id }, core::video::video_params{}, buffer)
+	{
+	}
+};
+
+// A source raising the frames it is given, synchronously
+class manual_source : public utils::ref_count_base<utils::video::video_source_base<core::video::video_source_interface>>
+{
+private:
+	std::atomic<core::video::video_state> m_state;
+
+public:
+	manual_source() :
+		m_state(core::video::video_state::STOPPED)
+	{
+	}
+
+	void raise(core::video::frame_interface* current)
+	{
+		raise_frame(current, false);
+	}
+
+	virtual core::video::video_state state() override
+	{
+		return m_state;
+	}
+
+	virtual void start() override
+	{
+		m_state = core::video::video_state::PLAYING;
+	}
+
+	virtual void stop() override
+	{
+		m_state = core::video::video_state::STOPPED;
+	}
+
+	virtual void pause() override
+	{
+		m_state = core::video::video_state::PAUSED;
+	}
+};
+
+// Publishes the ball pattern compressed with deltas, the subscriber gets the frames decoded
+static bool publish_compressed(size_t& received, size_t& intact)
+{
+	const char* name = "frame_compression";
+	core::imaging::image_params params = params_of(core::imaging::pixel_format::I420);
+
+	Video::FrameAllocator allocator = Video::Publishers::SharedMemoryFrameAllocator::Create(name, params.size + 4096, 8, true);
+	if (allocator.EnableCompression(false, KEYFRAME_INTERVAL) == false)
+		return false;
+
+	utils::ref_count_ptr<manual_source> source = utils::make_ref_count_ptr<manual_source>();
+	Video::VideoPublisher publisher = Video::Publishers::SharedMemoryVideoPublisher::Create(allocator, Video::VideoSource(source));
+	publisher.Start();
+
+	std::mt19937 random(1);
+	std::vector<std::vector<uint8_t>> frames(FRAMES, std::vector<uint8_t>(params.size));
+	for (uint32_t i = 0; i < FRAMES; i++)
+		draw(pattern::BALL, params.format, i, random, frames[i].data());
+
+	std::atomic<size_t> received_frames(0);
+	std::atomic<size_t> intact_frames(0);
+	Video::VideoSource subscriber = Video::Sources::SharedMemoryVideoSource::Create(name);
+	subscriber.OnFrame() += [&](const Video::Frame& current)
+	{
+		received_frames++;
+		Video::Frame received_frame = current;
+		uint64_t index = received_frame.PTS();
+		if (index < FRAMES && current.Size() == params.size && std::memcmp(current.Buffer(), frames[index].data(), params.size) == 0)
+			intact_frames++;
+	};
+
+	subscriber.Start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+	for (uint32_t i = 0; i < FRAMES; i++)
+	{
+		utils::ref_count_ptr<core::buffer_interface> buffer = utils::make_ref_count_ptr<utils::ref_count_buffer>(frames[i]);
+		source->raise(utils::make_ref_count_ptr<frame>(params, i, buffer));
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	subscriber.Stop();
+	publisher.Stop();
+
+	received = received_frames;
+	intact = intact_frames;
+	return true;
+}
+
+int main()
+{
+	utils::ref_count_ptr<core::compression_interface> compression;
+	if (compression::lz4_compression_interface::create(1, &compression) == false)
+		return 1;
+
+	const struct
+	{
+		const char* name;
+		pattern value;
+	} patterns[] = {
+		{ "bars", pattern::BARS },
+		{ "ball", pattern::BALL },
+		{ "snow", pattern::SNOW }
+	};
+
+	const struct
+	{
+		const char* name;
+		core::imaging::pixel_format value;
+	} formats[] = {
+		{ "RGBA", core::imaging::pixel_format::RGBA },
+		{ "I420", core::imaging::pixel_format::I420 }
+	};
+
+	const configuration configurations[] = {
+		{ "per plane", utils::video::frame_codec::chunking::PER_PLANE, 0 },
+		{ "per tile", utils::video::frame_codec::chunking::PER_TILE, 0 },
+		{ "per plane + delta", utils::video::frame_codec::chunking::PER_PLANE, KEYFRAME_INTERVAL }
+	};
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n%-8s %-6s %-18s %9s %14s %14s %8s", "pattern", "format", "chunks", "ratio", "encode (MB/s)", "decode (MB/s)", "intact");
+
+	bool valid = true;
+	for (const auto& current_pattern : patterns)
+	{
+		for (const auto& format : formats)
+		{
+			for (const configuration& config : configurations)
+			{
+				results measured = measure(current_pattern.value, format.value, config, compression);
+				valid = valid && measured.intact;
+
+				Core::Console::ColorPrint(false, true, measured.intact ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+					"\n%-8s %-6s %-18s %9.1f %14.0f %14.0f %8s", current_pattern.name, format.name, config.name,
+					measured.ratio, measured.encode_mbps, measured.decode_mbps, measured.intact ? "yes" : "NO");
+			}
+		}
+	}
+
+	size_t received = 0;
+	size_t intact = 0;
+	bool published = publish_compressed(received, intact);
+	bool subscribed = published && received > FRAMES / 2 && intact == received;
+	valid = valid && subscribed;
+
+	Core::Console::ColorPrint(false, true, subscribed ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+		"\n\nshared memory, ball I420 per plane + delta: %zu/%u frames received, %zu decoded intact", received, FRAMES, intact);
+
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nframes %s\n", valid ? "decoded intact" : "DID NOT decode intact");
+	return valid ? 0 : 1;
+}
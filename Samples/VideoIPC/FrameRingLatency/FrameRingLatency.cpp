@@ -0,0 +1,159 @@
+// FrameRingLatency.cpp : Publishes timestamped frames through a shared memory session in LOCKED and LOCK_FREE modes to 1
+// and 3 subscribers, one of them holding every frame for a while, and measures the publish-to-wake latency of the
+// subscribers and how long publishing takes the publisher.
+//
+#include <Core.hpp>
+
+#include <shared_memory_streaming.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t POOL_SIZE = 8;
+static constexpr uint32_t BUFFER_SIZE = 4096;
+static constexpr size_t FRAMES = 500;
+static constexpr std::chrono::microseconds FRAME_INTERVAL(1000);
+static constexpr std::chrono::microseconds SLOW_SUBSCRIBER_HOLD(5000);
+
+struct mode
+{
+	const char* name;
+	shared_memory::publication_mode publication;
+};
+
+static const mode MODES[] = {
+	{ "LOCKED", shared_memory::publication_mode::LOCKED },
+	{ "LOCK_FREE", shared_memory::publication_mode::LOCK_FREE }
+};
+
+static const uint32_t SUBSCRIBERS[] = { 1, 3 };
+
+static int64_t now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double percentile(std::vector<int64_t>& values, double fraction)
+{
+	if (values.empty())
+		return 0;
+
+	std::sort(values.begin(), values.end());
+	return static_cast<double>(values[std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size())))]) / 1000.0;
+}
+
+struct results
+{
+	std::vector<int64_t> latencies;
+	std::vector<int64_t> publishing;
+	size_t dropped;
+	size_t received;
+};
+
+static results run(const mode& current, uint32_t subscribers)
+{
+	const char* name = "frame_ring_latency";
+	shared_memory::shm_pool_params params{ 0, POOL_SIZE, BUFFER_SIZE, current.publication };
+	utils::ref_count_ptr<shared_memory::shm_session> session =
+		utils::make_ref_count_ptr<shared_memory::shm_session>(name, &params, static_cast<uint32_t>(1));
+
+	results retval;
+	retval.dropped = 0;
+	retval.received = 0;
+
+	std::mutex mutex;
+	std::atomic<bool> running(true);
+	std::vector<std::thread> threads;
+	for (uint32_t i = 0; i < subscribers; i++)
+	{
+		// The last subscriber of several holds its frames longer than the publisher interval
+		bool slow = (subscribers > 1 && i == subscribers - 1);
+		threads.emplace_back([&, slow]()
+		{
+			utils::ref_count_ptr<shared_memory::shm_session> reader = utils::make_ref_count_ptr<shared_memory::shm_session>(name);
+			std::vector<int64_t> latencies;
+			while (running == true)
+			{
+				utils::ref_count_ptr<core::buffer_interface> buffer;
+				if (reader->wait_for_buffer_share(0, shared_memory::MAX_BLOCKING_TIME_MS, &buffer) != shared_memory::error_codes::SHM_NO_ERROR)
+					continue;
+
+				int64_t woken = now();
+				int64_t published;
+				std::memcpy(&published, buffer->data(), sizeof(int64_t));
+				if (slow == false)
+					latencies.push_back(woken - published);
+				else
+					std::this_thread::sleep_for(SLOW_SUBSCRIBER_HOLD);
+			}
+
+			std::lock_guard<std::mutex> locker(mutex);
+			retval.received += latencies.size();
+			retval.latencies.insert(retval.latencies.end(), latencies.begin(), latencies.end());
+		});
+	}
+
+	// Letting the subscribers map the session and start waiting
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+	for (size_t i = 0; i < FRAMES; i++)
+	{
+		std::this_thread::sleep_for(FRAME_INTERVAL);
+
+		int64_t start = now();
+		utils::ref_count_ptr<shared_memory::shm_sharable_buffer_interface> buffer;
+		if (session->query_buffer_unique(0, &buffer) != shared_memory::error_codes::SHM_NO_ERROR)
+		{
+			retval.dropped++;
+			continue;
+		}
+
+		int64_t published = now();
+		std::memcpy(buffer->data(), &published, sizeof(int64_t));
+		session->publish(buffer);
+		retval.publishing.push_back(now() - start);
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	running = false;
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return retval;
+}
+
+int main()
+{
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n%-10s %11s %14s %14s %14s %14s %14s %9s", "mode", "subscribers", "wake p50 (us)", "wake p99 (us)", "wake max (us)",
+		"publish p99", "publish max", "dropped");
+
+	bool valid = true;
+	for (const mode& current : MODES)
+	{
+		for (uint32_t subscribers : SUBSCRIBERS)
+		{
+			results measured = run(current, subscribers);
+
+			// Every subscriber which does not hold its frames must get most of them
+			uint32_t fast_subscribers = (subscribers > 1) ? subscribers - 1 : subscribers;
+			bool received = measured.received >= (FRAMES * fast_subscribers) / 2;
+			valid = valid && received;
+
+			Core::Console::ColorPrint(false, true, received ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+				"\n%-10s %11u %14.1f %14.1f %14.1f %14.1f %14.1f %9zu", current.name, static_cast<unsigned>(subscribers),
+				percentile(measured.latencies, 0.5), percentile(measured.latencies, 0.99), percentile(measured.latencies, 1.0),
+				percentile(measured.publishing, 0.99), percentile(measured.publishing, 1.0), measured.dropped);
+		}
+	}
+
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nsubscribers %s the published frames (%u hardware threads)\n", valid ? "received" : "DID NOT receive",
+		std::thread::hardware_concurrency());
+	return valid ? 0 : 1;
+}
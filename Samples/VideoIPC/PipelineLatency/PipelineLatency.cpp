@@ -0,0 +1,207 @@
+// PipelineLatency.cpp : Publishes a test pattern through shared memory to a subscriber with a fast and a slow frame callback,
+// then prints the statistics of the source, the publisher and the subscriber: frames, fps, drops, copied bytes and the
+// latency histograms of every hop (capture, publish, receive and delivery to the callbacks).
+// Run with -videotestsrc to capture from GStreamer's videotestsrc instead of the built-in pattern source.
+//
+#include <Core.hpp>
+#include <Video.hpp>
+#include <Factories.hpp>
+
+#include <utils/video.hpp>
+#include <utils/video_statistics.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t WIDTH = 1280;
+static constexpr uint32_t HEIGHT = 720;
+static constexpr uint32_t FPS = 60;
+static constexpr std::chrono::seconds DURATION(3);
+static constexpr std::chrono::milliseconds SLOW_CALLBACK(30);
+
+class frame : public utils::video::frame_base<core::video::frame_interface>
+{
+public:
+	frame(const core::imaging::image_params& image_params, const core::video::video_params& video_params, uint64_t frame_id, core::buffer_interface* buffer) :
+		frame_base(image_params, core::video::display_params{ 0, frame_id, 0, 0, frame_id }, video_params, buffer)
+	{
+	}
+};
+
+// Raises I420 frames of moving bars at FPS, stamped when captured as videotestsrc frames are by the appsink
+class pattern_source : public utils::ref_count_base<utils::video::video_source_base<core::video::video_source_interface>>
+{
+private:
+	std::atomic<core::video::video_state> m_state;
+	std::thread m_thread;
+	std::vector<utils::ref_count_ptr<core::buffer_interface>> m_patterns;
+
+	void run()
+	{
+		core::imaging::image_params image_params{ WIDTH, HEIGHT, (WIDTH * HEIGHT * 3) / 2, core::imaging::pixel_format::I420 };
+		std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; m_state != core::video::video_state::STOPPED; i++)
+		{
+			next += std::chrono::microseconds(1000000 / FPS);
+			std::this_thread::sleep_until(next);
+
+			core::video::video_params video_params{ core::video::interlace_mode::PROGRESSIVE, { FPS, 1 }, core::video::video_data_type::RAW, {} };
+			utils::video::stamp(video_params, core::video::video_hop::CAPTURE_HOP);
+			raise_frame(utils::make_ref_count_ptr<frame>(image_params, video_params, i, m_patterns[i % m_patterns.size()]));
+		}
+	}
+
+public:
+	pattern_source() :
+		m_state(core::video::video_state::STOPPED)
+	{
+		for (uint32_t offset = 0; offset < 8; offset++)
+		{
+			utils::ref_count_ptr<utils::ref_count_buffer> pattern = utils::make_ref_count_ptr<utils::ref_count_buffer>((WIDTH * HEIGHT * 3) / 2);
+			for (uint32_t y = 0; y < HEIGHT; y++)
+				for (uint32_t x = 0; x < WIDTH; x++)
+					pattern->data()[static_cast<size_t>(y) * WIDTH + x] = static_cast<uint8_t>(16 + ((x / 160 + offset) % 8) * 27);
+
+			std::memset(pattern->data() + WIDTH * HEIGHT, 128, (WIDTH * HEIGHT) / 2);
+			m_patterns.emplace_back(pattern);
+		}
+	}
+
+	virtual ~pattern_source()
+	{
+		stop();
+	}
+
+	virtual core::video::video_state state() override
+	{
+		return m_state;
+	}
+
+	virtual void start() override
+	{
+		if (m_state == core::video::video_state::PLAYING)
+			return;
+
+		m_state = core::video::video_state::PLAYING;
+		m_thread = std::thread([this]() { run(); });
+	}
+
+	virtual void stop() override
+	{
+		m_state = core::video::video_state::STOPPED;
+		if (m_thread.joinable())
+			m_thread.join();
+
+		sync();
+	}
+
+	virtual void pause() override
+	{
+		stop();
+	}
+};
+
+static void print(const char* name, const Video::VideoStatistics& statistics)
+{
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n%-11s %7llu frames %7.1f fps %5llu dropped %9.1f MB copied", name,
+		static_cast<unsigned long long>(statistics.frames), statistics.fps, static_cast<unsigned long long>(statistics.dropped),
+		static_cast<double>(statistics.copied_bytes) / (1024.0 * 1024.0));
+
+	const char* hops[] = { "capture", "publish", "receive", "deliver" };
+	for (uint32_t hop = 0; hop <= core::video::video_hop::VIDEO_HOP_COUNT; hop++)
+	{
+		const Video::LatencyHistogram& histogram = (hop < core::video::video_hop::VIDEO_HOP_COUNT) ? statistics.hops[hop] : statistics.end_to_end;
+		if (histogram.count == 0)
+			continue;
+
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+			"\n  %-11s %7llu %10.1f %10llu %10llu %10llu", (hop < core::video::video_hop::VIDEO_HOP_COUNT) ? hops[hop] : "end to end",
+			static_cast<unsigned long long>(histogram.count),
+			static_cast<double>(histogram.total) / static_cast<double>(histogram.count),
+			static_cast<unsigned long long>(utils::video::latency_percentile(histogram, 0.5)),
+			static_cast<unsigned long long>(utils::video::latency_percentile(histogram, 0.99)),
+			static_cast<unsigned long long>(histogram.max));
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	const char* name = "pipeline_latency";
+
+	Video::VideoSource source;
+	if (argc > 1 && std::strcmp(argv[1], "-videotestsrc") == 0)
+	{
+#ifdef USE_GSTREAMER
+		source = Video::Sources::TestVideoSource::Create(WIDTH, HEIGHT, core::imaging::pixel_format::I420, { FPS, 1 });
+#else
+		Core::Console::ColorPrint(false, true, Core::Console::Colors::RED, "\nbuilt without GStreamer\n");
+		return 1;
+#endif
+	}
+	else
+	{
+		source = Video::VideoSource(utils::make_ref_count_ptr<pattern_source>());
+	}
+
+	// Frames pending for the slow callback pin their shared memory buffers, the pool has room for them
+	Video::VideoPublisher publisher = Video::Publishers::SharedMemoryVideoPublisher::Create(name, source, (WIDTH * HEIGHT * 3) / 2 + 4096, 32, true);
+	Video::VideoSource subscriber = Video::Sources::SharedMemoryVideoSource::Create(name);
+
+	// The signals of a VideoSource share one frame callback, the slow one gets its own
+	Video::VideoSource slow_subscriber(static_cast<core::video::video_source_interface*>(subscriber));
+
+	std::atomic<uint64_t> fast(0);
+	std::atomic<uint64_t> slow(0);
+	subscriber.OnFrame() += [&](const Video::Frame&)
+	{
+		fast++;
+	};
+
+	slow_subscriber.OnFrame() += [&](const Video::Frame&)
+	{
+		slow++;
+		std::this_thread::sleep_for(SLOW_CALLBACK);
+	};
+
+	subscriber.Start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	publisher.Start();
+	std::this_thread::sleep_for(DURATION);
+
+	Video::VideoStatistics source_statistics = {};
+	Video::VideoStatistics publisher_statistics = {};
+	Video::VideoStatistics subscriber_statistics = {};
+	bool measured = source.QueryStatistics(source_statistics) &&
+		publisher.QueryStatistics(publisher_statistics) &&
+		subscriber.QueryStatistics(subscriber_statistics);
+
+	publisher.Stop();
+	subscriber.Stop();
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n%-13s %7s %10s %10s %10s %10s", "latency (us)", "count", "mean", "p50", "p99", "max");
+	print("source", source_statistics);
+	print("publisher", publisher_statistics);
+	print("subscriber", subscriber_statistics);
+
+	// Every hop was measured, the publisher published the frames of the source and the slow callback lost frames
+	bool valid = measured &&
+		source_statistics.hops[core::video::video_hop::DELIVER_HOP].count != 0 &&
+		publisher_statistics.frames != 0 && publisher_statistics.frames + publisher_statistics.dropped <= source_statistics.frames &&
+		publisher_statistics.hops[core::video::video_hop::PUBLISH_HOP].count != 0 &&
+		subscriber_statistics.hops[core::video::video_hop::RECEIVE_HOP].count != 0 &&
+		subscriber_statistics.end_to_end.count != 0 &&
+		fast > slow && subscriber_statistics.dropped != 0;
+
+	Core::Console::ColorPrint(false, true, Core::Console::Colors::WHITE,
+		"\n\nsubscriber callbacks: fast %llu frames, slow %llu frames", static_cast<unsigned long long>(fast), static_cast<unsigned long long>(slow));
+
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthe pipeline %s measured\n", valid ? "was" : "WAS NOT");
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// ZeroCopyPublishing.cpp : Publishes 1080p RGBA frames through a SharedMemoryVideoPublisher from heap buffers (copied into
+// the shared memory) and from a SharedMemoryFrameAllocator (handed off), measures how long publishing a frame takes and
+// checks a subscriber receives every frame intact in both cases.
+//
+#include <Core.hpp>
+#include <Factories.hpp>
+
+#include <utils/video.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t WIDTH = 1920;
+static constexpr uint32_t HEIGHT = 1080;
+static constexpr uint32_t FRAME_SIZE = WIDTH * HEIGHT * 4;
+static constexpr uint32_t BUFFER_SIZE = FRAME_SIZE + 4096;
+static constexpr uint32_t POOL_SIZE = 8;
+static constexpr size_t FRAMES = 100;
+
+class frame : public utils::video::frame_base<core::video::frame_interface>
+{
+public:
+	frame(const core::imaging::image_params& image_params, core::buffer_interface* buffer) :
+		frame_base(image_params, core::video::display_params{}, core::video::video_params{}, buffer)
+	{
+	}
+};
+
+// A source raising the frames it is given, synchronously: raise returns once the publisher is done with the frame
+class manual_source : public utils::ref_count_base<utils::video::video_source_base<core::video::video_source_interface>>
+{
+private:
+	std::atomic<core::video::video_state> m_state;
+
+public:
+	manual_source() :
+		m_state(core::video::video_state::STOPPED)
+	{
+	}
+
+	void raise(core::video::frame_interface* current)
+	{
+		raise_frame(current, false);
+	}
+
+	virtual core::video::video_state state() override
+	{
+		return m_state;
+	}
+
+	virtual void start() override
+	{
+		m_state = core::video::video_state::PLAYING;
+	}
+
+	virtual void stop() override
+	{
+		m_state = core::video::video_state::STOPPED;
+	}
+
+	virtual void pause() override
+	{
+		m_state = core::video::video_state::PAUSED;
+	}
+};
+
+// Every byte of frame 'index' holds the index, frames are told apart by the subscriber
+static void fill(uint8_t* data, size_t index)
+{
+	std::memset(data, static_cast<int>(index & 0xFF), FRAME_SIZE);
+}
+
+struct results
+{
+	double publish_microseconds;
+	size_t received;
+	size_t intact;
+};
+
+static results run(const char* name, bool zero_copy)
+{
+	Video::FrameAllocator allocator = Video::Publishers::SharedMemoryFrameAllocator::Create(name, BUFFER_SIZE, POOL_SIZE, true);
+	Buffers::BufferAllocator heap = Buffers::PooledBufferAllocator::Create(static_cast<size_t>(FRAME_SIZE) * POOL_SIZE);
+
+	utils::ref_count_ptr<manual_source> source = utils::make_ref_count_ptr<manual_source>();
+	Video::VideoPublisher publisher = Video::Publishers::SharedMemoryVideoPublisher::Create(allocator, Video::VideoSource(source));
+	publisher.Start();
+
+	std::atomic<size_t> received(0);
+	std::atomic<size_t> intact(0);
+	Video::VideoSource subscriber = Video::Sources::SharedMemoryVideoSource::Create(name);
+	subscriber.OnFrame() += [&](const Video::Frame& current)
+	{
+		received++;
+		const uint8_t* data = current.Buffer();
+		if (current.Size() == FRAME_SIZE && current.Width() == WIDTH && data[0] == data[FRAME_SIZE / 2] && data[0] == data[FRAME_SIZE - 1])
+			intact++;
+	};
+
+	subscriber.Start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+	double publishing = 0;
+	for (size_t i = 0; i < FRAMES; i++)
+	{
+		Buffers::Buffer buffer = (zero_copy == true) ? allocator.Allocate(FRAME_SIZE) : heap.Allocate(FRAME_SIZE);
+		fill(buffer.Data(), i);
+
+		utils::ref_count_ptr<core::video::frame_interface> current = utils::make_ref_count_ptr<frame>(
+			core::imaging::image_params{ WIDTH, HEIGHT, FRAME_SIZE, core::imaging::pixel_format::RGBA },
+			static_cast<core::buffer_interface*>(buffer));
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		source->raise(current);
+		publishing += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+		// A frame interval, letting the subscriber keep up
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	subscriber.Stop();
+	publisher.Stop();
+
+	return results{ publishing / FRAMES, received, intact };
+}
+
+int main()
+{
+	const struct
+	{
+		const char* name;
+		bool zero_copy;
+	} modes[] = {
+		{ "heap buffers (copied)", false },
+		{ "FrameAllocator buffers (handed off)", true }
+	};
+
+	bool valid = true;
+	for (const auto& mode : modes)
+	{
+		results measured = run("zero_copy_publishing", mode.zero_copy);
+
+		// Frames may be dropped when the subscriber falls behind, but never torn
+		bool frames_valid = measured.received > FRAMES / 2 && measured.intact == measured.received;
+		valid = valid && frames_valid;
+
+		Core::Console::ColorPrint(false, true, frames_valid ? Core::Console::Colors::WHITE : Core::Console::Colors::RED,
+			"\n%-36s publish %9.1f us per frame, %zu/%zu frames received, %zu intact", mode.name,
+			measured.publish_microseconds, measured.received, FRAMES, measured.intact);
+	}
+
+	Core::Console::ColorPrint(false, true, valid ? Core::Console::Colors::GREEN : Core::Console::Colors::RED,
+		"\n\nthe subscriber %s\n", valid ? "received intact frames" : "DID NOT receive intact frames");
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+## Generates packed C++ structs from binary parser metadata at build time
+##
+## binary_parser_generate(TARGET <target> OUTPUT <header> INPUTS <metadata files...> [NAMESPACE <namespace>] [XML])
+##
+## INPUTS are JSON schema files (BinaryMetaData::ToJson) or, with XML, data set XML files.
+## The header is generated into the binary directory of the target, which is added to its include directories,
+## and is regenerated when the inputs or the generator change.
+## The generator is the BinaryParserCodeGen target, or the executable set in BINARY_PARSER_CODEGEN when cross compiling.
+include(CMakeParseArguments)
+
+function(binary_parser_generate)
+	cmake_parse_arguments(GENERATE "XML" "TARGET;OUTPUT;NAMESPACE" "INPUTS" ${ARGN})
+
+	if(NOT GENERATE_TARGET OR NOT GENERATE_OUTPUT OR NOT GENERATE_INPUTS)
+		message(FATAL_ERROR "binary_parser_generate: TARGET, OUTPUT and INPUTS are required")
+	endif()
+
+	if(NOT GENERATE_NAMESPACE)
+		set(GENERATE_NAMESPACE generated)
+	endif()
+
+	if(BINARY_PARSER_CODEGEN)
+		set(GENERATOR ${BINARY_PARSER_CODEGEN})
+		set(GENERATOR_DEPENDS ${BINARY_PARSER_CODEGEN})
+	else()
+		set(GENERATOR $<TARGET_FILE:BinaryParserCodeGen>)
+		set(GENERATOR_DEPENDS BinaryParserCodeGen)
+	endif()
+
+	set(GENERATE_FLAGS --namespace ${GENERATE_NAMESPACE})
+	if(GENERATE_XML)
+		list(APPEND GENERATE_FLAGS --xml)
+	endif()
+
+	set(INPUT_FILES)
+	foreach(INPUT ${GENERATE_INPUTS})
+		get_filename_component(INPUT_FILE ${INPUT} ABSOLUTE)
+		list(APPEND INPUT_FILES ${INPUT_FILE})
+	endforeach()
+
+	set(OUTPUT_FILE ${CMAKE_CURRENT_BINARY_DIR}/${GENERATE_OUTPUT})
+	get_filename_component(OUTPUT_DIR ${OUTPUT_FILE} DIRECTORY)
+
+	add_custom_command(OUTPUT ${OUTPUT_FILE}
+		COMMAND ${CMAKE_COMMAND} -E make_directory ${OUTPUT_DIR}
+		COMMAND ${GENERATOR} --output ${OUTPUT_FILE} ${GENERATE_FLAGS} ${INPUT_FILES}
+		DEPENDS ${INPUT_FILES} ${GENERATOR_DEPENDS}
+		COMMENT "Generating binary parser structs ${GENERATE_OUTPUT}"
+		VERBATIM)
+
+	target_sources(${GENERATE_TARGET} PRIVATE ${OUTPUT_FILE})
+	target_include_directories(${GENERATE_TARGET} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
+endfunction()